@@ -146,7 +146,7 @@ std::vector<SilkwormChainSnapshot> collect_all_snapshots(const SnapshotRepositor
     for (const auto& segment_file : snapshot_repository.get_segment_files()) {
         switch (segment_file.type()) {
             case SnapshotType::headers: {
-                const auto* header_snapshot{snapshot_repository.get_header_segment(segment_file)};
+                const auto header_snapshot{snapshot_repository.get_header_segment(segment_file)};
                 const auto* idx_header_hash{header_snapshot->idx_header_hash()};
                 SilkwormHeadersSnapshot raw_headers_snapshot{
                     .segment{
@@ -160,7 +160,7 @@ std::vector<SilkwormChainSnapshot> collect_all_snapshots(const SnapshotRepositor
                 headers_snapshot_sequence.push_back(raw_headers_snapshot);
             } break;
             case SnapshotType::bodies: {
-                const auto* body_snapshot{snapshot_repository.get_body_segment(segment_file)};
+                const auto body_snapshot{snapshot_repository.get_body_segment(segment_file)};
                 const auto* idx_body_number{body_snapshot->idx_body_number()};
                 SilkwormBodiesSnapshot raw_bodies_snapshot{
                     .segment{
@@ -174,7 +174,7 @@ std::vector<SilkwormChainSnapshot> collect_all_snapshots(const SnapshotRepositor
                 bodies_snapshot_sequence.push_back(raw_bodies_snapshot);
             } break;
             case SnapshotType::transactions: {
-                const auto* tx_snapshot{snapshot_repository.get_tx_segment(segment_file)};
+                const auto tx_snapshot{snapshot_repository.get_tx_segment(segment_file)};
                 const auto* idx_txn_hash{tx_snapshot->idx_txn_hash()};
                 const auto* idx_txn_hash_2_block{tx_snapshot->idx_txn_hash_2_block()};
                 SilkwormTransactionsSnapshot raw_transactions_snapshot{
@@ -286,7 +286,7 @@ int build_indexes(SilkwormHandle handle, const BuildIndexesSettings& settings, c
         if (!snapshot_path.has_value())
             throw std::runtime_error("Invalid snapshot path");
 
-        const Snapshot* snapshot;
+        std::shared_ptr<const Snapshot> snapshot;
         switch (snapshot_path->type()) {
             case headers:
                 snapshot = repository.get_header_segment(*snapshot_path);
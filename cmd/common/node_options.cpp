@@ -17,6 +17,7 @@
 #include "node_options.hpp"
 
 #include <filesystem>
+#include <map>
 #include <string>
 
 #include <silkworm/core/common/util.hpp>
@@ -57,6 +58,16 @@ void add_node_options(CLI::App& cli, node::Settings& settings) {
     cli.add_option("--etl.buffersize", etl_buffer_size_str, "Buffer size for ETL operations")
         ->capture_default_str()
         ->check(HumanSizeParserValidator("64MB", {"1GB"}));
+    std::map<std::string, etl::SpillCompression> etl_compression_mapping{
+        {"none", etl::SpillCompression::kNone},
+        {"prefix", etl::SpillCompression::kPrefixDelta},
+        {"snappy", etl::SpillCompression::kSnappy},
+    };
+    cli.add_option("--etl.compression", settings.etl_spill_compression,
+                   "Format of ETL temporary files: none, prefix (delta-encoded keys) or snappy (prefix + Snappy)")
+        ->capture_default_str()
+        ->transform(CLI::Transformer(etl_compression_mapping, CLI::ignore_case))
+        ->default_val(etl::SpillCompression::kNone);
 
     cli.add_option("--sync.loop.throttle", settings.sync_loop_throttle_seconds,
                    "Sets the minimum delay between sync loop starts (in seconds)")
@@ -69,6 +80,18 @@ void add_node_options(CLI::App& cli, node::Settings& settings) {
         ->check(CLI::Range(10u, 600u));
 
     cli.add_flag("--fakepow", settings.fake_pow, "Disables proof-of-work verification");
+    cli.add_flag("--execution.parallel", settings.parallel_execution_enabled,
+                 "Execute block transactions optimistically in parallel");
+    cli.add_flag("--execution.pipeline", settings.execution_pipeline_enabled,
+                 "Overlap block reading, execution and state flushing in Execution stage");
+    cli.add_option("--execution.prefetch", settings.execution_prefetch_blocks,
+                   "Number of upcoming blocks whose accounts and storage are prefetched during execution (0 = disabled)")
+        ->capture_default_str()
+        ->check(CLI::Range(0u, 1024u));
+    cli.add_option("--interhashes.threads", settings.trie_regeneration_threads,
+                   "Number of threads building state subtries in parallel on full trie regeneration")
+        ->capture_default_str()
+        ->check(CLI::Range(1u, 16u));
 
     add_option_private_api_address(cli, settings.server_settings.address_uri);
     add_option_remote_sentry_addresses(cli, settings.remote_sentry_addresses, /*is_required=*/false);
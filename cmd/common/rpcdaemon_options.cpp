@@ -18,6 +18,8 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <string>
 
 #include <absl/strings/str_split.h>
 
@@ -100,6 +102,41 @@ void add_rpcdaemon_options(CLI::App& cli, silkworm::rpc::DaemonSettings& setting
         ->delimiter(',')
         ->required(false);
 
+    cli.add_option("--http.batch.limit", settings.max_batch_size)
+        ->description("Maximum number of requests in one JSON RPC batch, zero means unlimited")
+        ->capture_default_str();
+
+    cli.add_option("--http.batch.concurrency", settings.batch_concurrency)
+        ->description("Maximum number of requests in one JSON RPC batch handled concurrently")
+        ->check(CLI::Range(1, 1024))
+        ->capture_default_str();
+
+    cli.add_option("--http.compression", settings.http_compression)
+        ->description("Flag indicating if HTTP replies are compressed when the client accepts gzip or deflate encoding (never on Engine API endpoint)")
+        ->capture_default_str();
+
+    cli.add_option("--http.compression.threshold", settings.http_compression_threshold)
+        ->description("Minimum size in bytes of HTTP replies to compress, streamed replies are always compressed")
+        ->capture_default_str();
+
+    const auto set_idle_timeout = [&settings](const uint32_t& seconds) { settings.http_idle_timeout = std::chrono::seconds{seconds}; };
+    cli.add_option_function<uint32_t>("--http.idle_timeout", set_idle_timeout)
+        ->description("Time in seconds after which an HTTP connection with no request in progress is closed, zero means unlimited")
+        ->default_str(std::to_string(std::chrono::duration_cast<std::chrono::seconds>(settings.http_idle_timeout).count()));
+
+    cli.add_option("--http.max_requests_per_connection", settings.http_max_requests_per_connection)
+        ->description("Maximum number of requests served on one HTTP connection before closing it, zero means unlimited")
+        ->capture_default_str();
+
+    cli.add_option("--http.max_pipelined_requests", settings.http_max_pipelined_requests)
+        ->description("Maximum number of requests received on one HTTP connection and waiting to be handled in order")
+        ->check(CLI::Range(1, 1024))
+        ->capture_default_str();
+
+    cli.add_option("--http.max_body_size", settings.http_max_content_length)
+        ->description("Maximum size in bytes of HTTP request body")
+        ->capture_default_str();
+
     cli.add_flag("--skip_protocol_check", settings.skip_protocol_check)
         ->description("Flag indicating if gRPC protocol version check should be skipped")
         ->capture_default_str();
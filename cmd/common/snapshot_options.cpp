@@ -16,6 +16,10 @@
 
 #include "snapshot_options.hpp"
 
+#include <silkworm/core/common/util.hpp>
+
+#include "human_size_parser_validator.hpp"
+
 namespace silkworm::cmd::common {
 
 void add_snapshot_options(CLI::App& cli, snapshot::SnapshotSettings& snapshot_settings) {
@@ -25,9 +29,63 @@ void add_snapshot_options(CLI::App& cli, snapshot::SnapshotSettings& snapshot_se
     cli.add_flag("--snapshots.no_downloader", snapshot_settings.no_downloader)
         ->description("If set, the snapshot downloader is disabled and just already present local snapshots are used")
         ->capture_default_str();
+    cli.add_flag("--snapshots.freeze", snapshot_settings.freeze)
+        ->description("If set, finalized blocks are periodically moved from the database into new snapshots")
+        ->capture_default_str();
     cli.add_option("--snapshots.repository.path", snapshot_settings.repository_dir)
         ->description("Filesystem path where snapshots will be stored")
         ->capture_default_str();
+    auto& index_build_settings = snapshot_settings.index_build_settings;
+    cli.add_option_function<std::string>(
+           "--snapshots.index.memory",
+           [&index_build_settings](const std::string& value) { index_build_settings.memory_budget = *parse_size(value); },
+           "Max memory for buffering keys across all concurrent snapshot index builds, keys are spilled to disk beyond it")
+        ->default_str(human_size(index_build_settings.memory_budget))
+        ->check(HumanSizeParserValidator("64MB"));
+    cli.add_option("--snapshots.index.max_builds", index_build_settings.max_concurrent_builds)
+        ->description("Max number of snapshot indexes built concurrently (0 means number of hardware threads)")
+        ->capture_default_str();
+    cli.add_option("--snapshots.index.threads", index_build_settings.scan_threads)
+        ->description("Number of threads scanning snapshots shared by all index builds (0 means number of hardware threads)")
+        ->capture_default_str();
+    auto& memory_mapping_settings = snapshot_settings.memory_mapping_settings;
+    cli.add_flag("--snapshots.mmap.segments.populate", memory_mapping_settings.segments.populate)
+        ->description("If set, snapshot segment files are entirely read in memory when opened")
+        ->capture_default_str();
+    cli.add_flag("--snapshots.mmap.segments.huge_pages", memory_mapping_settings.segments.huge_pages)
+        ->description("If set, snapshot segment files use transparent huge pages where the filesystem allows")
+        ->capture_default_str();
+    cli.add_flag("--snapshots.mmap.segments.lock", memory_mapping_settings.segments.lock)
+        ->description("If set, snapshot segment files are locked in memory (subject to the memory-lock limit)")
+        ->capture_default_str();
+    cli.add_flag("--snapshots.mmap.indexes.populate", memory_mapping_settings.indexes.populate)
+        ->description("If set, snapshot index files are entirely read in memory when opened")
+        ->capture_default_str();
+    cli.add_flag("--snapshots.mmap.indexes.huge_pages", memory_mapping_settings.indexes.huge_pages)
+        ->description("If set, snapshot index files use transparent huge pages where the filesystem allows")
+        ->capture_default_str();
+    cli.add_flag("--snapshots.mmap.indexes.lock", memory_mapping_settings.indexes.lock)
+        ->description("If set, snapshot index files are locked in memory (subject to the memory-lock limit)")
+        ->capture_default_str();
+    cli.add_option("--snapshots.mmap.hot_segments", memory_mapping_settings.hot_segments)
+        ->description("Number of most recent snapshots per type whose files are read ahead when opened")
+        ->capture_default_str();
+    cli.add_flag("--snapshots.mmap.count_page_faults", memory_mapping_settings.count_page_faults)
+        ->description("If set, major page faults are counted per snapshot type when reading snapshots")
+        ->capture_default_str();
+    auto& block_cache_settings = snapshot_settings.block_cache_settings;
+    cli.add_option("--snapshots.cache.headers", block_cache_settings.max_headers)
+        ->description("Max number of block headers decoded from snapshots kept in cache (0 means no cache)")
+        ->capture_default_str();
+    cli.add_option("--snapshots.cache.bodies", block_cache_settings.max_bodies)
+        ->description("Max number of block bodies decoded from snapshots kept in cache (0 means no cache)")
+        ->capture_default_str();
+    cli.add_option("--snapshots.cache.transactions", block_cache_settings.max_transactions)
+        ->description("Max number of block transaction lists decoded from snapshots kept in cache (0 means no cache)")
+        ->capture_default_str();
+    cli.add_option("--snapshots.cache.warm_up_blocks", block_cache_settings.warm_up_blocks)
+        ->description("Number of most recent blocks decoded from snapshots into cache when snapshots are opened")
+        ->capture_default_str();
 
     // TODO(canepat) add options for the other snapshot settings and for all bittorrent settings
     cli.add_option("--torrent.verify_on_startup", snapshot_settings.bittorrent_settings.verify_on_startup)
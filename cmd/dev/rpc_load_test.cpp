@@ -0,0 +1,218 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/read.hpp>
+#include <boost/beast/http/string_body.hpp>
+
+#include <silkworm/infra/concurrency/task.hpp>
+
+using namespace silkworm;
+using boost::asio::ip::tcp;
+using Clock = std::chrono::steady_clock;
+
+struct app_options_t {
+    std::string host{"localhost"};                                          // RPC daemon host
+    std::string port{"8545"};                                               // RPC daemon port
+    std::size_t connections{16};                                            // Number of concurrent connections
+    std::size_t requests{1'000};                                            // Number of requests sent on each connection
+    std::size_t pipeline_depth{1};                                          // Number of requests in flight on each connection
+    std::size_t threads{1};                                                 // Number of client threads
+    std::vector<std::string> methods{"eth_blockNumber", "eth_getBalance"};  // JSON-RPC methods to measure
+    std::string address{"0x0000000000000000000000000000000000000000"};      // Account address for eth_getBalance
+    std::string block{"latest"};                                            // Block tag or number for eth_getBalance
+};
+
+//! The measurements collected on a single connection
+struct ConnectionStats {
+    std::vector<Clock::duration> latencies;
+    std::size_t errors{0};
+    bool failed{false};
+};
+
+static std::string make_http_request(const app_options_t& options, const std::string& method) {
+    std::string params{"[]"};
+    if (method == "eth_getBalance") {
+        params = R"([")" + options.address + R"(",")" + options.block + R"("])";
+    }
+    const std::string body{R"({"jsonrpc":"2.0","id":1,"method":")" + method + R"(","params":)" + params + "}"};
+    return "POST / HTTP/1.1\r\n"
+           "Host: " + options.host + ":" + options.port + "\r\n"
+           "Content-Type: application/json\r\n"
+           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+           "\r\n" + body;
+}
+
+//! Send all the requests on one keep-alive connection, keeping up to pipeline_depth requests in flight
+static Task<void> run_connection(const app_options_t& options, const tcp::resolver::results_type& endpoints, const std::string& request, ConnectionStats& stats) {
+    tcp::socket socket{co_await ThisTask::executor};
+    co_await boost::asio::async_connect(socket, endpoints, boost::asio::use_awaitable);
+    socket.set_option(tcp::no_delay{true});
+
+    boost::beast::flat_buffer buffer;
+    std::deque<Clock::time_point> in_flight;
+    std::string outgoing;
+    std::size_t sent{0};
+    while (sent < options.requests || !in_flight.empty()) {
+        // Fill the pipeline and send the new requests in one write
+        outgoing.clear();
+        while (sent < options.requests && in_flight.size() < options.pipeline_depth) {
+            outgoing.append(request);
+            in_flight.push_back(Clock::now());
+            ++sent;
+        }
+        if (!outgoing.empty()) {
+            co_await boost::asio::async_write(socket, boost::asio::buffer(outgoing), boost::asio::use_awaitable);
+        }
+
+        // Replies come back in request order
+        boost::beast::http::response<boost::beast::http::string_body> response;
+        co_await boost::beast::http::async_read(socket, buffer, response, boost::asio::use_awaitable);
+        stats.latencies.push_back(Clock::now() - in_flight.front());
+        in_flight.pop_front();
+        if (response.result() != boost::beast::http::status::ok || response.body().find(R"("error")") != std::string::npos) {
+            ++stats.errors;
+        }
+        if (!response.keep_alive() && (sent < options.requests || !in_flight.empty())) {
+            throw std::runtime_error{"connection closed by server after " + std::to_string(stats.latencies.size()) + " requests"};
+        }
+    }
+}
+
+static double to_milliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+//! Nearest-rank percentile over sorted latencies
+static Clock::duration percentile(const std::vector<Clock::duration>& sorted_latencies, double p) {
+    if (sorted_latencies.empty()) return {};
+    const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted_latencies.size())));
+    return sorted_latencies[std::clamp<std::size_t>(rank, 1, sorted_latencies.size()) - 1];
+}
+
+static void run_scenario(const app_options_t& options, const tcp::resolver::results_type& endpoints, const std::string& method) {
+    const auto request{make_http_request(options, method)};
+
+    boost::asio::io_context io_context;
+    std::vector<ConnectionStats> stats(options.connections);
+    for (auto& connection_stats : stats) {
+        boost::asio::co_spawn(io_context, run_connection(options, endpoints, request, connection_stats), [&](std::exception_ptr eptr) {
+            if (!eptr) return;
+            connection_stats.failed = true;
+            try {
+                std::rethrow_exception(eptr);
+            } catch (const std::exception& e) {
+                std::cerr << method << ": connection failed: " << e.what() << "\n";
+            }
+        });
+    }
+
+    const auto start{Clock::now()};
+    std::vector<std::thread> threads;
+    for (std::size_t i{1}; i < options.threads; ++i) {
+        threads.emplace_back([&]() { io_context.run(); });
+    }
+    io_context.run();
+    for (auto& t : threads) {
+        t.join();
+    }
+    const auto elapsed{Clock::now() - start};
+
+    std::vector<Clock::duration> latencies;
+    std::size_t errors{0};
+    std::size_t failed_connections{0};
+    for (const auto& connection_stats : stats) {
+        latencies.insert(latencies.end(), connection_stats.latencies.cbegin(), connection_stats.latencies.cend());
+        errors += connection_stats.errors;
+        failed_connections += connection_stats.failed ? 1 : 0;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    const auto elapsed_seconds{std::chrono::duration<double>(elapsed).count()};
+    const auto throughput{elapsed_seconds > 0 ? static_cast<double>(latencies.size()) / elapsed_seconds : 0.0};
+    std::cout << std::left << std::setw(16) << method << std::right << std::fixed << std::setprecision(3)
+              << " requests: " << std::setw(9) << latencies.size()
+              << " errors: " << std::setw(6) << errors
+              << " failed conns: " << std::setw(4) << failed_connections
+              << " req/s: " << std::setw(12) << throughput
+              << " p50: " << std::setw(9) << to_milliseconds(percentile(latencies, 0.50)) << "ms"
+              << " p99: " << std::setw(9) << to_milliseconds(percentile(latencies, 0.99)) << "ms"
+              << " max: " << std::setw(9) << to_milliseconds(latencies.empty() ? Clock::duration{} : latencies.back()) << "ms\n";
+}
+
+int main(int argc, char* argv[]) {
+    CLI::App app("Load test for RPC daemon HTTP endpoint.");
+    app_options_t options{};
+
+    app.add_option("--host", options.host, "RPC daemon host")->capture_default_str();
+    app.add_option("--port", options.port, "RPC daemon port")->capture_default_str();
+    app.add_option("--connections", options.connections, "Number of concurrent keep-alive connections")
+        ->capture_default_str()
+        ->check(CLI::Range(1, 10'000));
+    app.add_option("--requests", options.requests, "Number of requests sent on each connection")
+        ->capture_default_str()
+        ->check(CLI::Range(1, 10'000'000));
+    app.add_option("--pipeline", options.pipeline_depth, "Number of pipelined requests in flight on each connection")
+        ->capture_default_str()
+        ->check(CLI::Range(1, 1024));
+    app.add_option("--threads", options.threads, "Number of client threads")
+        ->capture_default_str()
+        ->check(CLI::Range(1u, std::max(1u, std::thread::hardware_concurrency())));
+    app.add_option("--methods", options.methods, "JSON-RPC methods to measure")
+        ->capture_default_str()
+        ->check(CLI::IsMember({"eth_blockNumber", "eth_getBalance"}));
+    app.add_option("--address", options.address, "Account address used by eth_getBalance")->capture_default_str();
+    app.add_option("--block", options.block, "Block number or tag used by eth_getBalance")->capture_default_str();
+
+    CLI11_PARSE(app, argc, argv);
+
+    try {
+        boost::asio::io_context io_context;
+        tcp::resolver resolver{io_context};
+        const auto endpoints{resolver.resolve(options.host, options.port)};
+
+        std::cout << "Target: " << options.host << ":" << options.port << " connections: " << options.connections
+                  << " requests/connection: " << options.requests << " pipeline: " << options.pipeline_depth << "\n";
+        for (const auto& method : options.methods) {
+            run_scenario(options, endpoints, method);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Load test failed: " << e.what() << "\n";
+        return -1;
+    }
+    return 0;
+}
@@ -30,10 +30,10 @@
 #include <silkworm/core/types/call_traces.hpp>
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/concurrency/signal_handler.hpp>
-#include <silkworm/infra/concurrency/thread_pool.hpp>
 #include <silkworm/node/db/access_layer.hpp>
 #include <silkworm/node/db/buffer.hpp>
 #include <silkworm/node/snapshot/index.hpp>
+#include <silkworm/node/snapshot/index_scheduler.hpp>
 #include <silkworm/silkrpc/daemon.hpp>
 
 #include "instance.hpp"
@@ -165,8 +165,6 @@ SILKWORM_EXPORT int silkworm_init(
 }
 
 SILKWORM_EXPORT int silkworm_build_recsplit_indexes(SilkwormHandle handle, struct SilkwormMemoryMappedFile* snapshots[], size_t len) SILKWORM_NOEXCEPT {
-    const int kNeededIndexesToBuildInParallel = 2;
-
     if (!handle) {
         return SILKWORM_INVALID_HANDLE;
     }
@@ -205,33 +203,9 @@ SILKWORM_EXPORT int silkworm_build_recsplit_indexes(SilkwormHandle handle, struc
         needed_indexes.push_back(index);
     }
 
-    if (needed_indexes.size() < kNeededIndexesToBuildInParallel) {
-        // sequential build
-        for (const auto& index : needed_indexes) {
-            index->build();
-        }
-    } else {
-        // parallel build
-        ThreadPool workers;
-
-        // Create worker tasks for missing indexes
-        for (const auto& index : needed_indexes) {
-            workers.push_task([=]() {
-                SILK_INFO << "SnapshotSync: build index: " << index->path().filename() << " start";
-                index->build();
-                SILK_INFO << "SnapshotSync: build index: " << index->path().filename() << " end";
-            });
-        }
-
-        // Wait for all missing indexes to be built or stop request
-        while (workers.get_tasks_total()) {
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-        }
-
-        // Wait for any already-started-but-unfinished work in case of stop request
-        workers.pause();
-        workers.wait_for_tasks();
-    }
+    // Build the indexes in parallel within the default memory budget
+    snapshot::IndexBuildScheduler scheduler;
+    scheduler.build(std::move(needed_indexes));
 
     return SILKWORM_OK;
 }
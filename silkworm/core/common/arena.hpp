@@ -0,0 +1,125 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace silkworm {
+
+//! \brief MonotonicArena is a bump allocator: memory is handed out sequentially from a few large chunks and is given
+//! back all at once when the arena is destroyed, individual deallocations being no-ops
+//! \remarks Not thread-safe. Intended for short-lived containers whose elements die together, e.g. per-block state.
+class MonotonicArena {
+  public:
+    static constexpr size_t kDefaultInitialChunkSize{64 * 1024};
+    static constexpr size_t kMaxChunkSize{4 * 1024 * 1024};
+
+    explicit MonotonicArena(size_t initial_chunk_size = kDefaultInitialChunkSize)
+        : next_chunk_size_{std::max<size_t>(initial_chunk_size, 1)} {}
+
+    // Not copyable nor movable
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    [[nodiscard]] void* allocate(size_t size, size_t alignment) {
+        auto address{reinterpret_cast<uintptr_t>(cursor_)};
+        auto aligned{(address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1)};
+        if (cursor_ == nullptr || aligned + size > reinterpret_cast<uintptr_t>(end_)) {
+            add_chunk(size + alignment);
+            address = reinterpret_cast<uintptr_t>(cursor_);
+            aligned = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        }
+        cursor_ = reinterpret_cast<std::byte*>(aligned + size);
+        allocated_bytes_ += size;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    //! \brief Number of bytes handed out since construction
+    [[nodiscard]] size_t allocated_bytes() const noexcept { return allocated_bytes_; }
+
+    //! \brief Number of chunks currently owned, i.e. number of heap allocations made
+    [[nodiscard]] size_t num_chunks() const noexcept { return chunks_.size(); }
+
+  private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size{0};
+    };
+
+    void add_chunk(size_t min_size) {
+        const size_t size{std::max(next_chunk_size_, min_size)};
+        chunks_.push_back({std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+        cursor_ = chunks_.back().data.get();
+        end_ = cursor_ + size;
+        next_chunk_size_ = std::min(next_chunk_size_ * 2, kMaxChunkSize);
+    }
+
+    size_t next_chunk_size_;
+    std::vector<Chunk> chunks_;
+    std::byte* cursor_{nullptr};
+    std::byte* end_{nullptr};
+    size_t allocated_bytes_{0};
+};
+
+//! \brief ArenaAllocator is a standard allocator drawing memory from a MonotonicArena (or the heap if none)
+//! \remarks Copies of containers made by copy construction use the heap, so that they can safely outlive the arena
+template <typename T>
+class ArenaAllocator {
+  public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(MonotonicArena* arena) noexcept : arena_{arena} {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_{other.arena()} {}  // NOLINT(google-explicit-constructor)
+
+    [[nodiscard]] T* allocate(size_t n) {
+        if (arena_) {
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (!arena_) {
+            std::allocator<T>{}.deallocate(p, n);
+        }
+    }
+
+    [[nodiscard]] ArenaAllocator select_on_container_copy_construction() const noexcept { return ArenaAllocator{}; }
+
+    [[nodiscard]] MonotonicArena* arena() const noexcept { return arena_; }
+
+    template <typename U>
+    friend bool operator==(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) noexcept {
+        return lhs.arena() == rhs.arena();
+    }
+
+  private:
+    MonotonicArena* arena_{nullptr};
+};
+
+}  // namespace silkworm
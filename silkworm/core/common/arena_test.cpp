@@ -0,0 +1,97 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "arena.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/hash_maps.hpp>
+
+namespace silkworm {
+
+TEST_CASE("MonotonicArena allocate") {
+    MonotonicArena arena{/*initial_chunk_size=*/128};
+    CHECK(arena.num_chunks() == 0);
+    CHECK(arena.allocated_bytes() == 0);
+
+    SECTION("alignment is honoured") {
+        for (size_t alignment : {1u, 2u, 4u, 8u, 16u, 64u}) {
+            (void)arena.allocate(1, 1);  // misalign the cursor on purpose
+            const void* p{arena.allocate(3, alignment)};
+            CHECK(reinterpret_cast<uintptr_t>(p) % alignment == 0);
+        }
+        CHECK(arena.num_chunks() == 1);
+    }
+
+    SECTION("chunks are added on demand") {
+        (void)arena.allocate(100, 1);
+        CHECK(arena.num_chunks() == 1);
+        (void)arena.allocate(100, 1);
+        CHECK(arena.num_chunks() == 2);
+        (void)arena.allocate(10'000, 8);  // larger than the next chunk size
+        CHECK(arena.num_chunks() == 3);
+        CHECK(arena.allocated_bytes() == 10'200);
+    }
+}
+
+TEST_CASE("ArenaAllocator") {
+    MonotonicArena arena;
+
+    SECTION("containers draw from the arena") {
+        std::vector<uint64_t, ArenaAllocator<uint64_t>> v{ArenaAllocator<uint64_t>{&arena}};
+        for (uint64_t i{0}; i < 1'000; ++i) {
+            v.push_back(i);
+        }
+        CHECK(v.size() == 1'000);
+        CHECK(v[999] == 999);
+        CHECK(arena.num_chunks() == 1);
+        CHECK(arena.allocated_bytes() >= 1'000 * sizeof(uint64_t));
+    }
+
+    SECTION("hash map in the arena") {
+        using Map = FlatHashMap<uint64_t, uint64_t, ArenaAllocator<std::pair<const uint64_t, uint64_t>>>;
+        Map map{Map::allocator_type{&arena}};
+        for (uint64_t i{0}; i < 1'000; ++i) {
+            map.emplace(i, i * 2);
+        }
+        CHECK(map.size() == 1'000);
+        CHECK(map.at(500) == 1'000);
+        CHECK(map.get_allocator().arena() == &arena);
+
+        // Copies go to the heap so that they can outlive the arena
+        const Map copy{map};
+        CHECK(copy.get_allocator().arena() == nullptr);
+        CHECK(copy == map);
+
+        // Moves keep the arena
+        const Map moved{std::move(map)};
+        CHECK(moved.get_allocator().arena() == &arena);
+        CHECK(moved.size() == 1'000);
+    }
+
+    SECTION("heap fallback without arena") {
+        std::vector<uint64_t, ArenaAllocator<uint64_t>> v;
+        v.assign(100, 42);
+        CHECK(v.back() == 42);
+        CHECK(arena.allocated_bytes() == 0);
+    }
+}
+
+}  // namespace silkworm
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <utility>
+
 #if defined(SILKWORM_CORE_USE_ABSEIL)
 
 #include <absl/container/flat_hash_map.h>
@@ -35,7 +39,7 @@ Alias templates to fast hash maps and sets, such as Abseil "Swiss tables"
 
 The following aliases are defined:
 
-FlatHashMap – a hash map that might not have pointer stability.
+FlatHashMap – a hash map that might not have pointer stability, optionally with a custom allocator.
 FlatHashSet – a hash set that might not have pointer stability.
 
 See https://abseil.io/docs/cpp/guides/container#hash-tables
@@ -44,8 +48,9 @@ and https://abseil.io/docs/cpp/guides/container#fn:pointer-stability
 
 #if defined(SILKWORM_CORE_USE_ABSEIL)
 
-template <class K, class V>
-using FlatHashMap = absl::flat_hash_map<K, V>;
+template <class K, class V, class Allocator = std::allocator<std::pair<const K, V>>>
+using FlatHashMap = absl::flat_hash_map<K, V, typename absl::flat_hash_map<K, V>::hasher,
+                                        typename absl::flat_hash_map<K, V>::key_equal, Allocator>;
 
 template <class T>
 using FlatHashSet = absl::flat_hash_set<T>;
@@ -56,8 +61,8 @@ using FlatHashSet = absl::flat_hash_set<T>;
 // at least not under CMake, but see
 // https://github.com/abseil/abseil-cpp/pull/721
 
-template <class K, class V>
-using FlatHashMap = std::unordered_map<K, V>;
+template <class K, class V, class Allocator = std::allocator<std::pair<const K, V>>>
+using FlatHashMap = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, Allocator>;
 
 template <class T>
 using FlatHashSet = std::unordered_set<T>;
@@ -0,0 +1,149 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#ifndef __wasm__
+#include <mutex>
+#endif
+
+#include <silkworm/core/common/lru_cache.hpp>
+
+#ifndef __wasm__
+#define SILKWORM_DETAIL_SHARD_GUARD(shard) std::scoped_lock lock{(shard).mutex};
+#else
+#define SILKWORM_DETAIL_SHARD_GUARD(shard)
+#endif
+
+namespace silkworm {
+
+//! \brief ShardedLruCache is a size-bounded LRU cache safe to be shared by many threads
+//! \details Keys are spread over independent LRU shards each one having its own lock, so that concurrent accesses
+//! contend only when hitting the same shard. Eviction is LRU within each shard, hence approximately LRU overall.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedLruCache {
+  public:
+    static constexpr size_t kDefaultNumShards{16};
+
+    //! \param max_size the maximum number of entries kept overall
+    //! \param num_shards the number of shards, rounded up to the next power of 2
+    explicit ShardedLruCache(size_t max_size, size_t num_shards = kDefaultNumShards)
+        : num_shards_{std::bit_ceil(num_shards > 0 ? num_shards : 1)},
+          shard_shift_{64 - std::countr_zero(num_shards_)},
+          max_size_{max_size},
+          shards_{std::make_unique<Shard[]>(num_shards_)} {
+        const size_t shard_max_size{(max_size + num_shards_ - 1) / num_shards_};
+        for (size_t i{0}; i < num_shards_; ++i) {
+            shards_[i].cache = std::make_unique<lru_cache<Key, Value>>(shard_max_size);
+        }
+    }
+
+    // Not copyable nor movable
+    ShardedLruCache(const ShardedLruCache&) = delete;
+    ShardedLruCache& operator=(const ShardedLruCache&) = delete;
+
+    void put(const Key& key, const Value& value) {
+        Shard& shard{shard_for(key)};
+        SILKWORM_DETAIL_SHARD_GUARD(shard)
+        shard.cache->put(key, value);
+    }
+
+    std::optional<Value> get_as_copy(const Key& key) {
+        return get_as_copy_if(key, [](const Value&) { return true; });
+    }
+
+    //! \brief The same as get_as_copy but a cached value not satisfying the predicate is not returned and counts as a miss
+    template <typename Predicate>
+    std::optional<Value> get_as_copy_if(const Key& key, Predicate&& predicate) {
+        Shard& shard{shard_for(key)};
+        std::optional<Value> value;
+        {
+            SILKWORM_DETAIL_SHARD_GUARD(shard)
+            if (const Value* cached{shard.cache->get(key)}; cached && predicate(*cached)) {
+                value = *cached;
+            }
+        }
+        (value ? hits_ : misses_).fetch_add(1, std::memory_order_relaxed);
+        return value;
+    }
+
+    bool remove(const Key& key) {
+        Shard& shard{shard_for(key)};
+        SILKWORM_DETAIL_SHARD_GUARD(shard)
+        return shard.cache->remove(key);
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        size_t total_size{0};
+        for (size_t i{0}; i < num_shards_; ++i) {
+            SILKWORM_DETAIL_SHARD_GUARD(shards_[i])
+            total_size += shards_[i].cache->size();
+        }
+        return total_size;
+    }
+
+    [[nodiscard]] size_t max_size() const noexcept { return max_size_; }
+
+    [[nodiscard]] size_t num_shards() const noexcept { return num_shards_; }
+
+    void clear() noexcept {
+        for (size_t i{0}; i < num_shards_; ++i) {
+            SILKWORM_DETAIL_SHARD_GUARD(shards_[i])
+            shards_[i].cache->clear();
+        }
+    }
+
+    //! \brief Number of lookups which found the key
+    [[nodiscard]] uint64_t hits() const noexcept { return hits_.load(std::memory_order_relaxed); }
+
+    //! \brief Number of lookups which did not find the key
+    [[nodiscard]] uint64_t misses() const noexcept { return misses_.load(std::memory_order_relaxed); }
+
+  private:
+    //! Shards are aligned to (typical) cache line size to avoid false sharing among their locks
+    struct alignas(64) Shard {
+        std::unique_ptr<lru_cache<Key, Value>> cache;
+#ifndef __wasm__
+        mutable std::mutex mutex;
+#endif
+    };
+
+    Shard& shard_for(const Key& key) const {
+        if (num_shards_ == 1) {
+            return shards_[0];
+        }
+        // Fibonacci hashing spreads the high bits even if the key hash is weak
+        const uint64_t hash{static_cast<uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull};
+        return shards_[hash >> shard_shift_];
+    }
+
+    const size_t num_shards_;
+    const int shard_shift_;
+    const size_t max_size_;
+    std::unique_ptr<Shard[]> shards_;
+    std::atomic_uint64_t hits_{0};
+    std::atomic_uint64_t misses_{0};
+};
+
+}  // namespace silkworm
@@ -0,0 +1,74 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/core/common/lru_cache.hpp>
+#include <silkworm/core/common/random_number.hpp>
+#include <silkworm/core/common/sharded_lru_cache.hpp>
+
+namespace {
+
+using namespace silkworm;
+
+constexpr size_t kCacheSize{4'096};
+constexpr size_t kNumKeys{5'000};  // Slightly more keys than cache entries to have some misses
+constexpr size_t kNumLookups{1'024};
+
+using Value = std::shared_ptr<int>;  // Analysis cache values are shared pointers as well
+
+std::vector<uint64_t> random_keys() {
+    RandomNumber random_key{0, kNumKeys - 1};
+    std::vector<uint64_t> keys(kNumLookups);
+    for (auto& key : keys) {
+        key = random_key.generate_one();
+    }
+    return keys;
+}
+
+template <typename Cache>
+void lookup_or_insert(benchmark::State& state, Cache& cache) {
+    const auto keys{random_keys()};
+    const auto value{std::make_shared<int>(0)};
+    for ([[maybe_unused]] auto _ : state) {
+        for (const auto key : keys) {
+            if (const auto cached{cache.get_as_copy(key)}) {
+                benchmark::DoNotOptimize(cached);
+            } else {
+                cache.put(key, value);
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(kNumLookups));
+}
+
+void bench_mutex_lru_cache(benchmark::State& state) {
+    static lru_cache<uint64_t, Value> cache{kCacheSize, /*thread_safe=*/true};
+    lookup_or_insert(state, cache);
+}
+
+void bench_sharded_lru_cache(benchmark::State& state) {
+    static ShardedLruCache<uint64_t, Value> cache{kCacheSize};
+    lookup_or_insert(state, cache);
+}
+
+}  // namespace
+
+BENCHMARK(bench_mutex_lru_cache)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(bench_sharded_lru_cache)->ThreadRange(1, 16)->UseRealTime();
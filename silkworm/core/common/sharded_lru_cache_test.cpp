@@ -0,0 +1,102 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sharded_lru_cache.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("ShardedLruCache put and get") {
+    ShardedLruCache<int, int> cache{/*max_size=*/64, /*num_shards=*/3};
+    CHECK(cache.num_shards() == 4);
+    CHECK(cache.max_size() == 64);
+
+    CHECK_FALSE(cache.get_as_copy(7));
+    cache.put(7, 777);
+    CHECK(cache.get_as_copy(7) == 777);
+    CHECK(cache.size() == 1);
+    CHECK(cache.hits() == 1);
+    CHECK(cache.misses() == 1);
+
+    CHECK(cache.remove(7));
+    CHECK_FALSE(cache.remove(7));
+    CHECK(cache.size() == 0);
+}
+
+TEST_CASE("ShardedLruCache get with predicate") {
+    ShardedLruCache<int, int> cache{/*max_size=*/64};
+    cache.put(7, 777);
+    CHECK_FALSE(cache.get_as_copy_if(7, [](int value) { return value != 777; }));
+    CHECK(cache.hits() == 0);
+    CHECK(cache.misses() == 1);
+    CHECK(cache.get_as_copy_if(7, [](int value) { return value == 777; }) == 777);
+    CHECK(cache.hits() == 1);
+}
+
+TEST_CASE("ShardedLruCache keeps size bounded") {
+    static constexpr int kNumRecords{1'000};
+    ShardedLruCache<int, int> cache{/*max_size=*/100, /*num_shards=*/4};
+    for (int i{0}; i < kNumRecords; ++i) {
+        cache.put(i, i);
+    }
+    CHECK(cache.size() <= cache.max_size());
+    // Most recently inserted key is always there
+    CHECK(cache.get_as_copy(kNumRecords - 1) == kNumRecords - 1);
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+}
+
+TEST_CASE("ShardedLruCache single shard is exact LRU") {
+    ShardedLruCache<int, int> cache{/*max_size=*/2, /*num_shards=*/1};
+    cache.put(1, 1);
+    cache.put(2, 2);
+    CHECK(cache.get_as_copy(1) == 1);  // 1 becomes most recently used
+    cache.put(3, 3);
+    CHECK(cache.get_as_copy(1) == 1);
+    CHECK_FALSE(cache.get_as_copy(2));
+    CHECK(cache.get_as_copy(3) == 3);
+}
+
+TEST_CASE("ShardedLruCache concurrent access") {
+    static constexpr int kNumThreads{4};
+    static constexpr int kNumKeys{256};
+    ShardedLruCache<int, int> cache{/*max_size=*/kNumKeys};
+
+    std::vector<std::thread> threads;
+    for (int t{0}; t < kNumThreads; ++t) {
+        threads.emplace_back([&]() {
+            for (int i{0}; i < kNumKeys; ++i) {
+                if (const auto value{cache.get_as_copy(i)}) {
+                    CHECK(*value == i);
+                } else {
+                    cache.put(i, i);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(cache.hits() + cache.misses() == kNumThreads * kNumKeys);
+    CHECK(cache.size() <= cache.max_size());
+}
+
+}  // namespace silkworm
@@ -16,6 +16,12 @@
 
 #include "test_util.hpp"
 
+#include <bit>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/execution/processor.hpp>
+#include <silkworm/core/protocol/rule_set.hpp>
 #include <silkworm/core/types/evmc_bytes32.hpp>
 #include <silkworm/core/types/log.hpp>
 
@@ -83,4 +89,43 @@ std::vector<Receipt> sample_receipts() {
     return receipts;
 }
 
+evmc::address synthetic_address(size_t index, uint8_t prefix) {
+    evmc::address address{};
+    endian::store_big_u64(&address.bytes[kAddressLength - 8], index + 1);
+    address.bytes[0] = prefix;
+    return address;
+}
+
+std::unique_ptr<InMemoryState> synthetic_state(size_t num_accounts, uint8_t prefix, const evmc::address& contract,
+                                               ByteView contract_code) {
+    auto state{std::make_unique<InMemoryState>()};
+    for (size_t i{0}; i < num_accounts; ++i) {
+        state->update_account(synthetic_address(i, prefix), std::nullopt, Account{.balance = kEther});
+    }
+    const evmc::bytes32 code_hash{std::bit_cast<evmc_bytes32>(keccak256(contract_code))};
+    state->update_account(contract, std::nullopt, Account{.code_hash = code_hash, .incarnation = 1});
+    state->update_account_code(contract, 1, code_hash, contract_code);
+    return state;
+}
+
+Transaction synthetic_transaction(const evmc::address& from, const evmc::address& to) {
+    Transaction txn{};
+    txn.max_priority_fee_per_gas = 10 * kGiga;
+    txn.max_fee_per_gas = 10 * kGiga;
+    txn.gas_limit = 100'000;
+    txn.r = 1;
+    txn.s = 1;
+    txn.from = from;
+    txn.to = to;
+    return txn;
+}
+
+void set_gas_used_by_dry_run(Block& block, State& state, const ChainConfig& config) {
+    auto rule_set{protocol::rule_set_factory(config)};
+    std::vector<Receipt> receipts;
+    ExecutionProcessor processor{block, *rule_set, state, config};
+    (void)processor.execute_and_write_block(receipts);
+    block.header.gas_used = receipts.empty() ? 0 : receipts.back().cumulative_gas_used;
+}
+
 }  // namespace silkworm::test
@@ -16,7 +16,12 @@
 
 #pragma once
 
+#include <cstdint>
+#include <memory>
+
 #include <silkworm/core/chain/config.hpp>
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/state/in_memory_state.hpp>
 #include <silkworm/core/types/block.hpp>
 #include <silkworm/core/types/receipt.hpp>
 #include <silkworm/core/types/transaction.hpp>
@@ -301,4 +306,18 @@ inline const std::map<std::string, ChainConfig> kNetworkConfig{
 std::vector<Transaction> sample_transactions();
 std::vector<Receipt> sample_receipts();
 
+//! Address of the index-th account of a synthetic state, accounts with distinct prefixes (first byte) being distinct
+evmc::address synthetic_address(size_t index, uint8_t prefix);
+
+//! Synthetic state made of num_accounts accounts (see synthetic_address) holding 1 ether each plus a contract
+std::unique_ptr<InMemoryState> synthetic_state(size_t num_accounts, uint8_t prefix, const evmc::address& contract,
+                                               ByteView contract_code);
+
+//! Transaction with a fake signature and a known sender, paying 10 gwei per gas up to 100'000 gas
+Transaction synthetic_transaction(const evmc::address& from, const evmc::address& to);
+
+//! Fill in the gas used of a block whose header has none yet from a dry run of its execution against state, which
+//! is left unchanged as the dry run fails on the gas used check
+void set_gas_used_by_dry_run(Block& block, State& state, const ChainConfig& config);
+
 }  // namespace silkworm::test
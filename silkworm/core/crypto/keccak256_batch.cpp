@@ -0,0 +1,246 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "keccak256_batch.hpp"
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+#include <silkworm/core/common/assert.hpp>
+#include <silkworm/core/common/util.hpp>
+
+// Multi-buffer kernels rely on GCC/Clang vector extensions and function multi-versioning
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SILKWORM_KECCAK_SIMD
+#endif
+
+namespace silkworm {
+
+#if defined(SILKWORM_KECCAK_SIMD)
+
+namespace {
+
+    constexpr size_t kRate{136};  // Keccak-256 rate in bytes
+    constexpr size_t kRateWords{kRate / sizeof(uint64_t)};
+
+    constexpr std::array<uint64_t, 24> kRoundConstants{
+        0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000, 0x000000000000808b,
+        0x0000000080000001, 0x8000000080008081, 0x8000000000008009, 0x000000000000008a, 0x0000000000000088,
+        0x0000000080008009, 0x000000008000000a, 0x000000008000808b, 0x800000000000008b, 0x8000000000008089,
+        0x8000000000008003, 0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+        0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+    };
+
+    // Rotation offsets of rho step, indexed by x + 5 * y
+    constexpr std::array<int, 25> kRotations{
+        0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14,
+    };
+
+    // Vectors are passed by reference as these helpers are compiled without the target ISA enabled
+    template <typename V>
+    [[gnu::always_inline]] inline void rotl(V& out, const V& x, int n) {
+        out = n == 0 ? x : (x << n) | (x >> (64 - n));
+    }
+
+    //! Keccak-f[1600] permutation applied to each lane of vector type V independently
+    template <typename V>
+    [[gnu::always_inline]] inline void keccak_f(V (&a)[25]) {
+        for (const uint64_t round_constant : kRoundConstants) {
+            // theta
+            V c[5], d[5];
+            for (int x{0}; x < 5; ++x) {
+                c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+            }
+            for (int x{0}; x < 5; ++x) {
+                rotl(d[x], c[(x + 1) % 5], 1);
+                d[x] ^= c[(x + 4) % 5];
+            }
+            for (int i{0}; i < 25; ++i) {
+                a[i] ^= d[i % 5];
+            }
+            // rho and pi
+            V b[25];
+            for (int x{0}; x < 5; ++x) {
+                for (int y{0}; y < 5; ++y) {
+                    rotl(b[y + 5 * ((2 * x + 3 * y) % 5)], a[x + 5 * y], kRotations[static_cast<size_t>(x + 5 * y)]);
+                }
+            }
+            // chi
+            for (int y{0}; y < 25; y += 5) {
+                for (int x{0}; x < 5; ++x) {
+                    a[y + x] = b[y + x] ^ (~b[y + (x + 1) % 5] & b[y + (x + 2) % 5]);
+                }
+            }
+            // iota
+            a[0] ^= round_constant;
+        }
+    }
+
+    //! Hashes all the inputs running kLanes permutations side by side, each lane taking the next input when done
+    template <typename V, size_t kLanes>
+    [[gnu::always_inline]] inline void keccak256_lanes(std::span<const ByteView> inputs,
+                                                       std::span<evmc::bytes32> hashes) {
+        struct Lane {
+            size_t input{0};   // index of input being hashed
+            size_t offset{0};  // bytes of input absorbed so far
+            bool active{false};
+            bool last{false};  // whether the block just absorbed is the final (padded) one
+        };
+        std::array<Lane, kLanes> lanes{};
+        size_t next_input{0};
+        size_t num_active{0};
+        for (auto& lane : lanes) {
+            if (next_input < inputs.size()) {
+                lane = {next_input++, 0, true, false};
+                ++num_active;
+            }
+        }
+
+        V state[25]{};
+        alignas(64) uint64_t blocks[kRateWords][kLanes];
+        alignas(64) uint8_t padded[kRate];
+        while (num_active > 0) {
+            // Gather next block of each lane, transposed so that each state word can be loaded at once
+            std::memset(blocks, 0, sizeof(blocks));
+            for (size_t l{0}; l < kLanes; ++l) {
+                Lane& lane{lanes[l]};
+                if (!lane.active) {
+                    continue;
+                }
+                const ByteView data{inputs[lane.input].substr(lane.offset)};
+                const uint8_t* block{data.data()};
+                lane.last = data.size() < kRate;
+                if (lane.last) {
+                    // Keccak padding: 0x01 after data, 0x80 at the end of the block
+                    std::memset(padded, 0, kRate);
+                    if (!data.empty()) {
+                        std::memcpy(padded, data.data(), data.size());
+                    }
+                    padded[data.size()] ^= 0x01;
+                    padded[kRate - 1] ^= 0x80;
+                    block = padded;
+                }
+                for (size_t w{0}; w < kRateWords; ++w) {
+                    std::memcpy(&blocks[w][l], block + w * sizeof(uint64_t), sizeof(uint64_t));
+                }
+                lane.offset += kRate;
+            }
+            for (size_t w{0}; w < kRateWords; ++w) {
+                V word;
+                std::memcpy(&word, blocks[w], sizeof(V));
+                state[w] ^= word;
+            }
+
+            keccak_f(state);
+
+            // Squeeze finished lanes and refill them
+            for (size_t l{0}; l < kLanes; ++l) {
+                Lane& lane{lanes[l]};
+                if (!lane.active || !lane.last) {
+                    continue;
+                }
+                for (size_t w{0}; w < 4; ++w) {
+                    const uint64_t word{state[w][l]};
+                    std::memcpy(&hashes[lane.input].bytes[w * sizeof(uint64_t)], &word, sizeof(uint64_t));
+                }
+                for (auto& word : state) {
+                    word[l] = 0;
+                }
+                if (next_input < inputs.size()) {
+                    lane = {next_input++, 0, true, false};
+                } else {
+                    lane.active = false;
+                    --num_active;
+                }
+            }
+        }
+    }
+
+    using Vector4x64 = uint64_t __attribute__((vector_size(32)));
+    using Vector8x64 = uint64_t __attribute__((vector_size(64)));
+
+    [[gnu::target("avx2")]] void keccak256_avx2(std::span<const ByteView> inputs, std::span<evmc::bytes32> hashes) {
+        keccak256_lanes<Vector4x64, 4>(inputs, hashes);
+    }
+
+    [[gnu::target("avx512f")]] void keccak256_avx512(std::span<const ByteView> inputs,
+                                                     std::span<evmc::bytes32> hashes) {
+        keccak256_lanes<Vector8x64, 8>(inputs, hashes);
+    }
+
+}  // namespace
+
+#endif  // SILKWORM_KECCAK_SIMD
+
+bool is_supported(Keccak256Kernel kernel) noexcept {
+    switch (kernel) {
+        case Keccak256Kernel::kScalar:
+            return true;
+#if defined(SILKWORM_KECCAK_SIMD)
+        case Keccak256Kernel::kAvx2: {
+            static const bool kHasAvx2{(__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0)};
+            return kHasAvx2;
+        }
+        case Keccak256Kernel::kAvx512: {
+            static const bool kHasAvx512{(__builtin_cpu_init(), __builtin_cpu_supports("avx512f") != 0)};
+            return kHasAvx512;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+Keccak256Kernel best_keccak256_kernel() noexcept {
+    static const Keccak256Kernel kBest{[]() {
+        if (is_supported(Keccak256Kernel::kAvx512)) return Keccak256Kernel::kAvx512;
+        if (is_supported(Keccak256Kernel::kAvx2)) return Keccak256Kernel::kAvx2;
+        return Keccak256Kernel::kScalar;
+    }()};
+    return kBest;
+}
+
+void keccak256_batch(std::span<const ByteView> inputs, std::span<evmc::bytes32> hashes) noexcept {
+    keccak256_batch(inputs, hashes, best_keccak256_kernel());
+}
+
+void keccak256_batch(std::span<const ByteView> inputs, std::span<evmc::bytes32> hashes,
+                     Keccak256Kernel kernel) noexcept {
+    SILKWORM_ASSERT(hashes.size() >= inputs.size());
+#if defined(SILKWORM_KECCAK_SIMD)
+    // A single input is better served by the scalar kernel
+    if (inputs.size() > 1 && is_supported(kernel)) {
+        switch (kernel) {
+            case Keccak256Kernel::kAvx512:
+                keccak256_avx512(inputs, hashes);
+                return;
+            case Keccak256Kernel::kAvx2:
+                keccak256_avx2(inputs, hashes);
+                return;
+            case Keccak256Kernel::kScalar:
+                break;
+        }
+    }
+#else
+    (void)kernel;
+#endif
+    for (size_t i{0}; i < inputs.size(); ++i) {
+        hashes[i] = std::bit_cast<evmc_bytes32>(keccak256(inputs[i]));
+    }
+}
+
+}  // namespace silkworm
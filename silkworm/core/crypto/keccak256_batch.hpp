@@ -0,0 +1,48 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <span>
+
+#include <silkworm/core/common/base.hpp>
+
+namespace silkworm {
+
+//! \brief Implementations available for batch Keccak-256 hashing
+enum class Keccak256Kernel {
+    kScalar,  // One input at a time
+    kAvx2,    // 4 inputs at a time using AVX2 registers
+    kAvx512,  // 8 inputs at a time using AVX-512 registers
+};
+
+//! \brief Whether the given kernel can run on this CPU
+[[nodiscard]] bool is_supported(Keccak256Kernel kernel) noexcept;
+
+//! \brief The fastest kernel supported by this CPU, detected once at runtime
+[[nodiscard]] Keccak256Kernel best_keccak256_kernel() noexcept;
+
+//! \brief Computes the Keccak-256 hashes of many inputs at once, i.e. hashes[i] = keccak256(inputs[i])
+//! \details SIMD kernels run one independent Keccak-f permutation per register lane, refilling each lane with the next
+//! input as soon as the current one is done, so that inputs of different lengths keep all lanes busy
+//! \pre hashes.size() >= inputs.size()
+void keccak256_batch(std::span<const ByteView> inputs, std::span<evmc::bytes32> hashes) noexcept;
+
+//! \brief Same as above using the given kernel, or the scalar one if not supported by this CPU
+void keccak256_batch(std::span<const ByteView> inputs, std::span<evmc::bytes32> hashes,
+                     Keccak256Kernel kernel) noexcept;
+
+}  // namespace silkworm
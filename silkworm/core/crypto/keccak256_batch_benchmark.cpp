@@ -0,0 +1,61 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/core/crypto/keccak256_batch.hpp>
+
+using namespace silkworm;
+
+static void keccak256_batch_throughput(benchmark::State& state, Keccak256Kernel kernel, size_t input_size) {
+    if (!is_supported(kernel)) {
+        state.SkipWithError("kernel not supported on this CPU");
+        return;
+    }
+    constexpr size_t kBatchSize{1'024};
+    std::mt19937_64 rng{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::vector<Bytes> data(kBatchSize, Bytes(input_size, 0));
+    for (auto& input : data) {
+        for (auto& byte : input) {
+            byte = static_cast<uint8_t>(rng());
+        }
+    }
+    const std::vector<ByteView> inputs{data.begin(), data.end()};
+    std::vector<evmc::bytes32> hashes(kBatchSize);
+
+    for ([[maybe_unused]] auto _ : state) {
+        keccak256_batch(inputs, hashes, kernel);
+        benchmark::DoNotOptimize(hashes.data());
+        benchmark::ClobberMemory();
+    }
+
+    const auto lanes{kernel == Keccak256Kernel::kAvx512 ? 8 : kernel == Keccak256Kernel::kAvx2 ? 4 : 1};
+    const auto hashed{static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(kBatchSize)};
+    state.SetItemsProcessed(hashed);
+    state.SetBytesProcessed(hashed * static_cast<int64_t>(input_size));
+    state.counters["lanes"] = lanes;
+    state.counters["hashes/s/lane"] = benchmark::Counter(static_cast<double>(hashed) / lanes, benchmark::Counter::kIsRate);
+}
+
+// 32 bytes: storage locations, 150 bytes: typical legacy transaction
+BENCHMARK_CAPTURE(keccak256_batch_throughput, scalar_32, Keccak256Kernel::kScalar, 32);
+BENCHMARK_CAPTURE(keccak256_batch_throughput, avx2_32, Keccak256Kernel::kAvx2, 32);
+BENCHMARK_CAPTURE(keccak256_batch_throughput, avx512_32, Keccak256Kernel::kAvx512, 32);
+BENCHMARK_CAPTURE(keccak256_batch_throughput, scalar_150, Keccak256Kernel::kScalar, 150);
+BENCHMARK_CAPTURE(keccak256_batch_throughput, avx2_150, Keccak256Kernel::kAvx2, 150);
+BENCHMARK_CAPTURE(keccak256_batch_throughput, avx512_150, Keccak256Kernel::kAvx512, 150);
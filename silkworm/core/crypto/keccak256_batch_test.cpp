@@ -0,0 +1,90 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "keccak256_batch.hpp"
+
+#include <bit>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/util.hpp>
+
+namespace silkworm {
+
+static std::vector<Bytes> sample_inputs(size_t count, size_t max_size) {
+    std::vector<Bytes> inputs;
+    inputs.reserve(count);
+    for (size_t i{0}; i < count; ++i) {
+        // Deterministic sizes straddling the 136-byte rate boundaries
+        const size_t size{(i * 37 + i / 3) % (max_size + 1)};
+        Bytes input(size, 0);
+        for (size_t j{0}; j < size; ++j) {
+            input[j] = static_cast<uint8_t>(i * 131 + j * 7);
+        }
+        inputs.push_back(std::move(input));
+    }
+    return inputs;
+}
+
+static void check_kernel(Keccak256Kernel kernel, const std::vector<Bytes>& inputs) {
+    const std::vector<ByteView> views{inputs.begin(), inputs.end()};
+    std::vector<evmc::bytes32> hashes(views.size());
+    keccak256_batch(views, hashes, kernel);
+    for (size_t i{0}; i < views.size(); ++i) {
+        CHECK(hashes[i] == std::bit_cast<evmc_bytes32>(keccak256(views[i])));
+    }
+}
+
+TEST_CASE("Keccak256 batch of empty input") {
+    const std::vector<ByteView> inputs(3);
+    std::vector<evmc::bytes32> hashes(inputs.size());
+    for (const auto kernel : {Keccak256Kernel::kScalar, Keccak256Kernel::kAvx2, Keccak256Kernel::kAvx512}) {
+        keccak256_batch(inputs, hashes, kernel);
+        for (const auto& hash : hashes) {
+            CHECK(to_hex(hash) == "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+        }
+    }
+}
+
+TEST_CASE("Keccak256 batch matches keccak256") {
+    const auto kernel{GENERATE(Keccak256Kernel::kScalar, Keccak256Kernel::kAvx2, Keccak256Kernel::kAvx512)};
+    INFO("kernel: " << static_cast<int>(kernel) << " supported: " << is_supported(kernel));
+
+    SECTION("rate boundaries") {
+        std::vector<Bytes> inputs;
+        for (const size_t size : {0, 1, 31, 32, 135, 136, 137, 271, 272, 273}) {
+            inputs.emplace_back(size, static_cast<uint8_t>(size));
+        }
+        check_kernel(kernel, inputs);
+    }
+
+    SECTION("any batch size") {
+        for (size_t count{1}; count <= 20; ++count) {
+            check_kernel(kernel, sample_inputs(count, 600));
+        }
+    }
+
+    SECTION("mixed lengths") {
+        check_kernel(kernel, sample_inputs(1'000, 2'000));
+    }
+}
+
+TEST_CASE("Keccak256 batch kernel detection") {
+    CHECK(is_supported(Keccak256Kernel::kScalar));
+    CHECK(is_supported(best_keccak256_kernel()));
+}
+
+}  // namespace silkworm
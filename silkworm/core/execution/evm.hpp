@@ -26,8 +26,8 @@
 #include <intx/intx.hpp>
 
 #include <silkworm/core/chain/config.hpp>
-#include <silkworm/core/common/lru_cache.hpp>
 #include <silkworm/core/common/object_pool.hpp>
+#include <silkworm/core/common/sharded_lru_cache.hpp>
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/core/state/intra_block_state.hpp>
 #include <silkworm/core/types/block.hpp>
@@ -69,7 +69,8 @@ class EvmTracer {
 
 using EvmTracers = std::vector<std::reference_wrapper<EvmTracer>>;
 
-using AnalysisCache = lru_cache<evmc::bytes32, std::shared_ptr<evmone::baseline::CodeAnalysis>>;
+//! Code analyses by code hash, safe to be shared among EVM instances running on different threads
+using AnalysisCache = ShardedLruCache<evmc::bytes32, std::shared_ptr<evmone::baseline::CodeAnalysis>>;
 
 class EVM {
   public:
@@ -17,6 +17,7 @@
 #include "processor.hpp"
 
 #include <cassert>
+#include <memory>
 
 #include <silkworm/core/protocol/intrinsic_gas.hpp>
 #include <silkworm/core/protocol/param.hpp>
@@ -38,48 +39,69 @@ void ExecutionProcessor::execute_transaction(const Transaction& txn, Receipt& re
 
     state_.clear_journal_and_substate();
 
+    const intx::uint256 recipient_initial_balance{state_.get_balance(evm_.beneficiary)};
+
+    const TransactionOutcome outcome{run_transaction(txn, state_, evm_)};
+
+    settle_transaction(txn, outcome, recipient_initial_balance, receipt);
+}
+
+ExecutionProcessor::TransactionOutcome ExecutionProcessor::run_transaction(const Transaction& txn,
+                                                                           IntraBlockState& state,
+                                                                           EVM& evm) noexcept {
     assert(txn.from);
-    state_.access_account(*txn.from);
+    state.access_account(*txn.from);
 
     if (txn.to) {
-        state_.access_account(*txn.to);
+        state.access_account(*txn.to);
         // EVM itself increments the nonce for contract creation
-        state_.set_nonce(*txn.from, txn.nonce + 1);
+        state.set_nonce(*txn.from, txn.nonce + 1);
     }
 
     for (const AccessListEntry& ae : txn.access_list) {
-        state_.access_account(ae.account);
+        state.access_account(ae.account);
         for (const evmc::bytes32& key : ae.storage_keys) {
-            state_.access_storage(ae.account, key);
+            state.access_storage(ae.account, key);
         }
     }
 
-    const evmc_revision rev{evm_.revision()};
+    const evmc_revision rev{evm.revision()};
     if (rev >= EVMC_SHANGHAI) {
         // EIP-3651: Warm COINBASE
-        state_.access_account(evm_.beneficiary);
+        state.access_account(evm.beneficiary);
     }
 
-    const BlockHeader& header{evm_.block().header};
+    const BlockHeader& header{evm.block().header};
 
-    const intx::uint256 sender_initial_balance{state_.get_balance(*txn.from)};
-    const intx::uint256 recipient_initial_balance{state_.get_balance(evm_.beneficiary)};
+    TransactionOutcome outcome;
+    outcome.sender_initial_balance = state.get_balance(*txn.from);
 
     // EIP-1559 normal gas cost
     const intx::uint256 base_fee_per_gas{header.base_fee_per_gas.value_or(0)};
     const intx::uint256 effective_gas_price{txn.effective_gas_price(base_fee_per_gas)};
-    state_.subtract_from_balance(*txn.from, txn.gas_limit * effective_gas_price);
+    state.subtract_from_balance(*txn.from, txn.gas_limit * effective_gas_price);
 
     // EIP-4844 blob gas cost (calc_data_fee)
     const intx::uint256 blob_gas_price{header.blob_gas_price().value_or(0)};
-    state_.subtract_from_balance(*txn.from, txn.total_blob_gas() * blob_gas_price);
+    state.subtract_from_balance(*txn.from, txn.total_blob_gas() * blob_gas_price);
 
     const intx::uint128 g0{protocol::intrinsic_gas(txn, rev)};
     assert(g0 <= UINT64_MAX);  // true due to the precondition (transaction must be valid)
 
-    const CallResult vm_res{evm_.execute(txn, txn.gas_limit - static_cast<uint64_t>(g0))};
+    outcome.vm_res = evm.execute(txn, txn.gas_limit - static_cast<uint64_t>(g0));
 
-    const uint64_t gas_used{txn.gas_limit - refund_gas(txn, vm_res.gas_left, vm_res.gas_refund)};
+    outcome.gas_used = txn.gas_limit - refund_gas(state, txn, outcome.vm_res.gas_left, outcome.vm_res.gas_refund);
+
+    return outcome;
+}
+
+void ExecutionProcessor::settle_transaction(const Transaction& txn, const TransactionOutcome& outcome,
+                                            const intx::uint256& recipient_initial_balance,
+                                            Receipt& receipt) noexcept {
+    const evmc_revision rev{evm_.revision()};
+    const BlockHeader& header{evm_.block().header};
+    const intx::uint256 base_fee_per_gas{header.base_fee_per_gas.value_or(0)};
+    const uint64_t gas_used{outcome.gas_used};
 
     // award the fee recipient
     const intx::uint256 amount{txn.priority_fee_per_gas(base_fee_per_gas) * gas_used};
@@ -94,7 +116,7 @@ void ExecutionProcessor::execute_transaction(const Transaction& txn, Receipt& re
         }
     }
 
-    rule_set_.add_fee_transfer_log(state_, amount, *txn.from, sender_initial_balance,
+    rule_set_.add_fee_transfer_log(state_, amount, *txn.from, outcome.sender_initial_balance,
                                    evm_.beneficiary, recipient_initial_balance);
 
     state_.finalize_transaction(rev);
@@ -102,7 +124,7 @@ void ExecutionProcessor::execute_transaction(const Transaction& txn, Receipt& re
     cumulative_gas_used_ += gas_used;
 
     receipt.type = txn.type;
-    receipt.success = vm_res.status == EVMC_SUCCESS;
+    receipt.success = outcome.vm_res.status == EVMC_SUCCESS;
     receipt.cumulative_gas_used = cumulative_gas_used_;
     receipt.bloom = logs_bloom(state_.logs());
     std::swap(receipt.logs, state_.logs());
@@ -112,7 +134,8 @@ uint64_t ExecutionProcessor::available_gas() const noexcept {
     return evm_.block().header.gas_limit - cumulative_gas_used_;
 }
 
-uint64_t ExecutionProcessor::refund_gas(const Transaction& txn, uint64_t gas_left, uint64_t gas_refund) noexcept {
+uint64_t ExecutionProcessor::refund_gas(IntraBlockState& state, const Transaction& txn, uint64_t gas_left,
+                                        uint64_t gas_refund) noexcept {
     const evmc_revision rev{evm_.revision()};
 
     const uint64_t max_refund_quotient{rev >= EVMC_LONDON ? protocol::kMaxRefundQuotientLondon
@@ -123,30 +146,47 @@ uint64_t ExecutionProcessor::refund_gas(const Transaction& txn, uint64_t gas_lef
 
     const intx::uint256 base_fee_per_gas{evm_.block().header.base_fee_per_gas.value_or(0)};
     const intx::uint256 effective_gas_price{txn.effective_gas_price(base_fee_per_gas)};
-    state_.add_to_balance(*txn.from, gas_left * effective_gas_price);
+    state.add_to_balance(*txn.from, gas_left * effective_gas_price);
 
     return gas_left;
 }
 
 ValidationResult ExecutionProcessor::execute_block_no_post_validation(std::vector<Receipt>& receipts) noexcept {
+    const Block& block{evm_.block()};
+    const bool parallel{parallel_runner_ && evm_.tracers().empty() && !evm_.exo_evm && block.transactions.size() > 1};
+
+    // In parallel mode keep track of all the changes committed so far in the block, block initialization included
+    state::AccessSet committed;
+    if (parallel) {
+        state_.set_access_set(&committed);
+    }
+
     const evmc_revision rev{evm_.revision()};
     rule_set_.initialize(evm_);
     state_.finalize_transaction(rev);
 
     cumulative_gas_used_ = 0;
+    reexecuted_transactions_ = 0;
 
-    const Block& block{evm_.block()};
     notify_block_execution_start(block);
 
     receipts.resize(block.transactions.size());
-    auto receipt_it{receipts.begin()};
-    for (const auto& txn : block.transactions) {
-        const ValidationResult err{protocol::validate_transaction(txn, state_, available_gas())};
+    if (parallel) {
+        const ValidationResult err{execute_transactions_in_parallel(receipts, committed)};
+        state_.set_access_set(nullptr);
         if (err != ValidationResult::kOk) {
             return err;
         }
-        execute_transaction(txn, *receipt_it);
-        ++receipt_it;
+    } else {
+        auto receipt_it{receipts.begin()};
+        for (const auto& txn : block.transactions) {
+            const ValidationResult err{protocol::validate_transaction(txn, state_, available_gas())};
+            if (err != ValidationResult::kOk) {
+                return err;
+            }
+            execute_transaction(txn, *receipt_it);
+            ++receipt_it;
+        }
     }
 
     state_.clear_journal_and_substate();
@@ -158,6 +198,71 @@ ValidationResult ExecutionProcessor::execute_block_no_post_validation(std::vecto
     return ValidationResult::kOk;
 }
 
+ValidationResult ExecutionProcessor::execute_transactions_in_parallel(std::vector<Receipt>& receipts,
+                                                                     state::AccessSet& committed) noexcept {
+    const Block& block{evm_.block()};
+    const size_t num_transactions{block.transactions.size()};
+
+    struct Speculation {
+        std::unique_ptr<IntraBlockState> state;
+        state::AccessSet access_set;
+        TransactionOutcome outcome;
+        bool valid{false};
+    };
+    std::vector<Speculation> speculations(num_transactions);
+
+    // 1. Execute all transactions concurrently against the state at the beginning of the block
+    parallel_runner_(num_transactions, [&](size_t i, State& reader) {
+        const Transaction& txn{block.transactions[i]};
+        Speculation& speculation{speculations[i]};
+        speculation.state = std::make_unique<IntraBlockState>(reader);
+        IntraBlockState& state{*speculation.state};
+        state.set_access_set(&speculation.access_set);
+
+        const ValidationResult err{protocol::validate_transaction(txn, state, txn.gas_limit)};
+        if (err != ValidationResult::kOk) {
+            // Possibly valid only after preceding transactions, let the commit phase decide
+            return;
+        }
+
+        EVM evm{block, state, evm_.config()};
+        evm.beneficiary = evm_.beneficiary;
+        evm.analysis_cache = evm_.analysis_cache;  // Thread-safe, unlike state_pool
+        speculation.outcome = run_transaction(txn, state, evm);
+        speculation.valid = true;
+    });
+
+    // 2. Commit transactions in order, executing again those which observed values changed by preceding ones
+    for (size_t i{0}; i < num_transactions; ++i) {
+        const Transaction& txn{block.transactions[i]};
+        Speculation& speculation{speculations[i]};
+        Receipt& receipt{receipts[i]};
+
+        const ValidationResult err{protocol::validate_transaction(txn, state_, available_gas())};
+        if (err != ValidationResult::kOk) {
+            return err;
+        }
+
+        if (!speculation.valid || speculation.access_set.conflicts_with(committed)) {
+            ++reexecuted_transactions_;
+            execute_transaction(txn, receipt);
+        } else {
+            std::swap(receipt.logs, state_.logs());
+            state_.clear_journal_and_substate();
+
+            const intx::uint256 recipient_initial_balance{state_.get_balance(evm_.beneficiary)};
+
+            state_.merge_transaction(*speculation.state);
+            committed.merge_writes(speculation.access_set);
+
+            settle_transaction(txn, speculation.outcome, recipient_initial_balance, receipt);
+        }
+        speculation.state.reset();
+    }
+
+    return ValidationResult::kOk;
+}
+
 ValidationResult ExecutionProcessor::execute_and_write_block(std::vector<Receipt>& receipts) noexcept {
     if (const ValidationResult res{execute_block_no_post_validation(receipts)}; res != ValidationResult::kOk) {
         return res;
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <utility>
 #include <vector>
 
 #include <silkworm/core/execution/evm.hpp>
@@ -30,6 +32,11 @@ namespace silkworm {
 
 class ExecutionProcessor {
   public:
+    //! \brief Runs task(0, reader), ..., task(count - 1, reader), possibly concurrently, and returns when all of them
+    //! have completed. Each task must be given a reader State usable from the thread running it and exposing the same
+    //! state as the processor one, a reader being used by one task at a time.
+    using TaskRunner = std::function<void(size_t count, const std::function<void(size_t, State&)>& task)>;
+
     ExecutionProcessor(const ExecutionProcessor&) = delete;
     ExecutionProcessor& operator=(const ExecutionProcessor&) = delete;
 
@@ -48,10 +55,30 @@ class ExecutionProcessor {
 
     uint64_t available_gas() const noexcept;
 
+    //! \brief Enable optimistic parallel execution of the block transactions through the given runner.
+    //! \details Transactions are first executed speculatively against the state at the beginning of the block, each
+    //! one recording the accounts and storage locations it accesses. Then they are committed in order: speculative
+    //! results are applied unless they conflict with preceding transactions, in which case the transaction is
+    //! executed again. Results (receipts and state changes) are identical to serial execution.
+    //! \remarks Speculative executions read the readers given by the runner, never the processor State, which is
+    //! not read nor written until all of them have completed.
+    //! Serial execution is used anyway when tracers or an exogenous EVM are set.
+    void set_parallel_runner(TaskRunner runner) noexcept { parallel_runner_ = std::move(runner); }
+
+    //! \brief Number of transactions executed again after a failed speculation in the last executed block
+    [[nodiscard]] size_t reexecuted_transactions() const noexcept { return reexecuted_transactions_; }
+
     EVM& evm() noexcept { return evm_; }
     const EVM& evm() const noexcept { return evm_; }
 
   private:
+    //! \brief Outcome of a transaction executed up to the gas refund to the sender, fees not paid yet
+    struct TransactionOutcome {
+        CallResult vm_res;
+        uint64_t gas_used{0};
+        intx::uint256 sender_initial_balance;
+    };
+
     /**
      * Execute the block, but do not write to the DB yet.
      * Does not perform any post-execution validation (for example, receipt root is not checked).
@@ -59,18 +86,33 @@ class ExecutionProcessor {
      */
     [[nodiscard]] ValidationResult execute_block_no_post_validation(std::vector<Receipt>& receipts) noexcept;
 
+    //! \brief Execute the block transactions speculatively in parallel, then commit them in order.
+    //! \param committed accumulates the changes committed in the block, it must be recorded by the block state too
+    [[nodiscard]] ValidationResult execute_transactions_in_parallel(std::vector<Receipt>& receipts,
+                                                                    state::AccessSet& committed) noexcept;
+
+    //! \brief Buy gas, run the EVM and refund the unused gas for the transaction against the given state.
+    TransactionOutcome run_transaction(const Transaction& txn, IntraBlockState& state, EVM& evm) noexcept;
+
+    //! \brief Pay the fees of an already run transaction, finalize it and fill its receipt.
+    void settle_transaction(const Transaction& txn, const TransactionOutcome& outcome,
+                            const intx::uint256& recipient_initial_balance, Receipt& receipt) noexcept;
+
     //! \brief Notify the registered tracers at the start of block execution.
     void notify_block_execution_start(const Block& block);
 
     //! \brief Notify the registered tracers at the end of block execution.
     void notify_block_execution_end(const Block& block);
 
-    uint64_t refund_gas(const Transaction& txn, uint64_t gas_left, uint64_t gas_refund) noexcept;
+    uint64_t refund_gas(IntraBlockState& state, const Transaction& txn, uint64_t gas_left,
+                        uint64_t gas_refund) noexcept;
 
     uint64_t cumulative_gas_used_{0};
     IntraBlockState state_;
     protocol::IRuleSet& rule_set_;
     EVM evm_;
+    TaskRunner parallel_runner_;
+    size_t reexecuted_transactions_{0};
 };
 
 }  // namespace silkworm
@@ -16,9 +16,12 @@
 
 #include "processor.hpp"
 
+#include <bit>
+
 #include <catch2/catch.hpp>
 #include <evmc/evmc.hpp>
 
+#include <silkworm/core/common/util.hpp>
 #include <silkworm/core/protocol/param.hpp>
 #include <silkworm/core/state/in_memory_state.hpp>
 #include <silkworm/core/types/address.hpp>
@@ -383,4 +386,157 @@ TEST_CASE("Empty suicide beneficiary") {
     CHECK(!state.read_account(suicide_beneficiary));
 }
 
+TEST_CASE("Parallel execution matches serial execution") {
+    Block block{};
+    block.header.number = 1;
+    block.header.gas_limit = 5'000'000;
+    block.header.beneficiary = 0x61c808d82a3ac53231750dadc13c777b59310bd9_address;
+
+    const evmc::address sender1{0x4bf2054ffae7a454a35fd8cf4be21b23b1f25a6f_address};
+    const evmc::address sender2{0x5a0b54d5dc17e0aadc383d2db43b0a0d3e029c4c_address};
+    const evmc::address sender3{0x834e9b529ac9fa63b39a06f8d8c9b0d6791fa5df_address};
+    const evmc::address recipient1{0xee098e6c2a43d9e2c04f08f0c3a87b0ba59079d5_address};
+    const evmc::address recipient2{0x2a65aca4d5fc5b5c859090a6c34d164135398226_address};
+    const evmc::address contract{0x6d20c1c07e56b7098eb8c50ee03ba0f6f498a91d_address};
+
+    // Stores the first word of the call data into the 0th storage slot
+    const Bytes code{*from_hex("600035600055")};
+
+    const auto make_txn{[&](const evmc::address& from, uint64_t nonce, const evmc::address& to,
+                            const intx::uint256& value, const intx::uint256& gas_price, ByteView data = {}) {
+        Transaction txn{};
+        txn.nonce = nonce;
+        txn.max_priority_fee_per_gas = gas_price;
+        txn.max_fee_per_gas = gas_price;
+        txn.gas_limit = 100'000;
+        txn.to = to;
+        txn.value = value;
+        txn.data = Bytes{data};
+        txn.odd_y_parity = false;
+        txn.r = 1;
+        txn.s = 1;
+        txn.from = from;
+        return txn;
+    }};
+    Bytes data(32, '\0');
+    block.transactions.push_back(make_txn(sender1, 0, recipient1, 1'000, 10 * kGiga));
+    block.transactions.push_back(make_txn(sender2, 0, recipient2, 2'000, 10 * kGiga));
+    data[31] = 1;
+    block.transactions.push_back(make_txn(sender1, 1, contract, 0, 10 * kGiga, data));  // same sender as #0
+    data[31] = 2;
+    block.transactions.push_back(make_txn(sender3, 0, contract, 0, 10 * kGiga, data));  // same slot as #2
+    block.transactions.push_back(make_txn(recipient1, 0, sender3, 500, 0));              // funded by #0
+
+    const auto make_state{[&]() {
+        auto state{std::make_unique<InMemoryState>()};
+        for (const auto& address : {sender1, sender2, sender3}) {
+            state->update_account(address, std::nullopt, Account{.balance = kEther});
+        }
+        const evmc::bytes32 code_hash{std::bit_cast<evmc_bytes32>(keccak256(code))};
+        state->update_account(contract, std::nullopt, Account{.code_hash = code_hash, .incarnation = 1});
+        state->update_account_code(contract, 1, code_hash, code);
+        return state;
+    }};
+
+    auto rule_set{protocol::rule_set_factory(kMainnetConfig)};
+
+    // Dry run to find out the block gas used
+    std::vector<Receipt> receipts;
+    auto dry_run_state{make_state()};
+    ExecutionProcessor dry_run_processor{block, *rule_set, *dry_run_state, kMainnetConfig};
+    CHECK(dry_run_processor.execute_and_write_block(receipts) == ValidationResult::kWrongBlockGas);
+    block.header.gas_used = receipts.back().cumulative_gas_used;
+
+    std::vector<Receipt> serial_receipts;
+    auto serial_state{make_state()};
+    ExecutionProcessor serial_processor{block, *rule_set, *serial_state, kMainnetConfig};
+    REQUIRE(serial_processor.execute_and_write_block(serial_receipts) == ValidationResult::kOk);
+
+    std::vector<Receipt> parallel_receipts;
+    auto parallel_state{make_state()};
+    ExecutionProcessor parallel_processor{block, *rule_set, *parallel_state, kMainnetConfig};
+    // Run speculative executions in reverse order to stress the in-order commit
+    parallel_processor.set_parallel_runner([&](size_t count, const std::function<void(size_t, State&)>& task) {
+        for (size_t i{count}; i > 0; --i) {
+            task(i - 1, *parallel_state);
+        }
+    });
+    REQUIRE(parallel_processor.execute_and_write_block(parallel_receipts) == ValidationResult::kOk);
+
+    // #0 and #1 are independent, the others conflict with preceding transactions
+    CHECK(parallel_processor.reexecuted_transactions() == 3);
+
+    REQUIRE(parallel_receipts.size() == serial_receipts.size());
+    for (size_t i{0}; i < serial_receipts.size(); ++i) {
+        CHECK(parallel_receipts[i].success == serial_receipts[i].success);
+        CHECK(parallel_receipts[i].cumulative_gas_used == serial_receipts[i].cumulative_gas_used);
+        CHECK(parallel_receipts[i].bloom == serial_receipts[i].bloom);
+        CHECK(parallel_receipts[i].logs.size() == serial_receipts[i].logs.size());
+    }
+    CHECK(parallel_state->accounts() == serial_state->accounts());
+    CHECK(parallel_state->storage() == serial_state->storage());
+    CHECK(parallel_state->account_changes() == serial_state->account_changes());
+}
+
+TEST_CASE("Parallel execution of zero-value calls to the same contract") {
+    Block block{};
+    block.header.number = 1;
+    block.header.gas_limit = 5'000'000;
+    block.header.beneficiary = 0x61c808d82a3ac53231750dadc13c777b59310bd9_address;
+
+    const evmc::address sender1{0x4bf2054ffae7a454a35fd8cf4be21b23b1f25a6f_address};
+    const evmc::address sender2{0x5a0b54d5dc17e0aadc383d2db43b0a0d3e029c4c_address};
+    const evmc::address contract{0x6d20c1c07e56b7098eb8c50ee03ba0f6f498a91d_address};
+
+    // Loads the 0th storage slot, writes nothing
+    const Bytes code{*from_hex("60005450")};
+
+    for (const auto& sender : {sender1, sender2}) {
+        Transaction txn{};
+        txn.max_priority_fee_per_gas = 10 * kGiga;
+        txn.max_fee_per_gas = 10 * kGiga;
+        txn.gas_limit = 100'000;
+        txn.to = contract;
+        txn.r = 1;
+        txn.s = 1;
+        txn.from = sender;
+        block.transactions.push_back(txn);
+    }
+
+    const auto make_state{[&]() {
+        auto state{std::make_unique<InMemoryState>()};
+        for (const auto& sender : {sender1, sender2}) {
+            state->update_account(sender, std::nullopt, Account{.balance = kEther});
+        }
+        const evmc::bytes32 code_hash{std::bit_cast<evmc_bytes32>(keccak256(code))};
+        state->update_account(contract, std::nullopt, Account{.code_hash = code_hash, .incarnation = 1});
+        state->update_account_code(contract, 1, code_hash, code);
+        return state;
+    }};
+
+    auto rule_set{protocol::rule_set_factory(kMainnetConfig)};
+
+    // Dry run to find out the block gas used
+    std::vector<Receipt> receipts;
+    auto dry_run_state{make_state()};
+    ExecutionProcessor dry_run_processor{block, *rule_set, *dry_run_state, kMainnetConfig};
+    CHECK(dry_run_processor.execute_and_write_block(receipts) == ValidationResult::kWrongBlockGas);
+    block.header.gas_used = receipts.back().cumulative_gas_used;
+
+    auto state{make_state()};
+    ExecutionProcessor processor{block, *rule_set, *state, kMainnetConfig};
+    processor.set_parallel_runner([&](size_t count, const std::function<void(size_t, State&)>& task) {
+        for (size_t i{0}; i < count; ++i) {
+            task(i, *state);
+        }
+    });
+    REQUIRE(processor.execute_and_write_block(receipts) == ValidationResult::kOk);
+
+    // Calling the contract without transferring value does not change it, so there is no conflict
+    CHECK(processor.reexecuted_transactions() == 0);
+    CHECK(state->read_account(contract)->balance == 0);
+    CHECK(state->read_account(sender1)->nonce == 1);
+    CHECK(state->read_account(sender2)->nonce == 1);
+}
+
 }  // namespace silkworm
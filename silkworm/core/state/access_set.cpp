@@ -0,0 +1,74 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "access_set.hpp"
+
+namespace silkworm::state {
+
+namespace {
+    bool contains(const FlatHashSet<evmc::address>& accounts, const evmc::address& address) noexcept {
+        return accounts.find(address) != accounts.end();
+    }
+}  // namespace
+
+bool AccessSet::conflicts_with(const AccessSet& writes) const noexcept {
+    for (const auto& address : read_accounts) {
+        if (contains(writes.written_accounts, address)) {
+            return true;
+        }
+    }
+    for (const auto& address : written_accounts) {
+        if (contains(writes.written_accounts, address)) {
+            return true;
+        }
+    }
+    for (const auto& address : read_all_storage) {
+        if (writes.written_storage.find(address) != writes.written_storage.end()) {
+            return true;
+        }
+    }
+    for (const auto* locations : {&read_storage, &written_storage}) {
+        for (const auto& [address, keys] : *locations) {
+            const auto it{writes.written_storage.find(address)};
+            if (it == writes.written_storage.end()) {
+                continue;
+            }
+            for (const auto& key : keys) {
+                if (it->second.find(key) != it->second.end()) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void AccessSet::merge_writes(const AccessSet& other) {
+    written_accounts.insert(other.written_accounts.begin(), other.written_accounts.end());
+    for (const auto& [address, keys] : other.written_storage) {
+        written_storage[address].insert(keys.begin(), keys.end());
+    }
+}
+
+void AccessSet::clear() noexcept {
+    read_accounts.clear();
+    written_accounts.clear();
+    read_storage.clear();
+    written_storage.clear();
+    read_all_storage.clear();
+}
+
+}  // namespace silkworm::state
@@ -0,0 +1,43 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/common/hash_maps.hpp>
+
+namespace silkworm::state {
+
+// Accounts and storage locations read or written while executing a transaction.
+// Used to detect conflicts between transactions speculatively executed in parallel.
+struct AccessSet {
+    FlatHashSet<evmc::address> read_accounts;
+    FlatHashSet<evmc::address> written_accounts;
+    FlatHashMap<evmc::address, FlatHashSet<evmc::bytes32>> read_storage;
+    FlatHashMap<evmc::address, FlatHashSet<evmc::bytes32>> written_storage;
+    // Accounts whose whole storage has been observed (e.g. wiped on contract creation)
+    FlatHashSet<evmc::address> read_all_storage;
+
+    // Whether anything read or written here has been written in the given set.
+    [[nodiscard]] bool conflicts_with(const AccessSet& writes) const noexcept;
+
+    // Merge the written accounts and storage locations of the given set into this one.
+    void merge_writes(const AccessSet& other);
+
+    void clear() noexcept;
+};
+
+}  // namespace silkworm::state
@@ -22,60 +22,37 @@
 
 namespace silkworm::state {
 
-CreateDelta::CreateDelta(const evmc::address& address) noexcept : address_{address} {}
+void CreateDelta::revert(IntraBlockState& state) noexcept { state.objects_.erase(address); }
 
-void CreateDelta::revert(IntraBlockState& state) noexcept { state.objects_.erase(address_); }
-
-UpdateDelta::UpdateDelta(const evmc::address& address, const Object& previous) noexcept
-    : address_{address}, previous_{previous} {}
-
-void UpdateDelta::revert(IntraBlockState& state) noexcept { state.objects_[address_] = previous_; }
-
-UpdateBalanceDelta::UpdateBalanceDelta(const evmc::address& address, const intx::uint256& previous) noexcept
-    : address_{address}, previous_{previous} {}
+void UpdateDelta::revert(IntraBlockState& state) noexcept { state.objects_[address] = previous; }
 
 void UpdateBalanceDelta::revert(IntraBlockState& state) noexcept {
-    state.objects_[address_].current->balance = previous_;
+    state.objects_[address].current->balance = previous;
 }
 
-SuicideDelta::SuicideDelta(const evmc::address& address) noexcept : address_{address} {}
-
-void SuicideDelta::revert(IntraBlockState& state) noexcept { state.self_destructs_.erase(address_); }
-
-TouchDelta::TouchDelta(const evmc::address& address) noexcept : address_{address} {}
-
-void TouchDelta::revert(IntraBlockState& state) noexcept { state.touched_.erase(address_); }
-
-StorageChangeDelta::StorageChangeDelta(const evmc::address& address, const evmc::bytes32& key,
-                                       const evmc::bytes32& previous) noexcept
-    : address_{address}, key_{key}, previous_{previous} {}
+void SuicideDelta::revert(IntraBlockState& state) noexcept { state.self_destructs_.erase(address); }
 
-void StorageChangeDelta::revert(IntraBlockState& state) noexcept { state.storage_[address_].current[key_] = previous_; }
+void TouchDelta::revert(IntraBlockState& state) noexcept { state.touched_.erase(address); }
 
-StorageWipeDelta::StorageWipeDelta(const evmc::address& address, Storage storage) noexcept
-    : address_{address}, storage_{std::move(storage)} {}
-
-void StorageWipeDelta::revert(IntraBlockState& state) noexcept { state.storage_[address_] = storage_; }
-
-StorageCreateDelta::StorageCreateDelta(const evmc::address& address) noexcept : address_{address} {}
-
-void StorageCreateDelta::revert(IntraBlockState& state) noexcept { state.storage_.erase(address_); }
-
-StorageAccessDelta::StorageAccessDelta(const evmc::address& address, const evmc::bytes32& key) noexcept
-    : address_{address}, key_{key} {}
+void StorageChangeDelta::revert(IntraBlockState& state) noexcept {
+    state.storage_of(address).current[key] = previous;
+}
 
-void StorageAccessDelta::revert(IntraBlockState& state) noexcept { state.accessed_storage_keys_[address_].erase(key_); }
+// The delta is dropped right after being reverted, so the wiped storage can be moved back
+void StorageWipeDelta::revert(IntraBlockState& state) noexcept { state.storage_of(address) = std::move(storage); }
 
-AccountAccessDelta::AccountAccessDelta(const evmc::address& address) noexcept : address_{address} {}
+void StorageCreateDelta::revert(IntraBlockState& state) noexcept { state.storage_.erase(address); }
 
-void AccountAccessDelta::revert(IntraBlockState& state) noexcept { state.accessed_addresses_.erase(address_); }
+void StorageAccessDelta::revert(IntraBlockState& state) noexcept { state.accessed_storage_keys_[address].erase(key); }
 
-TransientStorageChangeDelta::TransientStorageChangeDelta(const evmc::address& address, const evmc::bytes32& key,
-                                                         const evmc::bytes32& previous) noexcept
-    : address_{address}, key_{key}, previous_{previous} {}
+void AccountAccessDelta::revert(IntraBlockState& state) noexcept { state.accessed_addresses_.erase(address); }
 
 void TransientStorageChangeDelta::revert(IntraBlockState& state) noexcept {
-    state.transient_storage_[address_][key_] = previous_;
+    state.transient_storage_[address][key] = previous;
+}
+
+void revert(Delta& delta, IntraBlockState& state) noexcept {
+    std::visit([&state](auto& d) { d.revert(state); }, delta);
 }
 
 }  // namespace silkworm::state
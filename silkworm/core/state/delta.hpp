@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <variant>
+
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/core/state/object.hpp>
 
@@ -25,151 +27,101 @@ class IntraBlockState;
 
 namespace state {
 
-    // Delta is a revertible change made to IntraBlockState.
-    class Delta {
-      public:
-        Delta(const Delta&) = delete;
-        Delta& operator=(const Delta&) = delete;
-
-        virtual ~Delta() = default;
-
-        virtual void revert(IntraBlockState& state) noexcept = 0;
-
-      protected:
-        Delta() = default;
-    };
+    // Deltas are revertible changes made to IntraBlockState.
+    // They are plain records stored by value into the journal, so that recording one does not allocate.
 
     // Account created.
-    class CreateDelta : public Delta {
-      public:
-        explicit CreateDelta(const evmc::address& address) noexcept;
+    struct CreateDelta {
+        evmc::address address;
 
-        void revert(IntraBlockState& state) noexcept override;
-
-      private:
-        evmc::address address_;
+        void revert(IntraBlockState& state) noexcept;
     };
 
     // Account updated.
-    class UpdateDelta : public Delta {
-      public:
-        UpdateDelta(const evmc::address& address, const Object& previous) noexcept;
-
-        void revert(IntraBlockState& state) noexcept override;
+    struct UpdateDelta {
+        evmc::address address;
+        Object previous;
 
-      private:
-        evmc::address address_;
-        Object previous_;
+        void revert(IntraBlockState& state) noexcept;
     };
 
     // Account balance updated.
     // UpdateBalanceDelta is a special case of the more general UpdateDelta. It occupies less memory than UpdateDelta.
-    class UpdateBalanceDelta : public Delta {
-      public:
-        UpdateBalanceDelta(const evmc::address& address, const intx::uint256& previous) noexcept;
+    struct UpdateBalanceDelta {
+        evmc::address address;
+        intx::uint256 previous;
 
-        void revert(IntraBlockState& state) noexcept override;
-
-      private:
-        evmc::address address_;
-        intx::uint256 previous_;
+        void revert(IntraBlockState& state) noexcept;
     };
 
     // Account recorded for self-destruction.
-    class SuicideDelta : public Delta {
-      public:
-        explicit SuicideDelta(const evmc::address& address) noexcept;
-
-        void revert(IntraBlockState& state) noexcept override;
+    struct SuicideDelta {
+        evmc::address address;
 
-      private:
-        evmc::address address_;
+        void revert(IntraBlockState& state) noexcept;
     };
 
     // Account touched.
-    class TouchDelta : public Delta {
-      public:
-        explicit TouchDelta(const evmc::address& address) noexcept;
+    struct TouchDelta {
+        evmc::address address;
 
-        void revert(IntraBlockState& state) noexcept override;
-
-      private:
-        evmc::address address_;
+        void revert(IntraBlockState& state) noexcept;
     };
 
     // Storage value changed.
-    class StorageChangeDelta : public Delta {
-      public:
-        StorageChangeDelta(const evmc::address& address, const evmc::bytes32& key,
-                           const evmc::bytes32& previous) noexcept;
-
-        void revert(IntraBlockState& state) noexcept override;
+    struct StorageChangeDelta {
+        evmc::address address;
+        evmc::bytes32 key;
+        evmc::bytes32 previous;
 
-      private:
-        evmc::address address_;
-        evmc::bytes32 key_;
-        evmc::bytes32 previous_;
+        void revert(IntraBlockState& state) noexcept;
     };
 
     // Entire storage deleted.
-    class StorageWipeDelta : public Delta {
-      public:
-        StorageWipeDelta(const evmc::address& address, Storage storage) noexcept;
-
-        void revert(IntraBlockState& state) noexcept override;
+    struct StorageWipeDelta {
+        evmc::address address;
+        Storage storage;
 
-      private:
-        evmc::address address_;
-        Storage storage_;
+        void revert(IntraBlockState& state) noexcept;
     };
 
     // Storage created.
-    class StorageCreateDelta : public Delta {
-      public:
-        explicit StorageCreateDelta(const evmc::address& address) noexcept;
+    struct StorageCreateDelta {
+        evmc::address address;
 
-        void revert(IntraBlockState& state) noexcept override;
-
-      private:
-        evmc::address address_;
+        void revert(IntraBlockState& state) noexcept;
     };
 
     // Storage accessed (see EIP-2929).
-    class StorageAccessDelta : public Delta {
-      public:
-        StorageAccessDelta(const evmc::address& address, const evmc::bytes32& key) noexcept;
-
-        void revert(IntraBlockState& state) noexcept override;
+    struct StorageAccessDelta {
+        evmc::address address;
+        evmc::bytes32 key;
 
-      private:
-        evmc::address address_;
-        evmc::bytes32 key_;
+        void revert(IntraBlockState& state) noexcept;
     };
 
     // Account accessed (see EIP-2929).
-    class AccountAccessDelta : public Delta {
-      public:
-        explicit AccountAccessDelta(const evmc::address& address) noexcept;
+    struct AccountAccessDelta {
+        evmc::address address;
 
-        void revert(IntraBlockState& state) noexcept override;
-
-      private:
-        evmc::address address_;
+        void revert(IntraBlockState& state) noexcept;
     };
 
     /// Transient storage add/modify/delete delta.
-    class TransientStorageChangeDelta : public Delta {
-      public:
-        TransientStorageChangeDelta(const evmc::address& address, const evmc::bytes32& key,
-                                    const evmc::bytes32& previous) noexcept;
-
-        void revert(IntraBlockState& state) noexcept override;
+    struct TransientStorageChangeDelta {
+        evmc::address address;
+        evmc::bytes32 key;
+        evmc::bytes32 previous;
 
-      private:
-        evmc::address address_;
-        evmc::bytes32 key_;
-        evmc::bytes32 previous_;
+        void revert(IntraBlockState& state) noexcept;
     };
 
+    // Delta is the tagged union of all the revertible changes.
+    using Delta = std::variant<CreateDelta, UpdateDelta, UpdateBalanceDelta, SuicideDelta, TouchDelta,
+                               StorageChangeDelta, StorageWipeDelta, StorageCreateDelta, StorageAccessDelta,
+                               AccountAccessDelta, TransientStorageChangeDelta>;
+
+    void revert(Delta& delta, IntraBlockState& state) noexcept;
+
 }  // namespace state
 }  // namespace silkworm
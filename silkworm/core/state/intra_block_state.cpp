@@ -17,12 +17,15 @@
 #include "intra_block_state.hpp"
 
 #include <bit>
+#include <utility>
 
 #include <silkworm/core/common/util.hpp>
 
 namespace silkworm {
 
 const state::Object* IntraBlockState::get_object(const evmc::address& address) const noexcept {
+    record_account_read(address);
+
     auto it{objects_.find(address)};
     if (it != objects_.end()) {
         return &it->second;
@@ -48,12 +51,17 @@ state::Object* IntraBlockState::get_object(const evmc::address& address) noexcep
 state::Object& IntraBlockState::get_or_create_object(const evmc::address& address) noexcept {
     auto* obj{get_object(address)};
 
+    // Only creation counts as a write here, callers record their own changes
+    if (obj == nullptr || obj->current == std::nullopt) {
+        record_account_write(address);
+    }
+
     if (obj == nullptr) {
-        journal_.emplace_back(new state::CreateDelta{address});
+        journal_.emplace_back(state::CreateDelta{address});
         obj = &objects_[address];
         obj->current = Account{};
     } else if (obj->current == std::nullopt) {
-        journal_.emplace_back(new state::UpdateDelta{address, *obj});
+        journal_.emplace_back(state::UpdateDelta{address, *obj});
         obj->current = Account{};
     }
 
@@ -74,6 +82,11 @@ bool IntraBlockState::is_dead(const evmc::address& address) const noexcept {
 }
 
 void IntraBlockState::create_contract(const evmc::address& address) noexcept {
+    record_account_write(address);
+    if (access_set_) {
+        access_set_->read_all_storage.insert(address);
+    }
+
     created_.insert(address);
     state::Object created{};
     created.current = Account{};
@@ -88,9 +101,9 @@ void IntraBlockState::create_contract(const evmc::address& address) noexcept {
         } else if (prev->initial) {
             prev_incarnation = prev->initial->incarnation;
         }
-        journal_.emplace_back(new state::UpdateDelta{address, *prev});
+        journal_.emplace_back(state::UpdateDelta{address, *prev});
     } else {
-        journal_.emplace_back(new state::CreateDelta{address});
+        journal_.emplace_back(state::CreateDelta{address});
     }
 
     if (!prev_incarnation || prev_incarnation == 0) {
@@ -103,28 +116,29 @@ void IntraBlockState::create_contract(const evmc::address& address) noexcept {
 
     auto it{storage_.find(address)};
     if (it == storage_.end()) {
-        journal_.emplace_back(new state::StorageCreateDelta{address});
+        journal_.emplace_back(state::StorageCreateDelta{address});
     } else {
-        journal_.emplace_back(new state::StorageWipeDelta{address, it->second});
-        storage_.erase(address);
+        journal_.emplace_back(state::StorageWipeDelta{address, std::move(it->second)});
+        storage_.erase(it);
     }
 }
 
 void IntraBlockState::touch(const evmc::address& address) noexcept {
+    // Touching alone is not a write: dead touched accounts are destructed (hence recorded) at the end of the transaction
     const bool inserted{touched_.insert(address).second};
 
     // See Yellow Paper, Appendix K "Anomalies on the Main Network"
     // and https://github.com/ethereum/EIPs/issues/716
     static constexpr evmc::address kRipemdAddress{0x0000000000000000000000000000000000000003_address};
     if (inserted && address != kRipemdAddress) {
-        journal_.emplace_back(new state::TouchDelta{address});
+        journal_.emplace_back(state::TouchDelta{address});
     }
 }
 
 bool IntraBlockState::record_suicide(const evmc::address& address) noexcept {
     const bool inserted{self_destructs_.insert(address).second};
     if (inserted) {
-        journal_.emplace_back(new state::SuicideDelta{address});
+        journal_.emplace_back(state::SuicideDelta{address});
     }
     return inserted;
 }
@@ -146,6 +160,7 @@ void IntraBlockState::destruct_touched_dead() {
 // Doesn't create a delta since it's called at the end of a transaction,
 // when we don't need snapshots anymore.
 void IntraBlockState::destruct(const evmc::address& address) {
+    record_account_write(address);
     storage_.erase(address);
     auto* obj{get_object(address)};
     if (obj) {
@@ -160,21 +175,30 @@ intx::uint256 IntraBlockState::get_balance(const evmc::address& address) const n
 
 void IntraBlockState::set_balance(const evmc::address& address, const intx::uint256& value) noexcept {
     auto& obj{get_or_create_object(address)};
-    journal_.emplace_back(new state::UpdateBalanceDelta{address, obj.current->balance});
+    if (obj.current->balance != value) {
+        record_account_write(address);
+    }
+    journal_.emplace_back(state::UpdateBalanceDelta{address, obj.current->balance});
     obj.current->balance = value;
     touch(address);
 }
 
 void IntraBlockState::add_to_balance(const evmc::address& address, const intx::uint256& addend) noexcept {
     auto& obj{get_or_create_object(address)};
-    journal_.emplace_back(new state::UpdateBalanceDelta{address, obj.current->balance});
+    if (addend != 0) {
+        record_account_write(address);
+    }
+    journal_.emplace_back(state::UpdateBalanceDelta{address, obj.current->balance});
     obj.current->balance += addend;
     touch(address);
 }
 
 void IntraBlockState::subtract_from_balance(const evmc::address& address, const intx::uint256& subtrahend) noexcept {
     auto& obj{get_or_create_object(address)};
-    journal_.emplace_back(new state::UpdateBalanceDelta{address, obj.current->balance});
+    if (subtrahend != 0) {
+        record_account_write(address);
+    }
+    journal_.emplace_back(state::UpdateBalanceDelta{address, obj.current->balance});
     obj.current->balance -= subtrahend;
     touch(address);
 }
@@ -186,7 +210,10 @@ uint64_t IntraBlockState::get_nonce(const evmc::address& address) const noexcept
 
 void IntraBlockState::set_nonce(const evmc::address& address, uint64_t nonce) noexcept {
     auto& obj{get_or_create_object(address)};
-    journal_.emplace_back(new state::UpdateDelta{address, obj});
+    if (obj.current->nonce != nonce) {
+        record_account_write(address);
+    }
+    journal_.emplace_back(state::UpdateDelta{address, obj});
     obj.current->nonce = nonce;
 }
 
@@ -222,7 +249,8 @@ evmc::bytes32 IntraBlockState::get_code_hash(const evmc::address& address) const
 
 void IntraBlockState::set_code(const evmc::address& address, ByteView code) noexcept {
     auto& obj{get_or_create_object(address)};
-    journal_.emplace_back(new state::UpdateDelta{address, obj});
+    record_account_write(address);
+    journal_.emplace_back(state::UpdateDelta{address, obj});
     obj.current->code_hash = std::bit_cast<evmc_bytes32>(keccak256(code));
 
     // Don't overwrite already existing code so that views of it
@@ -233,7 +261,7 @@ void IntraBlockState::set_code(const evmc::address& address, ByteView code) noex
 evmc_access_status IntraBlockState::access_account(const evmc::address& address) noexcept {
     const bool cold_read{accessed_addresses_.insert(address).second};
     if (cold_read) {
-        journal_.emplace_back(new state::AccountAccessDelta{address});
+        journal_.emplace_back(state::AccountAccessDelta{address});
     }
     return cold_read ? EVMC_ACCESS_COLD : EVMC_ACCESS_WARM;
 }
@@ -241,7 +269,7 @@ evmc_access_status IntraBlockState::access_account(const evmc::address& address)
 evmc_access_status IntraBlockState::access_storage(const evmc::address& address, const evmc::bytes32& key) noexcept {
     const bool cold_read{accessed_storage_keys_[address].insert(key).second};
     if (cold_read) {
-        journal_.emplace_back(new state::StorageAccessDelta{address, key});
+        journal_.emplace_back(state::StorageAccessDelta{address, key});
     }
     return cold_read ? EVMC_ACCESS_COLD : EVMC_ACCESS_WARM;
 }
@@ -263,7 +291,9 @@ evmc::bytes32 IntraBlockState::get_storage(const evmc::address& address, const e
         return {};
     }
 
-    state::Storage& storage{storage_[address]};
+    record_storage_read(address, key);
+
+    state::Storage& storage{storage_of(address)};
 
     if (!original) {
         auto it{storage.current.find(key)};
@@ -284,7 +314,7 @@ evmc::bytes32 IntraBlockState::get_storage(const evmc::address& address, const e
 
     evmc::bytes32 val{db_.read_storage(address, incarnation, key)};
 
-    state::CommittedValue& entry{storage_[address].committed[key]};
+    state::CommittedValue& entry{storage_of(address).committed[key]};
     entry.initial = val;
     entry.original = val;
 
@@ -297,8 +327,9 @@ void IntraBlockState::set_storage(const evmc::address& address, const evmc::byte
     if (prev == value) {
         return;
     }
-    storage_[address].current[key] = value;
-    journal_.emplace_back(new state::StorageChangeDelta{address, key, prev});
+    record_storage_write(address, key);
+    storage_of(address).current[key] = value;
+    journal_.emplace_back(state::StorageChangeDelta{address, key, prev});
 }
 
 evmc::bytes32 IntraBlockState::get_transient_storage(const evmc::address& addr, const evmc::bytes32& key) {
@@ -309,7 +340,7 @@ void IntraBlockState::set_transient_storage(const evmc::address& addr, const evm
     auto& v = transient_storage_[addr][key];
     const auto prev = v;
     v = value;
-    journal_.emplace_back(std::make_unique<state::TransientStorageChangeDelta>(addr, key, prev));
+    journal_.emplace_back(state::TransientStorageChangeDelta{addr, key, prev});
 }
 
 void IntraBlockState::write_to_db(uint64_t block_number) {
@@ -356,7 +387,7 @@ IntraBlockState::Snapshot IntraBlockState::take_snapshot() const noexcept {
 
 void IntraBlockState::revert_to_snapshot(const IntraBlockState::Snapshot& snapshot) noexcept {
     for (size_t i = journal_.size(); i > snapshot.journal_size_; --i) {
-        journal_[i - 1]->revert(*this);
+        state::revert(journal_[i - 1], *this);
     }
     journal_.resize(snapshot.journal_size_);
     logs_.resize(snapshot.log_size_);
@@ -393,4 +424,65 @@ void IntraBlockState::clear_journal_and_substate() {
 
 void IntraBlockState::add_log(const Log& log) noexcept { logs_.push_back(log); }
 
+void IntraBlockState::merge_transaction(const IntraBlockState& other) {
+    // Objects loaded by the other instance either have been changed by its transaction or they hold the
+    // same values as here, so they can be copied over as a whole.
+    for (const auto& [address, obj] : other.objects_) {
+        objects_[address] = obj;
+    }
+
+    for (const auto& address : other.created_) {
+        storage_.erase(address);
+    }
+    for (const auto& [address, other_storage] : other.storage_) {
+        state::Storage& storage{storage_of(address)};
+        for (const auto& [key, val] : other_storage.committed) {
+            storage.committed.try_emplace(key, val);
+        }
+        for (const auto& [key, val] : other_storage.current) {
+            storage.current[key] = val;
+        }
+    }
+
+    for (const auto& [code_hash, code] : other.new_code_) {
+        new_code_.try_emplace(code_hash, code);
+    }
+    for (const auto& [code_hash, code] : other.existing_code_) {
+        existing_code_.try_emplace(code_hash, code);
+    }
+
+    self_destructs_.insert(other.self_destructs_.begin(), other.self_destructs_.end());
+    touched_.insert(other.touched_.begin(), other.touched_.end());
+    created_.insert(other.created_.begin(), other.created_.end());
+    logs_.insert(logs_.end(), other.logs_.begin(), other.logs_.end());
+}
+
+state::Storage& IntraBlockState::storage_of(const evmc::address& address) const noexcept {
+    return storage_.try_emplace(address, &arena_).first->second;
+}
+
+void IntraBlockState::record_account_read(const evmc::address& address) const noexcept {
+    if (access_set_) {
+        access_set_->read_accounts.insert(address);
+    }
+}
+
+void IntraBlockState::record_account_write(const evmc::address& address) noexcept {
+    if (access_set_) {
+        access_set_->written_accounts.insert(address);
+    }
+}
+
+void IntraBlockState::record_storage_read(const evmc::address& address, const evmc::bytes32& key) const noexcept {
+    if (access_set_) {
+        access_set_->read_storage[address].insert(key);
+    }
+}
+
+void IntraBlockState::record_storage_write(const evmc::address& address, const evmc::bytes32& key) noexcept {
+    if (access_set_) {
+        access_set_->written_storage[address].insert(key);
+    }
+}
+
 }  // namespace silkworm
@@ -16,14 +16,16 @@
 
 #pragma once
 
-#include <memory>
+#include <utility>
 #include <vector>
 
 #include <intx/intx.hpp>
 
+#include <silkworm/core/common/arena.hpp>
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/core/common/bytes.hpp>
 #include <silkworm/core/common/hash_maps.hpp>
+#include <silkworm/core/state/access_set.hpp>
 #include <silkworm/core/state/delta.hpp>
 #include <silkworm/core/state/object.hpp>
 #include <silkworm/core/state/state.hpp>
@@ -119,18 +121,29 @@ class IntraBlockState {
 
     void set_transient_storage(const evmc::address& addr, const evmc::bytes32& key, const evmc::bytes32& value);
 
+    // Record the accounts and storage locations accessed from now on into the given set (nullptr to stop recording).
+    void set_access_set(state::AccessSet* access_set) noexcept { access_set_ = access_set; }
+
+    // Apply the changes of a transaction executed by another instance, but not finalized yet.
+    // Precondition: nothing read or written by the other instance has been changed here since the beginning
+    // of the block, i.e. both instances observed the same values.
+    void merge_transaction(const IntraBlockState& other);
+
+    // The arena objects and storage are allocated from (for diagnostics).
+    const MonotonicArena& arena() const noexcept { return arena_; }
+
   private:
-    friend class state::CreateDelta;
-    friend class state::UpdateDelta;
-    friend class state::UpdateBalanceDelta;
-    friend class state::SuicideDelta;
-    friend class state::TouchDelta;
-    friend class state::StorageChangeDelta;
-    friend class state::StorageWipeDelta;
-    friend class state::StorageCreateDelta;
-    friend class state::StorageAccessDelta;
-    friend class state::AccountAccessDelta;
-    friend class state::TransientStorageChangeDelta;
+    friend struct state::CreateDelta;
+    friend struct state::UpdateDelta;
+    friend struct state::UpdateBalanceDelta;
+    friend struct state::SuicideDelta;
+    friend struct state::TouchDelta;
+    friend struct state::StorageChangeDelta;
+    friend struct state::StorageWipeDelta;
+    friend struct state::StorageCreateDelta;
+    friend struct state::StorageAccessDelta;
+    friend struct state::AccountAccessDelta;
+    friend struct state::TransientStorageChangeDelta;
 
     evmc::bytes32 get_storage(const evmc::address& address, const evmc::bytes32& key, bool original) const noexcept;
 
@@ -139,15 +152,30 @@ class IntraBlockState {
 
     state::Object& get_or_create_object(const evmc::address& address) noexcept;
 
+    // Storage of the account, created in the arena if not there yet
+    state::Storage& storage_of(const evmc::address& address) const noexcept;
+
+    void record_account_read(const evmc::address& address) const noexcept;
+    void record_account_write(const evmc::address& address) noexcept;
+    void record_storage_read(const evmc::address& address, const evmc::bytes32& key) const noexcept;
+    void record_storage_write(const evmc::address& address, const evmc::bytes32& key) noexcept;
+
+    template <class K, class V>
+    using ArenaFlatHashMap = FlatHashMap<K, V, ArenaAllocator<std::pair<const K, V>>>;
+
     State& db_;
 
-    mutable FlatHashMap<evmc::address, state::Object> objects_;
-    mutable FlatHashMap<evmc::address, state::Storage> storage_;
+    // Objects and storage live as long as this instance, typically a block, so they are allocated in bulk from an
+    // arena which is freed at once on destruction. Must be declared before anything allocated in it.
+    mutable MonotonicArena arena_;
+
+    mutable ArenaFlatHashMap<evmc::address, state::Object> objects_{ArenaAllocator<state::Object>{&arena_}};
+    mutable ArenaFlatHashMap<evmc::address, state::Storage> storage_{ArenaAllocator<state::Storage>{&arena_}};
 
     mutable FlatHashMap<evmc::bytes32, ByteView> existing_code_;
     FlatHashMap<evmc::bytes32, std::vector<uint8_t>> new_code_;
 
-    std::vector<std::unique_ptr<state::Delta>> journal_;
+    std::vector<state::Delta> journal_;
 
     // substate
     FlatHashSet<evmc::address> self_destructs_;
@@ -159,6 +187,8 @@ class IntraBlockState {
     FlatHashMap<evmc::address, FlatHashSet<evmc::bytes32>> accessed_storage_keys_;
 
     FlatHashMap<evmc::address, FlatHashMap<evmc::bytes32, evmc::bytes32>> transient_storage_;
+
+    state::AccessSet* access_set_{nullptr};
 };
 
 }  // namespace silkworm
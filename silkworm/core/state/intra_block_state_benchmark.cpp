@@ -0,0 +1,231 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/core/common/assert.hpp>
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/test_util.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/execution/processor.hpp>
+#include <silkworm/core/protocol/rule_set.hpp>
+#include <silkworm/core/state/delta.hpp>
+#include <silkworm/core/state/in_memory_state.hpp>
+#include <silkworm/core/state/intra_block_state.hpp>
+
+namespace silkworm {
+
+static constexpr size_t kTransactionsPerBlock{200};
+static constexpr size_t kNumAccounts{2 * kTransactionsPerBlock};
+static constexpr size_t kTokenTransferEvery{3};  // roughly one mainnet transaction out of 3 is a token transfer
+static constexpr uint8_t kAccountPrefix{0xbb};
+
+static const evmc::address kToken{0xdac17f958d2ee523a2206206994597c13d831ec7_address};
+
+// ERC20-like contract: increments the caller balance slot and the total supply slot
+// CALLER SLOAD PUSH1 1 ADD CALLER SSTORE PUSH1 0 SLOAD PUSH1 1 ADD PUSH1 0 SSTORE STOP
+static const Bytes kTokenCode{*from_hex("3354600101335560005460010160005500")};
+
+static evmc::address account_address(size_t index) {
+    return test::synthetic_address(index, kAccountPrefix);
+}
+
+static std::unique_ptr<InMemoryState> make_genesis_state() {
+    return test::synthetic_state(kNumAccounts, kAccountPrefix, kToken, kTokenCode);
+}
+
+//! Block made of plain transfers and token transfers, each transaction from a distinct sender
+static const Block& mainnet_like_block() {
+    static const Block block{[]() {
+        Block b;
+        b.header.number = 1;
+        b.header.gas_limit = 30'000'000;
+        b.header.beneficiary = 0x61c808d82a3ac53231750dadc13c777b59310bd9_address;
+        for (size_t i{0}; i < kTransactionsPerBlock; ++i) {
+            if (i % kTokenTransferEvery == 0) {
+                b.transactions.push_back(test::synthetic_transaction(account_address(i), kToken));
+            } else {
+                Transaction txn{test::synthetic_transaction(account_address(i), account_address(kTransactionsPerBlock + i))};
+                txn.value = 1'000;
+                b.transactions.push_back(std::move(txn));
+            }
+        }
+        test::set_gas_used_by_dry_run(b, *make_genesis_state(), kMainnetConfig);
+        return b;
+    }()};
+    return block;
+}
+
+static void execute_mainnet_like_block(benchmark::State& state) {
+    const Block& block{mainnet_like_block()};
+    auto rule_set{protocol::rule_set_factory(kMainnetConfig)};
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        auto block_state{make_genesis_state()};
+        std::vector<Receipt> receipts;
+        receipts.reserve(kTransactionsPerBlock);
+        state.ResumeTiming();
+
+        ExecutionProcessor processor{block, *rule_set, *block_state, kMainnetConfig};
+        const auto result{processor.execute_and_write_block(receipts)};
+        SILKWORM_ASSERT(result == ValidationResult::kOk);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(kTransactionsPerBlock));
+}
+BENCHMARK(execute_mainnet_like_block);
+
+//! Journal-heavy workload: balance changes, storage writes and nested snapshot reverts as in a call tree
+static void intra_block_state_journal(benchmark::State& state) {
+    const auto genesis{make_genesis_state()};
+    const size_t num_accounts{static_cast<size_t>(state.range(0))};
+
+    size_t arena_bytes{0};
+    size_t arena_chunks{0};
+    for ([[maybe_unused]] auto _ : state) {
+        IntraBlockState ibs{*genesis};
+        for (size_t i{0}; i < num_accounts; ++i) {
+            const evmc::address address{account_address(i % kNumAccounts)};
+            const auto snapshot{ibs.take_snapshot()};
+            ibs.subtract_from_balance(address, 21'000);
+            ibs.add_to_balance(kToken, 21'000);
+            evmc::bytes32 slot{};
+            endian::store_big_u64(&slot.bytes[24], i);
+            ibs.set_storage(kToken, slot, 0x01_bytes32);
+            ibs.touch(address);
+            if (i % 10 == 0) {
+                ibs.revert_to_snapshot(snapshot);  // some calls fail
+            }
+        }
+        ibs.finalize_transaction(EVMC_SHANGHAI);
+        benchmark::DoNotOptimize(ibs.get_balance(kToken));
+        arena_bytes += ibs.arena().allocated_bytes();
+        arena_chunks += ibs.arena().num_chunks();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(num_accounts));
+
+    // Objects and storage are drawn from the arena, which hits the heap just once per chunk
+    state.counters["arena bytes"] = benchmark::Counter(static_cast<double>(arena_bytes),
+                                                       benchmark::Counter::kAvgIterations);
+    state.counters["arena chunks"] = benchmark::Counter(static_cast<double>(arena_chunks),
+                                                        benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(intra_block_state_journal)->Arg(100)->Arg(1'000)->Arg(10'000);
+
+//! Allocator counting the heap allocations it makes, so that journal layouts can be compared on their own
+template <typename T>
+class CountingAllocator {
+  public:
+    using value_type = T;
+
+    explicit CountingAllocator(size_t& count) noexcept : count_{&count} {}
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept : count_{other.count()} {}  // NOLINT(google-explicit-constructor)
+
+    [[nodiscard]] T* allocate(size_t n) {
+        ++*count_;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept { std::allocator<T>{}.deallocate(p, n); }
+
+    [[nodiscard]] size_t* count() const noexcept { return count_; }
+
+    template <typename U>
+    friend bool operator==(const CountingAllocator& lhs, const CountingAllocator<U>& rhs) noexcept {
+        return lhs.count() == rhs.count();
+    }
+
+  private:
+    size_t* count_;
+};
+
+//! Deltas recorded by the journal-heavy workload above for the index-th account
+static std::array<state::Delta, 3> journal_deltas(size_t index) {
+    const evmc::address address{account_address(index % kNumAccounts)};
+    evmc::bytes32 slot{};
+    endian::store_big_u64(&slot.bytes[24], index);
+    return {state::UpdateBalanceDelta{address, kEther}, state::StorageChangeDelta{kToken, slot, {}},
+            state::TouchDelta{address}};
+}
+
+//! Previous journal layout: each delta allocated on its own, the journal holding pointers to them
+static void journal_of_heap_deltas(benchmark::State& state) {
+    const size_t num_accounts{static_cast<size_t>(state.range(0))};
+
+    using Journal = std::vector<state::Delta*, CountingAllocator<state::Delta*>>;
+    size_t allocations{0};
+    CountingAllocator<state::Delta> delta_allocator{allocations};
+    const auto pop_delta{[&](Journal& journal) {
+        std::destroy_at(journal.back());
+        delta_allocator.deallocate(journal.back(), 1);
+        journal.pop_back();
+    }};
+    for ([[maybe_unused]] auto _ : state) {
+        Journal journal{Journal::allocator_type{allocations}};
+        for (size_t i{0}; i < num_accounts; ++i) {
+            const size_t snapshot{journal.size()};
+            for (const auto& delta : journal_deltas(i)) {
+                journal.push_back(std::construct_at(delta_allocator.allocate(1), delta));
+            }
+            if (i % 10 == 0) {
+                while (journal.size() > snapshot) {
+                    pop_delta(journal);  // some calls fail
+                }
+            }
+        }
+        benchmark::DoNotOptimize(journal.data());
+        while (!journal.empty()) {
+            pop_delta(journal);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(num_accounts));
+    state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocations),
+                                                       benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(journal_of_heap_deltas)->Arg(100)->Arg(1'000)->Arg(10'000);
+
+//! Current journal layout: deltas stored by value, so that the journal alone hits the heap
+static void journal_of_inline_deltas(benchmark::State& state) {
+    const size_t num_accounts{static_cast<size_t>(state.range(0))};
+
+    size_t allocations{0};
+    for ([[maybe_unused]] auto _ : state) {
+        std::vector<state::Delta, CountingAllocator<state::Delta>> journal{CountingAllocator<state::Delta>{allocations}};
+        for (size_t i{0}; i < num_accounts; ++i) {
+            const size_t snapshot{journal.size()};
+            for (const auto& delta : journal_deltas(i)) {
+                journal.push_back(delta);
+            }
+            if (i % 10 == 0) {
+                journal.resize(snapshot);  // some calls fail
+            }
+        }
+        benchmark::DoNotOptimize(journal.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(num_accounts));
+    state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocations),
+                                                       benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(journal_of_inline_deltas)->Arg(100)->Arg(1'000)->Arg(10'000);
+
+}  // namespace silkworm
@@ -99,4 +99,25 @@ TEST_CASE("Code view stability") {
     }
 }
 
+TEST_CASE("Revert journal to snapshot") {
+    InMemoryState db;
+    const evmc::address addr{random_address()};
+    db.update_account(addr, /*initial=*/std::nullopt, /*current=*/Account{.balance = 100});
+
+    IntraBlockState state{db};
+    const evmc::bytes32 key{0x01_bytes32};
+    const evmc::bytes32 value{0x2a_bytes32};
+    state.set_storage(addr, key, value);
+
+    const auto snapshot{state.take_snapshot()};
+    state.add_to_balance(addr, 50);
+    state.set_storage(addr, key, 0x07_bytes32);
+    state.create_contract(addr);  // wipes the storage
+    CHECK(state.get_current_storage(addr, key) == evmc::bytes32{});
+
+    state.revert_to_snapshot(snapshot);
+    CHECK(state.get_balance(addr) == 100);
+    CHECK(state.get_current_storage(addr, key) == value);
+}
+
 }  // namespace silkworm
@@ -17,7 +17,9 @@
 #pragma once
 
 #include <optional>
+#include <utility>
 
+#include <silkworm/core/common/arena.hpp>
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/core/common/hash_maps.hpp>
 #include <silkworm/core/types/account.hpp>
@@ -35,8 +37,15 @@ struct CommittedValue {
 };
 
 struct Storage {
-    FlatHashMap<evmc::bytes32, CommittedValue> committed;
-    FlatHashMap<evmc::bytes32, evmc::bytes32> current;
+    template <class V>
+    using Map = FlatHashMap<evmc::bytes32, V, ArenaAllocator<std::pair<const evmc::bytes32, V>>>;
+
+    Storage() = default;
+    explicit Storage(MonotonicArena* arena) : committed{Map<CommittedValue>::allocator_type{arena}},
+                                              current{Map<evmc::bytes32>::allocator_type{arena}} {}
+
+    Map<CommittedValue> committed;
+    Map<evmc::bytes32> current;
 };
 
 }  // namespace silkworm::state
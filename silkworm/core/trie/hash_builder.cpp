@@ -112,9 +112,52 @@ void HashBuilder::finalize() {
         gen_struct_step(key_, {});
         key_.clear();
         value_ = Bytes{};
+    } else if (!groups_.empty()) {
+        // Subtries are pending in the root branch node
+        SILKWORM_ASSERT(std::popcount(groups_[0]) >= 2);
+        close_branch_node(key_, 0);  // root prefix is empty
+        groups_.clear();
+        tree_masks_.clear();
+        hash_masks_.clear();
     }
 }
 
+Subtrie HashBuilder::finalize_subtrie() {
+    SILKWORM_ASSERT(!key_.empty());
+    Subtrie subtrie{.nibble = key_[0]};
+
+    // Any key diverging at the first nibble closes all the branches but the root one
+    const Bytes succeeding(1, static_cast<uint8_t>(key_[0] ^ 1u));
+    gen_struct_step(key_, succeeding);
+    SILKWORM_ASSERT(stack_.size() == 1);
+
+    const auto flag{static_cast<uint16_t>(1u << subtrie.nibble)};
+    subtrie.node_ref = std::move(stack_.back());
+    subtrie.hash_flag = !hash_masks_.empty() && (hash_masks_[0] & flag);
+    subtrie.tree_flag = !tree_masks_.empty() && (tree_masks_[0] & flag);
+    reset();
+    return subtrie;
+}
+
+void HashBuilder::add_subtrie(const Subtrie& subtrie) {
+    const auto flag{static_cast<uint16_t>(1u << subtrie.nibble)};
+    SILKWORM_ASSERT(key_.empty());
+    SILKWORM_ASSERT(groups_.empty() || groups_[0] < flag);
+    if (groups_.empty()) {
+        groups_.resize(1);
+        tree_masks_.resize(1);
+        hash_masks_.resize(1);
+    }
+    groups_[0] |= flag;
+    if (subtrie.hash_flag) {
+        hash_masks_[0] |= flag;
+    }
+    if (subtrie.tree_flag) {
+        tree_masks_[0] |= flag;
+    }
+    stack_.push_back(subtrie.node_ref);
+}
+
 evmc::bytes32 HashBuilder::root_hash() { return root_hash(/*auto_finalize=*/true); }
 
 evmc::bytes32 HashBuilder::root_hash(bool auto_finalize) {
@@ -209,33 +252,7 @@ void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
 
         // Close the immediately encompassing prefix group, if needed
         if (!succeeding.empty() || preceding_exists) {  // branch node
-            std::vector<Bytes> child_hashes{branch_ref(groups_[len], hash_masks_[len])};
-
-            // See node/silkworm/trie/intermediate_hashes.hpp
-            if (node_collector) {
-                if (len > 0) {
-                    hash_masks_[len - 1] |= 1u << current[len - 1];
-                }
-
-                const bool store_in_db_trie{tree_masks_[len] || hash_masks_[len]};
-                if (store_in_db_trie) {
-                    if (len > 0) {
-                        tree_masks_[len - 1] |= 1u << current[len - 1];  // register myself in parent bitmap
-                    }
-
-                    std::vector<evmc::bytes32> hashes(child_hashes.size());
-                    for (size_t i{0}; i < child_hashes.size(); ++i) {
-                        SILKWORM_ASSERT(child_hashes[i].size() == kHashLength + 1);
-                        std::memcpy(hashes[i].bytes, &child_hashes[i][1], kHashLength);
-                    }
-                    Node node{groups_[len], tree_masks_[len], hash_masks_[len], hashes};
-                    if (len == 0) {
-                        node.set_root_hash(root_hash(/*auto_finalize=*/false));
-                    }
-
-                    node_collector(current.substr(0, len), node);
-                }
-            }
+            close_branch_node(current, len);
         }
 
         groups_.resize(len);
@@ -254,6 +271,36 @@ void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
     }
 }
 
+void HashBuilder::close_branch_node(ByteView current, size_t len) {
+    std::vector<Bytes> child_hashes{branch_ref(groups_[len], hash_masks_[len])};
+
+    // See node/silkworm/trie/intermediate_hashes.hpp
+    if (node_collector) {
+        if (len > 0) {
+            hash_masks_[len - 1] |= 1u << current[len - 1];
+        }
+
+        const bool store_in_db_trie{tree_masks_[len] || hash_masks_[len]};
+        if (store_in_db_trie) {
+            if (len > 0) {
+                tree_masks_[len - 1] |= 1u << current[len - 1];  // register myself in parent bitmap
+            }
+
+            std::vector<evmc::bytes32> hashes(child_hashes.size());
+            for (size_t i{0}; i < child_hashes.size(); ++i) {
+                SILKWORM_ASSERT(child_hashes[i].size() == kHashLength + 1);
+                std::memcpy(hashes[i].bytes, &child_hashes[i][1], kHashLength);
+            }
+            Node node{groups_[len], tree_masks_[len], hash_masks_[len], hashes};
+            if (len == 0) {
+                node.set_root_hash(root_hash(/*auto_finalize=*/false));
+            }
+
+            node_collector(current.substr(0, len), node);
+        }
+    }
+}
+
 // Takes children from the stack and replaces them with branch node ref.
 std::vector<Bytes> HashBuilder::branch_ref(uint16_t state_mask, uint16_t hash_mask) {
     SILKWORM_ASSERT(is_subset(hash_mask, state_mask));
@@ -30,6 +30,15 @@ namespace silkworm::trie {
 // Erigon HashCollector2
 using NodeCollector = std::function<void(ByteView nibbled_key, const Node&)>;
 
+//! \brief A subtrie whose keys all share the same first nibble, built by its own HashBuilder
+//! \see HashBuilder::finalize_subtrie and HashBuilder::add_subtrie
+struct Subtrie {
+    uint8_t nibble{0};      // First nibble shared by all keys
+    Bytes node_ref;         // Reference to the subtrie node held by the root branch: hash or embedded RLP
+    bool hash_flag{false};  // Whether the subtrie node sets its bit in the root branch hash mask
+    bool tree_flag{false};  // Whether the subtrie node sets its bit in the root branch tree mask
+};
+
 // Calculates root hash of a Modified Merkle Patricia Trie.
 // See Appendix D "Modified Merkle Patricia Trie" of the Yellow Paper
 // and https://eth.wiki/fundamentals/patricia-tree
@@ -58,6 +67,17 @@ class HashBuilder {
     //! \remarks If no entries in the stack_ the kEmptyRoot is returned
     evmc::bytes32 root_hash();
 
+    //! \brief Closes a subtrie as if the added entries were followed by keys with a different first nibble and resets
+    //! the builder. All nodes below the root branch are passed to node_collector exactly as a builder over the whole
+    //! trie would do
+    //! \pre At least one leaf has been added and all added keys share the same first nibble
+    Subtrie finalize_subtrie();
+
+    //! \details Subtries must be added in strictly increasing order of nibble and cannot be mixed with leaves or
+    //! branch nodes. The root branch node is built by root_hash() and, if at least two subtries have been added, the
+    //! result is identical to adding all the leaves of the subtries to a single builder.
+    void add_subtrie(const Subtrie& subtrie);
+
     //! \brief Pointer to function for collecting nodes in etl.
     NodeCollector node_collector{nullptr};
 
@@ -72,6 +92,9 @@ class HashBuilder {
     // See Erigon GenStructStep
     void gen_struct_step(ByteView current, ByteView succeeding);
 
+    // Replaces the children on top of stack_ with the branch node of prefix current[0, len) and collects it if needed
+    void close_branch_node(ByteView current, size_t len);
+
     std::vector<Bytes> branch_ref(uint16_t state_mask, uint16_t hash_mask);
 
     ByteView leaf_node_rlp(ByteView path, ByteView value);
@@ -15,6 +15,8 @@
 */
 
 #include <iterator>
+#include <map>
+#include <random>
 
 #include <catch2/catch.hpp>
 #include <ethash/keccak.hpp>
@@ -198,4 +200,58 @@ TEST_CASE("Known root hash") {
     CHECK(to_hex(hb.root_hash()) == to_hex(root_hash.bytes));
 }
 
+TEST_CASE("Subtries combine into the same trie") {
+    using Nodes = std::map<Bytes, Node>;
+    std::mt19937 rng{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+
+    for (size_t iteration{0}; iteration < 200; ++iteration) {
+        // Few nibble values and a common prefix produce extension nodes and deep branches
+        const auto alphabet{static_cast<uint8_t>(1 + rng() % 16)};
+        std::map<Bytes, Bytes> leaves;
+        const size_t count{2 + rng() % 300};
+        for (size_t i{0}; i < count; ++i) {
+            Bytes key(64, '\0');
+            for (size_t j{0}; j < key.length(); ++j) {
+                key[j] = static_cast<uint8_t>(j < 4 && rng() % 2 ? 0xa : rng() % alphabet);
+            }
+            key[0] = static_cast<uint8_t>(rng() % 16);
+            Bytes value(1 + rng() % (rng() % 2 ? 3 : 40), '\0');  // both embedded and hashed nodes
+            for (auto& byte : value) {
+                byte = static_cast<uint8_t>(rng());
+            }
+            leaves.emplace(std::move(key), std::move(value));
+        }
+
+        Nodes expected_nodes;
+        HashBuilder hb;
+        hb.node_collector = [&](ByteView nibbled_key, const Node& node) { expected_nodes.emplace(nibbled_key, node); };
+        std::map<uint8_t, std::vector<std::pair<Bytes, Bytes>>> subtries;
+        for (const auto& [key, value] : leaves) {
+            hb.add_leaf(key, value);
+            subtries[key[0]].emplace_back(key, value);
+        }
+        const evmc::bytes32 expected_root{hb.root_hash()};
+        if (subtries.size() < 2) {
+            continue;
+        }
+
+        Nodes nodes;
+        const NodeCollector collector{[&](ByteView nibbled_key, const Node& node) { nodes.emplace(nibbled_key, node); }};
+        HashBuilder root_hb;
+        root_hb.node_collector = collector;
+        for (const auto& [nibble, subtrie_leaves] : subtries) {
+            HashBuilder subtrie_hb;
+            subtrie_hb.node_collector = collector;
+            for (const auto& [key, value] : subtrie_leaves) {
+                subtrie_hb.add_leaf(key, value);
+            }
+            const Subtrie subtrie{subtrie_hb.finalize_subtrie()};
+            CHECK(subtrie.nibble == nibble);
+            root_hb.add_subtrie(subtrie);
+        }
+        CHECK(to_hex(root_hb.root_hash()) == to_hex(expected_root));
+        CHECK(nodes == expected_nodes);
+    }
+}
+
 }  // namespace silkworm::trie
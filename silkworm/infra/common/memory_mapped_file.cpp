@@ -33,9 +33,20 @@
 #include <gsl/util>
 
 #include "ensure.hpp"
+#include "os.hpp"
 
 namespace silkworm {
 
+//! Read one byte in each page of the specified memory region, so that all pages are faulted in
+static void touch_pages(const uint8_t* address, std::size_t length) {
+    const auto page_size{os::page_size()};
+    uint8_t checksum{0};
+    for (std::size_t offset{0}; offset < length; offset += page_size) {
+        checksum ^= static_cast<const volatile uint8_t*>(address)[offset];
+    }
+    [[maybe_unused]] volatile uint8_t sink{checksum};
+}
+
 MemoryMappedFile::MemoryMappedFile(std::filesystem::path path, std::optional<MemoryMappedRegion> region, bool read_only)
     : path_(std::move(path)), managed_{not region.has_value()} {
     ensure(std::filesystem::exists(path_), "MemoryMappedFile: " + path_.string() + " does not exist");
@@ -98,6 +109,21 @@ void MemoryMappedFile::advise_random() {
 void MemoryMappedFile::advise_sequential() {
 }
 
+void MemoryMappedFile::advise_willneed() {
+}
+
+bool MemoryMappedFile::advise_huge_pages() {
+    return false;
+}
+
+void MemoryMappedFile::populate() {
+    touch_pages(address_, length_);
+}
+
+bool MemoryMappedFile::lock() {
+    return ::VirtualLock(address_, length_) != 0;
+}
+
 void* MemoryMappedFile::mmap(FileDescriptor fd, bool read_only) {
     DWORD protection = static_cast<DWORD>(read_only ? PAGE_READONLY : PAGE_READWRITE);
 
@@ -158,6 +184,33 @@ void MemoryMappedFile::advise_sequential() {
     advise(MADV_SEQUENTIAL);
 }
 
+void MemoryMappedFile::advise_willneed() {
+    advise(MADV_WILLNEED);
+}
+
+bool MemoryMappedFile::advise_huge_pages() {
+#ifdef MADV_HUGEPAGE
+    // Huge pages for file mappings require kernel support (e.g. CONFIG_READ_ONLY_THP_FOR_FS) otherwise EINVAL
+    return ::madvise(address_, length_, MADV_HUGEPAGE) == 0;
+#else
+    return false;
+#endif
+}
+
+void MemoryMappedFile::populate() {
+#ifdef MADV_POPULATE_READ
+    // Available since Linux 5.14, fallback to touching each page on older kernels
+    if (::madvise(address_, length_, MADV_POPULATE_READ) == 0) {
+        return;
+    }
+#endif
+    touch_pages(address_, length_);
+}
+
+bool MemoryMappedFile::lock() {
+    return ::mlock(address_, length_) == 0;
+}
+
 void* MemoryMappedFile::mmap(FileDescriptor fd, bool read_only) {
     int flags = MAP_SHARED;
 
@@ -107,6 +107,20 @@ class MemoryMappedFile {
     void advise_random();
     void advise_sequential();
 
+    //! Advise the OS to read ahead the whole file content asynchronously (e.g. to warm up hot files)
+    void advise_willneed();
+
+    //! Advise the OS to back the mapping with transparent huge pages
+    //! @return true if the advice has been accepted, false if not supported by the OS or the underlying filesystem
+    bool advise_huge_pages();
+
+    //! Read the whole file content in memory synchronously, like mapping it with MAP_POPULATE
+    void populate();
+
+    //! Lock the file pages in memory, so that they are never paged out until unmapped
+    //! @return true if the pages have been locked, false otherwise (e.g. when over the memory-lock limit)
+    bool lock();
+
   private:
     void map_existing(bool read_only);
 
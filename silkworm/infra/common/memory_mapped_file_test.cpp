@@ -78,6 +78,25 @@ TEST_CASE("MemoryMappedFile from file", "[silkworm][infra][common][memory_mapped
         CHECK_NOTHROW(mmf.advise_random());
     }
 
+    SECTION("advise_willneed") {
+        CHECK_NOTHROW(mmf.advise_willneed());
+    }
+
+    SECTION("advise_huge_pages") {
+        // Huge pages for file mappings depend on OS and filesystem, so just check that failure is not fatal
+        CHECK_NOTHROW(mmf.advise_huge_pages());
+    }
+
+    SECTION("populate") {
+        CHECK_NOTHROW(mmf.populate());
+        CHECK(mmf.address()[2] == '\x03');
+    }
+
+    SECTION("lock") {
+        // Locking may exceed the memory-lock limit, so just check that failure is not fatal
+        CHECK_NOTHROW(mmf.lock());
+    }
+
     SECTION("input stream") {
         MemoryMappedInputStream mmis{mmf.address(), mmf.length()};
         std::string s;
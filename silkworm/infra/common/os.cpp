@@ -82,4 +82,19 @@ std::size_t page_size() noexcept {
     return system_page_size;
 }
 
+uint64_t major_page_faults() noexcept {
+#if defined(__linux__) || defined(__APPLE__)
+#ifdef RUSAGE_THREAD
+    constexpr int kWho{RUSAGE_THREAD};
+#else
+    constexpr int kWho{RUSAGE_SELF};
+#endif  // RUSAGE_THREAD
+    rusage usage{};
+    if (getrusage(kWho, &usage) == -1) return 0;
+    return static_cast<uint64_t>(usage.ru_majflt);
+#else
+    return 0;
+#endif
+}
+
 }  // namespace silkworm::os
@@ -28,4 +28,8 @@ bool set_max_file_descriptors(uint64_t max_descriptors);
 
 std::size_t page_size() noexcept;
 
+//! The number of major page faults (i.e. requiring I/O) incurred so far by the calling thread where supported (Linux),
+//! by the whole process otherwise (0 if not supported at all)
+uint64_t major_page_faults() noexcept;
+
 }  // namespace silkworm::os
@@ -34,4 +34,9 @@ TEST_CASE("os::page_size", "[silkworm][infra][common][os]") {
     CHECK(page_size() >= 4096);
 }
 
+TEST_CASE("os::major_page_faults", "[silkworm][infra][common][os]") {
+    const auto major_faults = major_page_faults();
+    CHECK(major_page_faults() >= major_faults);
+}
+
 }  // namespace silkworm::os
@@ -0,0 +1,98 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace silkworm {
+
+//! \brief Blocking multi-producer multi-consumer queue holding at most a given number of items
+//! \remarks Producers block when the queue is full, consumers block when it is empty. Closing the queue wakes up
+//! everyone: further pushes are rejected while pops keep draining the items left
+template <typename T>
+class BoundedQueue {
+  public:
+    explicit BoundedQueue(size_t capacity) : capacity_{capacity > 0 ? capacity : 1} {}
+
+    // Not copyable nor movable
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    //! \brief Waits for room and enqueues the item
+    //! \return false if the queue has been closed
+    bool push(T item) {
+        std::unique_lock lock{mutex_};
+        not_full_.wait(lock, [&] { return closed_ || queue_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        queue_.push_back(std::move(item));
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    //! \brief Waits for an item and dequeues it
+    //! \return the item or std::nullopt if the queue has been closed and drained
+    std::optional<T> pop() {
+        std::unique_lock lock{mutex_};
+        not_empty_.wait(lock, [&] { return closed_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> item{std::move(queue_.front())};
+        queue_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return item;
+    }
+
+    void close() {
+        {
+            std::scoped_lock lock{mutex_};
+            closed_ = true;
+        }
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+    [[nodiscard]] bool closed() const {
+        std::scoped_lock lock{mutex_};
+        return closed_;
+    }
+
+    [[nodiscard]] size_t size() const {
+        std::scoped_lock lock{mutex_};
+        return queue_.size();
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+  private:
+    const size_t capacity_;
+    std::deque<T> queue_;
+    bool closed_{false};
+    mutable std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+};
+
+}  // namespace silkworm
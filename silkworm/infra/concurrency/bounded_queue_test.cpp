@@ -0,0 +1,75 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bounded_queue.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("BoundedQueue", "[silkworm][infra][concurrency][bounded_queue]") {
+    BoundedQueue<int> queue{2};
+    CHECK(queue.capacity() == 2);
+
+    SECTION("pop in FIFO order") {
+        CHECK(queue.push(1));
+        CHECK(queue.push(2));
+        CHECK(queue.size() == 2);
+        CHECK(queue.pop() == 1);
+        CHECK(queue.pop() == 2);
+        CHECK(queue.size() == 0);
+    }
+
+    SECTION("close rejects pushes and drains pops") {
+        CHECK(queue.push(1));
+        queue.close();
+        CHECK(queue.closed());
+        CHECK_FALSE(queue.push(2));
+        CHECK(queue.pop() == 1);
+        CHECK_FALSE(queue.pop().has_value());
+    }
+
+    SECTION("producer blocks until consumer makes room") {
+        static constexpr int kItems{100};
+        std::thread producer{[&]() {
+            for (int i{0}; i < kItems; ++i) {
+                CHECK(queue.push(i));
+            }
+            queue.close();
+        }};
+        std::vector<int> consumed;
+        while (auto item{queue.pop()}) {
+            CHECK(queue.size() <= queue.capacity());
+            consumed.push_back(*item);
+        }
+        producer.join();
+        REQUIRE(consumed.size() == kItems);
+        for (int i{0}; i < kItems; ++i) {
+            CHECK(consumed[static_cast<size_t>(i)] == i);
+        }
+    }
+
+    SECTION("close wakes up blocked consumer") {
+        std::thread closer{[&]() { queue.close(); }};
+        CHECK_FALSE(queue.pop().has_value());
+        closer.join();
+    }
+}
+
+}  // namespace silkworm
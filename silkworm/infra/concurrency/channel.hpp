@@ -17,6 +17,7 @@
 #pragma once
 
 #include <optional>
+#include <utility>
 
 #include "task.hpp"
 
@@ -39,7 +40,7 @@ class Channel {
 
     Task<void> send(T value) {
         try {
-            co_await channel_.async_send(boost::system::error_code(), value, boost::asio::use_awaitable);
+            co_await channel_.async_send(boost::system::error_code(), std::move(value), boost::asio::use_awaitable);
         } catch (const boost::system::system_error& ex) {
             if (ex.code() == boost::asio::experimental::error::channel_cancelled) {
                 throw boost::system::system_error(make_error_code(boost::system::errc::operation_canceled));
@@ -49,7 +50,7 @@ class Channel {
     }
 
     bool try_send(T value) {
-        return channel_.try_send(boost::system::error_code(), value);
+        return channel_.try_send(boost::system::error_code(), std::move(value));
     }
 
     Task<T> receive() {
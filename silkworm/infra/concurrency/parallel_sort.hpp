@@ -0,0 +1,111 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include <silkworm/infra/concurrency/thread_pool.hpp>
+
+namespace silkworm {
+
+//! \brief Minimum number of elements each thread of parallel_sort shall be given, below this sorting is sequential
+inline constexpr size_t kMinParallelSortChunk{16'384};
+
+//! \brief The pool shared by all parallel_sort calls not given their own, created on first use
+inline ThreadPool& parallel_sort_pool() {
+    static ThreadPool pool{std::max(std::thread::hardware_concurrency(), 2u) - 1};
+    return pool;
+}
+
+//! \brief Sorts the range [first, last) splitting it into chunks sorted by different threads, then merging the sorted
+//! chunks pairwise in parallel rounds
+//! \param workers : the pool running all chunks but one, never called from one of its threads to avoid starving it
+//! \param num_threads : max number of threads to use, including the calling one (0 means pool size plus one)
+//! \remarks Not stable. The calling thread takes part in the work and returns when the whole range is sorted
+template <std::random_access_iterator It, typename Compare = std::less<>>
+void parallel_sort(ThreadPool& workers, It first, It last, Compare comp = {}, size_t num_threads = 0) {
+    const auto size{static_cast<size_t>(std::distance(first, last))};
+    const size_t max_threads{size_t{workers.get_thread_count()} + 1};
+    num_threads = num_threads == 0 ? max_threads : std::min(num_threads, max_threads);
+    const size_t num_chunks{std::min(num_threads, size / kMinParallelSortChunk)};
+    if (num_chunks <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    // Chunk boundaries: chunk i is [bounds[i], bounds[i + 1])
+    std::vector<It> bounds;
+    bounds.reserve(num_chunks + 1);
+    for (size_t i{0}; i < num_chunks; ++i) {
+        bounds.push_back(first + static_cast<std::ptrdiff_t>(i * size / num_chunks));
+    }
+    bounds.push_back(last);
+
+    // Run one task per item on the pool except the first one, executed here. Pool tasks refer to this frame, so all
+    // of them are waited for before any error is rethrown
+    const auto run_all = [&workers](size_t count, const auto& task) {
+        std::vector<std::future<void>> futures;
+        futures.reserve(count);
+        for (size_t i{1}; i < count; ++i) {
+            futures.push_back(workers.submit(task, i));
+        }
+        std::exception_ptr error;
+        try {
+            task(0);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        for (auto& future : futures) {
+            try {
+                future.get();
+            } catch (...) {
+                if (!error) error = std::current_exception();
+            }
+        }
+        if (error) std::rethrow_exception(error);
+    };
+
+    run_all(num_chunks, [&](size_t i) { std::sort(bounds[i], bounds[i + 1], comp); });
+
+    // Each round merges adjacent sorted runs, halving their number
+    for (size_t width{1}; width < num_chunks; width *= 2) {
+        const size_t num_merges{(num_chunks + 2 * width - 1) / (2 * width)};
+        run_all(num_merges, [&](size_t i) {
+            const size_t begin{2 * width * i};
+            const size_t middle{std::min(begin + width, num_chunks)};
+            const size_t end{std::min(begin + 2 * width, num_chunks)};
+            if (middle < end) {
+                std::inplace_merge(bounds[begin], bounds[middle], bounds[end], comp);
+            }
+        });
+    }
+}
+
+//! \brief Sorts the range [first, last) in parallel on the shared parallel_sort_pool
+template <std::random_access_iterator It, typename Compare = std::less<>>
+void parallel_sort(It first, It last, Compare comp = {}, size_t num_threads = 0) {
+    parallel_sort(parallel_sort_pool(), first, last, comp, num_threads);
+}
+
+}  // namespace silkworm
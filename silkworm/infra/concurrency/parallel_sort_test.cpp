@@ -0,0 +1,77 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "parallel_sort.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+static std::vector<uint64_t> random_numbers(size_t count) {
+    std::mt19937_64 generator{42};
+    std::vector<uint64_t> numbers(count);
+    std::generate(numbers.begin(), numbers.end(), [&]() { return generator() % (count / 2 + 1); });
+    return numbers;
+}
+
+TEST_CASE("parallel_sort", "[silkworm][infra][concurrency][parallel_sort]") {
+    for (const size_t count : {size_t{0}, size_t{1}, size_t{1'000}, kMinParallelSortChunk * 5 + 3}) {
+        for (const size_t num_threads : {size_t{1}, size_t{2}, size_t{3}, size_t{8}}) {
+            SECTION("count: " + std::to_string(count) + " threads: " + std::to_string(num_threads)) {
+                auto numbers{random_numbers(count)};
+                auto expected{numbers};
+                std::sort(expected.begin(), expected.end());
+
+                parallel_sort(numbers.begin(), numbers.end(), std::less<>{}, num_threads);
+                CHECK(numbers == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("parallel_sort with custom comparator", "[silkworm][infra][concurrency][parallel_sort]") {
+    auto numbers{random_numbers(kMinParallelSortChunk * 4)};
+    parallel_sort(numbers.begin(), numbers.end(), std::greater<>{}, 4);
+    CHECK(std::is_sorted(numbers.begin(), numbers.end(), std::greater<>{}));
+}
+
+TEST_CASE("parallel_sort on given pool", "[silkworm][infra][concurrency][parallel_sort]") {
+    ThreadPool workers{2};
+    for (size_t run{0}; run < 3; ++run) {
+        auto numbers{random_numbers(kMinParallelSortChunk * 4 + run)};
+        parallel_sort(workers, numbers.begin(), numbers.end());
+        CHECK(std::is_sorted(numbers.begin(), numbers.end()));
+    }
+}
+
+TEST_CASE("parallel_sort waits for all chunks before rethrowing", "[silkworm][infra][concurrency][parallel_sort]") {
+    ThreadPool workers{3};
+    auto numbers{random_numbers(kMinParallelSortChunk * 4)};
+    const auto throwing_less = [](uint64_t a, uint64_t b) {
+        if (a == 0 || b == 0) throw std::runtime_error{"zero"};
+        return a < b;
+    };
+    CHECK_THROWS_AS(parallel_sort(workers, numbers.begin(), numbers.end(), throwing_less), std::runtime_error);
+}
+
+}  // namespace silkworm
@@ -32,6 +32,7 @@
 #include <silkworm/infra/common/directories.hpp>
 #include <silkworm/node/db/mdbx.hpp>
 #include <silkworm/node/db/prune_mode.hpp>
+#include <silkworm/node/etl/util.hpp>
 
 namespace silkworm {
 
@@ -44,6 +45,7 @@ struct NodeSettings {
     std::optional<ChainConfig> chain_config;               // Chain config
     size_t batch_size{512_Mebi};                           // Batch size to use in stages
     size_t etl_buffer_size{256_Mebi};                      // Buffer size for ETL operations
+    etl::SpillCompression etl_spill_compression{};         // Format of ETL temporary files
     std::vector<std::string> remote_sentry_addresses;      // Remote Sentry API addresses (host:port,host2:port2,...)
     bool fake_pow{false};                                  // Whether to verify Proof-of-Work (PoW)
     std::optional<evmc::address> etherbase{std::nullopt};  // Coinbase address (PoW only)
@@ -52,6 +54,10 @@ struct NodeSettings {
     uint32_t sync_loop_log_interval_seconds{30};           // Interval for sync loop to emit logs
     std::string node_name;                                 // The node identifying name
     bool parallel_fork_tracking_enabled{false};            // Whether to track multiple parallel forks at head
+    bool parallel_execution_enabled{false};                // Whether to execute block transactions in parallel
+    bool execution_pipeline_enabled{false};                // Whether to overlap block reads, execution and flushes
+    uint32_t execution_prefetch_blocks{0};                 // Upcoming blocks whose state is prefetched (0 = none)
+    uint32_t trie_regeneration_threads{1};                 // Threads building subtries on full trie regeneration
 };
 
 }  // namespace silkworm
@@ -966,7 +966,6 @@ void write_last_finalized_block(RWTxn& txn, const evmc::bytes32& hash) {
 }
 
 void DataModel::set_snapshot_repository(snapshot::SnapshotRepository* repository) {
-    ensure(repository, "DataModel::set_snapshot_repository: repository is null");
     repository_ = repository;
 }
 
@@ -1215,13 +1214,8 @@ std::optional<BlockHeader> DataModel::read_header_from_snapshot(BlockNum height)
         return {};
     }
 
-    std::optional<BlockHeader> block_header;
     // We know the header snapshot in advance: find it based on target block number
-    const auto header_snapshot = repository_->find_header_segment(height);
-    if (header_snapshot) {
-        block_header = header_snapshot->header_by_number(height);
-    }
-    return block_header;
+    return repository_->header_by_number(height);
 }
 
 std::optional<BlockHeader> DataModel::read_header_from_snapshot(const Hash& hash) {
@@ -1244,10 +1238,7 @@ bool DataModel::read_body_from_snapshot(BlockNum height, bool read_senders, Bloc
     }
 
     // We know the body snapshot in advance: find it based on target block number
-    const auto body_snapshot = repository_->find_body_segment(height);
-    if (!body_snapshot) return false;
-
-    auto stored_body = body_snapshot->body_by_number(height);
+    auto stored_body = repository_->body_by_number(height);
     if (!stored_body) return false;
 
     // Skip first and last *system transactions* in block body
@@ -1270,13 +1261,8 @@ bool DataModel::is_body_in_snapshot(BlockNum height) {
     }
 
     // We know the body snapshot in advance: find it based on target block number
-    const auto body_snapshot = repository_->find_body_segment(height);
-    if (body_snapshot) {
-        const auto stored_body = body_snapshot->body_by_number(height);
-        return stored_body.has_value();
-    }
-
-    return false;
+    const auto stored_body = repository_->body_by_number(height);
+    return stored_body.has_value();
 }
 
 bool DataModel::read_transactions_from_snapshot(BlockNum height, uint64_t base_txn_id, uint64_t txn_count,
@@ -1286,20 +1272,17 @@ bool DataModel::read_transactions_from_snapshot(BlockNum height, uint64_t base_t
         return true;
     }
 
-    const auto tx_snapshot = repository_->find_tx_segment(height);
-    if (!tx_snapshot) return false;
+    auto transactions = repository_->txn_range(height, base_txn_id, txn_count, read_senders);
+    if (!transactions) return false;
 
-    txs = tx_snapshot->txn_range(base_txn_id, txn_count, read_senders);
+    txs = std::move(*transactions);
 
     return true;
 }
 
 bool DataModel::read_rlp_transactions_from_snapshot(BlockNum height, std::vector<Bytes>& rlp_txs) {
-    const auto body_snapshot = repository_->find_body_segment(height);
-    if (body_snapshot) {
-        auto stored_body = body_snapshot->body_by_number(height);
-        if (!stored_body) return false;
-
+    const auto stored_body = repository_->body_by_number(height);
+    if (stored_body) {
         // Skip first and last *system transactions* in block body
         const auto base_txn_id{stored_body->base_txn_id + 1};
         const auto txn_count{stored_body->txn_count >= 2 ? stored_body->txn_count - 2 : stored_body->txn_count};
@@ -1325,6 +1308,7 @@ bool DataModel::read_rlp_transactions(BlockNum height, const evmc::bytes32& hash
 }
 
 std::optional<BlockNum> DataModel::read_tx_lookup(const evmc::bytes32& tx_hash) const {
+    // Recent transactions are the most looked up ones: a single TxLookup seek is far cheaper than probing all snapshots
     auto block_num = read_tx_lookup_from_db(tx_hash);
     if (block_num) {
         return block_num;
@@ -1333,6 +1317,29 @@ std::optional<BlockNum> DataModel::read_tx_lookup(const evmc::bytes32& tx_hash)
     return read_tx_lookup_from_snapshot(tx_hash);
 }
 
+std::vector<std::optional<BlockNum>> DataModel::read_tx_lookups(std::span<const evmc::bytes32> tx_hashes) const {
+    std::vector<std::optional<BlockNum>> block_nums;
+    block_nums.reserve(tx_hashes.size());
+    std::vector<Hash> missing_hashes;
+    for (const auto& tx_hash : tx_hashes) {
+        block_nums.push_back(read_tx_lookup_from_db(tx_hash));
+        if (!block_nums.back()) {
+            missing_hashes.emplace_back(tx_hash);
+        }
+    }
+    if (!repository_ || missing_hashes.empty()) {
+        return block_nums;
+    }
+
+    const auto snapshot_block_nums{repository_->find_block_numbers(missing_hashes)};
+    for (std::size_t i{0}, j{0}; i < block_nums.size(); ++i) {
+        if (!block_nums[i]) {
+            block_nums[i] = snapshot_block_nums[j++];
+        }
+    }
+    return block_nums;
+}
+
 std::optional<BlockNum> DataModel::read_tx_lookup_from_db(const evmc::bytes32& tx_hash) const {
     auto cursor = txn_.ro_cursor(table::kTxLookup);
     auto data{cursor->find(to_slice(tx_hash), /*throw_notfound = */ false)};
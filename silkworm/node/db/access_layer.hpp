@@ -252,6 +252,7 @@ void write_last_finalized_block(RWTxn& txn, const evmc::bytes32& hash);
 
 class DataModel {
   public:
+    //! Set the snapshot repository to read frozen blocks from, nullptr to read just from the database
     static void set_snapshot_repository(snapshot::SnapshotRepository* repository);
 
     explicit DataModel(db::ROTxn& txn);
@@ -320,8 +321,14 @@ class DataModel {
     //! Read the RLP encoded block transactions at specified height
     [[nodiscard]] bool read_rlp_transactions(BlockNum height, const evmc::bytes32& hash, std::vector<Bytes>& rlp_txs) const;
 
+    //! Read the number of the block containing the specified transaction
+    //! \details TxLookup table has just post-snapshot transactions, frozen ones are looked up in snapshot indexes on a miss
     [[nodiscard]] std::optional<BlockNum> read_tx_lookup(const evmc::bytes32& tx_hash) const;
 
+    //! Read the numbers of the blocks containing the specified transactions, the same as read_tx_lookup for each hash
+    //! \details Transactions missing in TxLookup table are looked up in snapshot indexes all together
+    [[nodiscard]] std::vector<std::optional<BlockNum>> read_tx_lookups(std::span<const evmc::bytes32> tx_hashes) const;
+
     //! Read total difficulty at specified height
     [[nodiscard]] std::optional<intx::uint256> read_total_difficulty(BlockNum height, const evmc::bytes32& hash) const;
     [[nodiscard]] std::optional<intx::uint256> read_total_difficulty(BlockNum, HashAsArray hash) const;
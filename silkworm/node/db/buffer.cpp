@@ -266,7 +266,9 @@ void Buffer::write_state_to_db() {
             incarnation_table.upsert(to_slice(address), to_slice(data));
             written_size += kAddressLength + kIncarnationLength;
         }
-        incarnations_.clear();
+        if (!retain_state_) {
+            incarnations_.clear();
+        }
         total_written_size += written_size;
         if (should_trace) {
             auto [_, duration]{sw.lap()};
@@ -281,7 +283,9 @@ void Buffer::write_state_to_db() {
             code_table.upsert(to_slice(entry.first), to_slice(entry.second));
             written_size += kHashLength + entry.second.length();
         }
-        hash_to_code_.clear();
+        if (!retain_state_) {
+            hash_to_code_.clear();
+        }
         total_written_size += written_size;
         if (should_trace) {
             auto [_, duration]{sw.lap()};
@@ -329,7 +333,9 @@ void Buffer::write_state_to_db() {
                 state_table->upsert(key, to_slice(encoded));
                 written_size += kAddressLength + encoded.length();
             }
-            accounts_.erase(it);
+            if (!retain_state_) {
+                accounts_.erase(it);
+            }
         }
 
         if (auto it{storage_.find(address)}; it != storage_.end()) {
@@ -340,7 +346,9 @@ void Buffer::write_state_to_db() {
                     written_size += prefix.length() + kLocationLength + kHashLength;
                 }
             }
-            storage_.erase(it);
+            if (!retain_state_) {
+                storage_.erase(it);
+            }
         }
     }
     total_written_size += written_size;
@@ -455,7 +463,7 @@ std::optional<intx::uint256> Buffer::total_difficulty(uint64_t block_number,
     if (auto it{difficulty_.find(key)}; it != difficulty_.end()) {
         return it->second;
     }
-    return db::read_total_difficulty(txn_, key);
+    return db::read_total_difficulty(read_txn_, key);
 }
 
 std::optional<BlockHeader> Buffer::read_header(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept {
@@ -479,7 +487,12 @@ std::optional<Account> Buffer::read_account(const evmc::address& address) const
     if (auto it{accounts_.find(address)}; it != accounts_.end()) {
         return it->second;
     }
-    auto db_account{db::read_account(txn_, address, historical_block_)};
+    std::optional<Account> db_account;
+    if (auto previous_account{find_in_previous([&](const Buffer& buffer) { return buffer.find_account(address); })}) {
+        db_account = *previous_account;
+    } else {
+        db_account = db::read_account(read_txn_, address, historical_block_);
+    }
     accounts_[address] = db_account;
     batch_state_size_ += kAddressLength + db_account.value_or(Account()).encoding_length_for_storage();
     return db_account;
@@ -489,7 +502,10 @@ ByteView Buffer::read_code(const evmc::bytes32& code_hash) const noexcept {
     if (auto it{hash_to_code_.find(code_hash)}; it != hash_to_code_.end()) {
         return it->second;
     }
-    std::optional<ByteView> code{db::read_code(txn_, code_hash)};
+    std::optional<ByteView> code{find_in_previous([&](const Buffer& buffer) { return buffer.find_code(code_hash); })};
+    if (!code) {
+        code = db::read_code(read_txn_, code_hash);
+    }
     if (code.has_value()) {
         return *code;
     } else {
@@ -509,20 +525,77 @@ evmc::bytes32 Buffer::read_storage(const evmc::address& address, uint64_t incarn
             }
         }
     }
-    auto db_storage{db::read_storage(txn_, address, incarnation, location, historical_block_)};
+    std::optional<evmc::bytes32> previous_storage{find_in_previous(
+        [&](const Buffer& buffer) { return buffer.find_storage(address, incarnation, location); })};
+    auto db_storage{previous_storage ? *previous_storage
+                                     : db::read_storage(read_txn_, address, incarnation, location, historical_block_)};
     storage_[address][incarnation][location] = db_storage;
     batch_state_size_ += payload_length;
     return db_storage;
 }
 
+bool Buffer::warm_account(const evmc::address& address, const std::optional<Account>& account) {
+    if (!accounts_.try_emplace(address, account).second) {
+        return false;
+    }
+    batch_state_size_ += kAddressLength + account.value_or(Account()).encoding_length_for_storage();
+    return true;
+}
+
+bool Buffer::warm_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                          const evmc::bytes32& value) {
+    if (!storage_[address][incarnation].try_emplace(location, value).second) {
+        return false;
+    }
+    batch_state_size_ += kAddressLength + kIncarnationLength + kLocationLength + kHashLength;
+    return true;
+}
+
 uint64_t Buffer::previous_incarnation(const evmc::address& address) const noexcept {
     if (auto it{incarnations_.find(address)}; it != incarnations_.end()) {
         return it->second;
     }
-    std::optional<uint64_t> incarnation{db::read_previous_incarnation(txn_, address, historical_block_)};
+    std::optional<uint64_t> incarnation{
+        find_in_previous([&](const Buffer& buffer) { return buffer.find_incarnation(address); })};
+    if (!incarnation) {
+        incarnation = db::read_previous_incarnation(read_txn_, address, historical_block_);
+    }
     return incarnation.value_or(0);
 }
 
+std::optional<std::optional<Account>> Buffer::find_account(const evmc::address& address) const {
+    if (auto it{accounts_.find(address)}; it != accounts_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+std::optional<evmc::bytes32> Buffer::find_storage(const evmc::address& address, uint64_t incarnation,
+                                                  const evmc::bytes32& location) const {
+    if (auto it1{storage_.find(address)}; it1 != storage_.end()) {
+        if (auto it2{it1->second.find(incarnation)}; it2 != it1->second.end()) {
+            if (auto it3{it2->second.find(location)}; it3 != it2->second.end()) {
+                return it3->second;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<uint64_t> Buffer::find_incarnation(const evmc::address& address) const {
+    if (auto it{incarnations_.find(address)}; it != incarnations_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+std::optional<ByteView> Buffer::find_code(const evmc::bytes32& code_hash) const {
+    if (auto it{hash_to_code_.find(code_hash)}; it != hash_to_code_.end()) {
+        return ByteView{it->second};
+    }
+    return std::nullopt;
+}
+
 void Buffer::unwind_state_changes(uint64_t) {
     throw std::runtime_error(std::string(__FUNCTION__).append(" not yet implemented"));
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <initializer_list>
 #include <optional>
 #include <vector>
 
@@ -40,7 +41,21 @@ class Buffer : public State {
     // txn must be valid (its handle != nullptr)
     explicit Buffer(RWTxn& txn, BlockNum prune_history_threshold,
                     std::optional<BlockNum> historical_block = std::nullopt)
-        : txn_{txn}, access_layer_{txn_}, prune_history_threshold_{prune_history_threshold}, historical_block_{historical_block} {}
+        : txn_{txn}, read_txn_{txn}, access_layer_{read_txn_}, prune_history_threshold_{prune_history_threshold}, historical_block_{historical_block} {}
+
+    //! \brief Buffer reading from a read-only txn possibly owned by another thread than the one writing through txn
+    //! \param previous a Buffer whose state is not visible to read_txn yet (nullptr if none): it must retain its state
+    //! on write and outlive the reads of this Buffer. Only its own state is looked up, not the one of its previous
+    //! \remarks Used to overlap the execution of a batch with the flush of the previous one
+    Buffer(RWTxn& txn, ROTxn& read_txn, const Buffer* previous, BlockNum prune_history_threshold)
+        : txn_{txn}, read_txn_{read_txn}, access_layer_{read_txn_}, prune_history_threshold_{prune_history_threshold}, previous_{previous} {}
+
+    //! \brief Buffer reading the state of source (and of its previous) first, then through its own read-only txn
+    //! \details Many such Buffers can read the same source concurrently without locking, one per thread: source must
+    //! not change and must outlive the reads of this Buffer, read_txn must see the same db snapshot as the one of source
+    //! \remarks Used by parallel execution workers to read the state at the beginning of a block
+    Buffer(const Buffer& source, ROTxn& read_txn)
+        : txn_{source.txn_}, read_txn_{read_txn}, access_layer_{read_txn_}, prune_history_threshold_{source.prune_history_threshold_}, historical_block_{source.historical_block_}, previous_{&source}, previous_of_previous_{source.previous_} {}
 
     /** @name Readers */
     //!@{
@@ -105,6 +120,19 @@ class Buffer : public State {
 
     //!@}
 
+    /** @name Prefetching
+     *  Cache state values read from db elsewhere unless already known, i.e. they must be up-to-date with respect to
+     *  what this Buffer has not persisted yet. Return true if the value has been cached.
+     */
+    //!@{
+
+    bool warm_account(const evmc::address& address, const std::optional<Account>& account);
+
+    bool warm_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                      const evmc::bytes32& value);
+
+    //!@}
+
     //! Account (backward) changes per block
     [[nodiscard]] const absl::btree_map<uint64_t, AccountChanges>& account_changes() const {
         return block_account_changes_;
@@ -130,14 +158,42 @@ class Buffer : public State {
     //! @param write_change_sets flag indicating if state changes should be written or not (default: true)
     void write_history_to_db(bool write_change_sets = true);
 
+    //! \brief Keep the state in memory after persisting it, so that it can still be read by a subsequent Buffer
+    void retain_state_on_write() noexcept { retain_state_ = true; }
+
   private:
     //! \brief Persists *state* accrued contents into db
     void write_state_to_db();
 
+    //! \brief Lookups into the accrued state only, neither touching the db nor changing anything
+    [[nodiscard]] std::optional<std::optional<Account>> find_account(const evmc::address& address) const;
+    [[nodiscard]] std::optional<evmc::bytes32> find_storage(const evmc::address& address, uint64_t incarnation,
+                                                            const evmc::bytes32& location) const;
+    [[nodiscard]] std::optional<uint64_t> find_incarnation(const evmc::address& address) const;
+    [[nodiscard]] std::optional<ByteView> find_code(const evmc::bytes32& code_hash) const;
+
+    //! \brief Lookup into the accrued state of the Buffers not visible to read_txn_ yet, the most recent first
+    template <typename Find>
+    auto find_in_previous(Find find) const -> decltype(find(*this)) {
+        for (const Buffer* buffer : {previous_, previous_of_previous_}) {
+            if (!buffer) {
+                break;
+            }
+            if (auto found{find(*buffer)}) {
+                return found;
+            }
+        }
+        return std::nullopt;
+    }
+
     RWTxn& txn_;
+    ROTxn& read_txn_;
     db::DataModel access_layer_;
     uint64_t prune_history_threshold_;
     std::optional<uint64_t> historical_block_{};
+    const Buffer* previous_{nullptr};
+    const Buffer* previous_of_previous_{nullptr};  // Set only for readers of another Buffer
+    bool retain_state_{false};
 
     absl::btree_map<Bytes, BlockHeader> headers_{};
     absl::btree_map<Bytes, BlockBody> bodies_{};
@@ -179,4 +179,47 @@ TEST_CASE("Account update") {
     }
 }
 
+TEST_CASE("Buffer on top of previous") {
+    test_util::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+    auto& txn{context.rw_txn()};
+
+    const auto address_a{0xbe00000000000000000000000000000000000000_address};
+    const auto address_b{0xbf00000000000000000000000000000000000000_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000013_bytes32};
+    const auto value{0x000000000000000000000000000000000000000000000000000000000000006b_bytes32};
+
+    Account account_a;
+    account_a.balance = 1;
+    Account account_b;
+    account_b.balance = 2;
+    account_b.incarnation = kDefaultIncarnation;
+
+    // account_b is in the db, previous deletes it and creates account_a with some storage
+    Buffer db_buffer{txn, 0};
+    db_buffer.begin_block(1);
+    db_buffer.update_account(address_b, /*initial=*/std::nullopt, account_b);
+    db_buffer.write_to_db();
+
+    Buffer previous{txn, 0};
+    previous.begin_block(2);
+    previous.update_account(address_a, /*initial=*/std::nullopt, account_a);
+    previous.update_storage(address_a, kDefaultIncarnation, location, /*initial=*/{}, /*current=*/value);
+    previous.update_account(address_b, /*initial=*/account_b, std::nullopt);
+    previous.retain_state_on_write();
+
+    Buffer buffer{txn, txn, &previous, 0};
+    CHECK(buffer.read_account(address_a) == account_a);
+    CHECK(buffer.read_storage(address_a, kDefaultIncarnation, location) == value);
+    CHECK_FALSE(buffer.read_account(address_b));
+    CHECK(buffer.previous_incarnation(address_b) == kDefaultIncarnation);
+
+    // Retained state is still readable after having been persisted
+    previous.write_to_db();
+    CHECK(buffer.read_account(address_a) == account_a);
+    Buffer next{txn, txn, &previous, 0};
+    CHECK(next.read_storage(address_a, kDefaultIncarnation, location) == value);
+    CHECK_FALSE(next.read_account(address_b));
+}
+
 }  // namespace silkworm::db
@@ -0,0 +1,149 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_prefetcher.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/node/db/access_layer.hpp>
+
+namespace silkworm::db {
+
+StatePrefetcher::StatePrefetcher(mdbx::env env, ThreadPool& thread_pool)
+    : env_{std::move(env)}, thread_pool_{thread_pool}, generation_{std::make_shared<std::atomic_uint64_t>(0)} {}
+
+StatePrefetcher::~StatePrefetcher() {
+    cancel();
+}
+
+void StatePrefetcher::prefetch(const Block& block) {
+    Keys keys{collect_keys(block)};
+    if (keys.empty()) {
+        return;
+    }
+    pending_.push_back(thread_pool_.submit([env = env_, keys = std::move(keys), generation = generation_,
+                                            expected_generation = generation_->load()]() -> Result {
+        if (*generation != expected_generation) {
+            return {};  // Cancelled before even starting
+        }
+        return read(env, keys);
+    }));
+}
+
+size_t StatePrefetcher::warm(Buffer& buffer) {
+    using namespace std::chrono_literals;
+    size_t warmed{0};
+    while (!pending_.empty() && pending_.front().wait_for(0s) == std::future_status::ready) {
+        Result result;
+        try {
+            result = pending_.front().get();
+        } catch (const std::exception& ex) {
+            // Prefetching is just an optimization, execution will read what is missing anyway
+            log::Warning("StatePrefetcher", {"exception", std::string(ex.what())});
+        }
+        pending_.pop_front();
+
+        for (const auto& [address, account] : result.accounts) {
+            warmed += buffer.warm_account(address, account) ? 1 : 0;
+        }
+        for (const auto& [address, incarnation, location, value] : result.storage) {
+            warmed += buffer.warm_storage(address, incarnation, location, value) ? 1 : 0;
+        }
+    }
+    return warmed;
+}
+
+void StatePrefetcher::wait() {
+    for (const auto& result : pending_) {
+        result.wait();
+    }
+}
+
+void StatePrefetcher::cancel() {
+    ++*generation_;
+    // Pending helpers only own copies of what they need, so their results can be dropped right away
+    pending_.clear();
+}
+
+void StatePrefetcher::learn(const StorageChanges& block_storage_changes) {
+    for (const auto& [address, incarnations] : block_storage_changes) {
+        if (hot_slots_.size() >= kMaxHotAccounts && !hot_slots_.contains(address)) {
+            hot_slots_.clear();  // Access patterns drift over time, just start over
+        }
+        auto& slots{hot_slots_[address]};
+        for (const auto& [_, locations] : incarnations) {
+            for (auto it{locations.cbegin()}; it != locations.cend() && slots.size() < kMaxHotSlotsPerAccount; ++it) {
+                if (std::find(slots.cbegin(), slots.cend(), it->first) == slots.cend()) {
+                    slots.push_back(it->first);
+                }
+            }
+        }
+    }
+}
+
+StatePrefetcher::Keys StatePrefetcher::collect_keys(const Block& block) const {
+    Keys keys;
+    const auto add_account{[&](const evmc::address& address) {
+        auto [it, inserted]{keys.try_emplace(address)};
+        if (inserted) {
+            if (const auto hot_it{hot_slots_.find(address)}; hot_it != hot_slots_.end()) {
+                it->second = hot_it->second;
+            }
+        }
+        return it;
+    }};
+
+    add_account(block.header.beneficiary);
+    for (const auto& txn : block.transactions) {
+        if (txn.from) {
+            add_account(*txn.from);
+        }
+        if (txn.to) {
+            add_account(*txn.to);
+        }
+        for (const auto& entry : txn.access_list) {
+            auto& slots{add_account(entry.account)->second};
+            for (const auto& location : entry.storage_keys) {
+                if (std::find(slots.cbegin(), slots.cend(), location) == slots.cend()) {
+                    slots.push_back(location);
+                }
+            }
+        }
+    }
+    return keys;
+}
+
+StatePrefetcher::Result StatePrefetcher::read(mdbx::env env, const Keys& keys) {
+    Result result;
+    result.accounts.reserve(keys.size());
+
+    ROTxnManaged txn{env};
+    for (const auto& [address, locations] : keys) {
+        auto account{read_account(txn, address)};
+        if (account && account->incarnation > 0) {
+            for (const auto& location : locations) {
+                result.storage.emplace_back(address, account->incarnation, location,
+                                            read_storage(txn, address, account->incarnation, location));
+            }
+        }
+        result.accounts.emplace_back(address, std::move(account));
+    }
+    return result;
+}
+
+}  // namespace silkworm::db
@@ -0,0 +1,95 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <silkworm/core/types/account.hpp>
+#include <silkworm/core/types/block.hpp>
+#include <silkworm/infra/concurrency/thread_pool.hpp>
+#include <silkworm/node/db/buffer.hpp>
+#include <silkworm/node/db/mdbx.hpp>
+#include <silkworm/node/db/util.hpp>
+
+namespace silkworm::db {
+
+//! \brief StatePrefetcher reads from helper threads the accounts and storage slots likely touched by upcoming blocks
+//! so that they can be cached into a Buffer before execution, instead of being read cold one key at a time
+//! \details Candidates are senders, recipients, beneficiaries and EIP-2930 access lists plus the storage slots which
+//! recently executed blocks have changed in the same accounts
+//! \remarks Prefetched values are read on fresh read-only txns, hence they are valid for a Buffer as long as no state
+//! has been persisted (and committed) since the Buffer creation: cancel() must be called when it is not the case
+class StatePrefetcher {
+  public:
+    static constexpr size_t kMaxHotAccounts{4096};
+    static constexpr size_t kMaxHotSlotsPerAccount{64};
+
+    StatePrefetcher(mdbx::env env, ThreadPool& thread_pool);
+    ~StatePrefetcher();
+
+    // Not copyable nor movable
+    StatePrefetcher(const StatePrefetcher&) = delete;
+    StatePrefetcher& operator=(const StatePrefetcher&) = delete;
+
+    //! \brief Starts reading in background the state statically known to be touched by the given block
+    void prefetch(const Block& block);
+
+    //! \brief Caches into buffer the prefetched values available so far without waiting for the others
+    //! \return the number of accounts and storage slots newly cached
+    size_t warm(Buffer& buffer);
+
+    //! \brief Waits for all the outstanding reads to complete
+    void wait();
+
+    //! \brief Drops all the outstanding reads and their results
+    void cancel();
+
+    //! \brief Remembers the storage slots changed by an executed block as likely to be touched again
+    //! \remarks Storage changes come from the history of executed blocks, so there are none to learn from when it's pruned
+    void learn(const StorageChanges& block_storage_changes);
+
+  private:
+    //! Accounts to read, each one with the storage slots to read
+    using Keys = absl::flat_hash_map<evmc::address, std::vector<evmc::bytes32>>;
+
+    struct Result {
+        std::vector<std::pair<evmc::address, std::optional<Account>>> accounts;
+        std::vector<std::tuple<evmc::address, uint64_t, evmc::bytes32, evmc::bytes32>> storage;
+    };
+
+    [[nodiscard]] Keys collect_keys(const Block& block) const;
+
+    static Result read(mdbx::env env, const Keys& keys);
+
+    mdbx::env env_;
+    ThreadPool& thread_pool_;
+    std::deque<std::future<Result>> pending_;
+    std::shared_ptr<std::atomic_uint64_t> generation_;  // Bumped on cancel to let helpers skip stale work
+    absl::flat_hash_map<evmc::address, std::vector<evmc::bytes32>> hot_slots_;
+};
+
+}  // namespace silkworm::db
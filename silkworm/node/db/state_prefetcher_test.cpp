@@ -0,0 +1,108 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_prefetcher.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/types/evmc_bytes32.hpp>
+#include <silkworm/infra/test_util/log.hpp>
+#include <silkworm/node/test/context.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("StatePrefetcher") {
+    test_util::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+    auto& txn{context.rw_txn()};
+
+    const auto sender{0xbe00000000000000000000000000000000000000_address};
+    const auto contract{0xbf00000000000000000000000000000000000000_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000013_bytes32};
+    const auto value{0x000000000000000000000000000000000000000000000000000000000000006b_bytes32};
+
+    Account sender_account;
+    sender_account.balance = 1;
+    Account contract_account;
+    contract_account.incarnation = kDefaultIncarnation;
+
+    Buffer db_buffer{txn, 0};
+    db_buffer.begin_block(1);
+    db_buffer.update_account(sender, /*initial=*/std::nullopt, sender_account);
+    db_buffer.update_account(contract, /*initial=*/std::nullopt, contract_account);
+    db_buffer.update_storage(contract, kDefaultIncarnation, location, /*initial=*/{}, /*current=*/value);
+    db_buffer.write_to_db();
+    context.commit_and_renew_txn();
+
+    Block block;
+    block.transactions.resize(1);
+    block.transactions[0].from = sender;
+    block.transactions[0].access_list = {{contract, {location}}};
+
+    ThreadPool thread_pool{2};
+    StatePrefetcher prefetcher{context.env(), thread_pool};
+
+    SECTION("warm buffer with prefetched state") {
+        prefetcher.prefetch(block);
+        prefetcher.wait();
+
+        Buffer buffer{txn, 0};
+        // Beneficiary (not existing), sender and contract accounts plus contract storage
+        CHECK(prefetcher.warm(buffer) == 4);
+        CHECK(buffer.current_batch_state_size() > 0);
+        CHECK(buffer.read_account(sender) == sender_account);
+        CHECK(buffer.read_storage(contract, kDefaultIncarnation, location) == value);
+    }
+
+    SECTION("do not override buffered state") {
+        Account updated_account{sender_account};
+        updated_account.balance = 2;
+        Buffer buffer{txn, 0};
+        buffer.begin_block(2);
+        buffer.update_account(sender, sender_account, updated_account);
+
+        prefetcher.prefetch(block);
+        prefetcher.wait();
+        CHECK(prefetcher.warm(buffer) == 3);
+        CHECK(buffer.read_account(sender) == updated_account);
+    }
+
+    SECTION("learn hot slots") {
+        StorageChanges changes;
+        changes[contract][kDefaultIncarnation][location] = Bytes{};
+        prefetcher.learn(changes);
+
+        Block other_block;
+        other_block.transactions.resize(1);
+        other_block.transactions[0].to = contract;
+        prefetcher.prefetch(other_block);
+        prefetcher.wait();
+
+        Buffer buffer{txn, 0};
+        CHECK(prefetcher.warm(buffer) == 3);
+        CHECK(buffer.read_storage(contract, kDefaultIncarnation, location) == value);
+    }
+
+    SECTION("cancel drops outstanding reads") {
+        prefetcher.prefetch(block);
+        prefetcher.cancel();
+
+        Buffer buffer{txn, 0};
+        CHECK(prefetcher.warm(buffer) == 0);
+    }
+}
+
+}  // namespace silkworm::db
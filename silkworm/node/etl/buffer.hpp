@@ -17,9 +17,11 @@
 #pragma once
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 #include <silkworm/core/common/base.hpp>
+#include <silkworm/infra/concurrency/parallel_sort.hpp>
 #include <silkworm/node/etl/util.hpp>
 
 namespace silkworm::etl {
@@ -71,8 +73,15 @@ class Buffer {
     }
 
     void sort() {
-        // Sort buffer in increasing order by key comparison
-        std::sort(buffer_.begin(), buffer_.end());
+        // Sort buffer in increasing order by key comparison, large buffers using multiple threads
+        parallel_sort(buffer_.begin(), buffer_.end());
+    }
+
+    void swap(Buffer& other) noexcept {
+        // Exchange contents with other buffer (e.g. to keep on filling one while the other is flushed)
+        std::swap(optimal_size_, other.optimal_size_);
+        std::swap(size_, other.size_);
+        buffer_.swap(other.buffer_);
     }
 
     [[nodiscard]] size_t size() const noexcept {
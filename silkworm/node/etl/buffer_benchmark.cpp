@@ -0,0 +1,101 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/infra/common/directories.hpp>
+#include <silkworm/node/etl/buffer.hpp>
+#include <silkworm/node/etl/collector.hpp>
+#include <silkworm/node/etl/file_provider.hpp>
+#include <silkworm/node/etl/slab_buffer.hpp>
+
+namespace silkworm::etl {
+
+static constexpr size_t kNumEntries{1'000'000};
+
+//! Entries shaped like those collected by HashState::hash_from_plainstate: hashed address (+ incarnation + hashed
+//! location for storage) as key and RLP-encoded account or storage value as value
+static const std::vector<Entry>& hashed_state_entries() {
+    static const std::vector<Entry> entries{[]() {
+        std::mt19937_64 generator{1};
+        const auto random_bytes{[&](size_t size) {
+            Bytes bytes(size, '\0');
+            for (auto& byte : bytes) {
+                byte = static_cast<uint8_t>(generator());
+            }
+            return bytes;
+        }};
+        std::vector<Entry> v;
+        v.reserve(kNumEntries);
+        for (size_t i{0}; i < kNumEntries; ++i) {
+            if (i % 3 == 0) {
+                v.emplace_back(random_bytes(32), random_bytes(8 + generator() % 64));  // account
+            } else {
+                v.emplace_back(random_bytes(32 + 8 + 32), random_bytes(1 + generator() % 32));  // storage
+            }
+        }
+        return v;
+    }()};
+    return entries;
+}
+
+static size_t memory_usage(const Buffer& buffer) {
+    // Entry vector plus key and value memory allocated outside of small string optimization
+    size_t usage{buffer.entries().capacity() * sizeof(Entry)};
+    for (const auto& entry : buffer.entries()) {
+        usage += entry.key.capacity() > Bytes{}.capacity() ? entry.key.capacity() + 1 : 0;
+        usage += entry.value.capacity() > Bytes{}.capacity() ? entry.value.capacity() + 1 : 0;
+    }
+    return usage;
+}
+
+static size_t memory_usage(const SlabBuffer& buffer) { return buffer.memory_usage(); }
+
+//! Collect, sort and flush to file all the entries (before: Buffer of Entry, after: SlabBuffer)
+template <typename BufferType>
+static void collect_sort_flush(benchmark::State& state) {
+    const auto& entries{hashed_state_entries()};
+    TemporaryDirectory tmp_dir;
+    size_t bytes{0};
+    for (const auto& entry : entries) {
+        bytes += entry.size();
+    }
+
+    size_t peak_memory{0};
+    for ([[maybe_unused]] auto _ : state) {
+        BufferType buffer{kOptimalBufferSize};
+        for (const auto& entry : entries) {
+            buffer.put(entry);
+        }
+        peak_memory = memory_usage(buffer);
+        buffer.sort();
+
+        FileProvider file_provider{(tmp_dir.path() / "buffer.bin").string(), 0};
+        file_provider.create(buffer.size());
+        file_provider.write(buffer);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(entries.size()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(bytes));
+    state.counters["memory/entry"] = static_cast<double>(peak_memory) / static_cast<double>(entries.size());
+}
+
+BENCHMARK_TEMPLATE(collect_sort_flush, Buffer)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(collect_sort_flush, SlabBuffer)->Unit(benchmark::kMillisecond);
+
+}  // namespace silkworm::etl
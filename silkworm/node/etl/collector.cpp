@@ -16,22 +16,30 @@
 
 #include "collector.hpp"
 
+#include <algorithm>
+#include <exception>
 #include <filesystem>
 #include <iomanip>
-#include <queue>
+#include <optional>
 #include <stdexcept>
+#include <vector>
 
 #include <silkworm/infra/common/directories.hpp>
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/common/stopwatch.hpp>
 #include <silkworm/infra/concurrency/signal_handler.hpp>
+#include <silkworm/node/etl/loser_tree.hpp>
 
 namespace silkworm::etl {
 
 namespace fs = std::filesystem;
 
 Collector::~Collector() {
-    clear();  // Will ensure all files (if any) have been orderly closed and deleted
+    try {
+        clear();  // Will ensure all files (if any) have been orderly closed and deleted
+    } catch (const std::exception& ex) {
+        log::Error("ETL collector flush failed", {"error", ex.what()});
+    }
     if (work_path_managed_ && fs::exists(work_path_)) {
         fs::remove_all(work_path_);
     }
@@ -39,57 +47,93 @@ Collector::~Collector() {
 
 void Collector::flush_buffer() {
     if (buffer_.size()) {
-        StopWatch sw(/*auto_start=*/true);
-        buffer_.sort();
+        // Only one flush at a time: the buffer just filled is swapped with the one being flushed
+        wait_for_flush();
+        buffer_.swap(flushing_buffer_);
 
         /* Build a unique file name to pass FileProvider */
         fs::path new_file_path{
             work_path_ / fs::path(std::to_string(unique_id_) + "-" + std::to_string(file_providers_.size()) + ".bin")};
 
-        file_providers_.emplace_back(new FileProvider(new_file_path.string(), file_providers_.size()));
-        file_providers_.back()->flush(buffer_);
-        buffer_.clear();
-        const auto [_, duration]{sw.stop()};
-        log::Info("ETL collector flushed file", {"path", std::string(file_providers_.back()->get_file_name()),
-                                                 "size", human_size(file_providers_.back()->get_file_size()),
-                                                 "in", StopWatch::format(duration)});
+        // File gets created here, so that any disk issue surfaces on the collecting thread
+        file_providers_.emplace_back(new FileProvider(new_file_path.string(), file_providers_.size(), compression_));
+        FileProvider* file_provider{file_providers_.back().get()};
+        file_provider->create(flushing_buffer_.size());
+
+        flush_result_ = std::async(std::launch::async, [this, file_provider]() {
+            StopWatch sw(/*auto_start=*/true);
+            flushing_buffer_.sort();
+            file_provider->write(flushing_buffer_);
+            const size_t raw_size{flushing_buffer_.size()};
+            flushing_buffer_.clear();
+            spilled_size_ += file_provider->get_file_size();
+            const auto [_, duration]{sw.stop()};
+            log::Info("ETL collector flushed file", {"path", std::string(file_provider->get_file_name()),
+                                                     "size", human_size(file_provider->get_file_size()),
+                                                     "raw", human_size(raw_size),
+                                                     "in", StopWatch::format(duration)});
+        });
+    }
+}
+
+void Collector::clear() {
+    // Let pending flush complete before removing its file
+    std::exception_ptr flush_error;
+    if (flush_result_.valid()) {
+        try {
+            flush_result_.get();
+        } catch (...) {
+            flush_error = std::current_exception();
+        }
+    }
+    file_providers_.clear();
+    buffer_.clear();
+    flushing_buffer_.clear();
+    spilled_size_ = 0;
+    size_ = 0;
+    bytes_size_ = 0;
+    if (flush_error) {
+        std::rethrow_exception(flush_error);
+    }
+}
+
+void Collector::wait_for_flush() {
+    if (flush_result_.valid()) {
+        flush_result_.get();
+    }
+}
+
+void Collector::put_into_buffer(ByteView key, ByteView value) {
+    // Flush before appending an entry exceeding the slab, which would otherwise be reallocated (an entry bigger than
+    // the whole slab is still appended to an empty one)
+    if (!buffer_.fits(key.size(), value.size()) && buffer_.entry_count() > 0) {
+        flush_buffer();
     }
+    buffer_.put(key, value);
 }
 
 void Collector::collect(const Entry& entry) {
     ++size_;
     bytes_size_ += entry.size();
-    buffer_.put(entry);
-    if (buffer_.overflows()) {
-        flush_buffer();
-    }
+    put_into_buffer(entry.key, entry.value);
 }
 
 void Collector::collect(Entry&& entry) {
     ++size_;
     bytes_size_ += entry.size();
-    buffer_.put(std::move(entry));
-    if (buffer_.overflows()) {
-        flush_buffer();
-    }
+    put_into_buffer(entry.key, entry.value);
 }
 
 void Collector::collect(const Bytes& key, const Bytes& value) {
     ++size_;
     bytes_size_ += key.size() + value.size();
-    buffer_.put(key, value);
-    if (buffer_.overflows()) {
-        flush_buffer();
-    }
+    put_into_buffer(key, value);
 }
 
 void Collector::collect(Bytes&& key, Bytes&& value) {
     ++size_;
     bytes_size_ += key.size() + value.size();
-    buffer_.put(std::move(key), std::move(value));
-    if (buffer_.overflows()) {
-        flush_buffer();
-    }
+    put_into_buffer(key, value);
 }
 
 void Collector::load(db::RWCursorDupSort& target, const LoadFunc& load_func, MDBX_put_flags_t flags) {
@@ -106,22 +150,27 @@ void Collector::load(db::RWCursorDupSort& target, const LoadFunc& load_func, MDB
     if (file_providers_.empty()) {
         buffer_.sort();
 
-        for (const auto& etl_entry : buffer_.entries()) {
+        Entry etl_entry;  // reused for all entries passed to load_func, so that its memory gets recycled
+        for (size_t i{0}; i < buffer_.entry_count(); ++i) {
+            const ByteView key{buffer_.key(i)};
+            const ByteView value{buffer_.value(i)};
             if (const auto now{std::chrono::steady_clock::now()}; log_time <= now) {
                 if (SignalHandler::signalled()) {
                     throw std::runtime_error("Operation cancelled");
                 }
-                set_loading_key(etl_entry.key);
+                set_loading_key(key);
                 log_time = now + kLogInterval;
             }
             if (load_func) {
+                etl_entry.key.assign(key);
+                etl_entry.value.assign(value);
                 load_func(etl_entry, target, flags);
             } else {
-                mdbx::slice k{db::to_slice(etl_entry.key)};
-                if (etl_entry.value.empty()) {
+                mdbx::slice k{db::to_slice(key)};
+                if (value.empty()) {
                     target.erase(k);
                 } else {
-                    mdbx::slice v{db::to_slice(etl_entry.value)};
+                    mdbx::slice v{db::to_slice(value)};
                     mdbx::error::success_or_throw(target.put(k, &v, flags));
                 }
             }
@@ -133,27 +182,26 @@ void Collector::load(db::RWCursorDupSort& target, const LoadFunc& load_func, MDB
 
     // Flush not overflown buffer data to file
     flush_buffer();
+    wait_for_flush();
 
-    // Define a priority queue based on smallest available key
-    auto key_comparer = [](const std::pair<Entry, size_t>& left, const std::pair<Entry, size_t>& right) {
-        return right.first < left.first;
-    };
-    std::priority_queue<std::pair<Entry, size_t>, std::vector<std::pair<Entry, size_t>>, decltype(key_comparer)> queue(
-        key_comparer);
+    StopWatch load_sw(/*auto_start=*/true);
+    const size_t num_files{file_providers_.size()};
+    const size_t spilled_size{spilled_size_};
 
-    // Read one "record" from each data_provider and let the queue
-    // sort them. On top of the queue the smallest key
+    // Merge the sorted files picking the smallest key among the heads of all files at each step.
+    // Read one "record" from each data_provider to start
+    std::vector<std::optional<Entry>> heads;
+    heads.reserve(file_providers_.size());
     for (auto& file_provider : file_providers_) {
         auto item{file_provider->read_entry()};
-        if (item.has_value()) {
-            queue.push(std::move(*item));
-        }
+        heads.push_back(item ? std::make_optional(std::move(item->first)) : std::nullopt);
     }
+    LoserTree<Entry> tree{std::move(heads)};
 
-    // Process the queue from smallest to largest key
-    while (!queue.empty()) {
-        auto& [etl_entry, provider_index]{queue.top()};           // Pick the smallest key by reference
-        auto& file_provider{file_providers_.at(provider_index)};  // and set current file provider
+    // Process the entries from smallest to largest key
+    while (!tree.empty()) {
+        const auto& etl_entry{tree.top()};                            // Pick the smallest key by reference
+        auto& file_provider{file_providers_.at(tree.top_source())};  // and set current file provider
 
         if (const auto now{std::chrono::steady_clock::now()}; log_time <= now) {
             if (SignalHandler::signalled()) {
@@ -177,21 +225,25 @@ void Collector::load(db::RWCursorDupSort& target, const LoadFunc& load_func, MDB
         }
 
         // From the provider which has served the current key
-        // read next "record"
+        // read next "record" and replace the current one with it
+        // (file provider gets destroyed when exhausted)
         auto next{file_provider->read_entry()};
-
-        // At this point `current` has been processed.
-        // We can remove it from the queue
-        queue.pop();
-
-        // Add next item to the queue only if it has
-        // meaningful data
         if (next.has_value()) {
-            queue.push(std::move(*next));
+            tree.replace_top(std::move(next->first));
         } else {
+            tree.replace_top(std::nullopt);
             file_provider.reset();
         }
     }
+
+    const auto [_, load_duration]{load_sw.stop()};
+    const auto load_seconds{std::max(std::chrono::duration<double>(load_duration).count(), 1e-3)};
+    const auto throughput{static_cast<uint64_t>(static_cast<double>(bytes_size_) / load_seconds)};
+    log::Info("ETL collector loaded files", {"files", std::to_string(num_files),
+                                             "disk", human_size(spilled_size),
+                                             "raw", human_size(bytes_size_ + size_ * sizeof(head_t)),
+                                             "in", StopWatch::format(load_duration),
+                                             "throughput", human_size(throughput) + "/s"});
     clear();
 }
 
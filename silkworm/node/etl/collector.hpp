@@ -16,12 +16,13 @@
 
 #pragma once
 
+#include <future>
 #include <mutex>
 
 #include <silkworm/node/common/settings.hpp>
 #include <silkworm/node/db/mdbx.hpp>
-#include <silkworm/node/etl/buffer.hpp>
 #include <silkworm/node/etl/file_provider.hpp>
+#include <silkworm/node/etl/slab_buffer.hpp>
 #include <silkworm/node/etl/util.hpp>
 
 // ETL : Extract, Transform, Load
@@ -35,6 +36,8 @@ inline constexpr size_t kOptimalBufferSize = 256_Mebi;
 using LoadFunc = std::function<void(const Entry&, db::RWCursorDupSort&, MDBX_put_flags_t)>;
 
 // Collects data Extracted from db
+// When the buffer is full it gets sorted and flushed to file on a background thread, while collection goes on into a
+// second buffer: memory usage can hence reach twice the optimal buffer size
 class Collector {
   public:
     // Not copyable nor movable
@@ -44,11 +47,21 @@ class Collector {
     explicit Collector(const NodeSettings* node_settings)
         : work_path_managed_{false},
           work_path_{set_work_path(node_settings->data_directory->etl().path())},
-          buffer_{node_settings->etl_buffer_size} {};
-    explicit Collector(const std::filesystem::path& work_path, size_t optimal_size = kOptimalBufferSize)
-        : work_path_managed_{false}, work_path_{set_work_path(work_path)}, buffer_{optimal_size} {}
+          buffer_{node_settings->etl_buffer_size},
+          flushing_buffer_{node_settings->etl_buffer_size},
+          compression_{node_settings->etl_spill_compression} {};
+    explicit Collector(const std::filesystem::path& work_path, size_t optimal_size = kOptimalBufferSize,
+                       SpillCompression compression = SpillCompression::kNone)
+        : work_path_managed_{false},
+          work_path_{set_work_path(work_path)},
+          buffer_{optimal_size},
+          flushing_buffer_{optimal_size},
+          compression_{compression} {}
     explicit Collector(size_t optimal_size = kOptimalBufferSize)
-        : work_path_managed_{true}, work_path_{set_work_path(std::nullopt)}, buffer_{optimal_size} {}
+        : work_path_managed_{true},
+          work_path_{set_work_path(std::nullopt)},
+          buffer_{optimal_size},
+          flushing_buffer_{optimal_size} {}
 
     ~Collector();
 
@@ -76,12 +89,8 @@ class Collector {
     [[nodiscard]] bool empty() const { return size_ == 0; }
 
     //! \brief Clears contents of collector and reset
-    void clear() {
-        file_providers_.clear();
-        buffer_.clear();
-        size_ = 0;
-        bytes_size_ = 0;
-    }
+    //! \remarks Rethrows the error of a pending background flush, if any, after the reset
+    void clear();
 
     //! \brief Returns the hex representation of current load key (for progress tracking)
     [[nodiscard]] std::string get_load_key() const {
@@ -92,7 +101,9 @@ class Collector {
   private:
     static std::filesystem::path set_work_path(const std::optional<std::filesystem::path>& provided_work_path);
 
-    void flush_buffer();  // Write buffer to file
+    void put_into_buffer(ByteView key, ByteView value);  // Append entry to buffer, flushing it first if full
+    void flush_buffer();                                 // Start writing buffer to file in background
+    void wait_for_flush();                               // Wait for completion of pending flush (if any), rethrowing its errors
 
     void set_loading_key(ByteView key) {
         std::unique_lock l{mutex_};
@@ -101,7 +112,10 @@ class Collector {
 
     bool work_path_managed_;
     std::filesystem::path work_path_;
-    Buffer buffer_;
+    SlabBuffer buffer_;               // Buffer being filled by collection
+    SlabBuffer flushing_buffer_;      // Buffer being sorted and flushed to file in background
+    std::future<void> flush_result_;  // Completion of background flush
+    SpillCompression compression_{SpillCompression::kNone};
 
     /*
      * TL;DR; In no way two instances of collector can have
@@ -119,6 +133,7 @@ class Collector {
     std::vector<std::unique_ptr<FileProvider>> file_providers_;  // Collection of file providers
     size_t size_{0};                                             // Count of total collected items
     size_t bytes_size_{0};                                       // Count of total collected bytes
+    size_t spilled_size_{0};                                     // Count of total bytes written to files
     mutable std::mutex mutex_{};                                 // To sync loading_key_
     std::string loading_key_{};                                  // Actual load key (for log purposes)
 };
@@ -0,0 +1,80 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/test_util/log.hpp>
+#include <silkworm/node/db/tables.hpp>
+#include <silkworm/node/etl/collector.hpp>
+#include <silkworm/node/test/context.hpp>
+
+namespace silkworm::etl {
+
+static constexpr size_t kNumEntries{1'000'000};
+static constexpr size_t kKeySize{32};
+static constexpr size_t kValueSize{32};
+
+//! Random 32-byte keys (e.g. hashed addresses or storage locations) with 32-byte values
+static const std::vector<Entry>& random_entries() {
+    static const std::vector<Entry> entries{[]() {
+        std::mt19937_64 generator{1};
+        std::vector<Entry> v(kNumEntries);
+        for (auto& entry : v) {
+            entry.key.resize(kKeySize);
+            entry.value.resize(kValueSize);
+            for (size_t i{0}; i < kKeySize; ++i) {
+                entry.key[i] = static_cast<uint8_t>(generator());
+            }
+            for (size_t i{0}; i < kValueSize; ++i) {
+                entry.value[i] = static_cast<uint8_t>(generator());
+            }
+        }
+        return v;
+    }()};
+    return entries;
+}
+
+//! Collect and load random entries using a buffer of state.range(0) MiB, i.e. spilling to more files as it shrinks
+static void collect_and_load(benchmark::State& state) {
+    test_util::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    const auto& entries{random_entries()};
+    const auto buffer_size{static_cast<size_t>(state.range(0)) * kMebi};
+
+    test::Context context;
+    db::PooledCursor target{context.rw_txn(), db::table::kHashedAccounts};
+    size_t loaded{0};
+    const LoadFunc count_only{[&loaded](const Entry& entry, auto&, MDBX_put_flags_t) {
+        benchmark::DoNotOptimize(entry.key.data());
+        ++loaded;
+    }};
+
+    for ([[maybe_unused]] auto _ : state) {
+        Collector collector{context.dir().etl().path(), buffer_size};
+        for (const auto& entry : entries) {
+            collector.collect(entry);
+        }
+        collector.load(target, count_only);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(loaded));
+    state.SetBytesProcessed(static_cast<int64_t>(loaded * (kKeySize + kValueSize)));
+}
+BENCHMARK(collect_and_load)->Arg(4)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+}  // namespace silkworm::etl
@@ -57,7 +57,8 @@ static std::vector<Entry> generate_entry_set(size_t size) {
     return pairs;
 }
 
-void run_collector_test(const LoadFunc& load_func, bool do_copy = true) {
+void run_collector_test(const LoadFunc& load_func, bool do_copy = true,
+                        SpillCompression compression = SpillCompression::kNone) {
     test::Context context;
 
     // Initialize random seed
@@ -69,7 +70,7 @@ void run_collector_test(const LoadFunc& load_func, bool do_copy = true) {
     for (const auto& entry : set) {
         generated_size += entry.size() + /* each flushed record stores also length of key and length of value */ 8;
     }
-    auto collector{Collector(context.dir().etl().path(), generated_size / 10)};  // expect 10 files
+    auto collector{Collector(context.dir().etl().path(), generated_size / 10, compression)};  // expect 10 files
 
     // Collection
     for (auto&& entry : set) {
@@ -109,6 +110,16 @@ TEST_CASE("collect_and_default_load_move") {
     run_collector_test(nullptr, false);
 }
 
+TEST_CASE("collect_and_default_load_compressed") {
+    test_util::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    SECTION("prefix-delta") {
+        run_collector_test(nullptr, true, SpillCompression::kPrefixDelta);
+    }
+    SECTION("snappy") {
+        run_collector_test(nullptr, true, SpillCompression::kSnappy);
+    }
+}
+
 TEST_CASE("collect_and_load") {
     test_util::SetLogVerbosityGuard log_guard{log::Level::kNone};
     run_collector_test([](const Entry& entry, auto& table, MDBX_put_flags_t) {
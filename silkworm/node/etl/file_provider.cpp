@@ -16,6 +16,8 @@
 
 #include "file_provider.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 
 #include <silkworm/core/common/bytes_to_string.hpp>
@@ -25,41 +27,142 @@ namespace silkworm::etl {
 namespace fs = std::filesystem;
 
 // https://abseil.io/tips/117
-FileProvider::FileProvider(std::string file_name, size_t id) : id_{id}, file_name_{std::move(file_name)} {}
+FileProvider::FileProvider(std::string file_name, size_t id, SpillCompression compression)
+    : id_{id}, file_name_{std::move(file_name)}, compression_{compression}, encoder_{compression}, decoder_{compression} {}
 
 FileProvider::~FileProvider() { reset(); }
 
 void FileProvider::flush(Buffer& buffer) {
-    head_t head{};
+    create(buffer.size());
+    write(buffer);
+}
 
-    // Check we have enough space to store all data
-    auto entries{buffer.entries()};
-    file_size_ = buffer.size();
+void FileProvider::create(size_t size) {
+    // Check we have enough space to store all data, compressed formats being possibly slightly larger than raw one
+    file_size_ = compression_ == SpillCompression::kNone ? size : max_spill_size(size);
     fs::path workdir(fs::path(file_name_).parent_path());
     if (fs::space(workdir).available < file_size_) {
         file_size_ = 0;
         throw etl_error("Insufficient disk space");
     }
 
-    // Open file for output and flush data
+    // Open file for output
     file_.open(file_name_, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
     if (!file_.is_open()) {
         reset();
         throw etl_error(errno2str(errno));
     }
+}
+
+void FileProvider::write(const Buffer& buffer) {
+    if (!file_.is_open()) {
+        throw etl_error("Invalid file handle");
+    }
+
+    for (const auto& entry : buffer.entries()) {
+        write_entry(entry.key, entry.value);
+    }
+    finish_write();
+}
+
+void FileProvider::write(const SlabBuffer& buffer) {
+    if (!file_.is_open()) {
+        throw etl_error("Invalid file handle");
+    }
+
+    for (size_t i{0}; i < buffer.entry_count(); ++i) {
+        if (compression_ == SpillCompression::kNone) {
+            // Records in slab are already in file format, so just write them out in sorted order
+            write_bytes(buffer.record(i));
+        } else {
+            write_entry(buffer.key(i), buffer.value(i));
+        }
+    }
+    finish_write();
+}
+
+std::optional<std::pair<Entry, size_t>> FileProvider::read_entry() {
+    if (!file_.is_open() || !file_size_) {
+        throw etl_error("Invalid file handle");
+    }
+
+    if (compression_ != SpillCompression::kNone) {
+        return read_compressed_entry();
+    }
+
+    head_t head{};
+    if (!read_ahead(sizeof(head))) {
+        reset();
+        return std::nullopt;
+    }
+    std::memcpy(head.bytes, &read_buffer_[read_offset_], sizeof(head));
+
+    if (!read_ahead(sizeof(head) + head.lengths[0] + head.lengths[1])) {
+        auto err{errno};
+        reset();
+        throw etl_error(errno2str(err));
+    }
+    const uint8_t* data{&read_buffer_[read_offset_ + sizeof(head)]};
+    Entry entry{Bytes(data, head.lengths[0]), Bytes(data + head.lengths[0], head.lengths[1])};
+    read_offset_ += sizeof(head) + head.lengths[0] + head.lengths[1];
+
+    return std::make_pair(std::move(entry), id_);
+}
 
-    for (const auto& entry : entries) {
-        head.lengths[0] = static_cast<uint32_t>(entry.key.size());
-        head.lengths[1] = static_cast<uint32_t>(entry.value.size());
-        if (!file_.write(byte_ptr_cast(head.bytes), 8) ||
-            !file_.write(byte_ptr_cast(entry.key.data()), static_cast<std::streamsize>(entry.key.size())) ||
-            !file_.write(byte_ptr_cast(entry.value.data()), static_cast<std::streamsize>(entry.value.size()))) {
+std::optional<std::pair<Entry, size_t>> FileProvider::read_compressed_entry() {
+    Entry entry;
+    // Decode entries one by one from current block, moving on to next block when it's over
+    while (!decoder_.next(entry)) {
+        block_head_t head{};
+        if (!read_ahead(sizeof(head))) {
+            reset();
+            return std::nullopt;
+        }
+        std::memcpy(head.bytes, &read_buffer_[read_offset_], sizeof(head));
+
+        if (!read_ahead(sizeof(head) + head.sizes[1])) {
             auto err{errno};
             reset();
             throw etl_error(errno2str(err));
         }
+        decoder_.reset(head, ByteView{&read_buffer_[read_offset_ + sizeof(head)], head.sizes[1]});
+        read_offset_ += sizeof(head) + head.sizes[1];
+    }
+
+    return std::make_pair(std::move(entry), id_);
+}
+
+void FileProvider::write_entry(ByteView key, ByteView value) {
+    if (compression_ == SpillCompression::kNone) {
+        head_t head{};
+        head.lengths[0] = static_cast<uint32_t>(key.size());
+        head.lengths[1] = static_cast<uint32_t>(value.size());
+        write_bytes({head.bytes, sizeof(head)});
+        write_bytes(key);
+        write_bytes(value);
+    } else if (encoder_.add(key, value)) {
+        write_bytes(encoder_.take_block());
+    }
+}
+
+void FileProvider::write_bytes(ByteView bytes) {
+    if (!file_.write(byte_ptr_cast(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+        auto err{errno};
+        reset();
+        throw etl_error(errno2str(err));
+    }
+    written_size_ += bytes.size();
+}
+
+void FileProvider::finish_write() {
+    if (!encoder_.empty()) {
+        write_bytes(encoder_.take_block());
     }
+    file_size_ = written_size_;
+    reopen_for_reading();
+}
 
+void FileProvider::reopen_for_reading() {
     // Close file in output mode and reopen for input mode
     // This is actually not strictly needed but amends an odd behavior on Windows
     // which prevents correct display of file size if the handle
@@ -73,31 +176,28 @@ void FileProvider::flush(Buffer& buffer) {
     }
 }
 
-std::optional<std::pair<Entry, size_t>> FileProvider::read_entry() {
-    head_t head{};
-
-    if (!file_.is_open() || !file_size_) {
-        throw etl_error("Invalid file handle");
-    }
-
-    if (!file_.read(byte_ptr_cast(head.bytes), 8)) {
-        reset();
-        return std::nullopt;
-    }
-
-    Entry entry{Bytes(head.lengths[0], '\0'), Bytes(head.lengths[1], '\0')};
-    if (!file_.read(byte_ptr_cast(entry.key.data()), head.lengths[0]) ||
-        !file_.read(byte_ptr_cast(entry.value.data()), head.lengths[1])) {
-        auto err{errno};
-        reset();
-        throw etl_error(errno2str(err));
+bool FileProvider::read_ahead(size_t count) {
+    const size_t available{read_buffer_.size() - read_offset_};
+    if (available >= count) {
+        return true;
     }
 
-    return std::make_pair(entry, id_);
+    // Keep the unread bytes and append a whole new chunk (or more, for entries larger than the chunk size)
+    read_buffer_.erase(0, read_offset_);
+    read_offset_ = 0;
+    const size_t to_read{std::max(count - available, kReadAheadSize)};
+    read_buffer_.resize(available + to_read);
+    file_.read(byte_ptr_cast(&read_buffer_[available]), static_cast<std::streamsize>(to_read));
+    read_buffer_.resize(available + static_cast<size_t>(file_.gcount()));
+    return read_buffer_.size() >= count;
 }
 
 void FileProvider::reset() {
     file_size_ = 0;
+    read_buffer_.clear();
+    read_buffer_.shrink_to_fit();
+    read_offset_ = 0;
+    written_size_ = 0;
     if (file_.is_open()) {
         file_.close();
         fs::remove(file_name_.c_str());
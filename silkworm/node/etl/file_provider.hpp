@@ -21,31 +21,52 @@
 #include <optional>
 
 #include <silkworm/node/etl/buffer.hpp>
+#include <silkworm/node/etl/slab_buffer.hpp>
+#include <silkworm/node/etl/spill_codec.hpp>
 #include <silkworm/node/etl/util.hpp>
 
 namespace silkworm::etl {
 
+// Size of the chunks read at once from file while loading entries
+inline constexpr size_t kReadAheadSize = 1_Mebi;
+
 /**
  * Provides an abstraction to flush data to disk
  * and re-read flushed data sequentially
  */
 class FileProvider {
   public:
-    FileProvider(std::string file_name, size_t id);
+    FileProvider(std::string file_name, size_t id, SpillCompression compression = SpillCompression::kNone);
     ~FileProvider();
 
     void flush(Buffer& buffer);                            // Write buffer's contents to disk
+    void create(size_t size);                              // Check there's enough disk space and create the file
+    void write(const Buffer& buffer);                      // Write buffer's contents to the created file
+    void write(const SlabBuffer& buffer);                  // Write buffer's records to the created file as they are
     std::optional<std::pair<Entry, size_t>> read_entry();  // Read next data element from file starting from position 0
     void reset();                                          // Remove the file when eof is met
 
     std::string get_file_name() const;
-    size_t get_file_size() const;
+    size_t get_file_size() const;  // Actual size on disk once written
 
   private:
+    void write_entry(ByteView key, ByteView value);  // Write entry in the configured format
+    void write_bytes(ByteView bytes);                // Write bytes as they are
+    void finish_write();                             // Write pending data and switch file to input mode
+    void reopen_for_reading();                       // Switch file from output to input mode once written
+    bool read_ahead(size_t count);                   // Ensure count bytes are available in read buffer, reading ahead
+    std::optional<std::pair<Entry, size_t>> read_compressed_entry();
+
     size_t id_;
-    std::fstream file_;      // Actual file stream
-    std::string file_name_;  // Actual name of file
-    size_t file_size_{0};    // Actual size of written data
+    std::fstream file_;             // Actual file stream
+    std::string file_name_;         // Actual name of file
+    size_t file_size_{0};           // Actual size of written data
+    size_t written_size_{0};        // Size of data written so far
+    Bytes read_buffer_;             // Chunk of file read ahead
+    size_t read_offset_{0};         // Offset of next unread byte in read_buffer_
+    SpillCompression compression_;  // Format of file
+    SpillBlockEncoder encoder_;     // Block encoder for compressed formats
+    SpillBlockDecoder decoder_;     // Block decoder for compressed formats
 };
 
 }  // namespace silkworm::etl
@@ -0,0 +1,96 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace silkworm::etl {
+
+//! \brief LoserTree is a tournament tree for k-way merging of sorted sources
+//! \details Each internal node keeps the loser of the match played there, the overall winner is kept apart. Replacing the
+//! winner with the next item of its source replays just the matches on the path from its leaf to the root, i.e. log2(k)
+//! comparisons against the k-1 needed by a binary heap pop + push. Ties are won by the source with the lower index.
+template <typename T, typename Less = std::less<>>
+class LoserTree {
+  public:
+    //! \param heads : the first item of each source (std::nullopt if empty)
+    explicit LoserTree(std::vector<std::optional<T>> heads, Less less = {})
+        : leaves_{std::move(heads)}, nodes_(leaves_.size()), less_{std::move(less)} {
+        if (!leaves_.empty()) {
+            nodes_[0] = play(1);
+        }
+    }
+
+    //! \brief Whether all the sources are exhausted
+    [[nodiscard]] bool empty() const noexcept { return leaves_.empty() || !leaves_[nodes_[0]]; }
+
+    //! \brief The smallest item among the source heads
+    //! \pre !empty()
+    [[nodiscard]] const T& top() const noexcept { return *leaves_[nodes_[0]]; }
+    [[nodiscard]] T& top() noexcept { return *leaves_[nodes_[0]]; }
+
+    //! \brief The index of the source top() comes from
+    [[nodiscard]] size_t top_source() const noexcept { return nodes_[0]; }
+
+    //! \brief Replaces top() with the next item of the same source (std::nullopt when exhausted)
+    void replace_top(std::optional<T> next) {
+        size_t winner{nodes_[0]};
+        leaves_[winner] = std::move(next);
+        for (size_t node{(winner + leaves_.size()) / 2}; node > 0; node /= 2) {
+            if (beats(nodes_[node], winner)) {
+                std::swap(nodes_[node], winner);
+            }
+        }
+        nodes_[0] = winner;
+    }
+
+  private:
+    // Whether source a wins over source b, exhausted sources behaving as +infinity
+    [[nodiscard]] bool beats(size_t a, size_t b) const {
+        if (!leaves_[a]) return false;
+        if (!leaves_[b]) return true;
+        if (less_(*leaves_[a], *leaves_[b])) return true;
+        if (less_(*leaves_[b], *leaves_[a])) return false;
+        return a < b;
+    }
+
+    // Plays the matches of the subtree rooted at node, returns the winner. Leaves are nodes [k, 2k)
+    size_t play(size_t node) {
+        const size_t k{leaves_.size()};
+        if (node >= k) {
+            return node - k;
+        }
+        const size_t left{play(2 * node)};
+        const size_t right{play(2 * node + 1)};
+        if (beats(left, right)) {
+            nodes_[node] = right;
+            return left;
+        }
+        nodes_[node] = left;
+        return right;
+    }
+
+    std::vector<std::optional<T>> leaves_;
+    std::vector<size_t> nodes_;  // nodes_[0] is the overall winner, nodes_[1..k) the losers of internal matches
+    Less less_;
+};
+
+}  // namespace silkworm::etl
@@ -0,0 +1,88 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "loser_tree.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::etl {
+
+static std::vector<int> merge_all(const std::vector<std::vector<int>>& sources) {
+    std::vector<size_t> positions(sources.size(), 0);
+    std::vector<std::optional<int>> heads;
+    for (const auto& source : sources) {
+        heads.push_back(source.empty() ? std::nullopt : std::make_optional(source.front()));
+    }
+
+    std::vector<int> merged;
+    LoserTree<int> tree{std::move(heads)};
+    while (!tree.empty()) {
+        merged.push_back(tree.top());
+        const size_t i{tree.top_source()};
+        const size_t next{++positions[i]};
+        tree.replace_top(next < sources[i].size() ? std::make_optional(sources[i][next]) : std::nullopt);
+    }
+    return merged;
+}
+
+TEST_CASE("LoserTree", "[silkworm][node][etl][loser_tree]") {
+    SECTION("no sources") {
+        LoserTree<int> tree{{}};
+        CHECK(tree.empty());
+    }
+
+    SECTION("empty sources") {
+        CHECK(merge_all({{}, {}, {}}).empty());
+    }
+
+    SECTION("single source") {
+        CHECK(merge_all({{1, 2, 3}}) == std::vector<int>{1, 2, 3});
+    }
+
+    SECTION("ties are won by lower source") {
+        std::vector<std::optional<int>> heads{5, 3, 3};
+        LoserTree<int> tree{std::move(heads)};
+        CHECK(tree.top_source() == 1);
+        tree.replace_top(std::nullopt);
+        CHECK(tree.top_source() == 2);
+        tree.replace_top(std::nullopt);
+        CHECK(tree.top_source() == 0);
+        tree.replace_top(std::nullopt);
+        CHECK(tree.empty());
+    }
+
+    SECTION("random sources") {
+        std::mt19937 generator{7};
+        for (size_t k : {2u, 3u, 5u, 8u, 13u}) {
+            std::vector<std::vector<int>> sources(k);
+            std::vector<int> expected;
+            for (auto& source : sources) {
+                source.resize(generator() % 50);
+                std::generate(source.begin(), source.end(), [&]() { return static_cast<int>(generator() % 100); });
+                std::sort(source.begin(), source.end());
+                expected.insert(expected.end(), source.begin(), source.end());
+            }
+            std::sort(expected.begin(), expected.end());
+            CHECK(merge_all(sources) == expected);
+        }
+    }
+}
+
+}  // namespace silkworm::etl
@@ -0,0 +1,152 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/infra/concurrency/parallel_sort.hpp>
+#include <silkworm/node/etl/util.hpp>
+
+namespace silkworm::etl {
+
+//! \brief SlabBuffer is an ETL buffer storing all the entries back to back into one contiguous slab of memory, in the
+//! same format used for files (i.e. head followed by key and value), so that collecting them does not allocate
+//! \details Sorting acts on a vector of fixed-size handles, each made of the first 8 bytes of the key and the offset of
+//! the entry in the slab: most comparisons are decided by the inlined key prefix without touching the slab at all
+class SlabBuffer {
+  public:
+    // Not copyable nor movable
+    SlabBuffer(const SlabBuffer&) = delete;
+    SlabBuffer& operator=(const SlabBuffer&) = delete;
+
+    explicit SlabBuffer(size_t optimal_size) : optimal_size_(optimal_size) {}
+
+    void put(ByteView key, ByteView value) {
+        // Reserve the whole slab upfront: memory pages get actually committed only when written
+        if (slab_.capacity() == 0) {
+            slab_.reserve(optimal_size_);
+        }
+        head_t head{};
+        head.lengths[0] = static_cast<uint32_t>(key.size());
+        head.lengths[1] = static_cast<uint32_t>(value.size());
+        handles_.push_back({key_prefix(key), slab_.size()});
+        slab_.append(head.bytes, sizeof(head));
+        slab_.append(key);
+        slab_.append(value);
+    }
+
+    void put(const Entry& entry) { put(entry.key, entry.value); }
+
+    void clear() noexcept {
+        // Set the buffer to contain 0 entries, keeping the allocated memory
+        slab_.clear();
+        handles_.clear();
+    }
+
+    [[nodiscard]] bool overflows() const noexcept {
+        // Whether accounted size overflows optimal_size_ (i.e. time to flush)
+        return slab_.size() >= optimal_size_;
+    }
+
+    [[nodiscard]] bool fits(size_t key_size, size_t value_size) const noexcept {
+        // Whether one more entry of given sizes can be appended within optimal_size_, i.e. without reallocating the
+        // slab reserved upfront (if not, time to flush before appending)
+        return slab_.size() + sizeof(head_t) + key_size + value_size <= optimal_size_;
+    }
+
+    void sort() {
+        // Sort handles in increasing order by key comparison (value comparison for equal keys)
+        parallel_sort(handles_.begin(), handles_.end(), [this](const Handle& a, const Handle& b) {
+            if (a.prefix != b.prefix) {
+                return a.prefix < b.prefix;
+            }
+            const ByteView key_a{key(a)}, key_b{key(b)};
+            if (const auto diff{key_a.compare(key_b)}; diff != 0) {
+                return diff < 0;
+            }
+            return value(a) < value(b);
+        });
+    }
+
+    void swap(SlabBuffer& other) noexcept {
+        // Exchange contents with other buffer (e.g. to keep on filling one while the other is flushed)
+        std::swap(optimal_size_, other.optimal_size_);
+        slab_.swap(other.slab_);
+        handles_.swap(other.handles_);
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        // Actual size of accounted data (i.e. same as file size)
+        return slab_.size();
+    }
+
+    [[nodiscard]] size_t entry_count() const noexcept { return handles_.size(); }
+
+    //! \brief Key, value and whole record (head included, as written to file) of i-th entry in current order
+    [[nodiscard]] ByteView key(size_t i) const noexcept { return key(handles_[i]); }
+    [[nodiscard]] ByteView value(size_t i) const noexcept { return value(handles_[i]); }
+    [[nodiscard]] ByteView record(size_t i) const noexcept {
+        const head_t head{head_at(handles_[i].offset)};
+        return {&slab_[handles_[i].offset], sizeof(head_t) + head.lengths[0] + head.lengths[1]};
+    }
+
+    //! \brief Bytes of memory in use, i.e. filled part of slab (the reserved rest is not committed yet) and handles
+    [[nodiscard]] size_t memory_usage() const noexcept {
+        return slab_.size() + handles_.capacity() * sizeof(Handle);
+    }
+
+  private:
+    struct Handle {
+        uint64_t prefix;  // First 8 bytes of key as big-endian number, zero padded if shorter
+        size_t offset;    // Offset of entry record within slab
+    };
+
+    static uint64_t key_prefix(ByteView key) noexcept {
+        uint8_t prefix[8]{};
+        if (!key.empty()) {
+            std::memcpy(prefix, key.data(), std::min(key.size(), sizeof(prefix)));
+        }
+        return endian::load_big_u64(prefix);
+    }
+
+    [[nodiscard]] head_t head_at(size_t offset) const noexcept {
+        head_t head;
+        std::memcpy(head.bytes, &slab_[offset], sizeof(head));
+        return head;
+    }
+
+    [[nodiscard]] ByteView key(const Handle& handle) const noexcept {
+        const head_t head{head_at(handle.offset)};
+        return {&slab_[handle.offset + sizeof(head_t)], head.lengths[0]};
+    }
+
+    [[nodiscard]] ByteView value(const Handle& handle) const noexcept {
+        const head_t head{head_at(handle.offset)};
+        return {&slab_[handle.offset + sizeof(head_t) + head.lengths[0]], head.lengths[1]};
+    }
+
+    size_t optimal_size_;
+    Bytes slab_;                   // entry records back to back
+    std::vector<Handle> handles_;  // one per entry, in collection order until sorted
+};
+
+}  // namespace silkworm::etl
@@ -0,0 +1,91 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "slab_buffer.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/util.hpp>
+
+namespace silkworm::etl {
+
+TEST_CASE("SlabBuffer", "[silkworm][node][etl][slab_buffer]") {
+    SlabBuffer buffer{64};
+    CHECK(buffer.entry_count() == 0);
+    CHECK(buffer.size() == 0);
+    CHECK_FALSE(buffer.overflows());
+
+    SECTION("entries are stored in file format") {
+        buffer.put(*from_hex("0102"), *from_hex("ff"));
+        CHECK(buffer.entry_count() == 1);
+        CHECK(buffer.size() == 8 + 2 + 1);
+        CHECK(buffer.key(0) == *from_hex("0102"));
+        CHECK(buffer.value(0) == *from_hex("ff"));
+        CHECK(to_hex(buffer.record(0)) == "0200000001000000" "0102" "ff");
+    }
+
+    SECTION("sort by key then value") {
+        // Same 8-byte prefix for some keys, shorter keys and empty ones
+        const std::vector<Entry> entries{
+            {*from_hex("0000000000000000ff"), *from_hex("01")},
+            {*from_hex("00000000000000000a"), *from_hex("01")},
+            {*from_hex("00"), *from_hex("")},
+            {*from_hex(""), *from_hex("02")},
+            {*from_hex("bb"), *from_hex("02")},
+            {*from_hex("bb"), *from_hex("01")},
+            {*from_hex("0000000000000000"), *from_hex("")},
+            {*from_hex("aabbccdd"), *from_hex("03")},
+        };
+        for (const auto& entry : entries) {
+            buffer.put(entry);
+        }
+        CHECK(buffer.overflows());
+
+        auto expected{entries};
+        std::sort(expected.begin(), expected.end());
+        buffer.sort();
+        REQUIRE(buffer.entry_count() == expected.size());
+        for (size_t i{0}; i < expected.size(); ++i) {
+            CHECK(buffer.key(i) == expected[i].key);
+            CHECK(buffer.value(i) == expected[i].value);
+        }
+    }
+
+    SECTION("fits within optimal size") {
+        CHECK(buffer.fits(24, 32));  // 8 + 24 + 32 == 64
+        CHECK_FALSE(buffer.fits(24, 33));
+        buffer.put(Bytes(24, '\x01'), Bytes(24, '\x02'));
+        CHECK(buffer.fits(0, 0));  // 56 + 8 == 64
+        CHECK_FALSE(buffer.fits(0, 1));
+        CHECK_FALSE(buffer.overflows());
+    }
+
+    SECTION("swap and clear") {
+        SlabBuffer other{64};
+        buffer.put(*from_hex("01"), *from_hex("01"));
+        buffer.swap(other);
+        CHECK(buffer.entry_count() == 0);
+        CHECK(other.entry_count() == 1);
+        other.clear();
+        CHECK(other.entry_count() == 0);
+        CHECK(other.size() == 0);
+    }
+}
+
+}  // namespace silkworm::etl
@@ -0,0 +1,123 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "spill_codec.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <snappy.h>
+
+#include <silkworm/core/common/bytes_to_string.hpp>
+
+namespace silkworm::etl {
+
+static void encode_varint(uint64_t value, Bytes& output) {
+    while (value >= 0x80) {
+        output.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    output.push_back(static_cast<uint8_t>(value));
+}
+
+static uint64_t decode_varint(ByteView input, size_t& position) {
+    uint64_t value{0};
+    for (unsigned shift{0}; position < input.size() && shift < 64; shift += 7) {
+        const uint8_t byte{input[position++]};
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw etl_error("Corrupted spill file: invalid varint");
+}
+
+bool SpillBlockEncoder::add(ByteView key, ByteView value) {
+    const auto mismatch{std::mismatch(key.begin(), key.end(), previous_.begin(), previous_.end())};
+    const auto shared{static_cast<size_t>(mismatch.first - key.begin())};
+
+    encode_varint(shared, raw_);
+    encode_varint(key.size() - shared, raw_);
+    encode_varint(value.size(), raw_);
+    raw_.append(key.substr(shared));
+    raw_.append(value);
+    previous_.assign(key);
+
+    return raw_.size() >= kSpillBlockSize;
+}
+
+ByteView SpillBlockEncoder::take_block() {
+    block_head_t head{};
+    block_.resize(sizeof(head));
+    bool compressed{false};
+    if (compression_ == SpillCompression::kSnappy) {
+        block_.resize(sizeof(head) + snappy::MaxCompressedLength(raw_.size()));
+        size_t compressed_length{0};
+        snappy::RawCompress(byte_ptr_cast(raw_.data()), raw_.size(), byte_ptr_cast(&block_[sizeof(head)]),
+                            &compressed_length);
+        block_.resize(sizeof(head) + compressed_length);
+        compressed = compressed_length < raw_.size();
+    }
+    // Incompressible blocks are stored as they are, which the decoder tells from stored size being equal to raw one
+    if (!compressed) {
+        block_.resize(sizeof(head));
+        block_.append(raw_);
+    }
+    head.sizes[0] = static_cast<uint32_t>(raw_.size());
+    head.sizes[1] = static_cast<uint32_t>(block_.size() - sizeof(head));
+    std::memcpy(block_.data(), head.bytes, sizeof(head));
+
+    // Keys of next block do not depend on this one, so that each block can be decoded on its own
+    raw_.clear();
+    previous_.clear();
+    return block_;
+}
+
+void SpillBlockDecoder::reset(const block_head_t& head, ByteView payload) {
+    if (compression_ == SpillCompression::kSnappy && head.sizes[1] != head.sizes[0]) {
+        raw_.resize(head.sizes[0]);
+        if (!snappy::RawUncompress(byte_ptr_cast(payload.data()), payload.size(), byte_ptr_cast(raw_.data()))) {
+            throw etl_error("Corrupted spill file: invalid snappy block");
+        }
+    } else {
+        raw_.assign(payload);
+    }
+    position_ = 0;
+    previous_.clear();
+}
+
+bool SpillBlockDecoder::next(Entry& entry) {
+    if (position_ >= raw_.size()) {
+        return false;
+    }
+    const ByteView raw{raw_};
+    const auto shared{decode_varint(raw, position_)};
+    const auto suffix_length{decode_varint(raw, position_)};
+    const auto value_length{decode_varint(raw, position_)};
+    if (shared > previous_.size() || raw.size() - position_ < suffix_length + value_length) {
+        throw etl_error("Corrupted spill file: invalid entry");
+    }
+
+    previous_.resize(shared);
+    previous_.append(raw.substr(position_, suffix_length));
+    position_ += suffix_length;
+    entry.key = previous_;
+    entry.value.assign(raw.substr(position_, value_length));
+    position_ += value_length;
+    return true;
+}
+
+}  // namespace silkworm::etl
@@ -0,0 +1,88 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/node/etl/util.hpp>
+
+namespace silkworm::etl {
+
+// Size of uncompressed data beyond which a block of compressed spill file is closed
+inline constexpr size_t kSpillBlockSize = 64_Kibi;
+
+// Head of each block in compressed spill file
+union block_head_t {
+    uint32_t sizes[2];  // raw size, stored size (equal when the block is stored uncompressed)
+    uint8_t bytes[8];
+};
+
+//! \brief Upper bound of the size of a compressed spill file holding entries taking raw_size bytes in raw format
+//! \details Blocks never grow when compressed because incompressible ones are stored as they are, but prefix-delta
+//! encoding may take a few more bytes than head_t for entries larger than 16 KiB (i.e. up to 7 bytes each) and each
+//! block adds its own head
+inline constexpr size_t max_spill_size(size_t raw_size) {
+    return raw_size + raw_size / 2048 + (raw_size / kSpillBlockSize + 1) * sizeof(block_head_t);
+}
+
+//! \brief SpillBlockEncoder turns sorted entries into compressed blocks
+//! \details Within each block, keys are stored as the length of the prefix shared with the previous key plus the
+//! remaining suffix. Since spilled entries are sorted this removes most of the key bytes (e.g. hashed addresses in
+//! storage keys). Optionally each block is then compressed with Snappy, unless this would not make it smaller.
+class SpillBlockEncoder {
+  public:
+    explicit SpillBlockEncoder(SpillCompression compression) : compression_{compression} {}
+
+    //! \brief Appends an entry to current block
+    //! \return true when the block is full and should be taken
+    bool add(ByteView key, ByteView value);
+
+    //! \brief Whether current block has no entries
+    [[nodiscard]] bool empty() const noexcept { return raw_.empty(); }
+
+    //! \brief Closes current block and starts a new one
+    //! \return the block, head included, valid until next call to add or take_block
+    ByteView take_block();
+
+  private:
+    SpillCompression compression_;
+    Bytes raw_;       // current block uncompressed
+    Bytes previous_;  // last key added
+    Bytes block_;     // last block taken
+};
+
+//! \brief SpillBlockDecoder streams back entries from blocks produced by SpillBlockEncoder
+class SpillBlockDecoder {
+  public:
+    explicit SpillBlockDecoder(SpillCompression compression) : compression_{compression} {}
+
+    //! \brief Starts decoding the given block payload (i.e. without head)
+    void reset(const block_head_t& head, ByteView payload);
+
+    //! \brief Decodes next entry of current block
+    //! \return false when current block is over
+    bool next(Entry& entry);
+
+  private:
+    SpillCompression compression_;
+    Bytes raw_;           // current block uncompressed
+    size_t position_{0};  // position of next entry within raw_
+    Bytes previous_;      // last key decoded
+};
+
+}  // namespace silkworm::etl
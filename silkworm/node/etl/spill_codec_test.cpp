@@ -0,0 +1,137 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "spill_codec.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/util.hpp>
+
+namespace silkworm::etl {
+
+static std::vector<Entry> sorted_entries(size_t count) {
+    std::vector<Entry> entries;
+    for (size_t i{0}; i < count; ++i) {
+        Bytes key(32, '\xaa');  // long shared prefix
+        key[30] = static_cast<uint8_t>(i >> 8);
+        key[31] = static_cast<uint8_t>(i);
+        entries.emplace_back(key, Bytes(i % 5, static_cast<uint8_t>(i)));
+    }
+    entries.emplace_back(*from_hex("ff"), Bytes{});  // shorter key than previous ones
+    return entries;
+}
+
+static std::vector<Entry> round_trip(const std::vector<Entry>& entries, SpillCompression compression) {
+    SpillBlockEncoder encoder{compression};
+    std::vector<Bytes> blocks;
+    for (const auto& entry : entries) {
+        if (encoder.add(entry.key, entry.value)) {
+            blocks.emplace_back(encoder.take_block());
+        }
+    }
+    if (!encoder.empty()) {
+        blocks.emplace_back(encoder.take_block());
+    }
+
+    SpillBlockDecoder decoder{compression};
+    std::vector<Entry> decoded;
+    for (const auto& block : blocks) {
+        block_head_t head{};
+        std::memcpy(head.bytes, block.data(), sizeof(head));
+        REQUIRE(head.sizes[1] == block.size() - sizeof(head));
+        decoder.reset(head, ByteView{block}.substr(sizeof(head)));
+        Entry entry;
+        while (decoder.next(entry)) {
+            decoded.push_back(entry);
+        }
+    }
+    return decoded;
+}
+
+TEST_CASE("SpillBlockEncoder and SpillBlockDecoder", "[silkworm][node][etl][spill_codec]") {
+    const auto entries{sorted_entries(10'000)};  // more than one block
+    size_t raw_size{0};
+    for (const auto& entry : entries) {
+        raw_size += sizeof(head_t) + entry.size();
+    }
+
+    for (const auto compression : {SpillCompression::kPrefixDelta, SpillCompression::kSnappy}) {
+        SECTION("compression: " + std::to_string(static_cast<int>(compression))) {
+            CHECK(round_trip(entries, compression) == entries);
+        }
+    }
+
+    SECTION("shared key prefixes are not stored") {
+        SpillBlockEncoder encoder{SpillCompression::kPrefixDelta};
+        for (const auto& entry : entries) {
+            (void)encoder.add(entry.key, entry.value);
+        }
+        CHECK(encoder.take_block().size() < raw_size / 4);
+    }
+
+    SECTION("incompressible block is stored raw") {
+        std::vector<Entry> random_entries;
+        uint64_t state{0x9e3779b97f4a7c15};
+        for (size_t i{0}; i < 100; ++i) {
+            Bytes value(500, 0);
+            for (auto& byte : value) {
+                state = state * 6364136223846793005 + 1442695040888963407;
+                byte = static_cast<uint8_t>(state >> 56);
+            }
+            random_entries.emplace_back(Bytes{static_cast<uint8_t>(i)}, value);
+        }
+        SpillBlockEncoder encoder{SpillCompression::kSnappy};
+        for (const auto& entry : random_entries) {
+            REQUIRE_FALSE(encoder.add(entry.key, entry.value));
+        }
+        const Bytes block{encoder.take_block()};
+        block_head_t head{};
+        std::memcpy(head.bytes, block.data(), sizeof(head));
+        CHECK(head.sizes[1] == head.sizes[0]);
+
+        CHECK(round_trip(random_entries, SpillCompression::kSnappy) == random_entries);
+    }
+
+    SECTION("max spill size") {
+        for (const auto compression : {SpillCompression::kPrefixDelta, SpillCompression::kSnappy}) {
+            SpillBlockEncoder encoder{compression};
+            size_t spill_size{0};
+            for (const auto& entry : entries) {
+                if (encoder.add(entry.key, entry.value)) {
+                    spill_size += encoder.take_block().size();
+                }
+            }
+            spill_size += encoder.take_block().size();
+            CHECK(spill_size <= max_spill_size(raw_size));
+        }
+    }
+
+    SECTION("corrupted block") {
+        SpillBlockDecoder decoder{SpillCompression::kPrefixDelta};
+        const Bytes payload{*from_hex("05")};  // shared prefix longer than previous key
+        block_head_t head{};
+        head.sizes[0] = head.sizes[1] = static_cast<uint32_t>(payload.size());
+        decoder.reset(head, payload);
+        Entry entry;
+        CHECK_THROWS_AS(decoder.next(entry), etl_error);
+    }
+}
+
+}  // namespace silkworm::etl
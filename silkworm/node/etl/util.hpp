@@ -32,6 +32,13 @@ class etl_error : public std::runtime_error {
     using std::runtime_error::runtime_error;
 };
 
+//! \brief Format of the files where collected entries are spilled to
+enum class SpillCompression {
+    kNone,         // Raw entries, each one preceded by its head
+    kPrefixDelta,  // Blocks of entries with each key stored as delta from the previous one
+    kSnappy,       // Prefix-delta blocks further compressed with Snappy
+};
+
 // Head of each data chunk on file
 union head_t {
     uint32_t lengths[2];
@@ -52,6 +59,8 @@ struct Entry {
     Bytes key;
     Bytes value;
     [[nodiscard]] size_t size() const noexcept { return key.size() + value.size(); }
+
+    friend bool operator==(const Entry&, const Entry&) = default;
 };
 
 inline bool operator<(const Entry& a, const Entry& b) {
@@ -0,0 +1,772 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "compressor.hpp"
+
+#include <bit>
+#include <climits>
+#include <deque>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <absl/container/flat_hash_map.h>
+#include <gsl/util>
+
+#include <silkworm/core/common/bytes_to_string.hpp>
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/infra/common/ensure.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/concurrency/thread_pool.hpp>
+
+namespace silkworm::huffman {
+
+//! Max length of Huffman codes, so that any code fits into 64 bits
+constexpr std::size_t kMaxCodeLength{64};
+
+//! Max number of words and bytes in batches of words compressed in parallel
+constexpr std::size_t kBatchWords{64 * 1024};
+constexpr std::size_t kBatchBytes{16_Mebi};
+
+//! Estimated cost in bits of the position preceding each pattern in compressed words
+constexpr uint64_t kPositionCostEstimate{4};
+
+//! Estimated cost in bits of pattern depth and length in the dictionary
+constexpr uint64_t kDictionaryEntryCostEstimate{16};
+
+//! Max number of rounds dropping from dictionary the patterns not worth their storage cost
+constexpr std::size_t kDictionaryPruneRounds{3};
+
+//! Max length of compressed words (positions must fit into int in Decompressor)
+constexpr std::size_t kMaxWordLength{std::numeric_limits<int>::max() - 1};
+
+namespace {
+
+    //! Compression uses Google ProtocolBuffers encoding (see also Go "varint" encoding)
+    void encode_varint(uint64_t value, Bytes& output) {
+        while (value > 127) {
+            output.push_back(static_cast<uint8_t>((value & 127) | 128));
+            value >>= 7;
+        }
+        output.push_back(static_cast<uint8_t>(value));
+    }
+
+    std::optional<uint64_t> read_varint(std::istream& input) {
+        uint64_t value{0};
+        for (int shift{0}; shift < 64; shift += 7) {
+            const auto c{input.get()};
+            if (c == std::istream::traits_type::eof()) {
+                if (shift == 0) return std::nullopt;
+                break;
+            }
+            value |= static_cast<uint64_t>(c & 127) << shift;
+            if ((c & 128) == 0) return value;
+        }
+        throw std::runtime_error{"intermediate word file is invalid: bad varint"};
+    }
+
+    //! Huffman code in stream order, i.e. the first bit read by Decompressor is the least significant one
+    struct Code {
+        uint64_t bits{0};
+        uint8_t length{0};
+    };
+
+    //! Bit stream writer following the bit order expected by Decompressor
+    class BitWriter {
+      public:
+        explicit BitWriter(Bytes& output) : output_{output} {}
+
+        void write(const Code& code) {
+            if (code.length > 32) {
+                write({code.bits & 0xFFFFFFFF, 32});
+                write({code.bits >> 32, static_cast<uint8_t>(code.length - 32)});
+                return;
+            }
+            buffer_ |= code.bits << bit_count_;
+            bit_count_ += code.length;
+            while (bit_count_ >= CHAR_BIT) {
+                output_.push_back(static_cast<uint8_t>(buffer_));
+                buffer_ >>= CHAR_BIT;
+                bit_count_ -= CHAR_BIT;
+            }
+        }
+
+        //! Pad the current byte with zero bits (each word starts at byte boundary)
+        void align() {
+            if (bit_count_ > 0) {
+                output_.push_back(static_cast<uint8_t>(buffer_));
+                buffer_ = 0;
+                bit_count_ = 0;
+            }
+        }
+
+      private:
+        Bytes& output_;
+        uint64_t buffer_{0};
+        std::size_t bit_count_{0};
+    };
+
+    //! Canonical Huffman codes for a set of symbols
+    struct HuffmanTable {
+        std::vector<Code> codes;         // The code of each symbol
+        std::vector<std::size_t> order;  // The symbols sorted by code length, i.e. the order expected in dictionaries
+    };
+
+    uint64_t reverse_bits(uint64_t bits, std::size_t length) {
+        uint64_t reversed{0};
+        for (std::size_t i{0}; i < length; ++i) {
+            reversed = (reversed << 1) | ((bits >> i) & 1);
+        }
+        return reversed;
+    }
+
+    //! Build canonical Huffman codes for symbols with the given weights
+    //! @details Decompressor rebuilds the code tree from code lengths alone assigning codes in dictionary order, which
+    //! is exactly the canonical assignment when symbols are sorted by code length
+    HuffmanTable build_huffman_table(const std::vector<uint64_t>& weights) {
+        const std::size_t n{weights.size()};
+        HuffmanTable table{std::vector<Code>(n), std::vector<std::size_t>(n)};
+        if (n == 0) return table;
+
+        // A lone symbol gets a 1-bit code anyway, so that no word is ever encoded in zero bits
+        std::vector<std::size_t> lengths(n, 1);
+        if (n > 1) {
+            // Leaves are nodes [0, n), internal nodes are [n, 2n - 1) with the root being the last one
+            std::vector<std::size_t> parents(2 * n - 1, 0);
+            using Node = std::pair<uint64_t, std::size_t>;  // weight and node, so that ties are broken deterministically
+            std::priority_queue<Node, std::vector<Node>, std::greater<>> queue;
+            for (std::size_t i{0}; i < n; ++i) {
+                queue.emplace(weights[i], i);
+            }
+            for (std::size_t next{n}; queue.size() > 1; ++next) {
+                const auto [weight0, node0] = queue.top();
+                queue.pop();
+                const auto [weight1, node1] = queue.top();
+                queue.pop();
+                parents[node0] = next;
+                parents[node1] = next;
+                queue.emplace(weight0 + weight1, next);
+            }
+            // Parents always follow their children, so depths can be computed walking down from the root
+            std::vector<std::size_t> depths(2 * n - 1, 0);
+            for (std::size_t node{2 * n - 2}; node-- > 0;) {
+                depths[node] = depths[parents[node]] + 1;
+            }
+            lengths.assign(depths.cbegin(), depths.cbegin() + static_cast<std::ptrdiff_t>(n));
+        }
+
+        std::iota(table.order.begin(), table.order.end(), 0);
+        std::stable_sort(table.order.begin(), table.order.end(), [&](auto lhs, auto rhs) { return lengths[lhs] < lengths[rhs]; });
+        uint64_t code{0};
+        for (std::size_t i{0}; i < n; ++i) {
+            const std::size_t symbol{table.order[i]};
+            const std::size_t length{lengths[symbol]};
+            ensure(length <= kMaxCodeLength, "Compressor: Huffman code too long: " + std::to_string(length));
+            if (i > 0) {
+                code = (code + 1) << (length - lengths[table.order[i - 1]]);
+            }
+            table.codes[symbol] = Code{reverse_bits(code, length), static_cast<uint8_t>(length)};
+        }
+        return table;
+    }
+
+    //! Build the suffix array of text by prefix doubling on its cyclic shifts
+    //! @details Text must end with a unique symbol, so that sorting cyclic shifts is the same as sorting suffixes
+    std::vector<uint32_t> build_suffix_array(const std::vector<uint32_t>& text, std::size_t alphabet_size) {
+        const std::size_t n{text.size()};
+        std::vector<uint32_t> suffixes(n), classes(n), shifted(n), new_classes(n);
+        std::vector<uint32_t> counts(std::max(alphabet_size, n), 0);
+        for (const auto symbol : text) {
+            ++counts[symbol];
+        }
+        for (std::size_t i{1}; i < alphabet_size; ++i) {
+            counts[i] += counts[i - 1];
+        }
+        for (std::size_t i{n}; i-- > 0;) {
+            suffixes[--counts[text[i]]] = static_cast<uint32_t>(i);
+        }
+        std::size_t num_classes{1};
+        classes[suffixes[0]] = 0;
+        for (std::size_t i{1}; i < n; ++i) {
+            if (text[suffixes[i]] != text[suffixes[i - 1]]) ++num_classes;
+            classes[suffixes[i]] = static_cast<uint32_t>(num_classes - 1);
+        }
+        for (std::size_t h{1}; h < n && num_classes < n; h <<= 1) {
+            // Suffixes are sorted by their first h symbols: sort them by 2h symbols using counting sort on classes
+            for (std::size_t i{0}; i < n; ++i) {
+                shifted[i] = static_cast<uint32_t>((suffixes[i] + n - h) % n);
+            }
+            std::fill_n(counts.begin(), num_classes, 0);
+            for (std::size_t i{0}; i < n; ++i) {
+                ++counts[classes[shifted[i]]];
+            }
+            for (std::size_t i{1}; i < num_classes; ++i) {
+                counts[i] += counts[i - 1];
+            }
+            for (std::size_t i{n}; i-- > 0;) {
+                suffixes[--counts[classes[shifted[i]]]] = shifted[i];
+            }
+            num_classes = 1;
+            new_classes[suffixes[0]] = 0;
+            for (std::size_t i{1}; i < n; ++i) {
+                const std::size_t current{suffixes[i]}, previous{suffixes[i - 1]};
+                if (classes[current] != classes[previous] || classes[(current + h) % n] != classes[(previous + h) % n]) {
+                    ++num_classes;
+                }
+                new_classes[current] = static_cast<uint32_t>(num_classes - 1);
+            }
+            classes.swap(new_classes);
+        }
+        return suffixes;
+    }
+
+    //! Build the array of longest common prefixes between adjacent suffixes in suffix array (Kasai algorithm)
+    std::vector<uint32_t> build_lcp_array(const std::vector<uint32_t>& text, const std::vector<uint32_t>& suffixes) {
+        const std::size_t n{text.size()};
+        std::vector<uint32_t> ranks(n), lcp(n, 0);
+        for (std::size_t i{0}; i < n; ++i) {
+            ranks[suffixes[i]] = static_cast<uint32_t>(i);
+        }
+        std::size_t h{0};
+        for (std::size_t i{0}; i < n; ++i) {
+            if (ranks[i] == 0) {
+                h = 0;
+                continue;
+            }
+            const std::size_t j{suffixes[ranks[i] - 1]};
+            while (i + h < n && j + h < n && text[i + h] == text[j + h]) ++h;
+            lcp[ranks[i]] = static_cast<uint32_t>(h);
+            if (h > 0) --h;
+        }
+        return lcp;
+    }
+
+    //! Pattern extracted from the sample words together with its number of occurrences
+    struct PatternCandidate {
+        Bytes data;
+        uint64_t count{0};
+    };
+
+    //! Extract the repeated substrings of the sample words which save most space
+    //! @details Each interval of the LCP array corresponds to one substring repeated as many times as interval size
+    std::vector<PatternCandidate> extract_patterns(ByteView sample, const std::vector<std::size_t>& sample_ends,
+                                                   const CompressorSettings& settings) {
+        if (sample_ends.empty() || settings.max_patterns == 0) return {};
+        ensure(sample.size() + sample_ends.size() < std::numeric_limits<uint32_t>::max(), "Compressor: sample too big");
+
+        // Words are terminated by distinct separators, so that no repeated substring can span across words
+        std::vector<uint32_t> text;
+        text.reserve(sample.size() + sample_ends.size());
+        uint32_t separator{256};
+        for (std::size_t i{0}, begin{0}; i < sample_ends.size(); begin = sample_ends[i], ++i) {
+            for (std::size_t j{begin}; j < sample_ends[i]; ++j) {
+                text.push_back(sample[j]);
+            }
+            text.push_back(separator++);
+        }
+        const auto suffixes{build_suffix_array(text, separator)};
+        const auto lcp{build_lcp_array(text, suffixes)};
+
+        struct Candidate {
+            uint64_t score{0};
+            uint64_t count{0};
+            std::size_t start{0};
+            std::size_t length{0};
+        };
+        auto by_score = [](const Candidate& lhs, const Candidate& rhs) { return lhs.score > rhs.score; };
+        std::priority_queue<Candidate, std::vector<Candidate>, decltype(by_score)> best{by_score};
+        auto add_candidate = [&](std::size_t length, std::size_t first, std::size_t last) {
+            if (length < settings.min_pattern_length) return;
+            const uint64_t count{last - first + 1};
+            const uint64_t score{(count - 1) * length};  // one occurrence is stored in the dictionary anyway
+            if (best.size() == settings.max_patterns) {
+                if (score <= best.top().score) return;
+                best.pop();
+            }
+            best.push({score, count, suffixes[first], length});
+        };
+
+        // Enumerate LCP intervals using a stack, common prefixes longer than max pattern length are just truncated
+        struct Interval {
+            std::size_t lcp{0};
+            std::size_t first{0};
+        };
+        std::vector<Interval> intervals{{0, 0}};
+        for (std::size_t i{1}; i <= text.size(); ++i) {
+            const std::size_t current_lcp{i < text.size() ? std::min<std::size_t>(lcp[i], settings.max_pattern_length) : 0};
+            std::size_t first{i - 1};
+            while (current_lcp < intervals.back().lcp) {
+                const Interval interval{intervals.back()};
+                intervals.pop_back();
+                add_candidate(interval.lcp, interval.first, i - 1);
+                first = interval.first;
+            }
+            if (current_lcp > intervals.back().lcp) {
+                intervals.push_back({current_lcp, first});
+            }
+        }
+
+        std::vector<PatternCandidate> patterns;
+        patterns.reserve(best.size());
+        for (; !best.empty(); best.pop()) {
+            const Candidate& candidate{best.top()};
+            Bytes data(candidate.length, 0);
+            for (std::size_t i{0}; i < candidate.length; ++i) {
+                data[i] = static_cast<uint8_t>(text[candidate.start + i]);
+            }
+            patterns.push_back({std::move(data), candidate.count});
+        }
+        return patterns;
+    }
+
+    //! Occurrence of one dictionary pattern inside a word
+    struct Match {
+        std::size_t position{0};
+        uint32_t pattern{0};
+    };
+
+    //! Reusable buffers for covering words with patterns
+    struct CoverBuffers {
+        std::vector<uint64_t> costs;
+        std::vector<int64_t> choices;
+    };
+
+    //! Dictionary of patterns able to find the cheapest cover of words
+    //! @details Patterns are stored in a byte trie, so that all the patterns matching at any word position are found
+    //! in one walk no longer than the max pattern length
+    class PatternDictionary {
+      public:
+        explicit PatternDictionary(std::vector<PatternCandidate> candidates) : nodes_(1) {
+            uint64_t total_count{0};
+            for (const auto& candidate : candidates) {
+                total_count += candidate.count;
+            }
+            patterns_.reserve(candidates.size());
+            costs_.reserve(candidates.size());
+            for (auto& candidate : candidates) {
+                // Estimate the code length of each pattern from its frequency in the sample
+                costs_.push_back(static_cast<uint64_t>(std::bit_width(total_count / candidate.count)) + kPositionCostEstimate);
+                patterns_.push_back(std::move(candidate.data));
+                insert(patterns_.back(), static_cast<int32_t>(patterns_.size() - 1));
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const { return patterns_.size(); }
+
+        [[nodiscard]] ByteView pattern(std::size_t i) const { return patterns_[i]; }
+
+        //! Keep only the patterns whose estimated saving on the actual uses exceeds their size in the dictionary
+        [[nodiscard]] std::vector<PatternCandidate> profitable_patterns(const std::vector<uint64_t>& uses) const {
+            const uint64_t total_uses{std::accumulate(uses.cbegin(), uses.cend(), uint64_t{0})};
+            std::vector<PatternCandidate> patterns;
+            for (std::size_t i{0}; i < patterns_.size(); ++i) {
+                if (uses[i] == 0) continue;
+                const uint64_t pattern_bits{patterns_[i].size() * CHAR_BIT};
+                const uint64_t code_bits{static_cast<uint64_t>(std::bit_width(total_uses / uses[i])) + kPositionCostEstimate};
+                const uint64_t saving{code_bits < pattern_bits ? uses[i] * (pattern_bits - code_bits) : 0};
+                if (saving > pattern_bits + kDictionaryEntryCostEstimate) {
+                    patterns.push_back({patterns_[i], uses[i]});
+                }
+            }
+            return patterns;
+        }
+
+        //! Find the sequence of non-overlapping patterns in word with the minimum estimated encoding cost
+        void cover(ByteView word, std::vector<Match>& matches, CoverBuffers& buffers) const {
+            matches.clear();
+            if (patterns_.empty()) return;
+
+            const std::size_t n{word.size()};
+            auto& costs{buffers.costs};
+            auto& choices{buffers.choices};
+            costs.assign(n + 1, 0);
+            choices.assign(n, -1);
+            for (std::size_t i{n}; i-- > 0;) {
+                costs[i] = costs[i + 1] + CHAR_BIT;
+                uint32_t node{0};
+                for (std::size_t j{i}; j < n; ++j) {
+                    node = child(node, word[j]);
+                    if (node == 0) break;
+                    const int32_t pattern_id{nodes_[node].pattern};
+                    if (pattern_id < 0) continue;
+                    const uint64_t cost{costs[j + 1] + costs_[static_cast<std::size_t>(pattern_id)]};
+                    if (cost < costs[i]) {
+                        costs[i] = cost;
+                        choices[i] = pattern_id;
+                    }
+                }
+            }
+            for (std::size_t i{0}; i < n;) {
+                if (choices[i] < 0) {
+                    ++i;
+                    continue;
+                }
+                const auto pattern_id{static_cast<uint32_t>(choices[i])};
+                matches.push_back({i, pattern_id});
+                i += patterns_[pattern_id].size();
+            }
+        }
+
+      private:
+        struct Node {
+            uint32_t first_child{0};   // 0 means no child (root is never a child)
+            uint32_t next_sibling{0};  // 0 means no sibling
+            uint8_t byte{0};
+            int32_t pattern{-1};  // the pattern ending at this node, if any
+        };
+
+        [[nodiscard]] uint32_t child(uint32_t node, uint8_t byte) const {
+            for (uint32_t c{nodes_[node].first_child}; c != 0; c = nodes_[c].next_sibling) {
+                if (nodes_[c].byte == byte) return c;
+            }
+            return 0;
+        }
+
+        void insert(ByteView pattern, int32_t pattern_id) {
+            uint32_t node{0};
+            for (const uint8_t byte : pattern) {
+                uint32_t next{child(node, byte)};
+                if (next == 0) {
+                    next = static_cast<uint32_t>(nodes_.size());
+                    nodes_.push_back({0, nodes_[node].first_child, byte, -1});
+                    nodes_[node].first_child = next;
+                }
+                node = next;
+            }
+            nodes_[node].pattern = pattern_id;
+        }
+
+        std::vector<Bytes> patterns_;
+        std::vector<uint64_t> costs_;  // estimated cost in bits of encoding each pattern
+        std::vector<Node> nodes_;      // pattern trie, root is the first node
+    };
+
+    //! Batch of words read from the intermediate file
+    struct WordBatch {
+        Bytes data;
+        std::vector<std::size_t> ends;
+        std::vector<uint8_t> compressed;
+
+        [[nodiscard]] std::size_t size() const { return ends.size(); }
+
+        [[nodiscard]] ByteView word(std::size_t i) const {
+            const std::size_t begin{i == 0 ? 0 : ends[i - 1]};
+            return ByteView{data}.substr(begin, ends[i] - begin);
+        }
+    };
+
+    bool read_batch(std::istream& input, WordBatch& batch) {
+        while (batch.size() < kBatchWords && batch.data.size() < kBatchBytes) {
+            const auto header{read_varint(input)};
+            if (!header) break;
+            const std::size_t length{*header >> 1};
+            const std::size_t offset{batch.data.size()};
+            batch.data.resize(offset + length);
+            input.read(byte_ptr_cast(batch.data.data() + offset), static_cast<std::streamsize>(length));
+            if (!input) throw std::runtime_error{"intermediate word file is invalid: truncated word"};
+            batch.ends.push_back(batch.data.size());
+            batch.compressed.push_back((*header & 1) == 0);
+        }
+        return batch.size() > 0;
+    }
+
+    //! Process the intermediate file in batches of words on the workers, merging the results in file order
+    template <typename Process, typename Merge>
+    void process_batches(std::istream& input, ThreadPool& workers, const Process& process, const Merge& merge) {
+        using Result = std::invoke_result_t<const Process&, const WordBatch&>;
+        std::deque<std::future<Result>> pending;
+        // Tasks refer to process, so wait for any submitted task before leaving
+        [[maybe_unused]] auto _ = gsl::finally([&]() {
+            for (auto& result : pending) result.wait();
+        });
+        const std::size_t max_pending{2 * std::max<std::size_t>(1, workers.get_thread_count())};
+        while (true) {
+            auto batch{std::make_shared<WordBatch>()};
+            if (!read_batch(input, *batch)) break;
+            pending.push_back(workers.submit([&process, batch]() { return process(*batch); }));
+            if (pending.size() == max_pending) {
+                merge(pending.front().get());
+                pending.pop_front();
+            }
+        }
+        for (; !pending.empty(); pending.pop_front()) {
+            merge(pending.front().get());
+        }
+    }
+
+    void write_bytes(std::ostream& output, ByteView bytes) {
+        output.write(byte_ptr_cast(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    void write_big_u64(std::ostream& output, uint64_t value) {
+        uint8_t bytes[sizeof(uint64_t)];
+        endian::store_big_u64(bytes, value);
+        write_bytes(output, ByteView{bytes, sizeof(uint64_t)});
+    }
+
+}  // namespace
+
+Compressor::Compressor(std::filesystem::path compressed_path, CompressorSettings settings)
+    : compressed_path_(std::move(compressed_path)), settings_(std::move(settings)) {
+    ensure_pre_condition(settings_.min_pattern_length > 0 && settings_.min_pattern_length <= settings_.max_pattern_length,
+                         "Compressor: invalid pattern length range");
+    const auto tmp_dir{settings_.tmp_dir.empty() ? compressed_path_.parent_path() : settings_.tmp_dir};
+    words_path_ = tmp_dir / (compressed_path_.filename().string() + ".words.tmp");
+    words_file_.open(words_path_, std::ios::binary | std::ios::trunc);
+    if (!words_file_) {
+        throw std::runtime_error{"cannot create intermediate word file: " + words_path_.string()};
+    }
+}
+
+Compressor::~Compressor() {
+    words_file_.close();
+    std::error_code ec;
+    std::filesystem::remove(words_path_, ec);
+}
+
+void Compressor::add_word(ByteView word) {
+    add_word(word, /*compressed=*/true);
+}
+
+void Compressor::add_uncompressed_word(ByteView word) {
+    add_word(word, /*compressed=*/false);
+}
+
+void Compressor::add_word(ByteView word, bool compressed) {
+    if (word.size() > kMaxWordLength) {
+        throw std::invalid_argument{"word is too long: " + std::to_string(word.size())};
+    }
+    Bytes header;
+    encode_varint((word.size() << 1) | (compressed ? 0 : 1), header);
+    write_bytes(words_file_, header);
+    write_bytes(words_file_, word);
+    if (!words_file_) {
+        throw std::runtime_error{"cannot write intermediate word file: " + words_path_.string()};
+    }
+
+    ++words_count_;
+    if (word.empty()) {
+        ++empty_words_count_;
+    }
+    if (compressed) {
+        sample_word(word);
+    }
+}
+
+void Compressor::sample_word(ByteView word) {
+    if (compressed_words_count_++ % sample_stride_ != 0) return;
+    if (word.empty() || word.size() > settings_.dictionary_sample_size) return;
+
+    sample_.append(word);
+    sample_ends_.push_back(sample_.size());
+
+    // Keep the sample within its budget halving it, so that it stays evenly spread over all the words
+    while (sample_.size() > settings_.dictionary_sample_size) {
+        Bytes kept_sample;
+        std::vector<std::size_t> kept_ends;
+        for (std::size_t i{0}, begin{0}; i < sample_ends_.size(); begin = sample_ends_[i], i += 2) {
+            kept_sample.append(sample_, begin, sample_ends_[i] - begin);
+            kept_ends.push_back(kept_sample.size());
+            if (i + 1 == sample_ends_.size()) break;
+        }
+        sample_.swap(kept_sample);
+        sample_ends_.swap(kept_ends);
+        sample_stride_ *= 2;
+    }
+}
+
+void Compressor::compress() {
+    words_file_.close();
+    if (!words_file_) {
+        throw std::runtime_error{"cannot close intermediate word file: " + words_path_.string()};
+    }
+    SILK_TRACE << "Compressor words count: " << words_count_ << " empty words count: " << empty_words_count_
+               << " sample size: " << sample_.size();
+
+    // Build the pattern dictionary from the word sample
+    PatternDictionary dictionary{extract_patterns(sample_, sample_ends_, settings_)};
+    Bytes{}.swap(sample_);
+    std::vector<std::size_t>{}.swap(sample_ends_);
+    SILK_TRACE << "Compressor dictionary patterns: " << dictionary.size();
+
+    ThreadPool workers{static_cast<unsigned>(std::max<std::size_t>(1, settings_.num_threads))};
+    std::ifstream words_input{words_path_, std::ios::binary};
+    if (!words_input) {
+        throw std::runtime_error{"cannot open intermediate word file: " + words_path_.string()};
+    }
+
+    // First pass (repeated while pruning): cover words in parallel and count the uses of each pattern and position
+    struct Uses {
+        std::vector<uint64_t> patterns;
+        absl::flat_hash_map<uint64_t, uint64_t> positions;
+    };
+    auto count_uses = [&dictionary](const WordBatch& batch) {
+        Uses uses{std::vector<uint64_t>(dictionary.size(), 0), {}};
+        CoverBuffers buffers;
+        std::vector<Match> matches;
+        for (std::size_t i{0}; i < batch.size(); ++i) {
+            const ByteView word{batch.word(i)};
+            ++uses.positions[word.size() + 1];  // 0 is terminator
+            if (word.empty()) continue;
+            if (batch.compressed[i]) {
+                dictionary.cover(word, matches, buffers);
+                std::size_t previous_position{0};
+                for (const auto& match : matches) {
+                    ++uses.positions[match.position - previous_position + 1];
+                    ++uses.patterns[match.pattern];
+                    previous_position = match.position;
+                }
+            }
+            ++uses.positions[0];
+        }
+        return uses;
+    };
+    Uses total_uses;
+    for (std::size_t round{0};; ++round) {
+        total_uses = {std::vector<uint64_t>(dictionary.size(), 0), {}};
+        process_batches(words_input, workers, count_uses, [&total_uses](Uses&& uses) {
+            for (std::size_t i{0}; i < uses.patterns.size(); ++i) {
+                total_uses.patterns[i] += uses.patterns[i];
+            }
+            for (const auto& [position, count] : uses.positions) {
+                total_uses.positions[position] += count;
+            }
+        });
+        words_input.clear();
+        words_input.seekg(0);
+        if (round == kDictionaryPruneRounds) break;
+
+        // Patterns found in the sample may turn out to be used too little to pay off, drop them and cover again
+        auto patterns{dictionary.profitable_patterns(total_uses.patterns)};
+        if (patterns.size() == dictionary.size()) break;
+        dictionary = PatternDictionary{std::move(patterns)};
+        SILK_TRACE << "Compressor dictionary patterns after round " << round << ": " << dictionary.size();
+    }
+
+    // Assign Huffman codes to patterns in use, the others are dropped from the dictionary
+    std::vector<std::size_t> used_patterns;
+    std::vector<uint64_t> pattern_weights;
+    for (std::size_t i{0}; i < total_uses.patterns.size(); ++i) {
+        if (total_uses.patterns[i] > 0) {
+            used_patterns.push_back(i);
+            pattern_weights.push_back(total_uses.patterns[i]);
+        }
+    }
+    const HuffmanTable pattern_table{build_huffman_table(pattern_weights)};
+    std::vector<Code> pattern_codes(dictionary.size());
+    for (std::size_t symbol{0}; symbol < used_patterns.size(); ++symbol) {
+        pattern_codes[used_patterns[symbol]] = pattern_table.codes[symbol];
+    }
+
+    // Assign Huffman codes to positions, sorted by value to make the output deterministic
+    std::vector<std::pair<uint64_t, uint64_t>> positions{total_uses.positions.cbegin(), total_uses.positions.cend()};
+    std::sort(positions.begin(), positions.end());
+    std::vector<uint64_t> position_weights;
+    position_weights.reserve(positions.size());
+    for (const auto& [_, count] : positions) {
+        position_weights.push_back(count);
+    }
+    const HuffmanTable position_table{build_huffman_table(position_weights)};
+    absl::flat_hash_map<uint64_t, Code> position_codes;
+    for (std::size_t symbol{0}; symbol < positions.size(); ++symbol) {
+        position_codes[positions[symbol].first] = position_table.codes[symbol];
+    }
+
+    Bytes pattern_dict;
+    for (const auto symbol : pattern_table.order) {
+        const ByteView pattern{dictionary.pattern(used_patterns[symbol])};
+        encode_varint(pattern_table.codes[symbol].length, pattern_dict);
+        encode_varint(pattern.size(), pattern_dict);
+        pattern_dict.append(pattern);
+    }
+    Bytes position_dict;
+    for (const auto symbol : position_table.order) {
+        encode_varint(position_table.codes[symbol].length, position_dict);
+        encode_varint(positions[symbol].first, position_dict);
+    }
+    SILK_TRACE << "Compressor used patterns: " << used_patterns.size() << " positions: " << positions.size();
+
+    // Write the compressed file under temporary name, so that it appears only when complete
+    const std::filesystem::path tmp_path{compressed_path_.string() + ".tmp"};
+    std::ofstream output{tmp_path, std::ios::binary | std::ios::trunc};
+    if (!output) {
+        throw std::runtime_error{"cannot create compressed file: " + tmp_path.string()};
+    }
+    write_big_u64(output, words_count_);
+    write_big_u64(output, empty_words_count_);
+    write_big_u64(output, pattern_dict.size());
+    write_bytes(output, pattern_dict);
+    write_big_u64(output, position_dict.size());
+    write_bytes(output, position_dict);
+
+    // Second pass: cover words again in parallel and encode them, each word starts at byte boundary
+    auto encode_words = [&](const WordBatch& batch) {
+        Bytes encoded;
+        encoded.reserve(batch.data.size());
+        BitWriter writer{encoded};
+        CoverBuffers buffers;
+        std::vector<Match> matches;
+        Bytes uncovered;
+        for (std::size_t i{0}; i < batch.size(); ++i) {
+            const ByteView word{batch.word(i)};
+            writer.write(position_codes.at(word.size() + 1));
+            if (word.empty()) {
+                writer.align();
+                continue;
+            }
+            uncovered.clear();
+            std::size_t last_uncovered{0};
+            if (batch.compressed[i]) {
+                dictionary.cover(word, matches, buffers);
+                std::size_t previous_position{0};
+                for (const auto& match : matches) {
+                    // Positions where to insert patterns are encoded relative to one another
+                    writer.write(position_codes.at(match.position - previous_position + 1));
+                    writer.write(pattern_codes[match.pattern]);
+                    uncovered.append(word.substr(last_uncovered, match.position - last_uncovered));
+                    last_uncovered = match.position + dictionary.pattern(match.pattern).size();
+                    previous_position = match.position;
+                }
+            }
+            uncovered.append(word.substr(last_uncovered));
+            writer.write(position_codes.at(0));
+            writer.align();
+            encoded.append(uncovered);
+        }
+        return encoded;
+    };
+    process_batches(words_input, workers, encode_words, [&output](Bytes&& encoded) {
+        write_bytes(output, encoded);
+    });
+
+    output.close();
+    if (!output) {
+        throw std::runtime_error{"cannot write compressed file: " + tmp_path.string()};
+    }
+    std::filesystem::rename(tmp_path, compressed_path_);
+    SILK_TRACE << "Compressor file: " << compressed_path_.string() << " size: " << std::filesystem::file_size(compressed_path_);
+
+    words_input.close();
+    std::filesystem::remove(words_path_);
+}
+
+}  // namespace silkworm::huffman
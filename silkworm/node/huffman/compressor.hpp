@@ -0,0 +1,97 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/common/bytes.hpp>
+
+namespace silkworm::huffman {
+
+struct CompressorSettings {
+    std::filesystem::path tmp_dir;                                               // Where intermediate files go (default: output dir)
+    std::size_t num_threads{std::max(1u, std::thread::hardware_concurrency())};  // Number of threads compressing words
+    std::size_t min_pattern_length{5};                                           // Min length of dictionary patterns
+    std::size_t max_pattern_length{128};                                         // Max length of dictionary patterns
+    std::size_t max_patterns{64 * 1024};                                         // Max number of dictionary patterns
+    std::size_t dictionary_sample_size{4_Mebi};                                  // Max size of word sample used to build dictionary
+};
+
+//! Snapshot encoder producing compressed files in the format read by Decompressor
+//! @details Words are first spooled into an intermediate file. Compression then extracts a dictionary of repeated
+//! patterns from a sample of the words, covers each word with the cheapest sequence of patterns in parallel and
+//! finally encodes patterns and positions using canonical Huffman codes
+class Compressor {
+  public:
+    explicit Compressor(std::filesystem::path compressed_path, CompressorSettings settings = {});
+    ~Compressor();
+
+    Compressor(const Compressor&) = delete;
+    Compressor& operator=(const Compressor&) = delete;
+
+    [[nodiscard]] const std::filesystem::path& compressed_path() const { return compressed_path_; }
+
+    //! The number of words added so far
+    [[nodiscard]] uint64_t words_count() const { return words_count_; }
+
+    //! The number of *empty* words added so far
+    [[nodiscard]] uint64_t empty_words_count() const { return empty_words_count_; }
+
+    //! Add one word to be compressed using patterns, i.e. to be read back by Decompressor::Iterator::next
+    void add_word(ByteView word);
+
+    //! Add one word to be stored as it is, i.e. to be read back by Decompressor::Iterator::next_uncompressed
+    void add_uncompressed_word(ByteView word);
+
+    //! Build the dictionaries and write the compressed file, which appears atomically at the compressed path
+    void compress();
+
+  private:
+    void add_word(ByteView word, bool compressed);
+    void sample_word(ByteView word);
+
+    //! The path to the compressed file
+    std::filesystem::path compressed_path_;
+
+    //! The compression settings
+    CompressorSettings settings_;
+
+    //! The intermediate file where words are spooled until compression
+    std::filesystem::path words_path_;
+    std::ofstream words_file_;
+
+    //! The number of words in the data
+    uint64_t words_count_{0};
+
+    //! The number of *empty* words in the data
+    uint64_t empty_words_count_{0};
+
+    //! The number of words to be compressed using patterns
+    uint64_t compressed_words_count_{0};
+
+    //! Sample of words used to build the pattern dictionary: one word every sample_stride_ words is kept
+    Bytes sample_;
+    std::vector<std::size_t> sample_ends_;
+    uint64_t sample_stride_{1};
+};
+
+}  // namespace silkworm::huffman
@@ -0,0 +1,203 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "compressor.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/infra/common/directories.hpp>
+#include <silkworm/node/huffman/decompressor.hpp>
+
+namespace silkworm::huffman {
+
+struct TestWord {
+    Bytes data;
+    bool compressed{true};
+};
+
+static std::filesystem::path compress(const std::filesystem::path& dir, const std::vector<TestWord>& words,
+                                      CompressorSettings settings = {}) {
+    const auto compressed_path{dir / "test.seg"};
+    std::filesystem::remove(compressed_path);
+    Compressor compressor{compressed_path, std::move(settings)};
+    for (const auto& word : words) {
+        if (word.compressed) {
+            compressor.add_word(word.data);
+        } else {
+            compressor.add_uncompressed_word(word.data);
+        }
+    }
+    CHECK(compressor.words_count() == words.size());
+    compressor.compress();
+    return compressed_path;
+}
+
+//! Check that Decompressor reads back exactly the same words
+static void check_words(const std::filesystem::path& compressed_path, const std::vector<TestWord>& words) {
+    Decompressor decoder{compressed_path};
+    REQUIRE_NOTHROW(decoder.open());
+    CHECK(decoder.words_count() == words.size());
+    const auto empty_words_count{std::count_if(words.cbegin(), words.cend(), [](const auto& w) { return w.data.empty(); })};
+    CHECK(decoder.empty_words_count() == static_cast<uint64_t>(empty_words_count));
+    auto it = decoder.make_iterator();
+    for (const auto& word : words) {
+        REQUIRE(it.has_next());
+        if (word.compressed) {
+            CHECK(it.has_prefix(ByteView{word.data}.substr(0, 3)));
+        }
+        Bytes decoded_word;
+        if (word.compressed) {
+            it.next(decoded_word);
+        } else {
+            it.next_uncompressed(decoded_word);
+        }
+        CHECK(decoded_word == word.data);
+    }
+    CHECK_FALSE(it.has_next());
+}
+
+static Bytes bytes_of(const std::string& s) {
+    return Bytes{s.cbegin(), s.cend()};
+}
+
+static std::vector<TestWord> lorem_ipsum_words() {
+    static const std::vector<std::string> kLoremIpsum{
+        "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit", "sed", "do", "eiusmod",
+        "tempor", "incididunt", "ut", "labore", "et", "dolore", "magna", "aliqua"};
+    std::vector<TestWord> words;
+    for (std::size_t i{0}; i < 1'000; ++i) {
+        std::string sentence;
+        for (std::size_t j{0}; j < i % 7 + 1; ++j) {
+            sentence += kLoremIpsum[(i * 3 + j) % kLoremIpsum.size()] + " ";
+        }
+        words.push_back({bytes_of(sentence + std::to_string(i)), i % 3 != 0});
+    }
+    return words;
+}
+
+//! Words looking like RLP-encoded records: long runs of zeros, a few repeated templates and random fields
+static std::vector<TestWord> record_like_words(std::size_t count, uint32_t seed) {
+    std::mt19937 rng{seed};
+    std::vector<Bytes> templates;
+    for (std::size_t i{0}; i < 8; ++i) {
+        Bytes t(32 + rng() % 200, 0);
+        for (auto& b : t) {
+            b = rng() % 4 == 0 ? static_cast<uint8_t>(rng()) : 0;
+        }
+        templates.push_back(std::move(t));
+    }
+    std::vector<TestWord> words;
+    words.reserve(count);
+    for (std::size_t i{0}; i < count; ++i) {
+        Bytes data;
+        if (rng() % 50 != 0) {  // some empty words
+            data = templates[rng() % templates.size()];
+            for (std::size_t j{0}; j < 4; ++j) {
+                data[rng() % data.size()] = static_cast<uint8_t>(rng());
+            }
+            data.resize(data.size() + rng() % 8, static_cast<uint8_t>(i));
+        }
+        words.push_back({std::move(data), rng() % 10 != 0});
+    }
+    return words;
+}
+
+TEST_CASE("Compressor: no words", "[silkworm][node][huffman][compressor]") {
+    TemporaryDirectory tmp_dir;
+    check_words(compress(tmp_dir.path(), {}), {});
+}
+
+TEST_CASE("Compressor: empty words only", "[silkworm][node][huffman][compressor]") {
+    TemporaryDirectory tmp_dir;
+    const std::vector<TestWord> words{{}, {{}, false}, {}};
+    check_words(compress(tmp_dir.path(), words), words);
+}
+
+TEST_CASE("Compressor: single word", "[silkworm][node][huffman][compressor]") {
+    TemporaryDirectory tmp_dir;
+    const std::vector<TestWord> words{{bytes_of("hello, world")}};
+    check_words(compress(tmp_dir.path(), words), words);
+}
+
+TEST_CASE("Compressor: lorem ipsum", "[silkworm][node][huffman][compressor]") {
+    TemporaryDirectory tmp_dir;
+    const auto words{lorem_ipsum_words()};
+    check_words(compress(tmp_dir.path(), words), words);
+}
+
+TEST_CASE("Compressor: record-like words", "[silkworm][node][huffman][compressor]") {
+    TemporaryDirectory tmp_dir;
+    const auto words{record_like_words(5'000, 42)};
+    std::size_t raw_size{0};
+    for (const auto& word : words) {
+        raw_size += word.data.size();
+    }
+
+    SECTION("default settings") {
+        const auto compressed_path{compress(tmp_dir.path(), words)};
+        check_words(compressed_path, words);
+        CHECK(std::filesystem::file_size(compressed_path) < raw_size / 2);
+    }
+    SECTION("sample smaller than data") {
+        check_words(compress(tmp_dir.path(), words, {.num_threads = 3, .dictionary_sample_size = 4_Kibi}), words);
+    }
+    SECTION("long patterns only") {
+        check_words(compress(tmp_dir.path(), words, {.min_pattern_length = 20, .max_pattern_length = 40}), words);
+    }
+    SECTION("no patterns") {
+        check_words(compress(tmp_dir.path(), words, {.max_patterns = 0}), words);
+    }
+}
+
+TEST_CASE("Compressor: multiple batches", "[silkworm][node][huffman][compressor]") {
+    TemporaryDirectory tmp_dir;
+    std::vector<TestWord> words;
+    for (std::size_t i{0}; i < 100'000; ++i) {
+        words.push_back({bytes_of("word" + std::to_string(i % 1'000) + "-" + std::to_string(i))});
+    }
+    check_words(compress(tmp_dir.path(), words, {.num_threads = 2}), words);
+}
+
+TEST_CASE("Compressor: output is deterministic", "[silkworm][node][huffman][compressor]") {
+    TemporaryDirectory tmp_dir1, tmp_dir2;
+    const auto words{record_like_words(2'000, 7)};
+    const auto path1{compress(tmp_dir1.path(), words, {.num_threads = 1})};
+    const auto path2{compress(tmp_dir2.path(), words, {.num_threads = 4})};
+    std::ifstream file1{path1, std::ios::binary}, file2{path2, std::ios::binary};
+    const std::string content1{std::istreambuf_iterator<char>{file1}, {}};
+    const std::string content2{std::istreambuf_iterator<char>{file2}, {}};
+    CHECK(content1 == content2);
+}
+
+TEST_CASE("Compressor: intermediate files are removed", "[silkworm][node][huffman][compressor]") {
+    TemporaryDirectory tmp_dir;
+    const auto words{lorem_ipsum_words()};
+    compress(tmp_dir.path(), words);
+    std::size_t file_count{0};
+    for ([[maybe_unused]] const auto& entry : std::filesystem::directory_iterator{tmp_dir.path()}) {
+        ++file_count;
+    }
+    CHECK(file_count == 1);
+}
+
+}  // namespace silkworm::huffman
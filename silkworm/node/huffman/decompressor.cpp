@@ -16,7 +16,11 @@
 
 #include "decompressor.hpp"
 
+#include <algorithm>
 #include <bitset>
+#include <cstring>
+#include <exception>
+#include <future>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -296,8 +300,125 @@ std::ostream& operator<<(std::ostream& out, const PositionTable& pt) {
     return out;
 }
 
-Decompressor::Decompressor(std::filesystem::path compressed_path, std::optional<MemoryMappedRegion> compressed_region)
-    : compressed_path_(std::move(compressed_path)), compressed_region_{compressed_region} {}
+//! Max number of entries in lookup tables including all subtables (codes needing more entries are left to trees)
+constexpr std::size_t kMaxLookupTableEntries{std::size_t{1} << 20};
+
+//! Reverse the lowest bit_length bits of the specified code
+static uint64_t reverse_bits(uint64_t code, uint64_t bit_length) {
+    uint64_t reversed{0};
+    for (uint64_t i{0}; i < bit_length; ++i) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    return reversed;
+}
+
+bool LookupTable::build(std::span<const uint64_t> depths, std::span<const uint32_t> symbols) {
+    SILKWORM_ASSERT(depths.size() == symbols.size());
+    entries_.assign(1, Entry{});
+    root_bit_length_ = 0;
+    root_mask_ = 0;
+    if (depths.empty()) {
+        return true;
+    }
+
+    // Assign codes in tree order like tree-based tables do: left branch first, code bits read starting from the root
+    std::vector<uint64_t> codes(depths.size());
+    uint64_t max_depth{0};
+    for (std::size_t i{0}; i < depths.size(); ++i) {
+        const uint64_t depth{depths[i]};
+        if (depth >= 64) {
+            return false;
+        }
+        if (i > 0) {
+            const uint64_t previous_depth{depths[i - 1]};
+            uint64_t code{codes[i - 1] + 1};
+            if ((code >> previous_depth) != 0) {
+                return false;  // no more codes available
+            }
+            if (depth >= previous_depth) {
+                code <<= depth - previous_depth;
+            } else {
+                if ((code & ((uint64_t{1} << (previous_depth - depth)) - 1)) != 0) {
+                    return false;  // not in tree order
+                }
+                code >>= previous_depth - depth;
+            }
+            codes[i] = code;
+        }
+        max_depth = std::max(max_depth, depth);
+    }
+
+    // Codes are read starting from the lowest bit, so entries are indexed by reversed codes
+    for (std::size_t i{0}; i < codes.size(); ++i) {
+        codes[i] = reverse_bits(codes[i], depths[i]);
+    }
+
+    root_bit_length_ = std::min(kRootBitLength, static_cast<std::size_t>(max_depth));
+    root_mask_ = (uint64_t{1} << root_bit_length_) - 1;
+    const std::size_t root_size{std::size_t{1} << root_bit_length_};
+    entries_.assign(root_size, Entry{});
+
+    // Short codes fill all root entries sharing their bits, long codes just determine their subtable size
+    std::vector<uint64_t> subtable_depths(root_size, 0);
+    for (std::size_t i{0}; i < codes.size(); ++i) {
+        const uint64_t depth{depths[i]};
+        if (depth <= root_bit_length_) {
+            for (uint64_t index{codes[i]}; index < root_size; index += uint64_t{1} << depth) {
+                entries_[index] = {symbols[i], 0, static_cast<uint8_t>(depth), kNoNextSymbol, EntryKind::kSymbol};
+            }
+        } else {
+            auto& subtable_depth{subtable_depths[codes[i] & root_mask_]};
+            subtable_depth = std::max(subtable_depth, depth - root_bit_length_);
+        }
+    }
+    for (std::size_t index{0}; index < root_size; ++index) {
+        const uint64_t subtable_bit_length{subtable_depths[index]};
+        if (subtable_bit_length == 0 || subtable_bit_length > kMaxSubtableBitLength) {
+            continue;
+        }
+        const std::size_t subtable_size{std::size_t{1} << subtable_bit_length};
+        if (entries_.size() + subtable_size > kMaxLookupTableEntries) {
+            continue;
+        }
+        entries_[index] = {static_cast<uint32_t>(entries_.size()), 0, static_cast<uint8_t>(subtable_bit_length),
+                           kNoNextSymbol, EntryKind::kSubtable};
+        entries_.resize(entries_.size() + subtable_size);
+    }
+    for (std::size_t i{0}; i < codes.size(); ++i) {
+        const uint64_t depth{depths[i]};
+        const Entry& root_entry{entries_[codes[i] & root_mask_]};
+        if (depth <= root_bit_length_ || root_entry.kind != EntryKind::kSubtable) {
+            continue;
+        }
+        const std::size_t subtable_offset{root_entry.symbol};
+        const std::size_t subtable_size{std::size_t{1} << root_entry.length};
+        for (uint64_t index{codes[i] >> root_bit_length_}; index < subtable_size; index += uint64_t{1} << (depth - root_bit_length_)) {
+            entries_[subtable_offset + index] = {symbols[i], 0, static_cast<uint8_t>(depth), kNoNextSymbol, EntryKind::kSymbol};
+        }
+    }
+    return true;
+}
+
+void LookupTable::combine(const LookupTable& next_table, uint32_t terminator) {
+    const std::size_t root_size{std::size_t{1} << root_bit_length_};
+    for (std::size_t index{0}; index < root_size; ++index) {
+        Entry& entry{entries_[index]};
+        if (entry.kind != EntryKind::kSymbol || entry.symbol == terminator) {
+            continue;
+        }
+        // The bits following this code in the index are the same for all the replicated entries of next code
+        const std::size_t spare_bit_length{root_bit_length_ - entry.length};
+        const Entry& next_entry{next_table.entries_[(index >> entry.length) & next_table.root_mask_]};
+        if (next_entry.kind == EntryKind::kSymbol && next_entry.length <= spare_bit_length) {
+            entry.next_symbol = next_entry.symbol;
+            entry.next_length = next_entry.length;
+        }
+    }
+}
+
+Decompressor::Decompressor(std::filesystem::path compressed_path, std::optional<MemoryMappedRegion> compressed_region,
+                           bool table_driven)
+    : compressed_path_(std::move(compressed_path)), compressed_region_{compressed_region}, table_driven_decoding_{table_driven} {}
 
 Decompressor::~Decompressor() {
     close();
@@ -322,6 +443,8 @@ void Decompressor::open() {
     const auto pattern_dict_length = endian::load_big_u64(address + kWordsCountSize + kEmptyWordsCountSize);
     SILK_TRACE << "Decompress pattern dictionary length: " << pattern_dict_length;
 
+    table_driven_ = table_driven_decoding_;
+
     const std::size_t patterns_dict_offset{kWordsCountSize + kEmptyWordsCountSize + kDictionaryLengthSize};
     read_patterns(ByteView{address + patterns_dict_offset, pattern_dict_length});
 
@@ -332,6 +455,13 @@ void Decompressor::open() {
     const std::size_t positions_dict_offset{patterns_dict_offset + pattern_dict_length + kDictionaryLengthSize};
     read_positions(ByteView{address + positions_dict_offset, position_dict_length});
 
+    // Each non-terminator position is followed by one pattern, so decode both at once whenever possible
+    if (table_driven_) {
+        position_lookup_.combine(pattern_lookup_, 0);
+    }
+    SILK_TRACE << "Decompressor table-driven: " << table_driven_ << " pattern lookup entries: "
+               << pattern_lookup_.num_entries() << " position lookup entries: " << position_lookup_.num_entries();
+
     // Store the start offset and length of the data words
     words_start_ = address + positions_dict_offset + position_dict_length;
     words_length_ = compressed_file_->length() - (positions_dict_offset + position_dict_length);
@@ -350,6 +480,56 @@ bool Decompressor::read_ahead(ReadAheadFuncRef fn) {
     return fn(it);
 }
 
+std::vector<Decompressor::WordRange> Decompressor::split_words(uint64_t max_words_per_range) const {
+    ensure(bool(compressed_file_), "decompressor closed, call open first");
+    ensure_pre_condition(max_words_per_range > 0, "Decompressor::split_words: zero words per range");
+
+    std::vector<WordRange> ranges;
+    ranges.reserve((words_count_ + max_words_per_range - 1) / max_words_per_range);
+    Iterator it{this};
+    uint64_t word_count{0}, offset{0};
+    while (it.has_next()) {
+        if (word_count % max_words_per_range == 0) {
+            ranges.push_back({word_count, 0, offset});
+        }
+        offset = it.skip();
+        ++ranges.back().word_count;
+        ++word_count;
+    }
+    return ranges;
+}
+
+bool Decompressor::read_ranges(std::span<const WordRange> ranges, ThreadPool& workers, WordRangeFuncRef fn) {
+    ensure(bool(compressed_file_), "decompressor closed, call open first");
+    compressed_file_->advise_sequential();
+    [[maybe_unused]] auto _ = gsl::finally([&]() { compressed_file_->advise_random(); });
+
+    std::vector<std::future<bool>> results;
+    results.reserve(ranges.size());
+    for (const auto& range : ranges) {
+        results.push_back(workers.submit([this, &range, fn]() {
+            Iterator it{this};
+            it.reset(range.offset);
+            return fn(range, it);
+        }));
+    }
+
+    // Tasks refer to ranges and fn, so wait for all of them before reporting any failure
+    bool read_ok{true};
+    std::exception_ptr first_exception;
+    for (auto& result : results) {
+        try {
+            read_ok = result.get() && read_ok;
+        } catch (...) {
+            if (!first_exception) first_exception = std::current_exception();
+        }
+    }
+    if (first_exception) {
+        std::rethrow_exception(first_exception);
+    }
+    return read_ok;
+}
+
 void Decompressor::close() {
     compressed_file_.reset();
 }
@@ -415,6 +595,21 @@ void Decompressor::read_patterns(ByteView dict) {
 
     SILK_TRACE << "#codewords: " << pattern_dict_->num_codewords();
     SILK_TRACE << *pattern_dict_;
+
+    if (table_driven_) {
+        std::vector<uint64_t> depths;
+        std::vector<uint32_t> symbols;
+        depths.reserve(patterns.size());
+        symbols.reserve(patterns.size());
+        patterns_.clear();
+        patterns_.reserve(patterns.size());
+        for (const auto& pattern : patterns) {
+            depths.push_back(pattern.depth);
+            symbols.push_back(static_cast<uint32_t>(patterns_.size()));
+            patterns_.push_back(pattern.value);
+        }
+        table_driven_ = pattern_lookup_.build(depths, symbols);
+    }
 }
 
 void Decompressor::read_positions(ByteView dict) {
@@ -471,6 +666,18 @@ void Decompressor::read_positions(ByteView dict) {
 
     SILK_TRACE << "#positions: " << position_dict_->num_positions();
     SILK_TRACE << *position_dict_;
+
+    if (table_driven_) {
+        std::vector<uint64_t> depths;
+        std::vector<uint32_t> symbols;
+        depths.reserve(positions.size());
+        symbols.reserve(positions.size());
+        for (const auto& position : positions) {
+            depths.push_back(position.depth);
+            symbols.push_back(static_cast<uint32_t>(position.value));
+        }
+        table_driven_ = position_lookup_.build(depths, symbols);
+    }
 }
 
 Decompressor::Iterator::Iterator(const Decompressor* decoder) : decoder_(decoder) {}
@@ -559,6 +766,127 @@ ByteView Decompressor::Iterator::data() const {
 }
 
 uint64_t Decompressor::Iterator::next(Bytes& buffer) {
+    if (decoder_->table_driven_) {
+        if (const auto next_offset{next_by_table(buffer)}) {
+            return *next_offset;
+        }
+    }
+    return next_by_tree(buffer);
+}
+
+uint64_t Decompressor::Iterator::peek_bits(uint64_t bit_offset) const {
+    const uint64_t byte_offset{bit_offset / CHAR_BIT};
+    const uint8_t* bytes{decoder_->words_start_ + byte_offset};
+    uint64_t bits{0};
+    if (byte_offset + sizeof(uint64_t) <= decoder_->words_length_) {
+        bits = endian::load_little_u64(bytes);
+    } else {
+        // Bits past the end of data stream read as zero like in next_code
+        for (std::size_t i{0}; byte_offset + i < decoder_->words_length_; ++i) {
+            bits |= uint64_t{bytes[i]} << (i * CHAR_BIT);
+        }
+    }
+    return bits >> (bit_offset % CHAR_BIT);
+}
+
+//! Copy size bytes from source to destination, copying fixed 16 bytes for short sizes when there is enough room
+//! @details The bytes copied past size must be overwritten afterwards, which holds copying left to right
+static inline void copy_word_part(uint8_t* dst, const uint8_t* dst_end, const uint8_t* src, const uint8_t* src_end, std::size_t size) {
+    constexpr std::size_t kFixedCopySize{16};
+    if (size <= kFixedCopySize && dst + kFixedCopySize <= dst_end && src + kFixedCopySize <= src_end) {
+        std::memcpy(dst, src, kFixedCopySize);
+    } else if (size > 0) {
+        std::memcpy(dst, src, size);
+    }
+}
+
+std::optional<Decompressor::Iterator::WordLayout> Decompressor::Iterator::decode_by_table() {
+    const LookupTable& position_lookup{decoder_->position_lookup_};
+    const LookupTable& pattern_lookup{decoder_->pattern_lookup_};
+    const uint64_t data_bit_length{decoder_->words_length_ * CHAR_BIT};
+
+    uint64_t bit_offset{(word_offset_ + (bit_position_ > 0 ? 1 : 0)) * CHAR_BIT};
+    const auto& length_entry{position_lookup.lookup(peek_bits(bit_offset))};
+    if (length_entry.kind != LookupTable::EntryKind::kSymbol || length_entry.symbol == 0) {
+        return std::nullopt;
+    }
+    bit_offset += length_entry.length;
+    const uint64_t word_length{length_entry.symbol - 1u};  // because when we create HT we do ++ (0 is terminator)
+
+    // Patterns must lie within the word without overlapping, any other layout is left to tree-based decoding
+    matches_.clear();
+    uint64_t position{0};
+    uint64_t covered_end{0};
+    uint64_t uncovered_count{0};
+    while (word_length > 0) {
+        const auto& position_entry{position_lookup.lookup(peek_bits(bit_offset))};
+        if (position_entry.kind != LookupTable::EntryKind::kSymbol) {
+            return std::nullopt;
+        }
+        bit_offset += position_entry.length;
+        if (position_entry.symbol == 0) {
+            break;
+        }
+        position += position_entry.symbol - 1;  // positions are encoded relative to one another
+        uint32_t pattern_index{position_entry.next_symbol};
+        if (position_entry.next_length != LookupTable::kNoNextSymbol) {
+            bit_offset += position_entry.next_length;
+        } else {
+            const auto& pattern_entry{pattern_lookup.lookup(peek_bits(bit_offset))};
+            if (pattern_entry.kind != LookupTable::EntryKind::kSymbol) {
+                return std::nullopt;
+            }
+            bit_offset += pattern_entry.length;
+            pattern_index = pattern_entry.symbol;
+        }
+        const ByteView pattern{decoder_->patterns_[pattern_index]};
+        if (bit_offset > data_bit_length || position < covered_end || position + pattern.size() > word_length) {
+            return std::nullopt;
+        }
+        uncovered_count += position - covered_end;
+        covered_end = position + pattern.size();
+        matches_.push_back({position, pattern});
+    }
+    uncovered_count += word_length - covered_end;
+    const uint64_t uncovered_offset{(bit_offset + CHAR_BIT - 1) / CHAR_BIT};
+    if (bit_offset > data_bit_length || uncovered_offset + uncovered_count > decoder_->words_length_) {
+        return std::nullopt;
+    }
+    return WordLayout{word_length, uncovered_offset, uncovered_count};
+}
+
+std::optional<uint64_t> Decompressor::Iterator::next_by_table(Bytes& buffer) {
+    const auto layout{decode_by_table()};
+    if (!layout) {
+        return std::nullopt;
+    }
+
+    // Interleave uncovered bytes and patterns left to right
+    const uint64_t word_length{layout->word_length};
+    const std::size_t buffer_start{buffer.size()};
+    buffer.resize(buffer_start + word_length);
+    uint8_t* word{buffer.data() + buffer_start};
+    const uint8_t* word_end{word + word_length};
+    const uint8_t* data_end{decoder_->words_start_ + decoder_->words_length_};
+    const uint8_t* uncovered{decoder_->words_start_ + layout->uncovered_offset};
+    uint64_t last_uncovered{0};
+    for (const auto& match : matches_) {
+        const std::size_t uncovered_size{match.position - last_uncovered};
+        copy_word_part(word + last_uncovered, word_end, uncovered, data_end, uncovered_size);
+        uncovered += uncovered_size;
+        copy_word_part(word + match.position, word_end, match.pattern.data(), data_end, match.pattern.size());
+        last_uncovered = match.position + match.pattern.size();
+    }
+    if (word_length > last_uncovered) {
+        std::memcpy(word + last_uncovered, uncovered, word_length - last_uncovered);
+    }
+
+    word_offset_ = layout->uncovered_offset + layout->uncovered_count;
+    bit_position_ = 0;
+    return word_offset_;
+}
+
+uint64_t Decompressor::Iterator::next_by_tree(Bytes& buffer) {
     const auto start_offset = word_offset_;
 
     uint64_t word_length = next_position(true);
@@ -660,6 +988,14 @@ uint64_t Decompressor::Iterator::next_uncompressed(Bytes& buffer) {
 }
 
 uint64_t Decompressor::Iterator::skip() {
+    if (decoder_->table_driven_) {
+        if (const auto layout{decode_by_table()}) {
+            word_offset_ = layout->uncovered_offset + layout->uncovered_count;
+            bit_position_ = 0;
+            return word_offset_;
+        }
+    }
+
     uint64_t word_length = next_position(true);
     if (word_length == 0) {
         throw std::runtime_error{"invalid zero word length in: " + decoder_->compressed_filename()};
@@ -20,6 +20,7 @@
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <span>
 #include <string>
@@ -31,6 +32,7 @@
 #include <silkworm/core/common/bytes.hpp>
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/common/memory_mapped_file.hpp>
+#include <silkworm/infra/concurrency/thread_pool.hpp>
 
 namespace silkworm::huffman {
 
@@ -170,6 +172,63 @@ class PositionTable : public DecodingTable {
     friend std::ostream& operator<<(std::ostream& out, const PositionTable& pt);
 };
 
+//! Flattened table decoding Huffman codes with one lookup for short codes and two lookups for longer ones
+//! @details Codes up to kRootBitLength bits are resolved by the root table, longer ones by subtables indexed by the
+//! following bits. Codes too long even for subtables are left to tree-based tables. In position tables, each root
+//! entry can also carry the pattern code following the position, so that both are decoded by a single lookup.
+class LookupTable {
+  public:
+    //! The bit length of root tables, small enough to make root tables stay cache-resident
+    constexpr static std::size_t kRootBitLength{10};
+
+    //! The max bit length of subtables (codes longer than root plus subtable bit lengths are not resolved)
+    constexpr static std::size_t kMaxSubtableBitLength{14};
+
+    //! The marker of entries not carrying any next symbol
+    constexpr static uint8_t kNoNextSymbol{0xFF};
+
+    enum class EntryKind : uint8_t {
+        kUnresolved,
+        kSymbol,
+        kSubtable,
+    };
+
+    struct Entry {
+        uint32_t symbol{0};                   // decoded symbol or subtable offset
+        uint32_t next_symbol{0};              // next symbol decoded along (only if next_length is valid)
+        uint8_t length{0};                    // code length in bits or subtable bit length
+        uint8_t next_length{kNoNextSymbol};  // next symbol code length in bits
+        EntryKind kind{EntryKind::kUnresolved};
+    };
+
+    //! Build the table from the depths of symbols listed in tree order (i.e. the dictionary order)
+    //! @return true if depths describe a valid prefix code, false otherwise
+    bool build(std::span<const uint64_t> depths, std::span<const uint32_t> symbols);
+
+    //! Make root entries also carry the symbol of next table that fits into their remaining bits, if any
+    //! @param terminator the symbol not followed by any next symbol
+    void combine(const LookupTable& next_table, uint32_t terminator);
+
+    [[nodiscard]] std::size_t root_bit_length() const { return root_bit_length_; }
+
+    [[nodiscard]] std::size_t num_entries() const { return entries_.size(); }
+
+    //! Get the entry for the code contained in the lowest bits
+    [[nodiscard]] const Entry& lookup(uint64_t bits) const {
+        const Entry& root_entry{entries_[bits & root_mask_]};
+        if (root_entry.kind != EntryKind::kSubtable) {
+            return root_entry;
+        }
+        const uint64_t subtable_mask{(uint64_t{1} << root_entry.length) - 1};
+        return entries_[root_entry.symbol + ((bits >> root_bit_length_) & subtable_mask)];
+    }
+
+  private:
+    std::vector<Entry> entries_{Entry{}};
+    std::size_t root_bit_length_{0};
+    uint64_t root_mask_{0};
+};
+
 //! Snapshot decoder using modified Condensed Huffman Table (CHT) algorithm
 class Decompressor {
   public:
@@ -214,6 +273,33 @@ class Decompressor {
         void reset(uint64_t data_offset);
 
       private:
+        //! Occurrence of one pattern inside the current word
+        struct PatternMatch {
+            uint64_t position{0};
+            ByteView pattern;
+        };
+
+        //! Extract one *compressed* word walking the tree-based tables code by code
+        uint64_t next_by_tree(Bytes& buffer);
+
+        //! Extract one *compressed* word using the lookup tables
+        //! @return the next word position or nothing if the word must be decoded by tree (iterator left untouched)
+        std::optional<uint64_t> next_by_table(Bytes& buffer);
+
+        //! Layout of one *compressed* word: patterns are collected into matches_, uncovered bytes follow the codes
+        struct WordLayout {
+            uint64_t word_length{0};
+            uint64_t uncovered_offset{0};
+            uint64_t uncovered_count{0};
+        };
+
+        //! Decode the codes of one *compressed* word using the lookup tables (iterator left untouched)
+        //! @return the word layout or nothing if the word must be decoded by tree
+        std::optional<WordLayout> decode_by_table();
+
+        //! Get the next 57 bits at least starting from the specified bit offset in the data stream
+        [[nodiscard]] inline uint64_t peek_bits(uint64_t bit_offset) const;
+
         //! View on the whole data stream.
         [[nodiscard]] inline ByteView data() const;
 
@@ -234,11 +320,26 @@ class Decompressor {
 
         //! Bit position [0..7] in current word of the data file
         uint8_t bit_position_{0};
+
+        //! The patterns decoded in current word (reused across words to avoid allocations)
+        std::vector<PatternMatch> matches_;
     };
 
     using ReadAheadFuncRef = absl::FunctionRef<bool(Iterator)>;
 
-    explicit Decompressor(std::filesystem::path compressed_path, std::optional<MemoryMappedRegion> compressed_region = {});
+    //! Range of consecutive data words
+    struct WordRange {
+        uint64_t first_word{0};  // ordinal of the first word in range
+        uint64_t word_count{0};  // number of words in range
+        uint64_t offset{0};      // data offset of the first word in range
+    };
+    using WordRangeFuncRef = absl::FunctionRef<bool(const WordRange&, Iterator)>;
+
+    //! @param table_driven enables table-driven decoding, which resolves most codes with one lookup into flattened tables
+    //! and falls back to tree-based decoding only for words containing very long codes. Disabling it is useful just
+    //! for comparison.
+    explicit Decompressor(std::filesystem::path compressed_path, std::optional<MemoryMappedRegion> compressed_region = {},
+                          bool table_driven = true);
     ~Decompressor();
 
     [[nodiscard]] const std::filesystem::path& compressed_path() const { return compressed_path_; }
@@ -256,12 +357,22 @@ class Decompressor {
     [[nodiscard]] bool is_open() const { return bool(compressed_file_); }
 
     [[nodiscard]] const MemoryMappedFile* memory_file() const { return compressed_file_.get(); }
+    [[nodiscard]] MemoryMappedFile* memory_file() { return compressed_file_.get(); }
 
     void open();
 
     //! Read the data stream eagerly applying the specified function, expected read in sequential order
     bool read_ahead(ReadAheadFuncRef fn);
 
+    //! Split the data stream into ranges of at most max_words_per_range *compressed* words
+    //! @details Range offsets are found skipping all words once, which is much cheaper than decoding them
+    [[nodiscard]] std::vector<WordRange> split_words(uint64_t max_words_per_range) const;
+
+    //! Read the specified word ranges concurrently on workers applying the specified function, one iterator per range
+    //! @return true if the function succeeds for all ranges, false otherwise
+    //! @warning this must not be called from tasks running on the same workers
+    bool read_ranges(std::span<const WordRange> ranges, ThreadPool& workers, WordRangeFuncRef fn);
+
     //! Get an iterator to the compressed data
     [[nodiscard]] Iterator make_iterator() const { return Iterator{this}; }
 
@@ -291,6 +402,21 @@ class Decompressor {
     //! The table of positions used to decode the data words
     std::unique_ptr<PositionTable> position_dict_;
 
+    //! The patterns in dictionary order, indexed by pattern lookup table symbols
+    std::vector<ByteView> patterns_;
+
+    //! The flattened table of patterns used to decode the data words
+    LookupTable pattern_lookup_;
+
+    //! The flattened table of positions (possibly followed by patterns) used to decode the data words
+    LookupTable position_lookup_;
+
+    //! Flag indicating if table-driven decoding is enabled
+    bool table_driven_decoding_;
+
+    //! Flag indicating if the data words are decoded using the lookup tables
+    bool table_driven_{false};
+
     //! The start offset of the data words
     uint8_t* words_start_{nullptr};
 
@@ -18,6 +18,7 @@
 
 #include <filesystem>
 #include <map>
+#include <random>
 #include <span>
 #include <stdexcept>
 #include <string>
@@ -31,6 +32,7 @@
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/infra/common/directories.hpp>
 #include <silkworm/infra/test_util/log.hpp>
+#include <silkworm/node/huffman/compressor.hpp>
 #include <silkworm/node/test/snapshots.hpp>
 
 using Catch::Matchers::Message;
@@ -193,6 +195,99 @@ TEST_CASE("PositionTable::operator<<", "[silkworm][node][huffman][decompressor]"
     CHECK_NOTHROW(test_util::null_stream() << table);
 }
 
+TEST_CASE("LookupTable::build", "[silkworm][node][huffman][decompressor]") {
+    LookupTable table;
+
+    SECTION("no symbols") {
+        CHECK(table.build({}, {}));
+        CHECK(table.root_bit_length() == 0);
+        CHECK(table.lookup(0).kind == LookupTable::EntryKind::kUnresolved);
+    }
+    SECTION("single symbol at depth 0") {
+        const std::vector<uint64_t> depths{0};
+        const std::vector<uint32_t> symbols{7};
+        CHECK(table.build(depths, symbols));
+        CHECK(table.root_bit_length() == 0);
+        CHECK(table.lookup(0xFF).kind == LookupTable::EntryKind::kSymbol);
+        CHECK(table.lookup(0xFF).symbol == 7);
+        CHECK(table.lookup(0xFF).length == 0);
+    }
+    SECTION("short codes") {
+        // Codes in tree order: 0, 10, 11 with first bit read from the lowest one
+        const std::vector<uint64_t> depths{1, 2, 2};
+        const std::vector<uint32_t> symbols{10, 20, 30};
+        CHECK(table.build(depths, symbols));
+        CHECK(table.root_bit_length() == 2);
+        CHECK(table.num_entries() == 4);
+        CHECK(table.lookup(0b00).symbol == 10);
+        CHECK(table.lookup(0b10).symbol == 10);
+        CHECK(table.lookup(0b10).length == 1);
+        CHECK(table.lookup(0b01).symbol == 20);
+        CHECK(table.lookup(0b11).symbol == 30);
+        CHECK(table.lookup(0b11).length == 2);
+    }
+    SECTION("long codes in subtables") {
+        // Codes in tree order: 0, 10, 110, ..., 1...10, 1...11 with the last two longer than root bit length
+        const std::size_t max_depth{LookupTable::kRootBitLength + 3};
+        std::vector<uint64_t> depths;
+        std::vector<uint32_t> symbols;
+        for (uint64_t depth{1}; depth <= max_depth; ++depth) {
+            depths.push_back(depth);
+            symbols.push_back(static_cast<uint32_t>(depth));
+        }
+        depths.push_back(max_depth);
+        symbols.push_back(0);
+        CHECK(table.build(depths, symbols));
+        CHECK(table.root_bit_length() == LookupTable::kRootBitLength);
+        CHECK(table.num_entries() == (1u << LookupTable::kRootBitLength) + (1u << 3));
+        const uint64_t all_ones{(uint64_t{1} << max_depth) - 1};
+        CHECK(table.lookup(all_ones).symbol == 0);
+        CHECK(table.lookup(all_ones).length == max_depth);
+        CHECK(table.lookup(all_ones >> 1).symbol == max_depth);
+        CHECK(table.lookup(all_ones >> 2).symbol == max_depth - 1);
+        CHECK(table.lookup(all_ones >> 2).length == max_depth - 1);
+    }
+    SECTION("codes too long for subtables") {
+        const std::size_t max_depth{LookupTable::kRootBitLength + LookupTable::kMaxSubtableBitLength + 1};
+        std::vector<uint64_t> depths;
+        std::vector<uint32_t> symbols;
+        for (uint64_t depth{1}; depth <= max_depth; ++depth) {
+            depths.push_back(depth);
+            symbols.push_back(static_cast<uint32_t>(depth));
+        }
+        depths.push_back(max_depth);
+        symbols.push_back(0);
+        CHECK(table.build(depths, symbols));
+        CHECK(table.lookup(0).symbol == 1);
+        CHECK(table.lookup((uint64_t{1} << max_depth) - 1).kind == LookupTable::EntryKind::kUnresolved);
+    }
+    SECTION("invalid depths") {
+        const std::vector<uint32_t> symbols{1, 2, 3};
+        CHECK_FALSE(table.build(std::vector<uint64_t>{1, 1, 1}, symbols));
+        CHECK_FALSE(table.build(std::vector<uint64_t>{2, 1, 2}, symbols));
+        CHECK_FALSE(table.build(std::vector<uint64_t>{1, 2, 64}, symbols));
+    }
+}
+
+TEST_CASE("LookupTable::combine", "[silkworm][node][huffman][decompressor]") {
+    LookupTable positions, patterns;
+    REQUIRE(positions.build(std::vector<uint64_t>{1, 2, 2}, std::vector<uint32_t>{0, 1, 2}));
+    REQUIRE(patterns.build(std::vector<uint64_t>{1, 1}, std::vector<uint32_t>{5, 6}));
+    positions.combine(patterns, 0);
+
+    CHECK(positions.lookup(0b00).next_length == LookupTable::kNoNextSymbol);  // terminator
+    CHECK(positions.lookup(0b01).next_length == LookupTable::kNoNextSymbol);  // no spare bits
+    CHECK(positions.lookup(0b11).next_length == LookupTable::kNoNextSymbol);  // no spare bits
+
+    LookupTable wide_positions;
+    REQUIRE(wide_positions.build(std::vector<uint64_t>{1, 2, 3, 3}, std::vector<uint32_t>{0, 1, 2, 3}));
+    wide_positions.combine(patterns, 0);
+    CHECK(wide_positions.lookup(0b001).next_length == 1);
+    CHECK(wide_positions.lookup(0b001).next_symbol == 5);
+    CHECK(wide_positions.lookup(0b101).next_symbol == 6);
+    CHECK(wide_positions.lookup(0b011).next_length == LookupTable::kNoNextSymbol);
+}
+
 static test::TemporarySnapshotFile create_snapshot_file(std::vector<test::SnapshotPattern>&& patterns,
                                                         std::vector<test::SnapshotPosition>&& positions) {
     test::SnapshotHeader header{
@@ -486,6 +581,124 @@ TEST_CASE("Decompressor: lorem ipsum next", "[silkworm][node][huffman][decompres
     CHECK(test_function(it));
 }
 
+//! Words made of a few repeated fragments plus random bytes to have both patterns and uncovered bytes
+static std::vector<Bytes> fragmented_words(std::size_t count) {
+    std::mt19937 rng{42};
+    std::vector<Bytes> words;
+    for (std::size_t i{0}; i < count; ++i) {
+        Bytes word;
+        const std::size_t num_fragments{rng() % 8};
+        for (std::size_t j{0}; j < num_fragments; ++j) {
+            const std::string fragment{kLoremIpsumWords[rng() % kLoremIpsumWords.size()]};
+            word.append(fragment.cbegin(), fragment.cend());
+            word.append(rng() % 4, static_cast<uint8_t>(rng()));
+        }
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+static std::filesystem::path compress_words(const std::filesystem::path& dir, const std::vector<Bytes>& words) {
+    const auto compressed_path{dir / "test.seg"};
+    Compressor compressor{compressed_path};
+    for (const auto& word : words) {
+        compressor.add_word(word);
+    }
+    compressor.compress();
+    return compressed_path;
+}
+
+TEST_CASE("Decompressor: table-driven and tree-based next", "[silkworm][node][huffman][decompressor]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    TemporaryDirectory tmp_dir;
+    const auto words{fragmented_words(5'000)};
+    const auto compressed_path{compress_words(tmp_dir.path(), words)};
+
+    for (const bool table_driven : {true, false}) {
+        Decompressor decoder{compressed_path, {}, table_driven};
+        REQUIRE_NOTHROW(decoder.open());
+        auto it = decoder.make_iterator();
+        Bytes buffer;
+        for (std::size_t i{0}; i < words.size(); ++i) {
+            REQUIRE(it.has_next());
+            buffer.clear();
+            it.next(buffer);
+            CHECK(buffer == words[i]);
+        }
+        CHECK_FALSE(it.has_next());
+
+        // Words are appended to the buffer
+        it.reset(0);
+        buffer = *from_hex("0x0102");
+        it.next(buffer);
+        CHECK(buffer == *from_hex("0x0102") + words[0]);
+    }
+}
+
+TEST_CASE("Decompressor::split_words", "[silkworm][node][huffman][decompressor]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    TemporaryDirectory tmp_dir;
+    const auto words{fragmented_words(1'000)};
+    Decompressor decoder{compress_words(tmp_dir.path(), words)};
+    CHECK_THROWS_AS(decoder.split_words(100), std::logic_error);
+    REQUIRE_NOTHROW(decoder.open());
+
+    CHECK_THROWS_AS(decoder.split_words(0), std::invalid_argument);
+    for (const uint64_t max_words_per_range : {1u, 300u, 1'000u, 5'000u}) {
+        SECTION("max words per range: " + std::to_string(max_words_per_range)) {
+            const auto ranges{decoder.split_words(max_words_per_range)};
+            REQUIRE(ranges.size() == (words.size() + max_words_per_range - 1) / max_words_per_range);
+            uint64_t expected_first_word{0};
+            for (const auto& range : ranges) {
+                CHECK(range.first_word == expected_first_word);
+                CHECK(range.word_count == std::min(max_words_per_range, words.size() - expected_first_word));
+                auto it = decoder.make_iterator();
+                it.reset(range.offset);
+                Bytes word;
+                it.next(word);
+                CHECK(word == words[range.first_word]);
+                expected_first_word += range.word_count;
+            }
+            CHECK(expected_first_word == words.size());
+        }
+    }
+}
+
+TEST_CASE("Decompressor::read_ranges", "[silkworm][node][huffman][decompressor]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    TemporaryDirectory tmp_dir;
+    const auto words{fragmented_words(1'000)};
+    Decompressor decoder{compress_words(tmp_dir.path(), words)};
+    REQUIRE_NOTHROW(decoder.open());
+    const auto ranges{decoder.split_words(64)};
+    ThreadPool workers{3};
+
+    SECTION("all words read") {
+        std::vector<Bytes> decoded_words(words.size());
+        const bool read_ok = decoder.read_ranges(ranges, workers, [&](const auto& range, auto it) {
+            for (uint64_t i{range.first_word}; i < range.first_word + range.word_count; ++i) {
+                it.next(decoded_words[i]);
+            }
+            return true;
+        });
+        CHECK(read_ok);
+        CHECK(decoded_words == words);
+    }
+    SECTION("failure in one range") {
+        const bool read_ok = decoder.read_ranges(ranges, workers, [&](const auto& range, auto) {
+            return range.first_word != 128;
+        });
+        CHECK_FALSE(read_ok);
+    }
+    SECTION("exception in one range") {
+        const auto read_function = [&](const auto& range, auto) -> bool {
+            if (range.first_word == 128) throw std::runtime_error{"error"};
+            return true;
+        };
+        CHECK_THROWS_AS(decoder.read_ranges(ranges, workers, read_function), std::runtime_error);
+    }
+}
+
 TEST_CASE("Decompressor: lorem ipsum has_prefix", "[silkworm][node][huffman][decompressor]") {
     test_util::SetLogVerbosityGuard guard{log::Level::kNone};
     test::TemporaryFile tmp_file{};
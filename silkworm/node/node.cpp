@@ -26,6 +26,7 @@
 #include <silkworm/node/bittorrent/client.hpp>
 #include <silkworm/node/common/preverified_hashes.hpp>
 #include <silkworm/node/common/resource_usage.hpp>
+#include <silkworm/node/snapshot/freezer.hpp>
 #include <silkworm/node/snapshot/sync.hpp>
 #include <silkworm/node/stagedsync/server.hpp>
 
@@ -59,6 +60,7 @@ class NodeImpl final {
     Task<void> start_execution_server();
     Task<void> start_backend_kv_grpc_server();
     Task<void> start_bittorrent_client();
+    Task<void> start_snapshot_freezer();
     Task<void> start_resource_usage_log();
     Task<void> start_execution_log_timer();
 
@@ -76,6 +78,7 @@ class NodeImpl final {
     std::unique_ptr<rpc::BackEndKvServer> backend_kv_rpc_server_;
     ResourceUsageLog resource_usage_log_;
     std::unique_ptr<BitTorrentClient> bittorrent_client_;
+    std::unique_ptr<snapshot::Freezer> snapshot_freezer_;
 };
 
 NodeImpl::NodeImpl(Settings& settings, SentryClientPtr sentry_client, mdbx::env chaindata_db)
@@ -116,6 +119,10 @@ void NodeImpl::setup_snapshots() {
 
         // Set snapshot repository into snapshot-aware database access
         db::DataModel::set_snapshot_repository(&snapshot_repository_);
+
+        if (settings_.snapshot_settings.freeze) {
+            snapshot_freezer_ = std::make_unique<snapshot::Freezer>(db::RWAccess{chaindata_db_}, &snapshot_repository_);
+        }
     } else {
         log::Info() << "Snapshot sync disabled, no snapshot must be downloaded";
     }
@@ -123,7 +130,7 @@ void NodeImpl::setup_snapshots() {
 
 Task<void> NodeImpl::run() {
     using namespace concurrency::awaitable_wait_for_all;
-    return (run_tasks() && start_backend_kv_grpc_server() && start_bittorrent_client());
+    return (run_tasks() && start_backend_kv_grpc_server() && start_bittorrent_client() && start_snapshot_freezer());
 }
 
 Task<void> NodeImpl::run_tasks() {
@@ -159,6 +166,18 @@ Task<void> NodeImpl::start_bittorrent_client() {
     }
 }
 
+Task<void> NodeImpl::start_snapshot_freezer() {
+    if (snapshot_freezer_) {
+        auto run = [this]() {
+            snapshot_freezer_->execute_loop();
+        };
+        auto stop = [this]() {
+            snapshot_freezer_->stop();
+        };
+        co_await concurrency::async_thread(std::move(run), std::move(stop), "snap-freezer");
+    }
+}
+
 Task<void> NodeImpl::start_resource_usage_log() {
     return resource_usage_log_.run();
 }
@@ -171,6 +171,12 @@ class EliasFanoList32 {
         return value;
     }
 
+    //! Prefetch the lower bits and jump data needed by get(i), leaving out the upper bits which depend on them
+    void prefetch(uint64_t i) const {
+        succinct::prefetch(lower_bits_.data() + i * l_ / 64);
+        succinct::prefetch(jump_.data() + (i / kSuperQ) * kSuperQSize32);
+    }
+
     void add_offset(uint64_t offset) {
         if (l_ != 0) {
             set_bits(lower_bits_, i_ * l_, l_, offset & lower_bits_mask_);
@@ -356,6 +362,12 @@ class DoubleEliasFanoList16 {
         get(i, cum_keys, position, window_cum_keys, select_cum_keys, curr_word_cum_keys, lower, cum_delta);
     }
 
+    //! Prefetch the lower bits and jump data needed by get2(i)/get3(i), leaving out the upper bits which depend on them
+    void prefetch(const uint64_t i) const {
+        succinct::prefetch(lower_bits.data() + i * (l_cum_keys + l_position) / 64);
+        succinct::prefetch(jump.data() + (i / kSuperQ) * kSuperQSize16 * 2);
+    }
+
     void get3(const uint64_t i, uint64_t& cum_keys, uint64_t& cum_keys_next, uint64_t& position) const {
         uint64_t window_cum_keys{0}, select_cum_keys{0}, curr_word_cum_keys{0}, lower{0}, cum_delta{0};
         get(i, cum_keys, position, window_cum_keys, select_cum_keys, curr_word_cum_keys, lower, cum_delta);
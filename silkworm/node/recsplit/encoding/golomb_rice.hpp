@@ -239,6 +239,9 @@ class GolombRiceVector {
 
     [[nodiscard]] Reader reader() const { return Reader{data}; }
 
+    //! Prefetch the data at the specified bit position, e.g. before resetting a reader to it
+    void prefetch(const std::size_t bit_pos) const { succinct::prefetch(data.data() + bit_pos / 64); }
+
   private:
     Uint64Sequence data;
 
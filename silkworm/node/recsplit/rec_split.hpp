@@ -54,6 +54,7 @@
 #include <memory>
 #include <numbers>
 #include <random>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -195,6 +196,9 @@ class RecSplit {
     using EliasFano = EliasFanoList32;
     using DoubleEliasFano = DoubleEliasFanoList16;
 
+    //! Number of keys resolved together by batch lookups, large enough to overlap the cache misses of distinct keys
+    static constexpr std::size_t kLookupChunkSize{32};
+
     //! The base class for RecSplit building strategies
     struct BuildingStrategy {
         virtual void init(std::size_t bucket_size, std::size_t bucket_count, std::size_t key_count, bool double_enum_index) = 0;
@@ -331,6 +335,11 @@ class RecSplit {
         building_strategy_->add_key(bucket_id, bucket_key, offset);
     }
 
+    //! Hash the specified key as add_key does, so that keys can be hashed elsewhere (e.g. concurrently) and then added
+    [[nodiscard]] hash128_t hash_key(ByteView key) const {
+        return murmur_hash_3(key.data(), key.size());
+    }
+
     void add_key(const void* key_data, const size_t key_length, uint64_t offset) {
         if (built_) {
             throw std::logic_error{"cannot add key after perfect hash function has been built"};
@@ -474,7 +483,106 @@ class RecSplit {
         const std::size_t bucket = hash128_to_bucket(hash);
         uint64_t cum_keys{0}, cum_keys_next{0}, bit_pos{0};
         double_ef_index_.get3(bucket, cum_keys, cum_keys_next, bit_pos);
+        return bucket_record(hash, cum_keys, cum_keys_next, bit_pos);
+    }
+
+    //! Return the value associated with the given key within the MPHF mapping
+    std::size_t operator()(const std::string& key) const { return operator()(murmur_hash_3(key.c_str(), key.size())); }
+
+    //! Return the value associated with the given key within the index
+    [[nodiscard]] std::size_t lookup(ByteView key) const { return lookup(key.data(), key.size()); }
+
+    //! Return the value associated with the given key within the index
+    [[nodiscard]] std::size_t lookup(const std::string& key) const { return lookup(key.data(), key.size()); }
+
+    //! Return the value associated with the given key within the index
+    std::size_t lookup(const void* key, const size_t length) const {
+        return record_value(operator()(murmur_hash_3(key, length)));
+    }
+
+    //! Return the values associated with the given keys within the index, the same as lookup for each key
+    //! @details Keys are resolved in chunks, going through all keys in a chunk at each stage (key hashing, bucket
+    //! location, bucket splitting tree, record value) and prefetching the data used by the next stage, so that cache
+    //! misses for distinct keys overlap instead of being waited for one key after another
+    void lookup_batch(std::span<const ByteView> keys, std::span<uint64_t> values) const {
+        ensure(values.size() >= keys.size(), "RecSplit: lookup_batch values shorter than keys");
+        ensure(built_, "RecSplit: perfect hash function not built yet");
+        ensure(key_count_ > 0, "RecSplit: invalid lookup with zero keys, use empty() to guard");
+
+        std::array<hash128_t, kLookupChunkSize> hashes;
+        std::array<uint64_t, kLookupChunkSize> buckets, cum_keys, cum_keys_next, bit_positions;
+        std::array<std::size_t, kLookupChunkSize> records;
+        for (std::size_t chunk_start{0}; chunk_start < keys.size(); chunk_start += kLookupChunkSize) {
+            const std::size_t chunk_size{std::min(kLookupChunkSize, keys.size() - chunk_start)};
+            const auto chunk_keys{keys.subspan(chunk_start, chunk_size)};
+
+            if (key_count_ == 1) {
+                records.fill(0);
+            } else {
+                for (std::size_t i{0}; i < chunk_size; ++i) {
+                    hashes[i] = murmur_hash_3(chunk_keys[i].data(), chunk_keys[i].size());
+                    buckets[i] = hash128_to_bucket(hashes[i]);
+                    double_ef_index_.prefetch(buckets[i]);
+                }
+                for (std::size_t i{0}; i < chunk_size; ++i) {
+                    double_ef_index_.get3(buckets[i], cum_keys[i], cum_keys_next[i], bit_positions[i]);
+                    golomb_rice_codes_.prefetch(bit_positions[i]);
+                    golomb_rice_codes_.prefetch(bit_positions[i] + skip_bits(cum_keys_next[i] - cum_keys[i]));
+                }
+                for (std::size_t i{0}; i < chunk_size; ++i) {
+                    records[i] = bucket_record(hashes[i], cum_keys[i], cum_keys_next[i], bit_positions[i]);
+                    succinct::prefetch(encoded_file_->address() + record_position(records[i]));
+                }
+            }
+            for (std::size_t i{0}; i < chunk_size; ++i) {
+                values[chunk_start + i] = record_value(records[i]);
+            }
+        }
+    }
+
+    //! Return the offset of the i-th element in the index. Perfect hash table lookup is not performed,
+    //! only access to the Elias-Fano structure containing all offsets
+    [[nodiscard]] std::size_t ordinal_lookup(uint64_t i) const { return ef_offsets_->get(i); }
 
+    //! Return the offsets of the given elements in the index, the same as ordinal_lookup for each element
+    void ordinal_lookup_batch(std::span<const uint64_t> ordinals, std::span<uint64_t> offsets) const {
+        ensure(offsets.size() >= ordinals.size(), "RecSplit: ordinal_lookup_batch offsets shorter than ordinals");
+        for (std::size_t chunk_start{0}; chunk_start < ordinals.size(); chunk_start += kLookupChunkSize) {
+            const auto chunk_ordinals{ordinals.subspan(chunk_start, std::min(kLookupChunkSize, ordinals.size() - chunk_start))};
+            for (const auto ordinal : chunk_ordinals) {
+                ef_offsets_->prefetch(ordinal);
+            }
+            for (std::size_t i{0}; i < chunk_ordinals.size(); ++i) {
+                offsets[chunk_start + i] = ef_offsets_->get(chunk_ordinals[i]);
+            }
+        }
+    }
+
+    //! Return the number of keys used to build the RecSplit instance
+    [[nodiscard]] std::size_t key_count() const { return key_count_; }
+
+    //! Return true if the index contains the offsets for ordinal lookup, false otherwise
+    [[nodiscard]] bool double_enum_index() const { return double_enum_index_; }
+
+    [[nodiscard]] bool empty() const { return key_count_ == 0; }
+    [[nodiscard]] uint64_t base_data_id() const { return base_data_id_; }
+    [[nodiscard]] uint64_t record_mask() const { return record_mask_; }
+    [[nodiscard]] uint64_t bucket_count() const { return bucket_count_; }
+    [[nodiscard]] uint16_t bucket_size() const { return bucket_size_; }
+
+    [[nodiscard]] std::size_t file_size() const { return std::filesystem::file_size(index_path_); }
+
+    [[nodiscard]] std::filesystem::file_time_type last_write_time() const {
+        return std::filesystem::last_write_time(index_path_);
+    }
+
+    [[nodiscard]] uint8_t* memory_file_address() const { return encoded_file_ ? encoded_file_->address() : nullptr; }
+    [[nodiscard]] std::size_t memory_file_size() const { return encoded_file_ ? encoded_file_->length() : 0; }
+    [[nodiscard]] MemoryMappedFile* memory_file() { return encoded_file_ ? &*encoded_file_ : nullptr; }
+
+  private:
+    //! Return the record associated with the given 128-bit hash walking the splitting tree of its bucket
+    std::size_t bucket_record(const hash128_t& hash, uint64_t cum_keys, uint64_t cum_keys_next, uint64_t bit_pos) const {
         // Number of keys in this bucket
         std::size_t m = cum_keys_next - cum_keys;
         auto reader = golomb_rice_codes_.reader();
@@ -521,19 +629,13 @@ class RecSplit {
         return cum_keys + remap16(remix(hash.second + b + kStartSeed[level]), m);
     }
 
-    //! Return the value associated with the given key within the MPHF mapping
-    std::size_t operator()(const std::string& key) const { return operator()(murmur_hash_3(key.c_str(), key.size())); }
 
-    //! Return the value associated with the given key within the index
-    [[nodiscard]] std::size_t lookup(ByteView key) const { return lookup(key.data(), key.size()); }
+    //! Return the position of the specified record within the index file
+    [[nodiscard]] std::size_t record_position(std::size_t record) const { return 1 + 8 + bytes_per_record_ * (record + 1); }
 
-    //! Return the value associated with the given key within the index
-    [[nodiscard]] std::size_t lookup(const std::string& key) const { return lookup(key.data(), key.size()); }
-
-    //! Return the value associated with the given key within the index
-    std::size_t lookup(const void* key, const size_t length) const {
-        const auto record = operator()(murmur_hash_3(key, length));
-        const auto position = 1 + 8 + bytes_per_record_ * (record + 1);
+    //! Return the value of the specified record within the index file
+    [[nodiscard]] std::size_t record_value(std::size_t record) const {
+        const auto position = record_position(record);
 
         const auto address = encoded_file_->address();
         ensure(position + sizeof(uint64_t) < encoded_file_->length(),
@@ -541,29 +643,6 @@ class RecSplit {
         return endian::load_big_u64(address + position) & record_mask_;
     }
 
-    //! Return the offset of the i-th element in the index. Perfect hash table lookup is not performed,
-    //! only access to the Elias-Fano structure containing all offsets
-    [[nodiscard]] std::size_t ordinal_lookup(uint64_t i) const { return ef_offsets_->get(i); }
-
-    //! Return the number of keys used to build the RecSplit instance
-    [[nodiscard]] std::size_t key_count() const { return key_count_; }
-
-    [[nodiscard]] bool empty() const { return key_count_ == 0; }
-    [[nodiscard]] uint64_t base_data_id() const { return base_data_id_; }
-    [[nodiscard]] uint64_t record_mask() const { return record_mask_; }
-    [[nodiscard]] uint64_t bucket_count() const { return bucket_count_; }
-    [[nodiscard]] uint16_t bucket_size() const { return bucket_size_; }
-
-    [[nodiscard]] std::size_t file_size() const { return std::filesystem::file_size(index_path_); }
-
-    [[nodiscard]] std::filesystem::file_time_type last_write_time() const {
-        return std::filesystem::last_write_time(index_path_);
-    }
-
-    [[nodiscard]] uint8_t* memory_file_address() const { return encoded_file_ ? encoded_file_->address() : nullptr; }
-    [[nodiscard]] std::size_t memory_file_size() const { return encoded_file_ ? encoded_file_->length() : 0; }
-
-  private:
     static inline std::size_t skip_bits(std::size_t m) { return memo[m] & 0xFFFF; }
 
     static inline std::size_t skip_nodes(std::size_t m) { return (memo[m] >> 16) & 0x7FF; }
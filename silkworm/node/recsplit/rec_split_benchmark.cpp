@@ -0,0 +1,127 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <filesystem>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/infra/common/directories.hpp>
+#include <silkworm/infra/test_util/log.hpp>
+#include <silkworm/node/recsplit/rec_split_seq.hpp>
+
+namespace silkworm::succinct {
+
+static constexpr std::size_t kIndexKeyCount{1'000'000};
+
+//! Keys looking like hashes, generated just once because benchmark functions are run several times
+static const std::vector<std::string>& hash_keys() {
+    static const std::vector<std::string> keys{[]() {
+        std::mt19937_64 rng{42};
+        std::vector<std::string> random_keys(kIndexKeyCount, std::string(32, '\0'));
+        for (auto& key : random_keys) {
+            for (auto& c : key) {
+                c = static_cast<char>(rng());
+            }
+        }
+        return random_keys;
+    }()};
+    return keys;
+}
+
+//! Index built from the hash keys, large enough not to fit in CPU caches
+static const RecSplitIndex& hash_index() {
+    static TemporaryDirectory tmp_dir;
+    static const std::filesystem::path index_path{[]() {
+        test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+        const auto path{tmp_dir.path() / "hashes.idx"};
+        RecSplitSettings settings{
+            .keys_count = kIndexKeyCount,
+            .bucket_size = 2'000,
+            .index_path = path,
+            .base_data_id = 0};
+        RecSplit8 rec_split{settings, seq_build_strategy(), /*.salt=*/1};
+        const auto& keys{hash_keys()};
+        for (std::size_t i{0}; i < keys.size(); ++i) {
+            rec_split.add_key(keys[i], i * 100);
+        }
+        [[maybe_unused]] const bool collision_detected{rec_split.build()};
+        return path;
+    }()};
+    static const RecSplitIndex index{index_path};
+    return index;
+}
+
+//! Keys to lookup picked at random among the indexed ones, so that successive lookups hit distant index locations
+static std::vector<ByteView> random_lookup_keys(std::size_t count) {
+    const auto& keys{hash_keys()};
+    std::mt19937_64 rng{7};
+    std::vector<ByteView> lookup_keys;
+    lookup_keys.reserve(count);
+    for (std::size_t i{0}; i < count; ++i) {
+        const auto& key{keys[rng() % keys.size()]};
+        lookup_keys.emplace_back(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+    }
+    return lookup_keys;
+}
+
+//! Number of keys looked up in each iteration, multiple of any batch size to measure the same work at each size
+static constexpr std::size_t kLookupsPerIteration{4'096};
+
+//! Counter of the average nanoseconds per lookup given the number of lookups in each iteration
+static benchmark::Counter nanoseconds_per_lookup(std::size_t lookups_per_iteration) {
+    // Inverted iteration rate is seconds per iteration, scaling the count by 1e-9 turns it into nanoseconds per lookup
+    return benchmark::Counter(static_cast<double>(lookups_per_iteration) * 1e-9,
+                              benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+//! Lookup keys and their offsets one at a time, report the time per lookup
+static void rec_split_lookup_single(benchmark::State& state) {
+    const auto& index{hash_index()};
+    const auto keys{random_lookup_keys(kLookupsPerIteration)};
+    for ([[maybe_unused]] auto _ : state) {
+        for (const auto key : keys) {
+            const auto offset{index.ordinal_lookup(index.lookup(key))};
+            benchmark::DoNotOptimize(offset);
+        }
+    }
+    state.counters["ns/lookup"] = nanoseconds_per_lookup(kLookupsPerIteration);
+}
+BENCHMARK(rec_split_lookup_single);
+
+//! Lookup keys and their offsets in batches of the size given by the benchmark argument, report the time per lookup
+static void rec_split_lookup_batch(benchmark::State& state) {
+    const auto& index{hash_index()};
+    const auto keys{random_lookup_keys(kLookupsPerIteration)};
+    const auto batch_size{static_cast<std::size_t>(state.range(0))};
+    std::vector<uint64_t> positions(batch_size);
+    std::vector<uint64_t> offsets(batch_size);
+    for ([[maybe_unused]] auto _ : state) {
+        for (std::size_t start{0}; start < keys.size(); start += batch_size) {
+            const std::span<const ByteView> batch_keys{keys.data() + start, batch_size};
+            index.lookup_batch(batch_keys, positions);
+            index.ordinal_lookup_batch(positions, offsets);
+            benchmark::DoNotOptimize(offsets.data());
+        }
+    }
+    state.counters["ns/lookup"] = nanoseconds_per_lookup(kLookupsPerIteration);
+}
+BENCHMARK(rec_split_lookup_batch)->ArgName("batch")->RangeMultiplier(2)->Range(1, 256);
+
+}  // namespace silkworm::succinct
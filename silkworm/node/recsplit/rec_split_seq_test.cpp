@@ -253,6 +253,53 @@ TEST_CASE("RecSplit8: double index lookup", "[silkworm][node][recsplit][ignore]"
     }
 }
 
+TEST_CASE("RecSplit8: batch lookup", "[silkworm][node][recsplit]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::TemporaryFile index_file;
+    for (const bool double_enum_index : {false, true}) {
+        SECTION("double_enum_index=" + std::to_string(double_enum_index)) {
+            RecSplitSettings settings{
+                .keys_count = 1'000,
+                .bucket_size = 100,
+                .index_path = index_file.path(),
+                .base_data_id = 0,
+                .double_enum_index = double_enum_index};
+            RecSplit8 rs1{settings, seq_build_strategy(), /*.salt=*/kTestSalt};
+
+            std::vector<std::string> keys;
+            for (size_t i{0}; i < settings.keys_count; ++i) {
+                keys.push_back("key " + std::to_string(i));
+                rs1.add_key(keys.back(), i * 17);
+            }
+            CHECK(rs1.build() == false /*collision_detected*/);
+
+            RecSplit8 rs2{settings.index_path};
+            std::vector<ByteView> key_views;
+            for (const auto& key : keys) {
+                key_views.emplace_back(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+            }
+            // Use a batch size not multiple of the lookup chunk size to exercise the last partial chunk
+            std::vector<uint64_t> values(key_views.size());
+            rs2.lookup_batch(key_views, values);
+            for (size_t i{0}; i < keys.size(); ++i) {
+                CHECK(values[i] == rs2.lookup(keys[i]));
+            }
+            if (double_enum_index) {
+                std::vector<uint64_t> offsets(values.size());
+                rs2.ordinal_lookup_batch(values, offsets);
+                for (size_t i{0}; i < keys.size(); ++i) {
+                    CHECK(values[i] == i);
+                    CHECK(offsets[i] == i * 17);
+                }
+            }
+
+            std::vector<uint64_t> no_values;
+            CHECK_NOTHROW(rs2.lookup_batch({}, no_values));
+            CHECK_THROWS_AS(rs2.lookup_batch(key_views, no_values), std::logic_error);
+        }
+    }
+}
+
 #endif  // _WIN32
 
 }  // namespace silkworm::succinct
\ No newline at end of file
@@ -165,6 +165,19 @@ using std::uint32_t;
 using std::uint64_t;
 using std::uint8_t;
 
+//! Hint the processor to bring the cache line containing the specified address into cache for reading
+inline void prefetch(const void* address) {
+#if defined(_MSC_VER) && !defined(__clang__)
+#if defined(_M_X64) || defined(_M_IX86)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+#else
+    __builtin_prefetch(address);
+#endif
+}
+
 /** Static (i.e. computed in compile time) 1 + log2 rounded up. */
 constexpr size_t ceil_log2_plus1(size_t n) { return ((n < 2) ? 1 : 1 + ceil_log2_plus1(n / 2)); }
 
@@ -0,0 +1,116 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_cache.hpp"
+
+#include <utility>
+
+namespace silkworm::snapshot {
+
+template <typename Value>
+static std::unique_ptr<ShardedLruCache<BlockCacheKey, Value>> make_cache(std::size_t max_size, std::size_t num_shards) {
+    if (max_size == 0) {
+        return nullptr;
+    }
+    return std::make_unique<ShardedLruCache<BlockCacheKey, Value>>(max_size, num_shards);
+}
+
+template <typename Value>
+static BlockCacheMetrics metrics_of(const ShardedLruCache<BlockCacheKey, Value>* cache) {
+    if (!cache) {
+        return {};
+    }
+    return {.hits = cache->hits(), .misses = cache->misses()};
+}
+
+BlockCache::BlockCache(const BlockCacheSettings& settings)
+    : headers_{make_cache<BlockHeader>(settings.max_headers, settings.num_shards)},
+      bodies_{make_cache<StoredBlockBody>(settings.max_bodies, settings.num_shards)},
+      transactions_{make_cache<Transactions>(settings.max_transactions, settings.num_shards)} {}
+
+std::optional<BlockHeader> BlockCache::header_by_number(const HeaderSnapshot& snapshot, BlockNum block_number) {
+    if (!headers_) {
+        return snapshot.header_by_number(block_number);
+    }
+    const BlockCacheKey key{snapshot.block_from(), snapshot.block_to(), block_number};
+    if (auto cached_header{headers_->get_as_copy(key)}) {
+        return cached_header;
+    }
+    auto header{snapshot.header_by_number(block_number)};
+    if (header) {
+        headers_->put(key, *header);
+    }
+    return header;
+}
+
+std::optional<StoredBlockBody> BlockCache::body_by_number(const BodySnapshot& snapshot, BlockNum block_number) {
+    if (!bodies_) {
+        return snapshot.body_by_number(block_number);
+    }
+    const BlockCacheKey key{snapshot.block_from(), snapshot.block_to(), block_number};
+    if (auto cached_body{bodies_->get_as_copy(key)}) {
+        return cached_body;
+    }
+    auto body{snapshot.body_by_number(block_number)};
+    if (body) {
+        bodies_->put(key, *body);
+    }
+    return body;
+}
+
+std::vector<Transaction> BlockCache::txn_range(const TransactionSnapshot& snapshot, uint64_t base_txn_id, uint64_t txn_count, bool read_senders) {
+    if (!transactions_ || txn_count == 0) {
+        return snapshot.txn_range(base_txn_id, txn_count, read_senders);
+    }
+    const BlockCacheKey key{snapshot.block_from(), snapshot.block_to(), base_txn_id};
+    // Cached transactions starting at the same id may still be a different range, so just the same count is a hit
+    auto cached_transactions{transactions_->get_as_copy_if(key, [&](const Transactions& transactions) {
+        return transactions->size() == txn_count;
+    })};
+    if (!cached_transactions) {
+        cached_transactions = std::make_shared<const std::vector<Transaction>>(
+            snapshot.txn_range(base_txn_id, txn_count, /*read_senders=*/true));
+        transactions_->put(key, *cached_transactions);
+    }
+    std::vector<Transaction> transactions{**cached_transactions};
+    if (!read_senders) {
+        for (auto& transaction : transactions) {
+            transaction.from.reset();
+        }
+    }
+    return transactions;
+}
+
+BlockCacheMetrics BlockCache::metrics(SnapshotType type) const {
+    switch (type) {
+        case SnapshotType::headers:
+            return metrics_of(headers_.get());
+        case SnapshotType::bodies:
+            return metrics_of(bodies_.get());
+        case SnapshotType::transactions:
+            return metrics_of(transactions_.get());
+        default:
+            return {};
+    }
+}
+
+void BlockCache::clear() {
+    if (headers_) headers_->clear();
+    if (bodies_) bodies_->clear();
+    if (transactions_) transactions_->clear();
+}
+
+}  // namespace silkworm::snapshot
@@ -0,0 +1,116 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/common/sharded_lru_cache.hpp>
+#include <silkworm/core/types/block.hpp>
+#include <silkworm/node/snapshot/path.hpp>
+#include <silkworm/node/snapshot/settings.hpp>
+#include <silkworm/node/snapshot/snapshot.hpp>
+
+namespace silkworm::snapshot {
+
+//! The key of one item decoded from snapshots: the block range of its segment plus its ordinal in the segment
+//! @details the ordinal is the block number for headers and bodies, the first transaction id for transactions
+struct BlockCacheKey {
+    BlockNum block_from{0};
+    BlockNum block_to{0};
+    uint64_t ordinal{0};
+
+    friend bool operator==(const BlockCacheKey&, const BlockCacheKey&) = default;
+};
+
+//! The hit/miss statistics of one type of cached items
+struct BlockCacheMetrics {
+    uint64_t hits{0};
+    uint64_t misses{0};
+
+    [[nodiscard]] double hit_rate() const {
+        const auto lookups{hits + misses};
+        return lookups > 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+}  // namespace silkworm::snapshot
+
+namespace std {
+
+//! for using BlockCacheKey as a key of std::unordered_map
+template <>
+struct hash<silkworm::snapshot::BlockCacheKey> {
+    size_t operator()(const silkworm::snapshot::BlockCacheKey& key) const noexcept {
+        size_t seed{std::hash<uint64_t>{}(key.ordinal)};
+        seed ^= std::hash<uint64_t>{}(key.block_from) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<uint64_t>{}(key.block_to) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+
+}  // namespace std
+
+namespace silkworm::snapshot {
+
+//! \brief BlockCache keeps the most recently used items decoded from snapshots, i.e. headers, bodies and the
+//! transactions of one block, so that reading them again avoids both decompression and RLP decoding.
+//! \details Each type of item has its own size-bounded sharded LRU cache, which is disabled if its size is zero.
+//! The cache is safe to be shared by many threads.
+class BlockCache {
+  public:
+    explicit BlockCache(const BlockCacheSettings& settings = {});
+
+    // Not copyable nor movable
+    BlockCache(const BlockCache&) = delete;
+    BlockCache& operator=(const BlockCache&) = delete;
+
+    //! The same as snapshot.header_by_number(block_number) but looking up the cache first
+    std::optional<BlockHeader> header_by_number(const HeaderSnapshot& snapshot, BlockNum block_number);
+
+    //! The same as snapshot.body_by_number(block_number) but looking up the cache first
+    std::optional<StoredBlockBody> body_by_number(const BodySnapshot& snapshot, BlockNum block_number);
+
+    //! The same as snapshot.txn_range(base_txn_id, txn_count, read_senders) but looking up the cache first
+    //! @details transactions are always cached with their senders, which are cleared if not requested. A cached list
+    //! starting at the same id but having a different size is a miss
+    std::vector<Transaction> txn_range(const TransactionSnapshot& snapshot, uint64_t base_txn_id, uint64_t txn_count, bool read_senders);
+
+    //! The hit/miss statistics for the specified type of items (transactions_to_block has no cache)
+    [[nodiscard]] BlockCacheMetrics metrics(SnapshotType type) const;
+
+    //! Remove all cached items (statistics are kept)
+    void clear();
+
+  private:
+    template <typename Value>
+    using Cache = ShardedLruCache<BlockCacheKey, Value>;
+
+    //! Transaction lists are shared, so that they are not copied while holding the cache shard lock
+    using Transactions = std::shared_ptr<const std::vector<Transaction>>;
+
+    std::unique_ptr<Cache<BlockHeader>> headers_;
+    std::unique_ptr<Cache<StoredBlockBody>> bodies_;
+    std::unique_ptr<Cache<Transactions>> transactions_;
+};
+
+}  // namespace silkworm::snapshot
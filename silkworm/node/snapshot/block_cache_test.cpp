@@ -0,0 +1,152 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/infra/common/directories.hpp>
+#include <silkworm/infra/test_util/log.hpp>
+#include <silkworm/node/snapshot/index.hpp>
+#include <silkworm/node/test/snapshots.hpp>
+
+namespace silkworm::snapshot {
+
+TEST_CASE("BlockCacheKey", "[silkworm][node][snapshot]") {
+    const BlockCacheKey key1{.block_from = 0, .block_to = 500'000, .ordinal = 1};
+    const BlockCacheKey key2{.block_from = 500'000, .block_to = 1'000'000, .ordinal = 1};
+    CHECK(key1 == key1);
+    CHECK(key1 != key2);
+    CHECK(std::hash<BlockCacheKey>{}(key1) != std::hash<BlockCacheKey>{}(key2));
+}
+
+TEST_CASE("BlockCache::header_by_number", "[silkworm][node][snapshot]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    TemporaryDirectory tmp_dir;
+    test::SampleHeaderSnapshotFile header_snapshot_file{tmp_dir.path()};               // contains headers for [1'500'012, 1'500'013]
+    test::SampleHeaderSnapshotPath header_snapshot_path{header_snapshot_file.path()};  // necessary to tweak the block numbers
+    HeaderIndex header_index{header_snapshot_path};
+    REQUIRE_NOTHROW(header_index.build());
+    HeaderSnapshot header_snapshot{header_snapshot_path};
+    header_snapshot.reopen_segment();
+    header_snapshot.reopen_index();
+
+    SECTION("enabled") {
+        BlockCache cache{BlockCacheSettings{.max_headers = 1, .num_shards = 1}};
+        const auto header{cache.header_by_number(header_snapshot, 1'500'012)};
+        REQUIRE(header);
+        CHECK(header->number == 1'500'012);
+        CHECK(cache.metrics(SnapshotType::headers).misses == 1);
+
+        const auto cached_header{cache.header_by_number(header_snapshot, 1'500'012)};
+        REQUIRE(cached_header);
+        CHECK(cached_header->hash() == header->hash());
+        CHECK(cache.metrics(SnapshotType::headers).hits == 1);
+        CHECK(cache.metrics(SnapshotType::headers).hit_rate() == 0.5);
+
+        // Cache is bounded to just one header, so the first one gets evicted
+        CHECK(cache.header_by_number(header_snapshot, 1'500'013));
+        CHECK(cache.header_by_number(header_snapshot, 1'500'012));
+        CHECK(cache.metrics(SnapshotType::headers).misses == 3);
+
+        // Missing headers are not cached
+        CHECK(!cache.header_by_number(header_snapshot, 1'500'011));
+        CHECK(!cache.header_by_number(header_snapshot, 1'500'011));
+        CHECK(cache.metrics(SnapshotType::headers).misses == 5);
+    }
+
+    SECTION("disabled by default") {
+        BlockCache cache;
+        CHECK(cache.header_by_number(header_snapshot, 1'500'012));
+        CHECK(cache.header_by_number(header_snapshot, 1'500'012));
+        CHECK(cache.metrics(SnapshotType::headers).hits == 0);
+        CHECK(cache.metrics(SnapshotType::headers).misses == 0);
+    }
+
+    SECTION("disabled") {
+        BlockCache cache{BlockCacheSettings{.max_headers = 0}};
+        CHECK(cache.header_by_number(header_snapshot, 1'500'012));
+        CHECK(cache.header_by_number(header_snapshot, 1'500'012));
+        CHECK(cache.metrics(SnapshotType::headers).hits == 0);
+        CHECK(cache.metrics(SnapshotType::headers).misses == 0);
+    }
+}
+
+TEST_CASE("BlockCache::body_by_number", "[silkworm][node][snapshot]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    TemporaryDirectory tmp_dir;
+    test::SampleBodySnapshotFile body_snapshot_file{tmp_dir.path()};             // contains bodies for [1'500'012, 1'500'013]
+    test::SampleBodySnapshotPath body_snapshot_path{body_snapshot_file.path()};  // necessary to tweak the block numbers
+    BodyIndex body_index{body_snapshot_path};
+    REQUIRE_NOTHROW(body_index.build());
+    BodySnapshot body_snapshot{body_snapshot_path};
+    body_snapshot.reopen_segment();
+    body_snapshot.reopen_index();
+
+    BlockCache cache{BlockCacheSettings{.max_bodies = 16}};
+    const auto body{cache.body_by_number(body_snapshot, 1'500'013)};
+    const auto cached_body{cache.body_by_number(body_snapshot, 1'500'013)};
+    REQUIRE(body);
+    REQUIRE(cached_body);
+    CHECK(cached_body->base_txn_id == 7'341'271);
+    CHECK(cached_body->txn_count == body->txn_count);
+    CHECK(cache.metrics(SnapshotType::bodies).hits == 1);
+    CHECK(cache.metrics(SnapshotType::bodies).misses == 1);
+
+    cache.clear();
+    CHECK(cache.body_by_number(body_snapshot, 1'500'013));
+    CHECK(cache.metrics(SnapshotType::bodies).misses == 2);
+}
+
+TEST_CASE("BlockCache::txn_range", "[silkworm][node][snapshot]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    TemporaryDirectory tmp_dir;
+    test::SampleTransactionSnapshotFile tx_snapshot_file{tmp_dir.path()};           // contains txs for [1'500'012, 1'500'013]
+    test::SampleTransactionSnapshotPath tx_snapshot_path{tx_snapshot_file.path()};  // necessary to tweak the block numbers
+    TransactionIndex tx_index{tx_snapshot_path};
+    REQUIRE_NOTHROW(tx_index.build());
+    TransactionSnapshot tx_snapshot{tx_snapshot_path};
+    tx_snapshot.reopen_segment();
+    tx_snapshot.reopen_index();
+
+    BlockCache cache{BlockCacheSettings{.max_transactions = 16}};
+    // block 1'500'012: base_txn_id is 7'341'263, txn_count is 7
+    const auto transactions{cache.txn_range(tx_snapshot, 7'341'263, 7, /*read_senders=*/false)};
+    REQUIRE(transactions.size() == 7);
+    CHECK(!transactions[0].from);
+
+    const auto cached_transactions{cache.txn_range(tx_snapshot, 7'341'263, 7, /*read_senders=*/true)};
+    REQUIRE(cached_transactions.size() == 7);
+    CHECK(cached_transactions[0].from);
+    CHECK(cached_transactions == tx_snapshot.txn_range(7'341'263, 7, /*read_senders=*/true));
+    CHECK(cache.metrics(SnapshotType::transactions).hits == 1);
+
+    // Same base transaction id but different range is a miss
+    CHECK(cache.txn_range(tx_snapshot, 7'341'263, 6, /*read_senders=*/true).size() == 6);
+    CHECK(cache.metrics(SnapshotType::transactions).hits == 1);
+    CHECK(cache.metrics(SnapshotType::transactions).misses == 2);
+
+    // Cached transactions are not affected by clearing the senders of the returned copy
+    CHECK(cache.txn_range(tx_snapshot, 7'341'263, 6, /*read_senders=*/false).size() == 6);
+    CHECK(cache.txn_range(tx_snapshot, 7'341'263, 6, /*read_senders=*/true)[0].from);
+    CHECK(cache.metrics(SnapshotType::transactions).hits == 3);
+
+    // Empty ranges bypass the cache
+    CHECK(cache.txn_range(tx_snapshot, 7'341'263, 0, /*read_senders=*/true).empty());
+    CHECK(cache.metrics(SnapshotType::transactions).misses == 2);
+}
+
+}  // namespace silkworm::snapshot
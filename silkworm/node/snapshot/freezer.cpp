@@ -0,0 +1,284 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "freezer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/types/hash.hpp>
+#include <silkworm/infra/common/decoding_exception.hpp>
+#include <silkworm/infra/common/ensure.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/node/db/access_layer.hpp>
+#include <silkworm/node/db/stages.hpp>
+#include <silkworm/node/db/tables.hpp>
+#include <silkworm/node/huffman/compressor.hpp>
+#include <silkworm/node/snapshot/index.hpp>
+
+namespace silkworm::snapshot {
+
+//! Number of blocks written between successive checks for stop requested
+static constexpr BlockNum kStopCheckInterval{1'000};
+
+Freezer::Freezer(db::RWAccess db_access, SnapshotRepository* repository, uint64_t segment_size)
+    : db_access_{std::move(db_access)}, repository_{repository}, segment_size_{segment_size} {
+    ensure(repository_, "Freezer: SnapshotRepository is null");
+    ensure_pre_condition(segment_size_ >= kMinimumSegmentSize && segment_size_ % kFileNameBlockScaleFactor == 0,
+                         "Freezer: invalid segment size " + std::to_string(segment_size_));
+}
+
+std::optional<BlockNumRange> Freezer::next_range(db::ROTxn& txn) const {
+    // New segments must be contiguous with existing ones, segment_max_block is meaningless without any segment
+    const BlockNum block_from{repository_->header_snapshots_count() > 0 ? repository_->segment_max_block() + 1 : 0};
+    const BlockNum block_to{block_from + segment_size_};
+
+    // Blocks are frozen only when far enough from the chain tip not to be affected by any reorg
+    const BlockNum finish_progress{db::stages::read_stage_progress(txn, db::stages::kFinishKey)};
+    if (block_to + kFullImmutabilityThreshold > finish_progress + 1) {
+        return std::nullopt;
+    }
+    return BlockNumRange{block_from, block_to};
+}
+
+std::size_t Freezer::freeze_ready_ranges() {
+    std::size_t frozen_ranges{0};
+    while (!is_stopping()) {
+        std::optional<BlockNumRange> range;
+        {
+            auto ro_txn{db_access_.start_ro_tx()};
+            range = next_range(ro_txn);
+        }
+        if (!range) break;
+
+        freeze(*range);
+        if (is_stopping()) break;
+        ++frozen_ranges;
+    }
+    return frozen_ranges;
+}
+
+void Freezer::freeze(BlockNumRange range) {
+    const auto [block_from, block_to] = range;
+    ensure_pre_condition(block_from < block_to && block_from % kFileNameBlockScaleFactor == 0 &&
+                             block_to % kFileNameBlockScaleFactor == 0,
+                         "Freezer: invalid block range [" + std::to_string(block_from) + ", " + std::to_string(block_to) + ")");
+    SILK_INFO << "Freezer: freeze blocks [" << block_from << ", " << block_to << ") start";
+
+    const auto dir{repository_->path()};
+    const auto headers_path{SnapshotPath::from(dir, kSnapshotV1, block_from, block_to, SnapshotType::headers)};
+    const auto bodies_path{SnapshotPath::from(dir, kSnapshotV1, block_from, block_to, SnapshotType::bodies)};
+    const auto txs_path{SnapshotPath::from(dir, kSnapshotV1, block_from, block_to, SnapshotType::transactions)};
+    {
+        auto ro_txn{db_access_.start_ro_tx()};
+        write_segments(ro_txn, range, headers_path, bodies_path, txs_path);
+    }
+    if (is_stopping()) {
+        SILK_INFO << "Freezer: freeze blocks [" << block_from << ", " << block_to << ") interrupted";
+        return;
+    }
+
+    SILK_INFO << "Freezer: build indexes for blocks [" << block_from << ", " << block_to << ")";
+    HeaderIndex{headers_path}.build();
+    BodyIndex{bodies_path}.build();
+    TransactionIndex{txs_path}.build();
+
+    // Make new segments available before pruning, so that blocks are always readable from either storage
+    auto headers_snapshot{std::make_unique<HeaderSnapshot>(headers_path)};
+    headers_snapshot->reopen_segment();
+    headers_snapshot->reopen_index();
+    auto bodies_snapshot{std::make_unique<BodySnapshot>(bodies_path)};
+    bodies_snapshot->reopen_segment();
+    bodies_snapshot->reopen_index();
+    auto txs_snapshot{std::make_unique<TransactionSnapshot>(txs_path)};
+    txs_snapshot->reopen_segment();
+    txs_snapshot->reopen_index();
+    repository_->add_snapshot_bundle(SnapshotBundle{
+        .headers_snapshot_path = headers_path,
+        .headers_snapshot = std::move(headers_snapshot),
+        .bodies_snapshot_path = bodies_path,
+        .bodies_snapshot = std::move(bodies_snapshot),
+        .tx_snapshot_path = txs_path,
+        .tx_snapshot = std::move(txs_snapshot),
+    });
+
+    auto rw_txn{db_access_.start_rw_tx()};
+    prune(rw_txn, range);
+    rw_txn.commit_and_stop();
+
+    SILK_INFO << "Freezer: freeze blocks [" << block_from << ", " << block_to << ") end";
+}
+
+void Freezer::execute_loop() {
+    SILK_TRACE << "Freezer::execute_loop start";
+    while (!is_stopping()) {
+        try {
+            freeze_ready_ranges();
+        } catch (const std::exception& ex) {
+            SILK_ERROR << "Freezer: freeze failed: " << ex.what();
+        }
+
+        std::unique_lock stop_lock{stop_mutex_};
+        stop_condition_.wait_for(stop_lock, kFreezeInterval, [&] { return is_stopping(); });
+    }
+    SILK_TRACE << "Freezer::execute_loop end";
+}
+
+bool Freezer::stop() {
+    const bool result{Stoppable::stop()};
+    {
+        std::scoped_lock stop_lock{stop_mutex_};
+    }
+    stop_condition_.notify_all();
+    return result;
+}
+
+uint64_t Freezer::first_txn_id(db::ROTxn& txn, BlockNum block_from) const {
+    // Transaction identifiers must continue the ones in the previous segment, if any
+    if (block_from > 0) {
+        if (const auto bodies_snapshot = repository_->find_body_segment(block_from - 1)) {
+            const auto last_body{bodies_snapshot->body_by_number(block_from - 1)};
+            ensure(last_body.has_value(), "Freezer: body not found in snapshot for block " + std::to_string(block_from - 1));
+            return last_body->base_txn_id + last_body->txn_count;
+        }
+    }
+
+    // Otherwise keep the identifiers assigned in the database
+    const auto hash{db::read_canonical_hash(txn, block_from)};
+    ensure(hash.has_value(), "Freezer: canonical hash not found for block " + std::to_string(block_from));
+    const Bytes key{db::block_key(block_from, hash->bytes)};
+    auto bodies_cursor{txn.ro_cursor(table::kBlockBodies)};
+    const auto body_data{bodies_cursor->find(db::to_slice(key), /*throw_notfound=*/false)};
+    ensure(body_data.done, "Freezer: body not found for block " + std::to_string(block_from));
+    ByteView body_view{db::from_slice(body_data.value)};
+    return db::detail::decode_stored_block_body(body_view).base_txn_id;
+}
+
+void Freezer::write_segments(db::ROTxn& txn, BlockNumRange range, const SnapshotPath& headers_path,
+                             const SnapshotPath& bodies_path, const SnapshotPath& txs_path) {
+    const auto [block_from, block_to] = range;
+    huffman::Compressor headers_compressor{headers_path.path()};
+    huffman::Compressor bodies_compressor{bodies_path.path()};
+    huffman::Compressor txs_compressor{txs_path.path()};
+
+    auto headers_cursor{txn.ro_cursor(table::kHeaders)};
+    auto bodies_cursor{txn.ro_cursor(table::kBlockBodies)};
+    auto txs_cursor{txn.ro_cursor(table::kBlockTransactions)};
+
+    // Bodies in snapshots refer to contiguous transaction identifiers, so they are renumbered skipping any gap left in
+    // the database by non-canonical blocks
+    uint64_t txn_id{first_txn_id(txn, block_from)};
+    Bytes word;
+    for (BlockNum block_number{block_from}; block_number < block_to; ++block_number) {
+        if (block_number % kStopCheckInterval == 0 && is_stopping()) return;
+
+        const auto hash{db::read_canonical_hash(txn, block_number)};
+        ensure(hash.has_value(), "Freezer: canonical hash not found for block " + std::to_string(block_number));
+        const Bytes key{db::block_key(block_number, hash->bytes)};
+
+        // Header word format: header_hash_1byte + header_rlp_bytes
+        const auto header_data{headers_cursor->find(db::to_slice(key), /*throw_notfound=*/false)};
+        ensure(header_data.done, "Freezer: header not found for block " + std::to_string(block_number));
+        word.assign(1, hash->bytes[0]);
+        word.append(db::from_slice(header_data.value));
+        headers_compressor.add_word(word);
+
+        // Body word format: body_for_storage_rlp_bytes
+        const auto body_data{bodies_cursor->find(db::to_slice(key), /*throw_notfound=*/false)};
+        ensure(body_data.done, "Freezer: body not found for block " + std::to_string(block_number));
+        ByteView body_view{db::from_slice(body_data.value)};
+        auto body{db::detail::decode_stored_block_body(body_view)};
+        ensure(body.txn_count > 1, "Freezer: unexpected txn_count=" + std::to_string(body.txn_count) +
+                                       " for block " + std::to_string(block_number));
+        const uint64_t db_base_txn_id{body.base_txn_id};
+        body.base_txn_id = txn_id;
+        bodies_compressor.add_word(body.encode());
+        txn_id += body.txn_count;
+
+        // Transaction word format: tx_hash_1byte + sender_address_20byte + tx_rlp_bytes, system txs are empty words
+        const auto senders{db::read_senders(txn, key)};
+        ensure(senders.size() == body.txn_count - 2, "Freezer: senders not found for block " + std::to_string(block_number));
+        txs_compressor.add_word({});
+        if (!senders.empty()) {
+            const Bytes first_txn_key{db::block_key(db_base_txn_id + 1)};
+            std::size_t i{0};
+            for (auto data{txs_cursor->find(db::to_slice(first_txn_key), /*throw_notfound=*/false)};
+                 data.done && i < senders.size();
+                 data = txs_cursor->to_next(/*throw_notfound=*/false), ++i) {
+                const ByteView tx_rlp{db::from_slice(data.value)};
+                ByteView tx_view{tx_rlp};
+                Transaction transaction;
+                success_or_throw(rlp::decode(tx_view, transaction), "Freezer: cannot decode tx in block " + std::to_string(block_number));
+                word.assign(1, transaction.hash().bytes[0]);
+                word.append(senders[i].bytes, kAddressLength);
+                word.append(tx_rlp);
+                txs_compressor.add_word(word);
+            }
+            ensure(i == senders.size(), "Freezer: transactions not found for block " + std::to_string(block_number));
+        }
+        txs_compressor.add_word({});
+    }
+
+    SILK_INFO << "Freezer: compress segments for blocks [" << block_from << ", " << block_to << ")";
+    headers_compressor.compress();
+    bodies_compressor.compress();
+    txs_compressor.compress();
+}
+
+void Freezer::prune(db::RWTxn& txn, BlockNumRange range) const {
+    const auto [block_from, block_to] = range;
+    auto headers_cursor{txn.rw_cursor(table::kHeaders)};
+    auto bodies_cursor{txn.rw_cursor(table::kBlockBodies)};
+    auto txs_cursor{txn.rw_cursor(table::kBlockTransactions)};
+    auto senders_cursor{txn.rw_cursor(table::kSenders)};
+    auto tx_lookup_cursor{txn.rw_cursor(table::kTxLookup)};
+
+    // Genesis is frozen in the first segment but kept in the database, where it is read directly in many places
+    std::size_t pruned_txs{0};
+    for (BlockNum block_number{std::max<BlockNum>(block_from, 1)}; block_number < block_to; ++block_number) {
+        // Any block at frozen heights goes away, including non-canonical ones
+        const Bytes prefix{db::block_key(block_number)};
+        db::cursor_for_prefix(*bodies_cursor, prefix, [&](ByteView /*key*/, ByteView value) {
+            const auto body{db::detail::decode_stored_block_body(value)};
+            for (uint64_t txn_id{body.base_txn_id}; txn_id < body.base_txn_id + body.txn_count; ++txn_id) {
+                const auto txn_data{txs_cursor->find(db::to_slice(db::block_key(txn_id)), /*throw_notfound=*/false)};
+                if (!txn_data) continue;
+                // Frozen txs are looked up by hash in snapshot indexes, so their TxLookup entries are useless unless
+                // pointing to some non-frozen block (same txn included also in some non-canonical block)
+                const Hash txn_hash{std::bit_cast<evmc_bytes32>(keccak256(db::from_slice(txn_data.value)))};
+                const auto lookup_data{tx_lookup_cursor->find(db::to_slice(txn_hash), /*throw_notfound=*/false)};
+                BlockNum lookup_block_number{0};
+                if (lookup_data && endian::from_big_compact(db::from_slice(lookup_data.value), lookup_block_number) &&
+                    lookup_block_number < block_to) {
+                    tx_lookup_cursor->erase();
+                }
+                if (txs_cursor->erase()) ++pruned_txs;
+            }
+        });
+        db::cursor_erase_prefix(*bodies_cursor, prefix);
+        db::cursor_erase_prefix(*headers_cursor, prefix);
+        db::cursor_erase_prefix(*senders_cursor, prefix);
+    }
+    SILK_DEBUG << "Freezer: pruned blocks [" << block_from << ", " << block_to << ") txs: " << pruned_txs;
+}
+
+}  // namespace silkworm::snapshot
@@ -0,0 +1,77 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/infra/concurrency/stoppable.hpp>
+#include <silkworm/node/db/mdbx.hpp>
+#include <silkworm/node/snapshot/path.hpp>
+#include <silkworm/node/snapshot/repository.hpp>
+
+namespace silkworm::snapshot {
+
+//! Job moving finalized blocks from the database into new snapshot segments.
+//! @details Each segment range is written as headers/bodies/transactions segments with their indexes, registered into
+//! the snapshot repository and then pruned from the database. Canonical hashes, total difficulties and header numbers
+//! are kept in the database, so that the canonical chain can still be walked there. The genesis block is never pruned.
+//! @remark Registration of new segments is not synchronized with concurrent snapshot readers
+class Freezer : public Stoppable {
+  public:
+    //! Number of blocks behind the Finish stage progress after which blocks are considered immutable
+    static constexpr BlockNum kFullImmutabilityThreshold{90'000};
+
+    //! Interval between successive checks for freezable block ranges
+    static constexpr std::chrono::seconds kFreezeInterval{60};
+
+    Freezer(db::RWAccess db_access, SnapshotRepository* repository, uint64_t segment_size = SnapshotPath::segment_size());
+
+    //! The next block range [from, to) ready to be frozen, if any
+    [[nodiscard]] std::optional<BlockNumRange> next_range(db::ROTxn& txn) const;
+
+    //! Freeze any block range ready to be frozen, return the number of frozen ranges
+    std::size_t freeze_ready_ranges();
+
+    //! Freeze the specified block range [from, to) into new snapshot segments and prune it from the database
+    void freeze(BlockNumRange range);
+
+    //! Run the freeze loop until stopped
+    void execute_loop();
+
+    bool stop() override;
+
+  private:
+    //! First transaction identifier to assign in the segment starting at the specified block
+    [[nodiscard]] uint64_t first_txn_id(db::ROTxn& txn, BlockNum block_from) const;
+
+    void write_segments(db::ROTxn& txn, BlockNumRange range, const SnapshotPath& headers_path,
+                        const SnapshotPath& bodies_path, const SnapshotPath& txs_path);
+    void prune(db::RWTxn& txn, BlockNumRange range) const;
+
+    db::RWAccess db_access_;
+    SnapshotRepository* repository_;
+    uint64_t segment_size_;
+
+    std::mutex stop_mutex_;
+    std::condition_variable stop_condition_;
+};
+
+}  // namespace silkworm::snapshot
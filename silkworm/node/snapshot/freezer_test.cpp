@@ -0,0 +1,192 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "freezer.hpp"
+
+#include <optional>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/types/address.hpp>
+#include <silkworm/core/types/block.hpp>
+#include <silkworm/infra/common/directories.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/test_util/log.hpp>
+#include <silkworm/node/db/access_layer.hpp>
+#include <silkworm/node/db/stages.hpp>
+#include <silkworm/node/db/tables.hpp>
+#include <silkworm/node/test/context.hpp>
+
+namespace silkworm::snapshot {
+
+TEST_CASE("Freezer::Freezer", "[silkworm][snapshot][freezer]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::Context context;
+    SnapshotRepository repository{SnapshotSettings{.repository_dir = TemporaryDirectory::get_unique_temporary_path()}};
+
+    CHECK_NOTHROW(Freezer{db::RWAccess{context.env()}, &repository});
+    CHECK_NOTHROW(Freezer{db::RWAccess{context.env()}, &repository, kMinimumSegmentSize});
+    CHECK_THROWS_AS((Freezer{db::RWAccess{context.env()}, nullptr}), std::logic_error);
+    CHECK_THROWS_AS((Freezer{db::RWAccess{context.env()}, &repository, 0}), std::invalid_argument);
+    CHECK_THROWS_AS((Freezer{db::RWAccess{context.env()}, &repository, 1'500}), std::invalid_argument);
+}
+
+TEST_CASE("Freezer::next_range", "[silkworm][snapshot][freezer]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::Context context;
+    SnapshotRepository repository{SnapshotSettings{.repository_dir = TemporaryDirectory::get_unique_temporary_path()}};
+    Freezer freezer{db::RWAccess{context.env()}, &repository, kMinimumSegmentSize};
+    auto& txn{context.rw_txn()};
+
+    SECTION("empty database") {
+        CHECK_FALSE(freezer.next_range(txn));
+    }
+
+    SECTION("blocks not yet immutable") {
+        db::stages::write_stage_progress(txn, db::stages::kFinishKey, kMinimumSegmentSize + Freezer::kFullImmutabilityThreshold - 2);
+        CHECK_FALSE(freezer.next_range(txn));
+    }
+
+    SECTION("blocks just immutable") {
+        db::stages::write_stage_progress(txn, db::stages::kFinishKey, kMinimumSegmentSize + Freezer::kFullImmutabilityThreshold - 1);
+        const auto range{freezer.next_range(txn)};
+        REQUIRE(range);
+        CHECK(*range == BlockNumRange{0, kMinimumSegmentSize});
+    }
+}
+
+TEST_CASE("Freezer::freeze", "[silkworm][snapshot][freezer]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::Context context;
+    SnapshotRepository repository{SnapshotSettings{.repository_dir = TemporaryDirectory::get_unique_temporary_path()}};
+    Freezer freezer{db::RWAccess{context.env()}, &repository, kMinimumSegmentSize};
+
+    SECTION("invalid range") {
+        CHECK_THROWS_AS(freezer.freeze({1'000, 1'000}), std::invalid_argument);
+        CHECK_THROWS_AS(freezer.freeze({1'000, 500}), std::invalid_argument);
+        CHECK_THROWS_AS(freezer.freeze({500, 1'000}), std::invalid_argument);
+    }
+}
+
+//! Populate the database with a canonical chain of the specified length, some blocks having one transaction
+static std::vector<Block> populate_chain(db::RWTxn& txn, BlockNum block_count) {
+    std::vector<Block> blocks;
+    Hash parent_hash;
+    for (BlockNum block_number{0}; block_number < block_count; ++block_number) {
+        Block block;
+        block.header.number = block_number;
+        block.header.parent_hash = parent_hash;
+        block.header.difficulty = 1;
+        block.header.gas_limit = 30'000'000;
+        block.header.timestamp = block_number * 12;
+        if (block_number % 100 == 1) {
+            Transaction transaction;
+            transaction.nonce = block_number;
+            transaction.gas_limit = 21'000;
+            transaction.to = 0xe5ef458d37212a06e3f59d40c454e76150ae7c32_address;
+            transaction.value = block_number;
+            transaction.r = 1;
+            transaction.s = 1;
+            transaction.from = 0x68d7899b6635146a37d01934461d0c9e4b65ddda_address;
+            block.transactions.push_back(transaction);
+        }
+
+        const auto hash{block.header.hash()};
+        db::write_header(txn, block.header, /*with_header_numbers=*/true);
+        db::write_canonical_header_hash(txn, hash.bytes, block_number);
+        db::write_body(txn, block, hash, block_number);
+        db::write_senders(txn, hash, block_number, block);
+
+        parent_hash = hash;
+        blocks.push_back(std::move(block));
+    }
+    return blocks;
+}
+
+//! Make DataModel read from the specified repository just in the current scope
+struct DataModelRepositoryGuard {
+    explicit DataModelRepositoryGuard(SnapshotRepository* repository) { db::DataModel::set_snapshot_repository(repository); }
+    ~DataModelRepositoryGuard() { db::DataModel::set_snapshot_repository(nullptr); }
+};
+
+TEST_CASE("Freezer::freeze_ready_ranges", "[silkworm][snapshot][freezer]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::Context context;
+    SnapshotRepository repository{SnapshotSettings{.repository_dir = TemporaryDirectory::get_unique_temporary_path()}};
+    Freezer freezer{db::RWAccess{context.env()}, &repository, kMinimumSegmentSize};
+
+    // Just one segment worth of immutable blocks plus some mutable ones
+    const BlockNum block_count{kMinimumSegmentSize + 10};
+    const auto blocks{populate_chain(context.rw_txn(), block_count)};
+    db::stages::write_stage_progress(context.rw_txn(), db::stages::kFinishKey, kMinimumSegmentSize + Freezer::kFullImmutabilityThreshold - 1);
+    context.commit_txn();  // the freezer opens its own txns
+
+    REQUIRE(freezer.freeze_ready_ranges() == 1);
+
+    // Segments and indexes are written and registered in the repository
+    for (const auto type : {SnapshotType::headers, SnapshotType::bodies, SnapshotType::transactions}) {
+        const auto path{SnapshotPath::from(repository.path(), kSnapshotV1, 0, kMinimumSegmentSize, type)};
+        CHECK(path.exists());
+        CHECK(path.index_file().exists());
+    }
+    CHECK(repository.header_snapshots_count() == 1);
+    CHECK(repository.segment_max_block() == kMinimumSegmentSize - 1);
+    CHECK(repository.max_block_available() == kMinimumSegmentSize - 1);
+
+    // No further range is ready
+    CHECK(freezer.freeze_ready_ranges() == 0);
+
+    db::ROTxnManaged ro_txn{context.env()};
+
+    // Frozen blocks are pruned from the database except genesis, canonical hashes are kept
+    CHECK(db::read_header(ro_txn, 0, blocks[0].header.hash().bytes).has_value());
+    BlockBody genesis_body;
+    CHECK(db::read_body(ro_txn, blocks[0].header.hash(), 0, genesis_body));
+    for (BlockNum block_number{1}; block_number < block_count; ++block_number) {
+        const auto hash{blocks[block_number].header.hash()};
+        CHECK(db::read_canonical_hash(ro_txn, block_number) == hash);
+        BlockBody body;
+        CHECK(db::read_body(ro_txn, hash, block_number, body) == (block_number >= kMinimumSegmentSize));
+        CHECK(db::read_header(ro_txn, block_number, hash.bytes).has_value() == (block_number >= kMinimumSegmentSize));
+    }
+    CHECK(ro_txn.ro_cursor(db::table::kBlockTransactions)->size() == 1);  // just the one in block 1'001
+
+    // All blocks are still readable, either from snapshots or from the database
+    DataModelRepositoryGuard repository_guard{&repository};
+    db::DataModel data_model{ro_txn};
+    for (BlockNum block_number{0}; block_number < block_count; ++block_number) {
+        const auto& expected_block{blocks[block_number]};
+        Block block;
+        REQUIRE(data_model.read_block(block_number, /*read_senders=*/true, block));
+        CHECK(block.header.hash() == expected_block.header.hash());
+        REQUIRE(block.transactions.size() == expected_block.transactions.size());
+        for (std::size_t i{0}; i < block.transactions.size(); ++i) {
+            CHECK(block.transactions[i].hash() == expected_block.transactions[i].hash());
+            CHECK(block.transactions[i].from == expected_block.transactions[i].from);
+        }
+    }
+
+    // Frozen transactions are looked up in snapshots, the mutable one has no TxLookup entry here
+    const std::vector<evmc::bytes32> tx_hashes{
+        blocks[1].transactions[0].hash(),
+        blocks[1'001].transactions[0].hash(),
+        blocks[901].transactions[0].hash(),
+    };
+    CHECK(data_model.read_tx_lookups(tx_hashes) == std::vector<std::optional<BlockNum>>{1, std::nullopt, 901});
+}
+
+}  // namespace silkworm::snapshot
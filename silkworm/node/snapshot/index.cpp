@@ -16,12 +16,17 @@
 
 #include "index.hpp"
 
+#include <algorithm>
+#include <filesystem>
+#include <span>
 #include <stdexcept>
+#include <vector>
 
 #include <magic_enum.hpp>
 
 #include <silkworm/core/common/endian.hpp>
 #include <silkworm/core/common/util.hpp>
+#include <silkworm/core/crypto/keccak256_batch.hpp>
 #include <silkworm/core/types/hash.hpp>
 #include <silkworm/infra/common/ensure.hpp>
 #include <silkworm/infra/common/log.hpp>
@@ -32,8 +37,53 @@ namespace silkworm::snapshot {
 
 using RecSplitSettings = succinct::RecSplitSettings;
 using RecSplit8 = succinct::RecSplit8;
+using WordRange = huffman::Decompressor::WordRange;
+
+namespace {
+
+    //! Scan the word ranges in waves of concurrent tasks computing the entries of each range, then consume all the
+    //! entries of each wave in word order (memory used for entries is bounded by wave size)
+    template <typename Entry, typename Process, typename Consume>
+    bool scan_ranges(huffman::Decompressor& decoder, std::span<const WordRange> ranges, ThreadPool& workers,
+                     const Process& process, const Consume& consume) {
+        const std::size_t wave_size{2 * std::max<std::size_t>(1, workers.get_thread_count())};
+        std::vector<std::vector<Entry>> wave_entries(std::min(wave_size, ranges.size()));
+        for (std::size_t wave_start{0}; wave_start < ranges.size(); wave_start += wave_size) {
+            const auto wave{ranges.subspan(wave_start, std::min(wave_size, ranges.size() - wave_start))};
+            const bool read_ok = decoder.read_ranges(wave, workers, [&](const WordRange& range, auto it) -> bool {
+                auto& entries{wave_entries[static_cast<std::size_t>(&range - wave.data())]};
+                entries.clear();
+                return process(range, it, entries);
+            });
+            if (!read_ok) return false;
+            for (std::size_t i{0}; i < wave.size(); ++i) {
+                consume(wave_entries[i]);
+            }
+        }
+        return true;
+    }
+
+}  // namespace
+
+std::vector<WordRange> Index::split_words(const huffman::Decompressor& decoder, const ThreadPool& workers) {
+    // At least a few ranges per worker to balance the load
+    const uint64_t range_count{4 * std::max<uint64_t>(1, workers.get_thread_count())};
+    return decoder.split_words(std::min(kMaxWordsPerScanRange, decoder.words_count() / range_count + 1));
+}
+
+std::size_t Index::segment_size() const {
+    if (segment_region_) return segment_region_->length;
+    std::error_code ec;
+    const auto file_size{std::filesystem::file_size(segment_path_.path(), ec)};
+    return ec ? 0 : file_size;
+}
 
 void Index::build() {
+    ThreadPool workers;
+    build(workers);
+}
+
+void Index::build(ThreadPool& workers) {
     SILK_TRACE << "Index::build path: " << segment_path_.path().string() << " start";
 
     huffman::Decompressor decoder{segment_path_.path(), segment_region_};
@@ -45,29 +95,41 @@ void Index::build() {
         .bucket_size = kBucketSize,
         .index_path = index_file.path(),
         .base_data_id = index_file.block_from()};
-    RecSplit8 rec_split{rec_split_settings, succinct::seq_build_strategy(etl::kOptimalBufferSize)};
+    // Keys are buffered in memory by two ETL collectors (keys by bucket and offsets) and spilled to disk beyond the budget
+    RecSplit8 rec_split{rec_split_settings, succinct::seq_build_strategy(memory_budget_ / 2)};
+    total_words_ = decoder.words_count();
 
-    SILK_TRACE << "Build index for: " << segment_path_.path().string() << " start";
+    const auto word_ranges{split_words(decoder, workers)};
+    SILK_TRACE << "Build index for: " << segment_path_.path().string() << " start [ranges=" << word_ranges.size() << "]";
     uint64_t iterations{0};
     bool collision_detected{false};
     do {
         iterations++;
         SILK_TRACE << "Process snapshot items to prepare index build for: " << segment_path_.path().string();
-        const bool read_ok = decoder.read_ahead([&](huffman::Decompressor::Iterator it) {
+        const auto process_range = [&](const WordRange& range, huffman::Decompressor::Iterator& it, std::vector<IndexEntry>& entries) {
+            entries.resize(range.word_count);
             Bytes word{};
             word.reserve(kPageSize);
-            uint64_t i{0}, offset{0};
-            while (it.has_next()) {
-                uint64_t next_position = it.next(word);
-                if (bool ok = walk(rec_split, i, offset, word); !ok) {
+            uint64_t offset{range.offset};
+            for (uint64_t i{0}; i < range.word_count; ++i) {
+                if (!it.has_next()) return false;
+                const uint64_t next_position = it.next(word);
+                if (bool ok = walk(rec_split, range.first_word + i, offset, word, entries[i]); !ok) {
                     return false;
                 }
-                ++i;
                 offset = next_position;
                 word.clear();
             }
             return true;
-        });
+        };
+        processed_words_ = 0;
+        const auto add_keys = [&](const std::vector<IndexEntry>& entries) {
+            for (const auto& entry : entries) {
+                rec_split.add_key(entry.key_hash, entry.value);
+            }
+            processed_words_ += entries.size();
+        };
+        const bool read_ok = scan_ranges<IndexEntry>(decoder, word_ranges, workers, process_range, add_keys);
         if (!read_ok) throw std::runtime_error{"cannot build index for: " + segment_path_.path().string()};
 
         SILK_TRACE << "Build RecSplit index for: " << segment_path_.path().string() << " [" << iterations << "]";
@@ -80,25 +142,25 @@ void Index::build() {
     SILK_TRACE << "Index::build path: " << segment_path_.path().string() << " end";
 }
 
-bool HeaderIndex::walk(RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) {
+bool HeaderIndex::walk(const RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word, IndexEntry& entry) const {
     ensure(!word.empty(), "HeaderIndex: word empty i=" + std::to_string(i));
     const uint8_t first_hash_byte{word[0]};
     const ByteView rlp_encoded_header{word.data() + 1, word.size() - 1};
     const ethash::hash256 hash = keccak256(rlp_encoded_header);
     ensure(hash.bytes[0] == first_hash_byte,
            "HeaderIndex: invalid prefix=" + to_hex(first_hash_byte) + " hash=" + to_hex(hash.bytes));
-    rec_split.add_key(hash.bytes, kHashLength, offset);
+    entry = {rec_split.hash_key({hash.bytes, kHashLength}), offset};
     return true;
 }
 
-bool BodyIndex::walk(RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView /*word*/) {
+bool BodyIndex::walk(const RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView /*word*/, IndexEntry& entry) const {
     Bytes uint64_buffer;
     const auto size = test::encode_varint<uint64_t>(i, uint64_buffer);
-    rec_split.add_key(uint64_buffer.data(), size, offset);
+    entry = {rec_split.hash_key({uint64_buffer.data(), size}), offset};
     return true;
 }
 
-void TransactionIndex::build() {
+void TransactionIndex::build(ThreadPool& workers) {
     SILK_TRACE << "TransactionIndex::build path: " << segment_path_.path().string() << " start";
 
     const SnapshotPath bodies_segment_path = SnapshotPath::from(segment_path_.path().parent_path(),
@@ -115,6 +177,7 @@ void TransactionIndex::build() {
 
     huffman::Decompressor txs_decoder{segment_path_.path(), segment_region_};
     txs_decoder.open();
+    total_words_ = txs_decoder.words_count();
 
     const auto tx_count = txs_decoder.words_count();
     if (tx_count != expected_tx_count) {
@@ -132,7 +195,7 @@ void TransactionIndex::build() {
         .index_path = tx_idx_file.path(),
         .base_data_id = first_tx_id,
         .double_enum_index = true};
-    RecSplit8 tx_hash_rs{tx_hash_rs_settings, succinct::seq_build_strategy(etl::kOptimalBufferSize / 2)};
+    RecSplit8 tx_hash_rs{tx_hash_rs_settings, succinct::seq_build_strategy(memory_budget_ / 4)};
 
     const SnapshotPath tx2block_idx_file = segment_path_.index_file_for_type(SnapshotType::transactions_to_block);
     SILK_TRACE << "TransactionIndex::build tx2block_idx_file path: " << tx2block_idx_file.path().string();
@@ -142,110 +205,131 @@ void TransactionIndex::build() {
         .index_path = tx2block_idx_file.path(),
         .base_data_id = first_block_num,
         .double_enum_index = false};
-    RecSplit8 tx_hash_to_block_rs{tx_hash_to_block_rs_settings, succinct::seq_build_strategy(etl::kOptimalBufferSize / 2)};
-
-    huffman::Decompressor bodies_decoder{bodies_segment_path.path()};
-    bodies_decoder.open();
-
-    using DoubleReadAheadFunc = std::function<bool(huffman::Decompressor::Iterator, huffman::Decompressor::Iterator)>;
-    auto double_read_ahead = [&txs_decoder, &bodies_decoder](const DoubleReadAheadFunc& fn) -> bool {
-        return txs_decoder.read_ahead([fn, &bodies_decoder](auto tx_it) -> bool {
-            return bodies_decoder.read_ahead([fn, &tx_it](auto body_it) {
-                return fn(tx_it, body_it);
-            });
-        });
+    RecSplit8 tx_hash_to_block_rs{tx_hash_to_block_rs_settings, succinct::seq_build_strategy(memory_budget_ / 4)};
+
+    // Collect the end transaction ID of each block, so that each range of transactions can find its starting block
+    std::vector<uint64_t> body_txn_ends(bodies_snapshot.item_count());
+    const bool bodies_ok = bodies_snapshot.for_each_body(workers, [&](BlockNum number, const StoredBlockBody* body) {
+        body_txn_ends[number - first_block_num] = body->base_txn_id + body->txn_count;
+        return true;
+    });
+    if (!bodies_ok) throw std::runtime_error{"cannot build index for: " + segment_path_.path().string()};
+
+    struct TxEntry {
+        succinct::hash128_t tx_hash_key{};           // key hash for tx_hash -> offset index
+        succinct::hash128_t tx_hash_to_block_key{};  // key hash for tx_hash -> block_number index
+        uint64_t offset{0};
+        BlockNum block_number{0};
     };
 
-    SILK_TRACE << "Build index for: " << segment_path_.path().string() << " start";
-    uint64_t iterations{0};
-    Hash tx_hash;
-    bool collision_detected{false};
-    do {
-        iterations++;
-        SILK_TRACE << "Process snapshot items to prepare index build for: " << segment_path_.path().string();
-        const bool read_ok = double_read_ahead(
-            [&, first_tx_id = first_tx_id, expected_tx_count = expected_tx_count](auto tx_it, auto body_it) -> bool {
-                BlockNum block_number = first_block_num;
-
-                db::detail::BlockBodyForStorage body;
-
-                Bytes tx_buffer{}, body_buffer{};
-                tx_buffer.reserve(kPageSize);
-                body_buffer.reserve(kPageSize);
-
-                body_it.next(body_buffer);
-                ByteView body_rlp{body_buffer.data(), body_buffer.length()};
-                SILK_TRACE << "double_read_ahead block_number: " << block_number << " body_rlp: " << to_hex(body_rlp);
-                auto decode_result = db::detail::decode_stored_block_body(body_rlp, body);
+    const auto process_txs = [&, first_tx_id = first_tx_id](const WordRange& range, huffman::Decompressor::Iterator& tx_it, std::vector<TxEntry>& entries) -> bool {
+        entries.resize(range.word_count);
+
+        // Find the block containing the first transaction in range
+        auto body_it{std::upper_bound(body_txn_ends.cbegin(), body_txn_ends.cend(), first_tx_id + range.first_word)};
+
+        // Transaction payloads are hashed in batches
+        constexpr std::size_t kTxBatchSize{256};
+        std::vector<evmc::bytes32> tx_hashes(range.word_count);
+        std::vector<Bytes> payloads(kTxBatchSize);
+        std::vector<std::size_t> payload_txs;
+        std::vector<ByteView> payload_views;
+        std::vector<evmc::bytes32> payload_hashes;
+        payload_txs.reserve(kTxBatchSize);
+        payload_views.reserve(kTxBatchSize);
+        payload_hashes.reserve(kTxBatchSize);
+        auto flush_payloads = [&]() {
+            payload_views.assign(payloads.cbegin(), payloads.cbegin() + static_cast<std::ptrdiff_t>(payload_txs.size()));
+            payload_hashes.resize(payload_views.size());
+            keccak256_batch(payload_views, payload_hashes);
+            for (std::size_t j{0}; j < payload_txs.size(); ++j) {
+                tx_hashes[payload_txs[j]] = payload_hashes[j];
+            }
+            payload_txs.clear();
+        };
+
+        Bytes tx_buffer{};
+        tx_buffer.reserve(kPageSize);
+        uint64_t offset{range.offset};
+        for (uint64_t j{0}; j < range.word_count; ++j) {
+            const uint64_t i{range.first_word + j};
+            if (!tx_it.has_next()) return false;
+            const uint64_t next_position = tx_it.next(tx_buffer);
+            while (body_it != body_txn_ends.cend() && *body_it <= first_tx_id + i) {
+                ++body_it;
+            }
+            if (body_it == body_txn_ends.cend()) return false;
+
+            TxEntry& entry{entries[j]};
+            entry.offset = offset;
+            entry.block_number = first_block_num + static_cast<BlockNum>(body_it - body_txn_ends.cbegin());
+            const bool is_system_tx{tx_buffer.empty()};
+            if (is_system_tx) {
+                // system-txs: hash:pad32(txnID)
+                endian::store_big_u64(tx_hashes[j].bytes, first_tx_id + i);
+            } else {
+                // Skip tx hash first byte plus address length for transaction decoding
+                constexpr int kTxFirstByteAndAddressLength{1 + kAddressLength};
+                const Bytes tx_envelope{tx_buffer.substr(kTxFirstByteAndAddressLength)};
+                ByteView tx_envelope_view{tx_envelope};
+
+                rlp::Header tx_header;
+                TransactionType tx_type{};
+                const auto decode_result = rlp::decode_transaction_header_and_type(tx_envelope_view, tx_header, tx_type);
                 if (!decode_result) {
-                    SILK_ERROR << "cannot decode block " << block_number << " body: " << to_hex(body_rlp) << " error: " << magic_enum::enum_name(decode_result.error());
+                    SILK_ERROR << "cannot decode tx envelope: " << to_hex(tx_envelope) << " i: " << i << " error: " << magic_enum::enum_name(decode_result.error());
                     return false;
                 }
-                body_buffer.clear();
-
-                uint64_t i{0}, offset{0};
-                while (tx_it.has_next()) {
-                    uint64_t next_position = tx_it.next(tx_buffer);
-                    while (body.base_txn_id + body.txn_count <= first_tx_id + i) {
-                        if (!body_it.has_next()) return false;
-                        body_it.next(body_buffer);
-                        body_rlp = ByteView{body_buffer.data(), body_buffer.length()};
-                        decode_result = db::detail::decode_stored_block_body(body_rlp, body);
-                        if (!decode_result) {
-                            SILK_ERROR << "cannot decode block " << block_number << " body: " << to_hex(body_rlp) << " i: " << i << " error: " << magic_enum::enum_name(decode_result.error());
-                            return false;
-                        }
-                        body_buffer.clear();
-                        ++block_number;
-                    }
-                    const bool is_system_tx{tx_buffer.empty()};
-                    if (is_system_tx) {
-                        // system-txs: hash:pad32(txnID)
-                        endian::store_big_u64(tx_hash.bytes, first_tx_id + i);
-
-                        tx_hash_rs.add_key(tx_hash.bytes, kHashLength, offset);
-                        tx_hash_to_block_rs.add_key(tx_hash.bytes, kHashLength, block_number);
-                    } else {
-                        // Skip tx hash first byte plus address length for transaction decoding
-                        constexpr int kTxFirstByteAndAddressLength{1 + kAddressLength};
-                        const Bytes tx_envelope{tx_buffer.substr(kTxFirstByteAndAddressLength)};
-                        ByteView tx_envelope_view{tx_envelope};
-
-                        rlp::Header tx_header;
-                        TransactionType tx_type{};
-                        decode_result = rlp::decode_transaction_header_and_type(tx_envelope_view, tx_header, tx_type);
-                        if (!decode_result) {
-                            SILK_ERROR << "cannot decode tx envelope: " << to_hex(tx_envelope) << " i: " << i << " error: " << magic_enum::enum_name(decode_result.error());
-                            return false;
-                        }
-                        const std::size_t tx_payload_offset = tx_type == TransactionType::kLegacy ? 0 : (tx_envelope.length() - tx_header.payload_length);
-
-                        if (i % 100'000 == 0) {
-                            SILK_DEBUG << "header.list: " << tx_header.list << " header.payload_length: " << tx_header.payload_length << " i: " << i;
-                        }
-
-                        const Bytes tx_payload{tx_buffer.substr(kTxFirstByteAndAddressLength + tx_payload_offset)};
-                        const auto h256{keccak256(tx_payload)};
-                        std::copy(std::begin(h256.bytes), std::begin(h256.bytes) + kHashLength, std::begin(tx_hash.bytes));
-                        SILK_DEBUG << "type: " << int(tx_type) << " i: " << i << " payload: " << to_hex(tx_payload)
-                                   << " h256: " << to_hex(h256.bytes, kHashLength);
-                        tx_hash_rs.add_key(tx_hash.bytes, kHashLength, offset);
-                        tx_hash_to_block_rs.add_key(tx_hash.bytes, kHashLength, block_number);
-                    }
-
-                    ++i;
-                    offset = next_position;
-                    tx_buffer.clear();
+                const std::size_t tx_payload_offset = tx_type == TransactionType::kLegacy ? 0 : (tx_envelope.length() - tx_header.payload_length);
+
+                if (i % 100'000 == 0) {
+                    SILK_DEBUG << "header.list: " << tx_header.list << " header.payload_length: " << tx_header.payload_length << " i: " << i;
                 }
 
-                if (i != expected_tx_count) {
-                    throw std::runtime_error{"tx count mismatch: expected=" + std::to_string(expected_tx_count) +
-                                             " got=" + std::to_string(i)};
+                payloads[payload_txs.size()].assign(ByteView{tx_buffer}.substr(kTxFirstByteAndAddressLength + tx_payload_offset));
+                SILK_DEBUG << "type: " << int(tx_type) << " i: " << i << " payload: " << to_hex(payloads[payload_txs.size()]);
+                payload_txs.push_back(j);
+                if (payload_txs.size() == kTxBatchSize) {
+                    flush_payloads();
                 }
+            }
 
-                return true;
-            });
+            offset = next_position;
+            tx_buffer.clear();
+        }
+        flush_payloads();
+
+        for (std::size_t j{0}; j < entries.size(); ++j) {
+            const ByteView tx_hash{tx_hashes[j].bytes, kHashLength};
+            entries[j].tx_hash_key = tx_hash_rs.hash_key(tx_hash);
+            entries[j].tx_hash_to_block_key = tx_hash_to_block_rs.hash_key(tx_hash);
+        }
+        return true;
+    };
+
+    const auto word_ranges{split_words(txs_decoder, workers)};
+    SILK_TRACE << "Build index for: " << segment_path_.path().string() << " start [ranges=" << word_ranges.size() << "]";
+    uint64_t iterations{0};
+    bool collision_detected{false};
+    do {
+        iterations++;
+        SILK_TRACE << "Process snapshot items to prepare index build for: " << segment_path_.path().string();
+        uint64_t i{0};
+        processed_words_ = 0;
+        const auto add_keys = [&](const std::vector<TxEntry>& entries) {
+            for (const auto& entry : entries) {
+                tx_hash_rs.add_key(entry.tx_hash_key, entry.offset);
+                tx_hash_to_block_rs.add_key(entry.tx_hash_to_block_key, entry.block_number);
+            }
+            i += entries.size();
+            processed_words_ += entries.size();
+        };
+        const bool read_ok = scan_ranges<TxEntry>(txs_decoder, word_ranges, workers, process_txs, add_keys);
         if (!read_ok) throw std::runtime_error{"cannot build index for: " + segment_path_.path().string()};
+        if (i != expected_tx_count) {
+            throw std::runtime_error{"tx count mismatch: expected=" + std::to_string(expected_tx_count) +
+                                     " got=" + std::to_string(i)};
+        }
 
         SILK_TRACE << "Build tx_hash RecSplit index for: " << segment_path_.path().string() << " [" << iterations << "]";
         collision_detected = tx_hash_rs.build();
@@ -265,7 +349,7 @@ void TransactionIndex::build() {
     SILK_TRACE << "TransactionIndex::build path: " << segment_path_.path().string() << " end";
 }
 
-bool TransactionIndex::walk(RecSplit8& /*rec_split*/, uint64_t /*i*/, uint64_t /*offset*/, ByteView /*word*/) {
+bool TransactionIndex::walk(const RecSplit8& /*rec_split*/, uint64_t /*i*/, uint64_t /*offset*/, ByteView /*word*/, IndexEntry& /*entry*/) const {
     return true;
 }
 
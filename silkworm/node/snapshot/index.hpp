@@ -16,9 +16,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/infra/concurrency/thread_pool.hpp>
 #include <silkworm/node/huffman/decompressor.hpp>
 #include <silkworm/node/recsplit/rec_split.hpp>
 #include <silkworm/node/snapshot/path.hpp>
@@ -30,19 +35,62 @@ class Index {
     static constexpr uint64_t kPageSize{4096};
     static constexpr std::size_t kBucketSize{2'000};
 
+    //! Max number of segment words scanned by each task, which bounds the memory used for keys before adding them
+    static constexpr uint64_t kMaxWordsPerScanRange{64 * 1024};
+
+    //! Default max memory used for buffering keys in one index build, keys are spilled to disk beyond it
+    static constexpr std::size_t kDefaultMemoryBudget{512_Mebi};
+
+    //! Min memory used for buffering keys in one index build
+    static constexpr std::size_t kMinMemoryBudget{64_Mebi};
+
     explicit Index(SnapshotPath segment_path, std::optional<MemoryMappedRegion> segment_region = {})
         : segment_path_(std::move(segment_path)), segment_region_{segment_region} {}
     virtual ~Index() = default;
 
     [[nodiscard]] SnapshotPath path() const { return segment_path_.index_file(); }
+    [[nodiscard]] const SnapshotPath& segment_path() const { return segment_path_; }
+
+    //! Return the size in bytes of the segment to index, zero if not available
+    [[nodiscard]] std::size_t segment_size() const;
+
+    [[nodiscard]] std::size_t memory_budget() const { return memory_budget_; }
+    void set_memory_budget(std::size_t memory_budget) { memory_budget_ = std::max(memory_budget, kMinMemoryBudget); }
+
+    //! The number of segment words already indexed and the total number of words, safe to read while building
+    [[nodiscard]] uint64_t processed_words() const { return processed_words_; }
+    [[nodiscard]] uint64_t total_words() const { return total_words_; }
 
-    virtual void build();
+    //! Build the index scanning the segment concurrently on as many workers as hardware threads
+    void build();
+
+    //! Build the index scanning the segment concurrently on the specified workers
+    //! @warning this must not be called from tasks running on the same workers
+    virtual void build(ThreadPool& workers);
 
   protected:
-    virtual bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) = 0;
+    //! Key hash and value to add into the index for one segment word
+    struct IndexEntry {
+        succinct::hash128_t key_hash{};
+        uint64_t value{0};
+    };
+
+    //! Compute the index entry for the i-th word at the specified offset
+    //! @details This is called concurrently for distinct words, hence it must not change any shared state
+    virtual bool walk(const succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word, IndexEntry& entry) const = 0;
+
+    //! Split the segment words into ranges to be scanned concurrently on the specified workers
+    [[nodiscard]] static std::vector<huffman::Decompressor::WordRange> split_words(const huffman::Decompressor& decoder,
+                                                                                   const ThreadPool& workers);
 
     SnapshotPath segment_path_;
     std::optional<MemoryMappedRegion> segment_region_;
+
+    //! The max memory for buffering keys, split among the ETL collectors used by the index build
+    std::size_t memory_budget_{kDefaultMemoryBudget};
+
+    std::atomic<uint64_t> processed_words_{0};
+    std::atomic<uint64_t> total_words_{0};
 };
 
 class HeaderIndex : public Index {
@@ -51,7 +99,7 @@ class HeaderIndex : public Index {
         : Index(std::move(segment_path), segment_region) {}
 
   protected:
-    bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) override;
+    bool walk(const succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word, IndexEntry& entry) const override;
 };
 
 class BodyIndex : public Index {
@@ -60,7 +108,7 @@ class BodyIndex : public Index {
         : Index(std::move(segment_path), segment_region) {}
 
   protected:
-    bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) override;
+    bool walk(const succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word, IndexEntry& entry) const override;
 };
 
 class TransactionIndex : public Index {
@@ -68,10 +116,11 @@ class TransactionIndex : public Index {
     explicit TransactionIndex(SnapshotPath segment_path, std::optional<MemoryMappedRegion> segment_region = {})
         : Index(std::move(segment_path), segment_region) {}
 
-    void build() override;
+    using Index::build;
+    void build(ThreadPool& workers) override;
 
   protected:
-    bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) override;
+    bool walk(const succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word, IndexEntry& entry) const override;
 };
 
 }  // namespace silkworm::snapshot
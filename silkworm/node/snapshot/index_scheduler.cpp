@@ -0,0 +1,147 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "index_scheduler.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <thread>
+#include <utility>
+
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/infra/common/log.hpp>
+
+namespace silkworm::snapshot {
+
+static constexpr std::chrono::seconds kCheckCompletionInterval{1};
+
+static unsigned thread_count_or_default(std::size_t thread_count) {
+    return thread_count > 0 ? static_cast<unsigned>(thread_count) : std::thread::hardware_concurrency();
+}
+
+static std::size_t compute_concurrent_builds(const IndexBuildSettings& settings) {
+    const std::size_t max_builds{settings.max_concurrent_builds > 0 ? settings.max_concurrent_builds
+                                                                    : std::max(1u, std::thread::hardware_concurrency())};
+    const std::size_t max_builds_in_budget{std::max<std::size_t>(1, settings.memory_budget / Index::kMinMemoryBudget)};
+    return std::min(max_builds, max_builds_in_budget);
+}
+
+IndexBuildScheduler::IndexBuildScheduler(IndexBuildSettings settings)
+    : settings_{settings},
+      concurrent_builds_{compute_concurrent_builds(settings_)},
+      scan_workers_{thread_count_or_default(settings_.scan_threads)},
+      build_workers_{static_cast<unsigned>(concurrent_builds_)} {}
+
+std::size_t IndexBuildScheduler::memory_budget_per_build() const {
+    return std::max(settings_.memory_budget / concurrent_builds_, Index::kMinMemoryBudget);
+}
+
+bool IndexBuildScheduler::build(std::vector<std::shared_ptr<Index>> indexes, const std::function<bool()>& stop_requested) {
+    // Largest segments first, so that the smallest ones fill the gaps at the end
+    std::vector<std::pair<std::size_t, std::shared_ptr<Index>>> sized_indexes;
+    sized_indexes.reserve(indexes.size());
+    for (auto& index : indexes) {
+        sized_indexes.emplace_back(index->segment_size(), std::move(index));
+    }
+    std::stable_sort(sized_indexes.begin(), sized_indexes.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first > rhs.first;
+    });
+    {
+        std::scoped_lock lock{indexes_mutex_};
+        indexes_.clear();
+        for (auto& [_, index] : sized_indexes) {
+            indexes_.push_back(std::move(index));
+        }
+        indexes_done_ = std::make_unique<std::atomic_bool[]>(indexes_.size());
+    }
+
+    SILK_INFO << "IndexBuildScheduler: build indexes: " << indexes_.size() << " concurrent builds: " << concurrent_builds_
+              << " memory per build: " << human_size(memory_budget_per_build());
+
+    std::atomic_bool stopping{false};
+    std::vector<std::future<void>> results;
+    results.reserve(indexes_.size());
+    for (std::size_t i{0}; i < indexes_.size(); ++i) {
+        results.push_back(build_workers_.submit([this, i, index = indexes_[i], &stopping]() {
+            if (stopping) return;
+            index->set_memory_budget(memory_budget_per_build());
+            SILK_INFO << "IndexBuildScheduler: build index: " << index->path().filename() << " start";
+            index->build(scan_workers_);
+            indexes_done_[i] = true;
+            SILK_INFO << "IndexBuildScheduler: build index: " << index->path().filename() << " end";
+        }));
+    }
+
+    // Wait for all builds, which must complete before returning because they refer to this scope
+    std::exception_ptr first_exception;
+    auto next_progress_time{std::chrono::steady_clock::now() + kProgressInterval};
+    for (auto& result : results) {
+        while (result.wait_for(kCheckCompletionInterval) != std::future_status::ready) {
+            if (!stopping && stop_requested && stop_requested()) {
+                SILK_INFO << "IndexBuildScheduler: stop requested, waiting for started builds";
+                stopping = true;
+            }
+            if (std::chrono::steady_clock::now() >= next_progress_time) {
+                log_progress();
+                next_progress_time += kProgressInterval;
+            }
+        }
+        try {
+            result.get();
+        } catch (...) {
+            // Do not start any other build after the first failure
+            if (!first_exception) first_exception = std::current_exception();
+            stopping = true;
+        }
+    }
+    if (first_exception) std::rethrow_exception(first_exception);
+
+    std::scoped_lock lock{indexes_mutex_};
+    return std::all_of(indexes_done_.get(), indexes_done_.get() + indexes_.size(), [](const auto& done) { return done.load(); });
+}
+
+std::vector<IndexBuildScheduler::SegmentProgress> IndexBuildScheduler::progress() const {
+    std::scoped_lock lock{indexes_mutex_};
+    std::vector<SegmentProgress> segment_progress;
+    segment_progress.reserve(indexes_.size());
+    for (std::size_t i{0}; i < indexes_.size(); ++i) {
+        const auto& index{indexes_[i]};
+        segment_progress.push_back({
+            .segment_file = index->segment_path().filename(),
+            .processed_words = index->processed_words(),
+            .total_words = index->total_words(),
+            .done = indexes_done_[i].load(),
+        });
+    }
+    return segment_progress;
+}
+
+void IndexBuildScheduler::log_progress() const {
+    const auto segment_progress{progress()};
+    std::size_t done_count{0};
+    for (const auto& segment : segment_progress) {
+        if (segment.done) {
+            ++done_count;
+        } else if (segment.total_words > 0) {
+            SILK_INFO << "IndexBuildScheduler: segment: " << segment.segment_file
+                      << " words: " << segment.processed_words << "/" << segment.total_words;
+        }
+    }
+    SILK_INFO << "IndexBuildScheduler: indexes built: " << done_count << "/" << segment_progress.size();
+}
+
+}  // namespace silkworm::snapshot
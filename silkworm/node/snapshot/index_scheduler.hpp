@@ -0,0 +1,86 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <silkworm/infra/concurrency/thread_pool.hpp>
+#include <silkworm/node/snapshot/index.hpp>
+#include <silkworm/node/snapshot/settings.hpp>
+
+namespace silkworm::snapshot {
+
+//! Scheduler of index builds for many segments sharing one memory budget and one pool of scan workers.
+//! @details The memory budget bounds the number of concurrent builds and it is split evenly among them, so that each
+//! build spills its keys to disk when over its share. Segments are scanned in ranges by the scan workers, so the total
+//! number of busy threads does not depend on the number of concurrent builds. Largest segments are scheduled first.
+class IndexBuildScheduler {
+  public:
+    //! Interval between successive progress reports
+    static constexpr std::chrono::seconds kProgressInterval{10};
+
+    explicit IndexBuildScheduler(IndexBuildSettings settings = {});
+
+    //! Number of indexes built concurrently within the memory budget
+    [[nodiscard]] std::size_t concurrent_builds() const { return concurrent_builds_; }
+
+    //! Max memory for buffering keys in each index build
+    [[nodiscard]] std::size_t memory_budget_per_build() const;
+
+    //! Build the specified indexes until completion or stop request
+    //! @param stop_requested predicate checked periodically, builds already started are always completed
+    //! @return true if all indexes have been built, false if stopped before
+    //! @throws the first exception raised by any index build, after all started builds are completed
+    bool build(std::vector<std::shared_ptr<Index>> indexes, const std::function<bool()>& stop_requested = {});
+
+    struct SegmentProgress {
+        std::string segment_file;
+        uint64_t processed_words{0};
+        uint64_t total_words{0};
+        bool done{false};
+    };
+
+    //! The progress of each segment in the current (or last) build
+    [[nodiscard]] std::vector<SegmentProgress> progress() const;
+
+  private:
+    void log_progress() const;
+
+    IndexBuildSettings settings_;
+
+    //! The number of concurrent builds, each one running on a dedicated build worker
+    std::size_t concurrent_builds_;
+
+    //! The workers scanning segment ranges, shared by all builds
+    ThreadPool scan_workers_;
+
+    //! The workers running the builds, just waiting for scan workers most of the time
+    ThreadPool build_workers_;
+
+    //! The indexes in the current (or last) build along with their completion flags
+    mutable std::mutex indexes_mutex_;
+    std::vector<std::shared_ptr<Index>> indexes_;
+    std::unique_ptr<std::atomic_bool[]> indexes_done_;
+};
+
+}  // namespace silkworm::snapshot
@@ -0,0 +1,92 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "index_scheduler.hpp"
+
+#include <filesystem>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/infra/test_util/log.hpp>
+#include <silkworm/node/test/snapshots.hpp>
+
+namespace silkworm::snapshot {
+
+TEST_CASE("IndexBuildScheduler::concurrent_builds", "[silkworm][snapshot][index]") {
+    SECTION("bounded by memory budget") {
+        IndexBuildScheduler scheduler{{.memory_budget = 2 * Index::kMinMemoryBudget, .max_concurrent_builds = 8, .scan_threads = 1}};
+        CHECK(scheduler.concurrent_builds() == 2);
+        CHECK(scheduler.memory_budget_per_build() == Index::kMinMemoryBudget);
+    }
+    SECTION("bounded by max concurrent builds") {
+        IndexBuildScheduler scheduler{{.memory_budget = 3_Gibi, .max_concurrent_builds = 3, .scan_threads = 1}};
+        CHECK(scheduler.concurrent_builds() == 3);
+        CHECK(scheduler.memory_budget_per_build() == 1_Gibi);
+    }
+    SECTION("at least one build") {
+        IndexBuildScheduler scheduler{{.memory_budget = 1_Mebi, .max_concurrent_builds = 2, .scan_threads = 1}};
+        CHECK(scheduler.concurrent_builds() == 1);
+        CHECK(scheduler.memory_budget_per_build() == Index::kMinMemoryBudget);
+    }
+}
+
+TEST_CASE("IndexBuildScheduler::build", "[silkworm][snapshot][index]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    IndexBuildScheduler scheduler{{.memory_budget = 2 * Index::kMinMemoryBudget, .max_concurrent_builds = 2, .scan_threads = 2}};
+
+    SECTION("no index") {
+        CHECK(scheduler.build({}));
+        CHECK(scheduler.progress().empty());
+    }
+
+    SECTION("sample indexes") {
+        test::SampleHeaderSnapshotFile header_snapshot_file;
+        test::SampleHeaderSnapshotPath header_snapshot_path{header_snapshot_file.path()};
+        test::SampleBodySnapshotFile body_snapshot_file;
+        test::SampleBodySnapshotPath body_snapshot_path{body_snapshot_file.path()};
+        test::SampleTransactionSnapshotFile txn_snapshot_file;
+        test::SampleTransactionSnapshotPath txn_snapshot_path{txn_snapshot_file.path()};
+
+        std::vector<std::shared_ptr<Index>> indexes{
+            std::make_shared<HeaderIndex>(header_snapshot_path),
+            std::make_shared<BodyIndex>(body_snapshot_path),
+            std::make_shared<TransactionIndex>(txn_snapshot_path),
+        };
+        CHECK(scheduler.build(indexes, [] { return false; }));
+
+        for (const auto& index : indexes) {
+            CHECK(std::filesystem::exists(index->path().path()));
+            CHECK(index->memory_budget() == scheduler.memory_budget_per_build());
+        }
+        const auto progress{scheduler.progress()};
+        CHECK(progress.size() == indexes.size());
+        for (const auto& segment_progress : progress) {
+            CHECK(segment_progress.done);
+            CHECK(segment_progress.processed_words == segment_progress.total_words);
+        }
+    }
+
+    SECTION("invalid segment") {
+        test::TemporarySnapshotFile tmp_snapshot_file{"v1-014500-015000-headers.seg"};
+        std::vector<std::shared_ptr<Index>> indexes{
+            std::make_shared<HeaderIndex>(*SnapshotPath::parse(tmp_snapshot_file.path().string())),
+        };
+        CHECK_THROWS_AS(scheduler.build(indexes), std::logic_error);
+        CHECK_FALSE(scheduler.progress()[0].done);
+    }
+}
+
+}  // namespace silkworm::snapshot
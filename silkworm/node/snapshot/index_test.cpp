@@ -138,4 +138,14 @@ TEST_CASE("TransactionIndex::build OK", "[silkworm][snapshot][index]") {
     CHECK_NOTHROW(tx_index.build());
 }
 
+TEST_CASE("TransactionIndex::build OK: explicit workers", "[silkworm][snapshot][index]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::SampleBodySnapshotFile valid_bodies_snapshot{};
+    test::SampleTransactionSnapshotFile valid_txs_snapshot{};
+    test::SampleTransactionSnapshotPath txs_snapshot_path{valid_txs_snapshot.path()};  // necessary to tweak the block numbers
+    TransactionIndex tx_index{txs_snapshot_path};
+    ThreadPool workers{2};
+    CHECK_NOTHROW(tx_index.build(workers));
+}
+
 }  // namespace silkworm::snapshot
@@ -17,24 +17,76 @@
 #include "repository.hpp"
 
 #include <algorithm>
+#include <numeric>
 #include <ranges>
 #include <utility>
 
 #include <silkworm/core/common/assert.hpp>
 #include <silkworm/infra/common/ensure.hpp>
 #include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/common/os.hpp>
 #include <silkworm/node/snapshot/index.hpp>
 
 namespace silkworm::snapshot {
 
 namespace fs = std::filesystem;
 
+//! Scope adding the major page faults incurred by the calling thread within it to the specified counter, if any
+class PageFaultScope {
+  public:
+    explicit PageFaultScope(std::atomic_uint64_t* counter)
+        : counter_{counter}, start_faults_{counter ? os::major_page_faults() : 0} {}
+    ~PageFaultScope() {
+        if (counter_) {
+            *counter_ += os::major_page_faults() - start_faults_;
+        }
+    }
+
+    PageFaultScope(const PageFaultScope&) = delete;
+    PageFaultScope& operator=(const PageFaultScope&) = delete;
+
+  private:
+    std::atomic_uint64_t* counter_;
+    uint64_t start_faults_;
+};
+
+//! Apply the specified memory-mapping policy to the specified file, just warning about unsupported features
+static void apply_policy(MemoryMappedFile& file, const MemoryMappingPolicy& policy) {
+    if (policy.huge_pages && !file.advise_huge_pages()) {
+        SILK_DEBUG << "Huge pages not available for: " << file.path().filename().string();
+    }
+    if (policy.populate) {
+        file.populate();
+    }
+    if (policy.lock && !file.lock()) {
+        SILK_WARN << "Cannot lock in memory: " << file.path().filename().string() << " (memory-lock limit exceeded?)";
+    }
+}
+
 template <ConcreteSnapshot T>
-const T* get_segment(const SnapshotsByPath<T>& segments, const SnapshotPath& path) {
-    if (not segments.contains(path.path())) {
+std::shared_ptr<const T> get_segment(const SnapshotsByPath<T>& segments, const SnapshotPath& path) {
+    const auto segment_it = segments.find(path.path());
+    if (segment_it == segments.end()) {
         return nullptr;
     }
-    return segments.find(path.path())->second.get();
+    return segment_it->second;
+}
+
+template <ConcreteSnapshot T>
+std::shared_ptr<const T> find_segment(const SnapshotSet& snapshot_set, const SnapshotsByPath<T>& segments, BlockNum number) {
+    if (number > std::min(snapshot_set.segment_max_block, snapshot_set.idx_max_block)) {
+        return nullptr;
+    }
+
+    // Search for target segment in reverse order (from the newest segment to the oldest one)
+    for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+        const auto& snapshot = it->second;
+        // We're looking for the segment containing the target block number in its block range
+        if (snapshot->block_from() <= number && number < snapshot->block_to()) {
+            return snapshot;
+        }
+    }
+    return nullptr;
 }
 
 template <ConcreteSnapshot T>
@@ -64,20 +116,85 @@ std::size_t view(const SnapshotsByPath<T>& segments, const SnapshotWalker<T>& wa
     return visited_views;
 }
 
-SnapshotRepository::SnapshotRepository(SnapshotSettings settings) : settings_(std::move(settings)) {}
+static bool has_all_indexes(const HeaderSnapshot& snapshot) {
+    return snapshot.idx_header_hash() != nullptr;
+}
+
+static bool has_all_indexes(const BodySnapshot& snapshot) {
+    return snapshot.idx_body_number() != nullptr;
+}
+
+static bool has_all_indexes(const TransactionSnapshot& snapshot) {
+    return snapshot.idx_txn_hash() != nullptr && snapshot.idx_txn_hash_2_block() != nullptr;
+}
+
+//! The max block number such that all segments up to it have all their indexes
+template <ConcreteSnapshot T>
+static BlockNum max_idx_available(const SnapshotsByPath<T>& segments) {
+    BlockNum max_block{0};
+    for (const auto& [_, segment] : segments) {
+        if (not has_all_indexes(*segment)) break;
+        max_block = segment->block_to() - 1;
+    }
+    return max_block;
+}
+
+template <ConcreteSnapshot T>
+static BlockNum max_segment_available(const SnapshotsByPath<T>& segments) {
+    return segments.empty() ? 0 : segments.rbegin()->second->block_to() - 1;
+}
+
+//! Remove from the specified segments the ones whose segment file does not exist anymore
+template <ConcreteSnapshot T>
+static void retire_gone_segments(SnapshotsByPath<T>& segments) {
+    std::erase_if(segments, [](const auto& path_and_segment) {
+        return !fs::exists(path_and_segment.first);
+    });
+}
+
+SnapshotRepository::SnapshotRepository(SnapshotSettings settings)
+    : settings_(std::move(settings)),
+      block_cache_{settings_.block_cache_settings},
+      snapshot_set_{std::make_shared<SnapshotSet>()} {}
 
 SnapshotRepository::~SnapshotRepository() {
     close();
 }
 
+std::shared_ptr<const SnapshotSet> SnapshotRepository::snapshot_set() const {
+    return std::atomic_load_explicit(&snapshot_set_, std::memory_order_acquire);
+}
+
+BlockNum SnapshotRepository::max_block_available() const {
+    const auto snapshots{snapshot_set()};
+    return std::min(snapshots->segment_max_block, snapshots->idx_max_block);
+}
+
+std::size_t SnapshotRepository::total_snapshots_count() const {
+    const auto snapshots{snapshot_set()};
+    return snapshots->header_segments.size() + snapshots->body_segments.size() + snapshots->tx_segments.size();
+}
+
+void SnapshotRepository::publish(std::shared_ptr<SnapshotSet> snapshot_set) {
+    snapshot_set->epoch = this->snapshot_set()->epoch + 1;
+    snapshot_set->segment_max_block = std::max({max_segment_available(snapshot_set->header_segments),
+                                                max_segment_available(snapshot_set->body_segments),
+                                                max_segment_available(snapshot_set->tx_segments)});
+    snapshot_set->idx_max_block = std::min({max_idx_available(snapshot_set->header_segments),
+                                            max_idx_available(snapshot_set->body_segments),
+                                            max_idx_available(snapshot_set->tx_segments)});
+    // Snapshots no more in the new set are closed when the last reader holding the previous sets releases them
+    std::shared_ptr<const SnapshotSet> published_set{std::move(snapshot_set)};
+    std::atomic_store_explicit(&snapshot_set_, std::move(published_set), std::memory_order_release);
+}
+
 void SnapshotRepository::add_snapshot_bundle(SnapshotBundle&& bundle) {
-    header_segments_[bundle.headers_snapshot_path.path()] = std::move(bundle.headers_snapshot);
-    body_segments_[bundle.bodies_snapshot_path.path()] = std::move(bundle.bodies_snapshot);
-    tx_segments_[bundle.tx_snapshot_path.path()] = std::move(bundle.tx_snapshot);
-    if (bundle.tx_snapshot_path.block_to() > segment_max_block_) {
-        segment_max_block_ = bundle.tx_snapshot_path.block_to() - 1;
-    }
-    idx_max_block_ = max_idx_available();
+    std::scoped_lock lock{publish_mutex_};
+    auto snapshots{std::make_shared<SnapshotSet>(*snapshot_set())};
+    snapshots->header_segments[bundle.headers_snapshot_path.path()] = std::move(bundle.headers_snapshot);
+    snapshots->body_segments[bundle.bodies_snapshot_path.path()] = std::move(bundle.bodies_snapshot);
+    snapshots->tx_segments[bundle.tx_snapshot_path.path()] = std::move(bundle.tx_snapshot);
+    publish(std::move(snapshots));
 }
 
 void SnapshotRepository::reopen_folder() {
@@ -89,15 +206,8 @@ void SnapshotRepository::reopen_folder() {
 
 void SnapshotRepository::close() {
     SILK_TRACE << "Close snapshot repository folder: " << settings_.repository_dir.string();
-    for (const auto& [_, header_seg] : this->header_segments_) {
-        header_seg->close();
-    }
-    for (const auto& [_, body_seg] : this->body_segments_) {
-        body_seg->close();
-    }
-    for (const auto& [_, tx_seg] : this->tx_segments_) {
-        tx_seg->close();
-    }
+    std::scoped_lock lock{publish_mutex_};
+    publish(std::make_shared<SnapshotSet>());
 }
 
 std::vector<BlockNumRange> SnapshotRepository::missing_block_ranges() const {
@@ -116,7 +226,9 @@ std::vector<BlockNumRange> SnapshotRepository::missing_block_ranges() const {
 }
 
 bool SnapshotRepository::for_each_header(const HeaderSnapshot::Walker& fn) {
-    for (const auto& [_, header_snapshot] : header_segments_) {
+    PageFaultScope page_faults{page_fault_counter(SnapshotType::headers)};
+    const auto snapshots{snapshot_set()};
+    for (const auto& [_, header_snapshot] : snapshots->header_segments) {
         SILK_TRACE << "for_each_header header_snapshot: " << header_snapshot->fs_path().string();
         const auto keep_going = header_snapshot->for_each_header([fn](const auto* header) {
             return fn(header);
@@ -127,7 +239,9 @@ bool SnapshotRepository::for_each_header(const HeaderSnapshot::Walker& fn) {
 }
 
 bool SnapshotRepository::for_each_body(const BodySnapshot::Walker& fn) {
-    for (const auto& [_, body_snapshot] : body_segments_) {
+    PageFaultScope page_faults{page_fault_counter(SnapshotType::bodies)};
+    const auto snapshots{snapshot_set()};
+    for (const auto& [_, body_snapshot] : snapshots->body_segments) {
         SILK_TRACE << "for_each_body body_snapshot: " << body_snapshot->fs_path().string();
         const auto keep_going = body_snapshot->for_each_body([fn](BlockNum number, const auto* body) {
             return fn(number, body);
@@ -137,56 +251,107 @@ bool SnapshotRepository::for_each_body(const BodySnapshot::Walker& fn) {
     return true;
 }
 
+bool SnapshotRepository::for_each_body(ThreadPool& workers, const BodySnapshot::Walker& fn) {
+    const auto snapshots{snapshot_set()};
+    for (const auto& [_, body_snapshot] : snapshots->body_segments) {
+        SILK_TRACE << "for_each_body body_snapshot: " << body_snapshot->fs_path().string();
+        const auto keep_going = body_snapshot->for_each_body(workers, fn);
+        if (!keep_going) return false;
+    }
+    return true;
+}
+
+bool SnapshotRepository::for_each_txn_view(const TransactionSnapshot::ViewWalker& fn) {
+    PageFaultScope page_faults{page_fault_counter(SnapshotType::transactions)};
+    const auto snapshots{snapshot_set()};
+    for (const auto& [_, tx_snapshot] : snapshots->tx_segments) {
+        SILK_TRACE << "for_each_txn_view tx_snapshot: " << tx_snapshot->fs_path().string();
+        const auto keep_going = tx_snapshot->for_each_txn_view(fn);
+        if (!keep_going) return false;
+    }
+    return true;
+}
+
 SnapshotRepository::ViewResult SnapshotRepository::view_header_segment(BlockNum number, const HeaderSnapshotWalker& walker) {
-    return view(header_segments_, number, walker);
+    PageFaultScope page_faults{page_fault_counter(SnapshotType::headers)};
+    return view(snapshot_set()->header_segments, number, walker);
 }
 
 SnapshotRepository::ViewResult SnapshotRepository::view_body_segment(BlockNum number, const BodySnapshotWalker& walker) {
-    return view(body_segments_, number, walker);
+    PageFaultScope page_faults{page_fault_counter(SnapshotType::bodies)};
+    return view(snapshot_set()->body_segments, number, walker);
 }
 
 SnapshotRepository::ViewResult SnapshotRepository::view_tx_segment(BlockNum number, const TransactionSnapshotWalker& walker) {
-    return view(tx_segments_, number, walker);
+    PageFaultScope page_faults{page_fault_counter(SnapshotType::transactions)};
+    return view(snapshot_set()->tx_segments, number, walker);
 }
 
 std::size_t SnapshotRepository::view_header_segments(const HeaderSnapshotWalker& walker) {
-    return view(header_segments_, walker);
+    PageFaultScope page_faults{page_fault_counter(SnapshotType::headers)};
+    return view(snapshot_set()->header_segments, walker);
 }
 
 std::size_t SnapshotRepository::view_body_segments(const BodySnapshotWalker& walker) {
-    return view(body_segments_, walker);
+    PageFaultScope page_faults{page_fault_counter(SnapshotType::bodies)};
+    return view(snapshot_set()->body_segments, walker);
 }
 
 std::size_t SnapshotRepository::view_tx_segments(const TransactionSnapshotWalker& walker) {
-    return view(tx_segments_, walker);
+    PageFaultScope page_faults{page_fault_counter(SnapshotType::transactions)};
+    return view(snapshot_set()->tx_segments, walker);
+}
+
+std::shared_ptr<const HeaderSnapshot> SnapshotRepository::get_header_segment(const SnapshotPath& path) const {
+    return get_segment(snapshot_set()->header_segments, path);
 }
 
-const HeaderSnapshot* SnapshotRepository::get_header_segment(const SnapshotPath& path) const {
-    return get_segment(header_segments_, path);
+std::shared_ptr<const BodySnapshot> SnapshotRepository::get_body_segment(const SnapshotPath& path) const {
+    return get_segment(snapshot_set()->body_segments, path);
 }
 
-const BodySnapshot* SnapshotRepository::get_body_segment(const SnapshotPath& path) const {
-    return get_segment(body_segments_, path);
+std::shared_ptr<const TransactionSnapshot> SnapshotRepository::get_tx_segment(const SnapshotPath& path) const {
+    return get_segment(snapshot_set()->tx_segments, path);
 }
 
-const TransactionSnapshot* SnapshotRepository::get_tx_segment(const SnapshotPath& path) const {
-    return get_segment(tx_segments_, path);
+std::shared_ptr<const HeaderSnapshot> SnapshotRepository::find_header_segment(BlockNum number) const {
+    const auto snapshots{snapshot_set()};
+    return find_segment(*snapshots, snapshots->header_segments, number);
 }
 
-const HeaderSnapshot* SnapshotRepository::find_header_segment(BlockNum number) const {
-    return find_segment(header_segments_, number);
+std::shared_ptr<const BodySnapshot> SnapshotRepository::find_body_segment(BlockNum number) const {
+    const auto snapshots{snapshot_set()};
+    return find_segment(*snapshots, snapshots->body_segments, number);
 }
 
-const BodySnapshot* SnapshotRepository::find_body_segment(BlockNum number) const {
-    return find_segment(body_segments_, number);
+std::shared_ptr<const TransactionSnapshot> SnapshotRepository::find_tx_segment(BlockNum number) const {
+    const auto snapshots{snapshot_set()};
+    return find_segment(*snapshots, snapshots->tx_segments, number);
 }
 
-const TransactionSnapshot* SnapshotRepository::find_tx_segment(BlockNum number) const {
-    return find_segment(tx_segments_, number);
+std::optional<BlockHeader> SnapshotRepository::header_by_number(BlockNum number) const {
+    const auto header_snapshot{find_header_segment(number)};
+    if (!header_snapshot) return std::nullopt;
+    return block_cache_.header_by_number(*header_snapshot, number);
+}
+
+std::optional<StoredBlockBody> SnapshotRepository::body_by_number(BlockNum number) const {
+    const auto body_snapshot{find_body_segment(number)};
+    if (!body_snapshot) return std::nullopt;
+    return block_cache_.body_by_number(*body_snapshot, number);
+}
+
+std::optional<std::vector<Transaction>> SnapshotRepository::txn_range(BlockNum number, uint64_t base_txn_id, uint64_t txn_count,
+                                                                      bool read_senders) const {
+    const auto tx_snapshot{find_tx_segment(number)};
+    if (!tx_snapshot) return std::nullopt;
+    return block_cache_.txn_range(*tx_snapshot, base_txn_id, txn_count, read_senders);
 }
 
 std::optional<BlockNum> SnapshotRepository::find_block_number(Hash txn_hash) const {
-    for (const auto& it : std::ranges::reverse_view(tx_segments_)) {
+    PageFaultScope page_faults{page_fault_counter(SnapshotType::transactions)};
+    const auto snapshots{snapshot_set()};
+    for (const auto& it : std::ranges::reverse_view(snapshots->tx_segments)) {
         const auto& snapshot = it.second;
         auto block = snapshot->block_num_by_txn_hash(txn_hash);
         if (block) {
@@ -196,6 +361,49 @@ std::optional<BlockNum> SnapshotRepository::find_block_number(Hash txn_hash) con
     return {};
 }
 
+std::vector<std::optional<BlockNum>> SnapshotRepository::find_block_numbers(std::span<const Hash> txn_hashes) const {
+    PageFaultScope page_faults{page_fault_counter(SnapshotType::transactions)};
+    std::vector<std::optional<BlockNum>> block_numbers(txn_hashes.size());
+    std::vector<Hash> missing_hashes{txn_hashes.begin(), txn_hashes.end()};
+    std::vector<std::size_t> missing_indexes(txn_hashes.size());
+    std::iota(missing_indexes.begin(), missing_indexes.end(), 0);
+    const auto snapshots{snapshot_set()};
+    for (const auto& it : std::ranges::reverse_view(snapshots->tx_segments)) {
+        if (missing_hashes.empty()) break;
+        const auto& snapshot = it.second;
+        const auto segment_block_numbers{snapshot->block_nums_by_txn_hash(missing_hashes)};
+        // Just the hashes not found yet are looked up in the next segment
+        std::size_t j{0};
+        for (std::size_t i{0}; i < missing_hashes.size(); ++i) {
+            if (segment_block_numbers[i]) {
+                block_numbers[missing_indexes[i]] = segment_block_numbers[i];
+            } else {
+                missing_hashes[j] = missing_hashes[i];
+                missing_indexes[j] = missing_indexes[i];
+                ++j;
+            }
+        }
+        missing_hashes.resize(j);
+        missing_indexes.resize(j);
+    }
+    return block_numbers;
+}
+
+uint64_t SnapshotRepository::major_page_faults(SnapshotType type) const {
+    const auto* counter{page_fault_counter(type)};
+    return counter ? counter->load() : 0;
+}
+
+std::atomic_uint64_t* SnapshotRepository::page_fault_counter(SnapshotType type) const {
+    if (!settings_.memory_mapping_settings.count_page_faults) {
+        return nullptr;
+    }
+    // Transactions-to-block indexes belong to transaction segments
+    const auto segment_type{type == SnapshotType::transactions_to_block ? SnapshotType::transactions : type};
+    SILKWORM_ASSERT(static_cast<std::size_t>(segment_type) < major_page_faults_.size());
+    return &major_page_faults_[static_cast<std::size_t>(segment_type)];
+}
+
 std::vector<std::shared_ptr<Index>> SnapshotRepository::missing_indexes() const {
     SnapshotPathList segment_files = get_segment_files();
     std::vector<std::shared_ptr<Index>> missing_index_list;
@@ -233,98 +441,115 @@ void SnapshotRepository::reopen_file(const SnapshotPath& segment_path, bool opti
 }
 
 void SnapshotRepository::reopen_list(const SnapshotPathList& segment_files, bool optimistic) {
-    BlockNum segment_max_block{0};
+    // Build the new snapshot set starting from the current one, which is left untouched for the readers using it
+    std::scoped_lock lock{publish_mutex_};
+    auto snapshots{std::make_shared<SnapshotSet>(*snapshot_set())};
+    retire_gone_segments(snapshots->header_segments);
+    retire_gone_segments(snapshots->body_segments);
+    retire_gone_segments(snapshots->tx_segments);
+
     for (const auto& seg_file : segment_files) {
         try {
             SILK_TRACE << "Reopen segment file: " << seg_file.path().filename().string();
-            bool snapshot_valid{true};
-            switch (seg_file.type()) {
-                case SnapshotType::headers: {
-                    const auto header_it = header_segments_.find(seg_file.path());
-                    if (header_it != header_segments_.end()) {
-                        header_it->second->reopen_index();
-                    } else {
-                        snapshot_valid = reopen_header(seg_file);
-                    }
-                    break;
-                }
-                case SnapshotType::bodies: {
-                    const auto body_it = body_segments_.find(seg_file.path());
-                    if (body_it != body_segments_.end()) {
-                        body_it->second->reopen_index();
-                    } else {
-                        snapshot_valid = reopen_body(seg_file);
-                    }
-                    break;
-                }
-                case SnapshotType::transactions: {
-                    const auto tx_it = tx_segments_.find(seg_file.path());
-                    if (tx_it != tx_segments_.end()) {
-                        tx_it->second->reopen_index();
-                    } else {
-                        snapshot_valid = reopen_transaction(seg_file);
-                    }
-                    break;
-                }
-                default: {
-                    SILKWORM_ASSERT(false);
-                }
-            }
+            PageFaultScope page_faults{page_fault_counter(seg_file.type())};
+            const bool snapshot_valid = reopen(*snapshots, seg_file);
             ensure(snapshot_valid, "invalid empty snapshot " + seg_file.filename());
-
-            if (seg_file.block_to() > segment_max_block) {
-                segment_max_block = seg_file.block_to() - 1;
-            }
         } catch (const std::exception& exc) {
             SILK_WARN << "Reopen failed for: " << seg_file.path() << " [" << exc.what() << "]";
             if (!optimistic) throw;
         }
     }
-    segment_max_block_ = segment_max_block;
-    idx_max_block_ = max_idx_available();
-}
 
-bool SnapshotRepository::reopen_header(const SnapshotPath& seg_file) {
-    return reopen(header_segments_, seg_file);
+    warm_up_hot_segments(*snapshots);
+    publish(std::move(snapshots));
+    warm_up_block_cache();
 }
 
-bool SnapshotRepository::reopen_body(const SnapshotPath& seg_file) {
-    return reopen(body_segments_, seg_file);
+bool SnapshotRepository::reopen(SnapshotSet& snapshot_set, const SnapshotPath& seg_file) const {
+    switch (seg_file.type()) {
+        case SnapshotType::headers: {
+            return reopen(snapshot_set.header_segments, seg_file);
+        }
+        case SnapshotType::bodies: {
+            return reopen(snapshot_set.body_segments, seg_file);
+        }
+        case SnapshotType::transactions: {
+            return reopen(snapshot_set.tx_segments, seg_file);
+        }
+        default: {
+            SILKWORM_ASSERT(false);
+        }
+    }
+    return false;
 }
 
-bool SnapshotRepository::reopen_transaction(const SnapshotPath& seg_file) {
-    return reopen(tx_segments_, seg_file);
+template <ConcreteSnapshot T>
+bool SnapshotRepository::reopen(SnapshotsByPath<T>& segments, const SnapshotPath& seg_file) const {
+    const auto segment_it = segments.find(seg_file.path());
+    if (segment_it != segments.end() && has_all_indexes(*segment_it->second)) {
+        // Nothing new to open, keep sharing the same snapshot with its readers
+        return true;
+    }
+
+    // Open a new snapshot instead of reopening indexes of the current one, which may be in use by readers
+    auto segment = std::make_shared<T>(seg_file);
+    segment->reopen_segment();
+    if (segment->empty()) return false;
+    segment->reopen_index();
+    apply_memory_mapping(*segment);
+    segments[seg_file.path()] = std::move(segment);
+    return true;
 }
 
-template <ConcreteSnapshot T>
-const T* SnapshotRepository::find_segment(const SnapshotsByPath<T>& segments, BlockNum number) const {
-    if (number > max_block_available()) {
-        return nullptr;
+void SnapshotRepository::apply_memory_mapping(Snapshot& snapshot) const {
+    if (auto* segment_file = snapshot.segment_file()) {
+        apply_policy(*segment_file, settings_.memory_mapping_settings.segments);
     }
+    for (auto* index_file : snapshot.index_files()) {
+        apply_policy(*index_file, settings_.memory_mapping_settings.indexes);
+    }
+}
 
-    // Search for target segment in reverse order (from the newest segment to the oldest one)
-    for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+void SnapshotRepository::warm_up_hot_segments(const SnapshotSet& snapshot_set) const {
+    if (settings_.memory_mapping_settings.hot_segments == 0) return;
+    warm_up(snapshot_set.header_segments);
+    warm_up(snapshot_set.body_segments);
+    warm_up(snapshot_set.tx_segments);
+}
+
+template <ConcreteSnapshot T>
+void SnapshotRepository::warm_up(const SnapshotsByPath<T>& segments) const {
+    // Most recent segments come last because segments are ordered by block range
+    std::size_t warmed_segments{0};
+    for (auto it = segments.rbegin(); it != segments.rend() && warmed_segments < settings_.memory_mapping_settings.hot_segments; ++it) {
         const auto& snapshot = it->second;
-        // We're looking for the segment containing the target block number in its block range
-        if (snapshot->block_from() <= number && number < snapshot->block_to()) {
-            return snapshot.get();
+        SILK_TRACE << "Warm up hot segment: " << snapshot->fs_path().filename().string();
+        if (auto* segment_file = snapshot->segment_file()) {
+            segment_file->advise_willneed();
+        }
+        for (auto* index_file : snapshot->index_files()) {
+            index_file->advise_willneed();
         }
+        ++warmed_segments;
     }
-    return nullptr;
 }
 
-template <ConcreteSnapshot T>
-bool SnapshotRepository::reopen(SnapshotsByPath<T>& segments, const SnapshotPath& seg_file) {
-    if (segments.find(seg_file.path()) == segments.end()) {
-        auto segment = std::make_unique<T>(seg_file);
-        segment->reopen_segment();
-        if (segment->empty()) return false;
-        segments[seg_file.path()] = std::move(segment);
+void SnapshotRepository::warm_up_block_cache() const {
+    const auto warm_up_blocks{settings_.block_cache_settings.warm_up_blocks};
+    const auto max_block{max_block_available()};
+    if (warm_up_blocks == 0 || max_block == 0) return;
+
+    const BlockNum min_block{max_block >= warm_up_blocks ? max_block - warm_up_blocks + 1 : 0};
+    SILK_TRACE << "Warm up block cache from block " << min_block << " to block " << max_block;
+    for (BlockNum number{min_block}; number <= max_block; ++number) {
+        [[maybe_unused]] const auto header{header_by_number(number)};
+        const auto body{body_by_number(number)};
+        if (!body) continue;
+        // Skip first and last *system transactions* in block body as done when reading blocks
+        const auto base_txn_id{body->base_txn_id + 1};
+        const auto txn_count{body->txn_count >= 2 ? body->txn_count - 2 : body->txn_count};
+        [[maybe_unused]] const auto transactions{txn_range(number, base_txn_id, txn_count, /*read_senders=*/true)};
     }
-    SILKWORM_ASSERT(segments.find(seg_file.path()) != segments.end());
-    const auto& segment = segments[seg_file.path()];
-    segment->reopen_index();
-    return true;
 }
 
 SnapshotPathList SnapshotRepository::get_files(const std::string& ext) const {
@@ -354,24 +579,4 @@ SnapshotPathList SnapshotRepository::get_files(const std::string& ext) const {
     return snapshot_files;
 }
 
-BlockNum SnapshotRepository::max_idx_available() const {
-    BlockNum max_block_headers{0};
-    for (auto& [_, header_seg] : header_segments_) {
-        if (not header_seg->idx_header_hash()) break;
-        max_block_headers = header_seg->block_to() - 1;
-    }
-    BlockNum max_block_bodies{0};
-    for (auto& [_, body_seg] : body_segments_) {
-        if (not body_seg->idx_body_number()) break;
-        max_block_bodies = body_seg->block_to() - 1;
-    }
-    BlockNum max_block_txs{0};
-    for (auto& [_, tx_seg] : tx_segments_) {
-        if (not tx_seg->idx_txn_hash() or not tx_seg->idx_txn_hash_2_block()) break;
-        max_block_txs = tx_seg->block_to() - 1;
-    }
-
-    return std::min(max_block_headers, std::min(max_block_bodies, max_block_txs));
-}
-
 }  // namespace silkworm::snapshot
@@ -16,15 +16,22 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <filesystem>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
 
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/core/types/block.hpp>
+#include <silkworm/node/snapshot/block_cache.hpp>
 #include <silkworm/node/snapshot/path.hpp>
 #include <silkworm/node/snapshot/settings.hpp>
 #include <silkworm/node/snapshot/snapshot.hpp>
@@ -37,7 +44,7 @@ template <typename T>
 concept ConcreteSnapshot = std::is_base_of<Snapshot, T>::value;
 
 template <ConcreteSnapshot T>
-using SnapshotsByPath = std::map<std::filesystem::path, std::unique_ptr<T>>;
+using SnapshotsByPath = std::map<std::filesystem::path, std::shared_ptr<T>>;
 
 template <ConcreteSnapshot T>
 using SnapshotWalker = std::function<bool(const T* snapshot)>;
@@ -54,9 +61,32 @@ struct SnapshotBundle {
     std::unique_ptr<TransactionSnapshot> tx_snapshot;
 };
 
+//! Immutable set of snapshots published by the repository at some epoch
+//! @details Readers holding one set keep all its snapshots open, even if retired by the repository meanwhile
+struct SnapshotSet {
+    //! The sequence number of this set, incremented at each publication
+    uint64_t epoch{0};
+
+    //! The snapshots containing the block Headers
+    SnapshotsByPath<HeaderSnapshot> header_segments;
+
+    //! The snapshots containing the block Bodies
+    SnapshotsByPath<BodySnapshot> body_segments;
+
+    //! The snapshots containing the Transactions
+    SnapshotsByPath<TransactionSnapshot> tx_segments;
+
+    //! All types of .seg files are available - up to this block number
+    BlockNum segment_max_block{0};
+
+    //! All types of .idx files are available - up to this block number
+    BlockNum idx_max_block{0};
+};
+
 //! Read-only repository for all snapshot files.
-//! @details Some simplifications are currently in place:
-//! - it opens snapshots only on startup and they are immutable
+//! @details Snapshots can be added while the repository is in use: the current snapshot set is replaced by a new one
+//! published atomically, so that each reader sees one consistent set and snapshots removed from the set (i.e. retired)
+//! are closed just when the last reader holding them is done. Some simplifications are currently in place:
 //! - all snapshots of given blocks range must exist (to make such range available)
 //! - gaps in blocks range are not allowed
 //! - segments have [from:to) semantic
@@ -68,7 +98,13 @@ class SnapshotRepository {
     [[nodiscard]] const SnapshotSettings& settings() const { return settings_; }
     [[nodiscard]] std::filesystem::path path() const { return settings_.repository_dir; }
 
-    [[nodiscard]] BlockNum max_block_available() const { return std::min(segment_max_block_, idx_max_block_); }
+    //! The snapshot set published most recently, which stays valid as long as it is held
+    [[nodiscard]] std::shared_ptr<const SnapshotSet> snapshot_set() const;
+
+    //! The epoch of the snapshot set published most recently
+    [[nodiscard]] uint64_t epoch() const { return snapshot_set()->epoch; }
+
+    [[nodiscard]] BlockNum max_block_available() const;
 
     [[nodiscard]] SnapshotPathList get_segment_files() const {
         return get_files(kSegmentExtension);
@@ -76,20 +112,33 @@ class SnapshotRepository {
 
     void add_snapshot_bundle(SnapshotBundle&& bundle);
 
+    //! Open the specified segments not open yet along with their indexes (and the indexes missing in open segments)
+    //! @details the resulting snapshot set is published all at once, either all segments or none in case of failure
+    //! @param optimistic flag indicating if segments failing to open must be skipped instead of failing the whole list
     void reopen_list(const SnapshotPathList& segment_files, bool optimistic = false);
     void reopen_file(const SnapshotPath& segment_path, bool optimistic = false);
+
+    //! Open the segments in the repository folder not open yet and retire the open segments whose files are gone
     void reopen_folder();
+
+    //! Retire all snapshots, which are closed when no reader holds them anymore
     void close();
 
     bool for_each_header(const HeaderSnapshot::Walker& fn);
     bool for_each_body(const BodySnapshot::Walker& fn);
 
-    [[nodiscard]] std::size_t header_snapshots_count() const { return header_segments_.size(); }
-    [[nodiscard]] std::size_t body_snapshots_count() const { return body_segments_.size(); }
-    [[nodiscard]] std::size_t tx_snapshots_count() const { return tx_segments_.size(); }
-    [[nodiscard]] std::size_t total_snapshots_count() const {
-        return header_snapshots_count() + body_snapshots_count() + tx_snapshots_count();
-    }
+    //! Apply the specified function to all bodies in snapshots, reading each snapshot concurrently on the workers
+    //! @details the function is called concurrently and in no particular block order, so it must be thread-safe
+    bool for_each_body(ThreadPool& workers, const BodySnapshot::Walker& fn);
+
+    //! Apply the specified function to views of all transactions in snapshots, decoding their fields just on demand
+    //! @details views are valid only within the function call, see TransactionSnapshot::for_each_txn_view
+    bool for_each_txn_view(const TransactionSnapshot::ViewWalker& fn);
+
+    [[nodiscard]] std::size_t header_snapshots_count() const { return snapshot_set()->header_segments.size(); }
+    [[nodiscard]] std::size_t body_snapshots_count() const { return snapshot_set()->body_segments.size(); }
+    [[nodiscard]] std::size_t tx_snapshots_count() const { return snapshot_set()->tx_segments.size(); }
+    [[nodiscard]] std::size_t total_snapshots_count() const;
 
     [[nodiscard]] std::vector<BlockNumRange> missing_block_ranges() const;
     enum ViewResult {
@@ -105,31 +154,69 @@ class SnapshotRepository {
     std::size_t view_body_segments(const BodySnapshotWalker& walker);
     std::size_t view_tx_segments(const TransactionSnapshotWalker& walker);
 
-    [[nodiscard]] const HeaderSnapshot* get_header_segment(const SnapshotPath& path) const;
-    [[nodiscard]] const BodySnapshot* get_body_segment(const SnapshotPath& path) const;
-    [[nodiscard]] const TransactionSnapshot* get_tx_segment(const SnapshotPath& path) const;
+    //! The returned snapshots stay open as long as they are held, even if retired by the repository meanwhile
+    [[nodiscard]] std::shared_ptr<const HeaderSnapshot> get_header_segment(const SnapshotPath& path) const;
+    [[nodiscard]] std::shared_ptr<const BodySnapshot> get_body_segment(const SnapshotPath& path) const;
+    [[nodiscard]] std::shared_ptr<const TransactionSnapshot> get_tx_segment(const SnapshotPath& path) const;
 
-    [[nodiscard]] const HeaderSnapshot* find_header_segment(BlockNum number) const;
-    [[nodiscard]] const BodySnapshot* find_body_segment(BlockNum number) const;
-    [[nodiscard]] const TransactionSnapshot* find_tx_segment(BlockNum number) const;
+    [[nodiscard]] std::shared_ptr<const HeaderSnapshot> find_header_segment(BlockNum number) const;
+    [[nodiscard]] std::shared_ptr<const BodySnapshot> find_body_segment(BlockNum number) const;
+    [[nodiscard]] std::shared_ptr<const TransactionSnapshot> find_tx_segment(BlockNum number) const;
+
+    //! The header for the specified block number, read from snapshots through the decoded block cache
+    [[nodiscard]] std::optional<BlockHeader> header_by_number(BlockNum number) const;
+
+    //! The body for the specified block number, read from snapshots through the decoded block cache
+    [[nodiscard]] std::optional<StoredBlockBody> body_by_number(BlockNum number) const;
+
+    //! The specified transactions of the specified block number, read from snapshots through the decoded block cache
+    //! @return std::nullopt if no snapshot contains the specified block
+    [[nodiscard]] std::optional<std::vector<Transaction>> txn_range(BlockNum number, uint64_t base_txn_id, uint64_t txn_count,
+                                                                    bool read_senders) const;
+
+    //! The hit/miss statistics of the decoded block cache for the specified type of items
+    [[nodiscard]] BlockCacheMetrics block_cache_metrics(SnapshotType type) const { return block_cache_.metrics(type); }
 
     [[nodiscard]] std::vector<std::shared_ptr<Index>> missing_indexes() const;
 
-    [[nodiscard]] BlockNum segment_max_block() const { return segment_max_block_; }
-    [[nodiscard]] BlockNum idx_max_block() const { return idx_max_block_; }
+    [[nodiscard]] BlockNum segment_max_block() const { return snapshot_set()->segment_max_block; }
+    [[nodiscard]] BlockNum idx_max_block() const { return snapshot_set()->idx_max_block; }
 
     [[nodiscard]] std::optional<BlockNum> find_block_number(Hash txn_hash) const;
 
+    //! Find the numbers of the blocks containing the specified transactions, the same as find_block_number for each hash
+    [[nodiscard]] std::vector<std::optional<BlockNum>> find_block_numbers(std::span<const Hash> txn_hashes) const;
+
+    //! The major page faults incurred so far when opening or reading the segments of the specified type
+    //! @details faults are counted only if enabled in settings and only for the calling thread, so faults incurred
+    //! on worker threads (e.g. by concurrent body scans) are not accounted
+    [[nodiscard]] uint64_t major_page_faults(SnapshotType type) const;
+
   private:
-    bool reopen_header(const SnapshotPath& seg_file);
-    bool reopen_body(const SnapshotPath& seg_file);
-    bool reopen_transaction(const SnapshotPath& seg_file);
+    //! Open the specified segment along with its indexes into the specified snapshot set
+    //! @return true if the segment is open in the set, false if it is empty
+    bool reopen(SnapshotSet& snapshot_set, const SnapshotPath& seg_file) const;
 
     template <ConcreteSnapshot T>
-    const T* find_segment(const SnapshotsByPath<T>& segments, BlockNum number) const;
+    bool reopen(SnapshotsByPath<T>& segments, const SnapshotPath& seg_file) const;
+
+    //! Publish the specified snapshot set replacing the current one with the next epoch
+    void publish(std::shared_ptr<SnapshotSet> snapshot_set);
+
+    //! Apply the memory-mapping policies in settings to the segment and index files of the specified snapshot
+    void apply_memory_mapping(Snapshot& snapshot) const;
+
+    //! Advise the OS to read ahead the files of the most recent snapshots of each type, as many as hot segments in settings
+    void warm_up_hot_segments(const SnapshotSet& snapshot_set) const;
 
     template <ConcreteSnapshot T>
-    static bool reopen(SnapshotsByPath<T>& segments, const SnapshotPath& seg_file);
+    void warm_up(const SnapshotsByPath<T>& segments) const;
+
+    //! Decode into the block cache the most recent blocks available, as many as warm-up blocks in settings
+    void warm_up_block_cache() const;
+
+    //! The counter of major page faults for segments of the specified type, if page fault counting is enabled
+    [[nodiscard]] std::atomic_uint64_t* page_fault_counter(SnapshotType type) const;
 
     [[nodiscard]] SnapshotPathList get_idx_files() const {
         return get_files(kIdxExtension);
@@ -137,25 +224,22 @@ class SnapshotRepository {
 
     [[nodiscard]] SnapshotPathList get_files(const std::string& ext) const;
 
-    [[nodiscard]] BlockNum max_idx_available() const;
-
     //! The configuration settings for snapshots
     SnapshotSettings settings_;
 
-    //! All types of .seg files are available - up to this block number
-    BlockNum segment_max_block_{0};
+    //! The cache of items decoded from snapshots, shared by all snapshot sets
+    mutable BlockCache block_cache_;
 
-    //! All types of .idx files are available - up to this block number
-    BlockNum idx_max_block_{0};
+    //! The current snapshot set, always accessed atomically by readers and replaced as a whole by writers
+    //! @details The atomic shared_ptr access is not lock-free: the standard library guards it with an internal lock
+    //! held just for copying the pointer, so readers never wait for a writer building a new set
+    std::shared_ptr<const SnapshotSet> snapshot_set_;
 
-    //! The snapshots containing the block Headers
-    SnapshotsByPath<HeaderSnapshot> header_segments_;
-
-    //! The snapshots containing the block Bodies
-    SnapshotsByPath<BodySnapshot> body_segments_;
+    //! The mutex serializing the writers building and publishing new snapshot sets
+    std::mutex publish_mutex_;
 
-    //! The snapshots containing the Transactions
-    SnapshotsByPath<TransactionSnapshot> tx_segments_;
+    //! The major page faults for each type of segment (i.e. headers, bodies, transactions)
+    mutable std::array<std::atomic_uint64_t, 3> major_page_faults_{};
 };
 
 }  // namespace silkworm::snapshot
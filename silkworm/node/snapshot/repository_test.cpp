@@ -242,4 +242,110 @@ TEST_CASE("SnapshotRepository::find_block_number", "[silkworm][node][snapshot]")
     // CHECK_FALSE(block_number.has_value());  // needs correct key check in index
 }
 
+TEST_CASE("SnapshotRepository::memory_mapping_settings", "[silkworm][node][snapshot]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    const auto tmp_dir = TemporaryDirectory::get_unique_temporary_path();
+    std::filesystem::create_directories(tmp_dir);
+
+    test::SampleHeaderSnapshotFile header_snapshot{tmp_dir};
+    test::SampleBodySnapshotFile body_snapshot{tmp_dir};
+    test::SampleTransactionSnapshotFile txn_snapshot{tmp_dir};
+
+    test::SampleHeaderSnapshotPath header_snapshot_path{header_snapshot.path()};  // necessary to tweak the block numbers
+    HeaderIndex header_index{header_snapshot_path};
+    REQUIRE_NOTHROW(header_index.build());
+    test::SampleBodySnapshotPath body_snapshot_path{body_snapshot.path()};  // necessary to tweak the block numbers
+    BodyIndex body_index{body_snapshot_path};
+    REQUIRE_NOTHROW(body_index.build());
+    test::SampleTransactionSnapshotPath txn_snapshot_path{txn_snapshot.path()};  // necessary to tweak the block numbers
+    TransactionIndex txn_index{txn_snapshot_path};
+    REQUIRE_NOTHROW(txn_index.build());
+
+    SECTION("default settings") {
+        SnapshotRepository repository{SnapshotSettings{tmp_dir}};
+        REQUIRE_NOTHROW(repository.reopen_folder());
+        CHECK(repository.find_block_number(0x2224c39c930355233f11414e9f216f381c1f6b0c32fc77b192128571c2dc9eb9_bytes32) == 1'500'012);
+        CHECK(repository.major_page_faults(SnapshotType::transactions) == 0);
+    }
+
+    SECTION("all policies enabled") {
+        SnapshotSettings settings{tmp_dir};
+        settings.memory_mapping_settings = {
+            .segments = {.populate = true, .huge_pages = true, .lock = true},
+            .indexes = {.populate = true, .huge_pages = true, .lock = true},
+            .hot_segments = 1,
+            .count_page_faults = true,
+        };
+        SnapshotRepository repository{settings};
+        // Unsupported huge pages or memory locking over limits must not prevent opening snapshots
+        REQUIRE_NOTHROW(repository.reopen_folder());
+        CHECK(repository.total_snapshots_count() == 3);
+        CHECK(repository.find_block_number(0x2224c39c930355233f11414e9f216f381c1f6b0c32fc77b192128571c2dc9eb9_bytes32) == 1'500'012);
+        // Sample files are just written hence in page cache, so major page faults are unlikely but still possible
+        CHECK_NOTHROW(repository.major_page_faults(SnapshotType::headers));
+        CHECK(repository.major_page_faults(SnapshotType::transactions_to_block) == repository.major_page_faults(SnapshotType::transactions));
+    }
+}
+
+TEST_CASE("SnapshotRepository::hot reload", "[silkworm][node][snapshot]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    const auto tmp_dir = TemporaryDirectory::get_unique_temporary_path();
+    std::filesystem::create_directories(tmp_dir);
+    SnapshotRepository repository{SnapshotSettings{tmp_dir}};
+    CHECK(repository.epoch() == 0);
+
+    test::SampleHeaderSnapshotFile header_snapshot{tmp_dir};
+    test::SampleBodySnapshotFile body_snapshot{tmp_dir};
+    test::SampleTransactionSnapshotFile txn_snapshot{tmp_dir};
+    REQUIRE_NOTHROW(repository.reopen_folder());
+    CHECK(repository.epoch() == 1);
+    CHECK(repository.total_snapshots_count() == 3);
+
+    const auto header_snapshot_path{*SnapshotPath::parse(header_snapshot.path())};
+    const auto txn_snapshot_path{*SnapshotPath::parse(txn_snapshot.path())};
+    const auto first_set{repository.snapshot_set()};
+    const auto first_tx_segment{repository.get_tx_segment(txn_snapshot_path)};
+    REQUIRE(first_tx_segment != nullptr);
+    CHECK(first_tx_segment->idx_txn_hash() == nullptr);
+
+    SECTION("unchanged segments are shared across epochs") {
+        REQUIRE_NOTHROW(repository.reopen_folder());
+        CHECK(repository.epoch() == 2);
+        CHECK(repository.get_tx_segment(txn_snapshot_path) == first_tx_segment);
+    }
+
+    SECTION("new indexes are picked up by new snapshots") {
+        test::SampleTransactionSnapshotPath txn_path{txn_snapshot.path()};  // necessary to tweak the block numbers
+        TransactionIndex txn_index{txn_path};
+        REQUIRE_NOTHROW(txn_index.build());
+        REQUIRE_NOTHROW(repository.reopen_folder());
+        CHECK(repository.epoch() == 2);
+
+        const auto tx_segment{repository.get_tx_segment(txn_snapshot_path)};
+        REQUIRE(tx_segment != nullptr);
+        CHECK(tx_segment != first_tx_segment);
+        CHECK(tx_segment->idx_txn_hash() != nullptr);
+        // The snapshot published in the previous epoch is left untouched
+        CHECK(first_tx_segment->idx_txn_hash() == nullptr);
+        CHECK(first_set->tx_segments.at(txn_snapshot.path()) == first_tx_segment);
+    }
+
+    SECTION("segments whose files are gone are retired") {
+        std::filesystem::remove(header_snapshot.path());
+        REQUIRE_NOTHROW(repository.reopen_folder());
+        CHECK(repository.epoch() == 2);
+        CHECK(repository.header_snapshots_count() == 0);
+        CHECK(repository.get_header_segment(header_snapshot_path) == nullptr);
+        CHECK(first_set->header_segments.size() == 1);
+    }
+
+    SECTION("retired snapshots stay open while held") {
+        repository.close();
+        CHECK(repository.epoch() == 2);
+        CHECK(repository.total_snapshots_count() == 0);
+        CHECK(first_set->tx_segments.size() == 1);
+        CHECK(first_tx_segment->item_count() > 0);
+    }
+}
+
 }  // namespace silkworm::snapshot
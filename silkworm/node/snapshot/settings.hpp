@@ -16,19 +16,56 @@
 
 #pragma once
 
+#include <cstddef>
 #include <filesystem>
 
+#include <silkworm/core/common/base.hpp>
 #include <silkworm/infra/common/directories.hpp>
 #include <silkworm/node/bittorrent/settings.hpp>
 #include <silkworm/node/snapshot/path.hpp>
 
 namespace silkworm::snapshot {
 
+struct IndexBuildSettings {
+    std::size_t memory_budget{2_Gibi};     // Max memory for buffering keys across all concurrent index builds
+    std::size_t max_concurrent_builds{0};  // Max number of indexes built concurrently (0 means number of hardware threads)
+    std::size_t scan_threads{0};           // Number of threads scanning segments shared by all builds (0 means number of hardware threads)
+};
+
+//! The memory-mapping policy for one kind of snapshot files, on top of random access advice (sequential during scans)
+struct MemoryMappingPolicy {
+    bool populate{false};    // Flag indicating if file content must be read in memory when opened (like MAP_POPULATE)
+    bool huge_pages{false};  // Flag indicating if transparent huge pages must be used (where the filesystem allows)
+    bool lock{false};        // Flag indicating if file content must be locked in memory (like mlock)
+};
+
+struct MemoryMappingSettings {
+    MemoryMappingPolicy segments;   // The memory-mapping policy for segment files
+    MemoryMappingPolicy indexes;    // The memory-mapping policy for index files
+    std::size_t hot_segments{0};    // Number of most recent segments per type whose files are warmed up when opened
+    bool count_page_faults{false};  // Flag indicating if major page faults must be counted per segment type
+};
+
+//! The sizes of the caches of items decoded from snapshots, each one disabled if zero (default)
+//! @details caches are bounded by number of items, not by bytes, and pay off only for repeated reads of the same
+//! blocks (e.g. RPC serving recent blocks), whilst sequential scans just evict everything: enable them only if needed
+struct BlockCacheSettings {
+    std::size_t max_headers{0};       // Max number of decoded block headers kept in cache
+    std::size_t max_bodies{0};        // Max number of decoded block bodies kept in cache
+    std::size_t max_transactions{0};  // Max number of decoded block transaction lists kept in cache
+    std::size_t num_shards{16};       // Number of independently locked shards of each cache
+    std::size_t warm_up_blocks{0};        // Number of most recent blocks decoded into the caches when snapshots are opened
+};
+
 struct SnapshotSettings {
     std::filesystem::path repository_dir{DataDirectory{}.snapshots().path()};  // Path to the snapshot repository on disk
     bool enabled{true};                                                        // Flag indicating if snapshots are enabled
     bool no_downloader{false};                                                 // Flag indicating if snapshots download is disabled
+    bool freeze{false};                                                        // Flag indicating if finalized blocks must be moved into snapshots
     BitTorrentSettings bittorrent_settings;                                    // The Bittorrent protocol settings
+    IndexBuildSettings index_build_settings;                                   // The index build settings
+    MemoryMappingSettings memory_mapping_settings;                             // The memory-mapping settings
+    BlockCacheSettings block_cache_settings;                                   // The decoded block cache settings
 };
 
 }  // namespace silkworm::snapshot
@@ -16,6 +16,10 @@
 
 #include "snapshot.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+
 #include <magic_enum.hpp>
 
 #include <silkworm/core/common/util.hpp>
@@ -37,6 +41,17 @@ inline std::string to_string(DecodingResult result) {
     return s;
 }
 
+//! The memory-mapped files of the specified indexes, skipping the ones not open
+static std::vector<MemoryMappedFile*> index_memory_files(std::initializer_list<succinct::RecSplitIndex*> indexes) {
+    std::vector<MemoryMappedFile*> files;
+    for (auto* index : indexes) {
+        if (index && index->memory_file()) {
+            files.push_back(index->memory_file());
+        }
+    }
+    return files;
+}
+
 namespace fs = std::filesystem;
 
 Snapshot::Snapshot(SnapshotPath path)
@@ -83,6 +98,47 @@ bool Snapshot::for_each_item(const Snapshot::WordItemFunc& fn) {
     });
 }
 
+std::vector<huffman::Decompressor::WordRange> Snapshot::split_items(uint64_t max_items_per_range) const {
+    ensure_pre_condition(max_items_per_range > 0, "Snapshot::split_items: zero items per range");
+
+    // Use the ordinal index as checkpoint source when available, avoiding any pass over the segment data
+    const auto* index = ordinal_index();
+    if (index && index->double_enum_index() && index->key_count() == item_count()) {
+        std::vector<huffman::Decompressor::WordRange> ranges;
+        ranges.reserve((item_count() + max_items_per_range - 1) / max_items_per_range);
+        for (uint64_t first_item{0}; first_item < item_count(); first_item += max_items_per_range) {
+            const uint64_t range_size{std::min<uint64_t>(max_items_per_range, item_count() - first_item)};
+            ranges.push_back({first_item, range_size, index->ordinal_lookup(first_item)});
+        }
+        return ranges;
+    }
+    return decoder_.split_words(max_items_per_range);
+}
+
+bool Snapshot::for_each_item(ThreadPool& workers, const Snapshot::WordItemFunc& fn) {
+    // At least a few ranges per worker to balance the load
+    const uint64_t range_count{4 * std::max<uint64_t>(1, workers.get_thread_count())};
+    const auto ranges{split_items(item_count() / range_count + 1)};
+
+    std::atomic_bool keep_going{true};
+    return decoder_.read_ranges(ranges, workers, [&](const huffman::Decompressor::WordRange& range, auto it) -> bool {
+        WordItem item{};
+        item.offset = range.offset;
+        for (uint64_t i{0}; i < range.word_count && keep_going; ++i) {
+            if (!it.has_next()) return false;
+            const uint64_t next_offset = it.next(item.value);
+            item.position = range.first_word + i;
+            if (!fn(item)) {
+                keep_going = false;
+                return false;
+            }
+            item.offset = next_offset;
+            item.value.clear();
+        }
+        return keep_going.load();
+    });
+}
+
 std::optional<Snapshot::WordItem> Snapshot::next_item(uint64_t offset, ByteView prefix) const {
     SILK_TRACE << "Snapshot::next_item offset: " << offset;
     auto data_iterator = decoder_.make_iterator();
@@ -219,6 +275,10 @@ void HeaderSnapshot::reopen_index() {
     }
 }
 
+std::vector<MemoryMappedFile*> HeaderSnapshot::index_files() {
+    return index_memory_files({idx_header_hash_.get()});
+}
+
 void HeaderSnapshot::close_index() {
     idx_header_hash_.reset();
 }
@@ -241,6 +301,15 @@ bool BodySnapshot::for_each_body(const Walker& walker) {
     });
 }
 
+bool BodySnapshot::for_each_body(ThreadPool& workers, const Walker& walker) {
+    return for_each_item(workers, [&](const WordItem& item) -> bool {
+        db::detail::BlockBodyForStorage body;
+        success_or_throw(decode_body(item, body));
+        const BlockNum number = path_.block_from() + item.position;
+        return walker(number, &body);
+    });
+}
+
 std::pair<uint64_t, uint64_t> BodySnapshot::compute_txs_amount() {
     uint64_t first_tx_id{0}, last_tx_id{0}, last_txs_amount{0};
 
@@ -316,6 +385,10 @@ void BodySnapshot::reopen_index() {
     }
 }
 
+std::vector<MemoryMappedFile*> BodySnapshot::index_files() {
+    return index_memory_files({idx_body_number_.get()});
+}
+
 void BodySnapshot::close_index() {
     idx_body_number_.reset();
 }
@@ -386,9 +459,12 @@ std::optional<BlockNum> TransactionSnapshot::block_num_by_txn_hash(const Hash& t
         return {};
     }
 
-    // First, lookup the entire txn to check that the retrieved txn hash matches (no way to know if key exists in MPHF)
-    const auto transaction{txn_by_hash(txn_hash)};
-    if (!transaction) {
+    if (!idx_txn_hash_) {
+        return {};
+    }
+
+    // First, check that the retrieved txn hash matches (no way to know if key exists in MPHF)
+    if (!has_txn_hash(idx_txn_hash_->lookup(txn_hash), txn_hash)) {
         return {};
     }
 
@@ -396,6 +472,70 @@ std::optional<BlockNum> TransactionSnapshot::block_num_by_txn_hash(const Hash& t
     return idx_txn_hash_2_block_->lookup(txn_hash);
 }
 
+bool TransactionSnapshot::has_txn_hash(uint64_t txn_position, const Hash& txn_hash) const {
+    const auto txn_id{idx_txn_hash_->base_data_id() + txn_position};
+    const auto txn_offset{idx_txn_hash_->ordinal_lookup(txn_position)};
+
+    auto data_iterator = decoder_.make_iterator();
+    data_iterator.reset(txn_offset);
+    if (!data_iterator.has_next()) {
+        return false;
+    }
+    // Most false positives are filtered out by the hash first byte without decompressing the word, except that
+    // system txs have empty words and their hash must be checked against the txn id instead
+    if (!data_iterator.has_prefix({txn_hash.bytes, 1}) && TransactionView{txn_id, {}}.hash() != txn_hash) {
+        return false;
+    }
+
+    Bytes word;
+    try {
+        data_iterator.next(word);
+    } catch (const std::runtime_error& re) {
+        SILK_WARN << "TransactionSnapshot::has_txn_hash invalid offset: " << txn_offset << " what: " << re.what();
+        return false;
+    }
+    const TransactionView txn{txn_id, word};
+    return txn.may_have_hash(txn_hash) && txn.hash() == txn_hash;
+}
+
+std::vector<std::optional<BlockNum>> TransactionSnapshot::block_nums_by_txn_hash(std::span<const Hash> txn_hashes) const {
+    std::vector<std::optional<BlockNum>> block_numbers(txn_hashes.size());
+    if (!idx_txn_hash_2_block_ or !idx_txn_hash_ or txn_hashes.empty()) {
+        return block_numbers;
+    }
+
+    std::vector<ByteView> keys;
+    keys.reserve(txn_hashes.size());
+    for (const auto& txn_hash : txn_hashes) {
+        keys.emplace_back(txn_hash);
+    }
+
+    // First, get the txn ordinal positions in snapshot by using txn hashes as MPHF index
+    std::vector<uint64_t> txn_positions(txn_hashes.size());
+    idx_txn_hash_->lookup_batch(keys, txn_positions);
+
+    // Then, check that the retrieved txn hashes match (no way to know if key exists in MPHF) as in block_num_by_txn_hash
+    std::vector<bool> found(txn_hashes.size());
+    std::vector<ByteView> found_keys;
+    found_keys.reserve(txn_hashes.size());
+    for (std::size_t i{0}; i < txn_hashes.size(); ++i) {
+        found[i] = has_txn_hash(txn_positions[i], txn_hashes[i]);
+        if (found[i]) {
+            found_keys.push_back(keys[i]);
+        }
+    }
+
+    // Finally, get the block numbers using dedicated MPHF index
+    std::vector<uint64_t> found_block_numbers(found_keys.size());
+    idx_txn_hash_2_block_->lookup_batch(found_keys, found_block_numbers);
+    for (std::size_t i{0}, j{0}; i < txn_hashes.size(); ++i) {
+        if (found[i]) {
+            block_numbers[i] = found_block_numbers[j++];
+        }
+    }
+    return block_numbers;
+}
+
 std::vector<Transaction> TransactionSnapshot::txn_range(uint64_t base_txn_id, uint64_t txn_count, bool read_senders) const {
     std::vector<Transaction> transactions;
     transactions.reserve(txn_count);
@@ -476,6 +616,13 @@ DecodingResult TransactionSnapshot::decode_txn(const WordItem& item, Transaction
 }
 
 void TransactionSnapshot::for_each_txn(uint64_t base_txn_id, uint64_t txn_count, const Walker& walker) const {
+    uint64_t i{0};
+    for_each_txn_view(base_txn_id, txn_count, [&](const TransactionView& txn) -> bool {
+        return walker(i++, txn.senders_data(), txn.rlp());
+    });
+}
+
+void TransactionSnapshot::for_each_txn_view(uint64_t base_txn_id, uint64_t txn_count, const ViewWalker& walker) const {
     if (!idx_txn_hash_ or txn_count == 0) {
         return;
     }
@@ -489,20 +636,28 @@ void TransactionSnapshot::for_each_txn(uint64_t base_txn_id, uint64_t txn_count,
     // Then, get the first transaction offset in snapshot by using ordinal lookup
     const auto first_txn_offset = idx_txn_hash_->ordinal_lookup(first_txn_position);
 
-    // Finally, iterate over each encoded transaction item
-    for (uint64_t i{0}, offset{first_txn_offset}; i < txn_count; ++i) {
-        const auto item = next_item(offset);
-        ensure(item.has_value(), "TransactionSnapshot: record not found at offset=" + std::to_string(offset));
-
-        auto [senders_data, tx_rlp] = slice_tx_data(*item);
-
-        const bool go_on{walker(i, senders_data, tx_rlp)};
+    // Finally, iterate over each encoded transaction word reusing the same buffer
+    auto data_iterator = decoder_.make_iterator();
+    data_iterator.reset(first_txn_offset);
+    Bytes word;
+    word.reserve(kPageSize);
+    for (uint64_t i{0}; i < txn_count; ++i) {
+        ensure(data_iterator.has_next(), "TransactionSnapshot: record not found for txn ID: " + std::to_string(base_txn_id + i));
+        word.clear();
+        data_iterator.next(word);
+
+        const bool go_on{walker(TransactionView{base_txn_id + i, word})};
         if (!go_on) return;
-
-        offset = item->offset;
     }
 }
 
+bool TransactionSnapshot::for_each_txn_view(const ViewWalker& walker) {
+    const uint64_t base_txn_id{idx_txn_hash_ ? idx_txn_hash_->base_data_id() : 0};
+    return for_each_item([&](const WordItem& item) -> bool {
+        return walker(TransactionView{base_txn_id + item.position, item.value});
+    });
+}
+
 void TransactionSnapshot::reopen_index() {
     ensure(decoder_.is_open(), "TransactionSnapshot: segment not open, call reopen_segment");
 
@@ -531,6 +686,10 @@ void TransactionSnapshot::reopen_index() {
     }
 }
 
+std::vector<MemoryMappedFile*> TransactionSnapshot::index_files() {
+    return index_memory_files({idx_txn_hash_.get(), idx_txn_hash_2_block_.get()});
+}
+
 void TransactionSnapshot::close_index() {
     idx_txn_hash_.reset();
     idx_txn_hash_2_block_.reset();
@@ -21,17 +21,21 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/core/common/bytes.hpp>
 #include <silkworm/core/types/block.hpp>
 #include <silkworm/infra/common/os.hpp>
+#include <silkworm/infra/concurrency/thread_pool.hpp>
 #include <silkworm/node/db/util.hpp>
 #include <silkworm/node/huffman/decompressor.hpp>
 #include <silkworm/node/recsplit/rec_split_par.hpp>
 #include <silkworm/node/snapshot/path.hpp>
+#include <silkworm/node/snapshot/transaction_view.hpp>
 
 namespace silkworm::snapshot {
 
@@ -79,6 +83,12 @@ class Snapshot {
     void reopen_segment();
     virtual void reopen_index() = 0;
 
+    //! The memory-mapped segment file, null if segment is not open
+    [[nodiscard]] MemoryMappedFile* segment_file() { return decoder_.memory_file(); }
+
+    //! The memory-mapped index files, just the open ones
+    [[nodiscard]] virtual std::vector<MemoryMappedFile*> index_files() { return {}; }
+
     struct WordItem {
         uint64_t position{0};
         uint64_t offset{0};
@@ -90,6 +100,16 @@ class Snapshot {
     };
     using WordItemFunc = std::function<bool(WordItem&)>;
     bool for_each_item(const WordItemFunc& fn);
+
+    //! Split the segment items into ranges of at most max_items_per_range items which can be read independently
+    //! @details range offsets come from the ordinal index if available, otherwise from a skip pass over the segment
+    [[nodiscard]] std::vector<huffman::Decompressor::WordRange> split_items(uint64_t max_items_per_range) const;
+
+    //! Apply the specified function to all items reading ranges of items concurrently on the specified workers
+    //! @details the function is called concurrently for items in distinct ranges, so it must be thread-safe
+    //! @warning this must not be called from tasks running on the same workers
+    bool for_each_item(ThreadPool& workers, const WordItemFunc& fn);
+
     [[nodiscard]] std::optional<WordItem> next_item(uint64_t offset, ByteView prefix = {}) const;
 
     void close();
@@ -98,6 +118,9 @@ class Snapshot {
     void close_segment();
     virtual void close_index() = 0;
 
+    //! The index supporting the ordinal lookup of segment items, if any
+    [[nodiscard]] virtual const succinct::RecSplitIndex* ordinal_index() const { return nullptr; }
+
     //! The path of the segment file for this snapshot
     SnapshotPath path_;
 
@@ -120,11 +143,13 @@ class HeaderSnapshot : public Snapshot {
     [[nodiscard]] std::optional<BlockHeader> header_by_number(BlockNum block_height) const;
 
     void reopen_index() override;
+    [[nodiscard]] std::vector<MemoryMappedFile*> index_files() override;
 
   protected:
     bool decode_header(const Snapshot::WordItem& item, BlockHeader& header) const;
 
     void close_index() override;
+    [[nodiscard]] const succinct::RecSplitIndex* ordinal_index() const override { return idx_header_hash_.get(); }
 
   private:
     //! Index header_hash -> headers_segment_offset
@@ -146,6 +171,11 @@ class BodySnapshot : public Snapshot {
 
     using Walker = std::function<bool(BlockNum number, const StoredBlockBody* body)>;
     bool for_each_body(const Walker& walker);
+
+    //! Apply the specified walker to all bodies reading them concurrently on the specified workers
+    //! @details the walker is called concurrently and in no particular block order, so it must be thread-safe
+    bool for_each_body(ThreadPool& workers, const Walker& walker);
+
     [[nodiscard]] std::optional<StoredBlockBody> next_body(uint64_t offset) const;
 
     std::pair<uint64_t, uint64_t> compute_txs_amount();
@@ -153,11 +183,13 @@ class BodySnapshot : public Snapshot {
     [[nodiscard]] std::optional<StoredBlockBody> body_by_number(BlockNum block_height) const;
 
     void reopen_index() override;
+    [[nodiscard]] std::vector<MemoryMappedFile*> index_files() override;
 
   protected:
     static DecodingResult decode_body(const Snapshot::WordItem& item, StoredBlockBody& body);
 
     void close_index() override;
+    [[nodiscard]] const succinct::RecSplitIndex* ordinal_index() const override { return idx_body_number_.get(); }
 
   private:
     //! Index block_num_u64 -> bodies_segment_offset
@@ -183,9 +215,27 @@ class TransactionSnapshot : public Snapshot {
     [[nodiscard]] std::vector<Transaction> txn_range(uint64_t base_txn_id, uint64_t txn_count, bool read_senders) const;
     [[nodiscard]] std::vector<Bytes> txn_rlp_range(uint64_t base_txn_id, uint64_t txn_count) const;
 
+    //! Return the block number for the specified transaction hash, looking just at the hash first byte and the
+    //! transaction payload of the candidate word without decoding the transaction
     [[nodiscard]] std::optional<BlockNum> block_num_by_txn_hash(const Hash& txn_hash) const;
 
+    //! Return the block numbers for the specified transaction hashes, the same as block_num_by_txn_hash for each hash
+    //! @details Index lookups are batched to overlap their cache misses, so prefer this over repeated block_num_by_txn_hash
+    [[nodiscard]] std::vector<std::optional<BlockNum>> block_nums_by_txn_hash(std::span<const Hash> txn_hashes) const;
+
+    using ViewWalker = std::function<bool(const TransactionView& txn)>;
+
+    //! Apply the specified walker to views of the specified transactions, whose fields are decoded just on demand
+    //! @details all the views point into one word buffer reused for each transaction, so they are valid only within
+    //! the walker call but no memory is allocated per transaction
+    void for_each_txn_view(uint64_t base_txn_id, uint64_t txn_count, const ViewWalker& walker) const;
+
+    //! Apply the specified walker to views of all the transactions in this snapshot, in transaction id order
+    //! @details transaction ids require the transaction hash index, they are relative to this snapshot otherwise
+    bool for_each_txn_view(const ViewWalker& walker);
+
     void reopen_index() override;
+    [[nodiscard]] std::vector<MemoryMappedFile*> index_files() override;
 
   protected:
     static std::pair<ByteView, ByteView> slice_tx_data(const WordItem& item);
@@ -195,7 +245,11 @@ class TransactionSnapshot : public Snapshot {
     using Walker = std::function<bool(uint64_t i, ByteView senders_data, ByteView txn_rlp)>;
     void for_each_txn(uint64_t base_txn_id, uint64_t txn_count, const Walker& walker) const;
 
+    //! Check if the transaction at the specified ordinal position has the specified hash
+    [[nodiscard]] bool has_txn_hash(uint64_t txn_position, const Hash& txn_hash) const;
+
     void close_index() override;
+    [[nodiscard]] const succinct::RecSplitIndex* ordinal_index() const override { return idx_txn_hash_.get(); }
 
   private:
     //! Index transaction_hash -> transactions_segment_offset
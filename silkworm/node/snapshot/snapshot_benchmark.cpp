@@ -14,12 +14,17 @@
    limitations under the License.
 */
 
+#include <random>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/infra/common/directories.hpp>
 #include <silkworm/infra/test_util/log.hpp>
+#include <silkworm/node/huffman/compressor.hpp>
 #include <silkworm/node/huffman/decompressor.hpp>
+#include <silkworm/node/snapshot/block_cache.hpp>
 #include <silkworm/node/snapshot/index.hpp>
 #include <silkworm/node/test/files.hpp>
 #include <silkworm/node/test/snapshots.hpp>
@@ -60,6 +65,81 @@ static void open_snapshot(benchmark::State& state) {
 }
 BENCHMARK(open_snapshot);
 
+//! Decode all the words in the segment file using table-driven decoding if enabled, report decoded bytes per second
+static void decode_segment(benchmark::State& state, const std::filesystem::path& segment_path, bool table_driven) {
+    huffman::Decompressor decoder{segment_path, {}, table_driven};
+    decoder.open();
+
+    Bytes word;
+    int64_t decoded_bytes{0};
+    for ([[maybe_unused]] auto _ : state) {
+        auto it = decoder.make_iterator();
+        while (it.has_next()) {
+            word.clear();
+            it.next(word);
+            decoded_bytes += static_cast<int64_t>(word.size());
+        }
+        benchmark::DoNotOptimize(word.data());
+    }
+    state.SetBytesProcessed(decoded_bytes);
+}
+
+static void decode_sample_header_segment(benchmark::State& state) {
+    TemporaryDirectory tmp_dir;
+    test::SampleHeaderSnapshotFile header_snapshot{tmp_dir.path()};
+    decode_segment(state, header_snapshot.path(), state.range(0) != 0);
+}
+BENCHMARK(decode_sample_header_segment)->ArgName("table_driven")->Arg(0)->Arg(1);
+
+static void decode_sample_body_segment(benchmark::State& state) {
+    TemporaryDirectory tmp_dir;
+    test::SampleBodySnapshotFile body_snapshot{tmp_dir.path()};
+    decode_segment(state, body_snapshot.path(), state.range(0) != 0);
+}
+BENCHMARK(decode_sample_body_segment)->ArgName("table_driven")->Arg(0)->Arg(1);
+
+static void decode_sample_transaction_segment(benchmark::State& state) {
+    TemporaryDirectory tmp_dir;
+    test::SampleTransactionSnapshotFile txn_snapshot{tmp_dir.path()};
+    decode_segment(state, txn_snapshot.path(), state.range(0) != 0);
+}
+BENCHMARK(decode_sample_transaction_segment)->ArgName("table_driven")->Arg(0)->Arg(1);
+
+//! Segment made of words looking like RLP-encoded records: a few templates with long zero runs and random fields
+//! @details The segment is compressed just once because benchmark functions are run several times
+static const std::filesystem::path& record_segment_path() {
+    static TemporaryDirectory tmp_dir;
+    static const std::filesystem::path segment_path{[]() {
+        const auto path{tmp_dir.path() / "records.seg"};
+        std::mt19937 rng{42};
+        std::vector<Bytes> templates;
+        for (std::size_t i{0}; i < 16; ++i) {
+            Bytes record(100 + rng() % 500, 0);
+            for (auto& b : record) {
+                b = rng() % 4 == 0 ? static_cast<uint8_t>(rng()) : 0;
+            }
+            templates.push_back(std::move(record));
+        }
+        huffman::Compressor compressor{path};
+        for (std::size_t i{0}; i < 5'000; ++i) {
+            Bytes record{templates[rng() % templates.size()]};
+            for (std::size_t j{0}; j < 8; ++j) {
+                record[rng() % record.size()] = static_cast<uint8_t>(rng());
+            }
+            compressor.add_word(record);
+        }
+        compressor.compress();
+        return path;
+    }()};
+    return segment_path;
+}
+
+static void decode_record_segment(benchmark::State& state) {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    decode_segment(state, record_segment_path(), state.range(0) != 0);
+}
+BENCHMARK(decode_record_segment)->ArgName("table_driven")->Arg(0)->Arg(1);
+
 static void build_header_index(benchmark::State& state) {
     const auto tmp_dir = TemporaryDirectory::get_unique_temporary_path();
     std::filesystem::create_directories(tmp_dir);
@@ -152,4 +232,65 @@ static void reopen_folder(benchmark::State& state) {
 }
 BENCHMARK(reopen_folder);
 
+//! Replay an access trace typical of RPC clients following the chain tip, i.e. reading header, body and transactions
+//! of blocks mostly among the most recent ones, with or without the cache of decoded blocks, report the hit rate
+static void replay_block_access_trace(benchmark::State& state) {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    TemporaryDirectory tmp_dir;
+
+    // These sample snapshot files just contain data for block range [1'500'012, 1'500'013]
+    test::SampleHeaderSnapshotFile header_snapshot_file{tmp_dir.path()};
+    test::SampleBodySnapshotFile body_snapshot_file{tmp_dir.path()};
+    test::SampleTransactionSnapshotFile txn_snapshot_file{tmp_dir.path()};
+
+    test::SampleHeaderSnapshotPath header_snapshot_path{header_snapshot_file.path()};  // necessary to tweak the block numbers
+    snapshot::HeaderIndex header_index{header_snapshot_path};
+    header_index.build();
+    test::SampleBodySnapshotPath body_snapshot_path{body_snapshot_file.path()};  // necessary to tweak the block numbers
+    snapshot::BodyIndex body_index{body_snapshot_path};
+    body_index.build();
+    test::SampleTransactionSnapshotPath txn_snapshot_path{txn_snapshot_file.path()};  // necessary to tweak the block numbers
+    snapshot::TransactionIndex txn_index{txn_snapshot_path};
+    txn_index.build();
+
+    snapshot::HeaderSnapshot header_snapshot{header_snapshot_path};
+    header_snapshot.reopen_segment();
+    header_snapshot.reopen_index();
+    snapshot::BodySnapshot body_snapshot{body_snapshot_path};
+    body_snapshot.reopen_segment();
+    body_snapshot.reopen_index();
+    snapshot::TransactionSnapshot txn_snapshot{txn_snapshot_path};
+    txn_snapshot.reopen_segment();
+    txn_snapshot.reopen_index();
+
+    const bool cache_enabled{state.range(0) != 0};
+    snapshot::BlockCacheSettings cache_settings;
+    if (cache_enabled) {
+        cache_settings = {.max_headers = 16'384, .max_bodies = 16'384, .max_transactions = 1'024};
+    }
+    snapshot::BlockCache cache{cache_settings};
+
+    // Trace skewed towards the latest block: 80% of accesses to the latest one, the others to the previous one
+    std::mt19937 rng{42};
+    std::vector<BlockNum> trace(1'000);
+    for (auto& block_number : trace) {
+        block_number = rng() % 10 < 8 ? 1'500'013 : 1'500'012;
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+        for (const auto block_number : trace) {
+            const auto header{cache.header_by_number(header_snapshot, block_number)};
+            benchmark::DoNotOptimize(header);
+            const auto body{cache.body_by_number(body_snapshot, block_number)};
+            if (!body) continue;
+            // Skip first and last *system transactions* in block body
+            const auto transactions{cache.txn_range(txn_snapshot, body->base_txn_id + 1, body->txn_count - 2, /*read_senders=*/true)};
+            benchmark::DoNotOptimize(transactions.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(trace.size()));
+    state.counters["hit_rate"] = cache.metrics(snapshot::SnapshotType::bodies).hit_rate();
+}
+BENCHMARK(replay_block_access_trace)->ArgName("cache")->Arg(0)->Arg(1);
+
 }  // namespace silkworm
@@ -16,6 +16,8 @@
 
 #include "snapshot.hpp"
 
+#include <map>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -185,6 +187,46 @@ TEST_CASE("BodySnapshot::body_by_number OK", "[silkworm][node][snapshot][index]"
     // CHECK(!body_snapshot.body_by_number(1'500'014)); // TODO(canepat) assert in EF, should return std::nullopt instead
 }
 
+TEST_CASE("BodySnapshot::for_each_body concurrent", "[silkworm][node][snapshot]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::SampleBodySnapshotFile valid_body_snapshot{};                           // contains bodies for [1'500'012, 1'500'013]
+    test::SampleBodySnapshotPath body_snapshot_path{valid_body_snapshot.path()};  // necessary to tweak the block numbers
+
+    BodySnapshot body_snapshot{body_snapshot_path};
+    body_snapshot.reopen_segment();
+
+    std::map<BlockNum, StoredBlockBody> expected_bodies;
+    REQUIRE(body_snapshot.for_each_body([&](BlockNum number, const StoredBlockBody* body) {
+        expected_bodies.emplace(number, *body);
+        return true;
+    }));
+    REQUIRE(expected_bodies.size() == body_snapshot.item_count());
+
+    ThreadPool workers{2};
+    const auto check_concurrent_walk = [&]() {
+        std::mutex bodies_mutex;
+        std::map<BlockNum, StoredBlockBody> bodies;
+        CHECK(body_snapshot.for_each_body(workers, [&](BlockNum number, const StoredBlockBody* body) {
+            std::scoped_lock lock{bodies_mutex};
+            bodies.emplace(number, *body);
+            return true;
+        }));
+        CHECK(bodies == expected_bodies);
+        CHECK_FALSE(body_snapshot.for_each_body(workers, [](BlockNum, const StoredBlockBody*) { return false; }));
+    };
+
+    SECTION("ranges from segment scan") {
+        check_concurrent_walk();
+    }
+    SECTION("ranges from ordinal index") {
+        BodyIndex body_index{body_snapshot_path};
+        REQUIRE_NOTHROW(body_index.build(workers));
+        body_snapshot.reopen_index();
+        REQUIRE(body_snapshot.idx_body_number());
+        check_concurrent_walk();
+    }
+}
+
 // https://etherscan.io/block/1500013
 TEST_CASE("TransactionSnapshot::txn_by_id OK", "[silkworm][node][snapshot][index]") {
     test_util::SetLogVerbosityGuard guard{log::Level::kNone};
@@ -235,6 +277,47 @@ TEST_CASE("TransactionSnapshot::block_num_by_txn_hash OK", "[silkworm][node][sna
     // transaction hash not present in snapshot (first txn hash in block 1'500'014)
     block_number = tx_snapshot.block_num_by_txn_hash(0xfa496b4cd9748754a28c66690c283ec9429440eb8609998901216908ad1b48eb_bytes32);
     CHECK(not block_number.has_value());
+
+    // system txn hash is pad32(txn_id): 7'341'271 is the first (system) txn in block 1'500'013
+    block_number = tx_snapshot.block_num_by_txn_hash(0x00000000007004d7000000000000000000000000000000000000000000000000_bytes32);
+    CHECK(block_number == 1'500'013);
+}
+
+// https://etherscan.io/block/1500012
+TEST_CASE("TransactionSnapshot::block_nums_by_txn_hash OK", "[silkworm][node][snapshot][index]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::SampleTransactionSnapshotFile valid_tx_snapshot{};                         // contains txs for [1'500'012, 1'500'013]
+    test::SampleTransactionSnapshotPath tx_snapshot_path{valid_tx_snapshot.path()};  // necessary to tweak the block numbers
+    TransactionIndex tx_index{tx_snapshot_path};
+    REQUIRE_NOTHROW(tx_index.build());
+
+    TransactionSnapshot tx_snapshot{tx_snapshot_path};
+    tx_snapshot.reopen_segment();
+    tx_snapshot.reopen_index();
+
+    CHECK(tx_snapshot.block_nums_by_txn_hash({}).empty());
+
+    // block 1'500'012: base_txn_id is 7'341'263, txn_count is 7; block 1'500'013: base_txn_id is 7'341'272, txn_count is 1
+    std::vector<Hash> txn_hashes;
+    for (const uint64_t txn_id : {7'341'264, 7'341'265, 7'341'266, 7'341'267, 7'341'268, 7'341'269, 7'341'272}) {
+        const auto transaction{tx_snapshot.txn_by_id(txn_id)};
+        REQUIRE(transaction);
+        txn_hashes.emplace_back(transaction->hash());
+    }
+    // transaction hash not present in snapshot (first txn hash in block 1'500'014)
+    txn_hashes.insert(txn_hashes.begin() + 3, 0xfa496b4cd9748754a28c66690c283ec9429440eb8609998901216908ad1b48eb_bytes32);
+    // system txn hash is pad32(txn_id): 7'341'271 is the first (system) txn in block 1'500'013
+    txn_hashes.push_back(0x00000000007004d7000000000000000000000000000000000000000000000000_bytes32);
+
+    const auto block_numbers{tx_snapshot.block_nums_by_txn_hash(txn_hashes)};
+    REQUIRE(block_numbers.size() == txn_hashes.size());
+    for (std::size_t i{0}; i < txn_hashes.size(); ++i) {
+        CHECK(block_numbers[i] == tx_snapshot.block_num_by_txn_hash(txn_hashes[i]));
+    }
+    CHECK(block_numbers[0] == 1'500'012);
+    CHECK(!block_numbers[3]);
+    CHECK(block_numbers[txn_hashes.size() - 2] == 1'500'013);
+    CHECK(block_numbers.back() == 1'500'013);
 }
 
 // https://etherscan.io/block/1500012
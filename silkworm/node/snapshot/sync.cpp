@@ -24,12 +24,12 @@
 #include <silkworm/core/types/hash.hpp>
 #include <silkworm/infra/common/ensure.hpp>
 #include <silkworm/infra/common/log.hpp>
-#include <silkworm/infra/concurrency/thread_pool.hpp>
 #include <silkworm/infra/concurrency/thread_safe_queue.hpp>
 #include <silkworm/node/db/stages.hpp>
 #include <silkworm/node/etl/collector.hpp>
 #include <silkworm/node/snapshot/config.hpp>
 #include <silkworm/node/snapshot/index.hpp>
+#include <silkworm/node/snapshot/index_scheduler.hpp>
 #include <silkworm/node/snapshot/path.hpp>
 
 namespace silkworm::snapshot {
@@ -209,25 +209,9 @@ bool SnapshotSync::stop() {
 }
 
 void SnapshotSync::build_missing_indexes() {
-    ThreadPool workers;
-
-    // Determine the missing indexes and build them in parallel
-    const auto missing_indexes = repository_->missing_indexes();
-    for (const auto& index : missing_indexes) {
-        workers.push_task([=]() {
-            SILK_INFO << "SnapshotSync: build index: " << index->path().filename() << " start";
-            index->build();
-            SILK_INFO << "SnapshotSync: build index: " << index->path().filename() << " end";
-        });
-    }
-
-    // Wait for all missing indexes to be built or stop request
-    while (workers.get_tasks_total() and not is_stopping()) {
-        std::this_thread::sleep_for(kCheckCompletionInterval);
-    }
-    // Wait for any already-started-but-unfinished work in case of stop request
-    workers.pause();
-    workers.wait_for_tasks();
+    // Determine the missing indexes and build them in parallel within the memory budget
+    IndexBuildScheduler scheduler{settings_.index_build_settings};
+    scheduler.build(repository_->missing_indexes(), [this]() { return is_stopping(); });
 }
 
 void SnapshotSync::update_database(db::RWTxn& txn, BlockNum max_block_available) {
@@ -0,0 +1,137 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "transaction_view.hpp"
+
+#include <bit>
+#include <string>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/rlp/decode.hpp>
+#include <silkworm/core/types/address.hpp>
+#include <silkworm/infra/common/ensure.hpp>
+
+namespace silkworm::snapshot {
+
+//! The offset of the transaction RLP in the word, after the transaction hash first byte and the sender address
+static constexpr std::size_t kTxRlpDataOffset{1 + kAddressLength};
+
+bool TransactionView::may_have_hash(const Hash& txn_hash) const {
+    if (is_system()) {
+        return hash() == txn_hash;
+    }
+    return word_[0] == txn_hash.bytes[0];
+}
+
+const Hash& TransactionView::hash() const {
+    if (!hash_) {
+        if (is_system()) {
+            // system-txs: hash:pad32(txnID)
+            Hash system_txn_hash;
+            endian::store_big_u64(system_txn_hash.bytes, txn_id_);
+            hash_ = system_txn_hash;
+        } else {
+            hash_ = Hash{std::bit_cast<evmc_bytes32>(keccak256(payload()))};
+        }
+    }
+    return *hash_;
+}
+
+ByteView TransactionView::senders_data() const {
+    ensure(word_.size() >= kTxRlpDataOffset, "TransactionView: too short record: " + std::to_string(word_.size()));
+    return word_.substr(1, kAddressLength);
+}
+
+evmc::address TransactionView::sender() const {
+    return bytes_to_address(senders_data());
+}
+
+ByteView TransactionView::rlp() const {
+    ensure(word_.size() >= kTxRlpDataOffset, "TransactionView: too short record: " + std::to_string(word_.size()));
+    return word_.substr(kTxRlpDataOffset);
+}
+
+ByteView TransactionView::payload() const {
+    decode_envelope();
+    return *payload_;
+}
+
+TransactionType TransactionView::type() const {
+    decode_envelope();
+    return type_;
+}
+
+void TransactionView::decode_envelope() const {
+    if (payload_) return;
+
+    const ByteView tx_rlp{rlp()};
+    ByteView tx_envelope{tx_rlp};
+    rlp::Header tx_header;
+    TransactionType tx_type{};
+    const auto envelope_result = rlp::decode_transaction_header_and_type(tx_envelope, tx_header, tx_type);
+    ensure(envelope_result.has_value(), "TransactionView: cannot decode tx envelope for txn id: " + std::to_string(txn_id_));
+
+    const std::size_t tx_payload_offset = tx_type == TransactionType::kLegacy ? 0 : (tx_rlp.length() - tx_header.payload_length);
+    payload_ = tx_rlp.substr(tx_payload_offset);
+    type_ = tx_type;
+}
+
+std::optional<evmc::address> TransactionView::to() const {
+    ByteView fields{payload()};
+    const auto txn_type{type()};
+    if (txn_type != TransactionType::kLegacy) {
+        fields.remove_prefix(1);
+    }
+    const auto list_header{rlp::decode_header(fields)};
+    ensure(list_header && list_header->list, "TransactionView: invalid tx payload for txn id: " + std::to_string(txn_id_));
+
+    // Skip the fields preceding the recipient: [chain_id] nonce gas_price|max_priority_fee [max_fee] gas_limit
+    std::size_t preceding_fields{3};
+    if (txn_type == TransactionType::kAccessList) {
+        preceding_fields = 4;
+    } else if (txn_type == TransactionType::kDynamicFee || txn_type == TransactionType::kBlob) {
+        preceding_fields = 5;
+    }
+    for (std::size_t i{0}; i < preceding_fields; ++i) {
+        const auto field_header{rlp::decode_header(fields)};
+        ensure(field_header && !field_header->list && field_header->payload_length <= fields.size(),
+               "TransactionView: invalid tx field for txn id: " + std::to_string(txn_id_));
+        fields.remove_prefix(field_header->payload_length);
+    }
+
+    ensure(!fields.empty(), "TransactionView: missing tx recipient for txn id: " + std::to_string(txn_id_));
+    if (fields[0] == rlp::kEmptyStringCode) {
+        return std::nullopt;
+    }
+    evmc::address recipient;
+    const auto decode_result{rlp::decode(fields, recipient.bytes, rlp::Leftover::kAllow)};
+    ensure(decode_result.has_value(), "TransactionView: invalid tx recipient for txn id: " + std::to_string(txn_id_));
+    return recipient;
+}
+
+Transaction TransactionView::to_transaction(bool read_sender) const {
+    ByteView tx_payload{payload()};
+    Transaction transaction;
+    const auto payload_result = rlp::decode_transaction(tx_payload, transaction, rlp::Eip2718Wrapping::kBoth);
+    ensure(payload_result.has_value(), "TransactionView: cannot decode tx payload for txn id: " + std::to_string(txn_id_));
+    if (read_sender) {
+        transaction.from = sender();
+    }
+    return transaction;
+}
+
+}  // namespace silkworm::snapshot
@@ -0,0 +1,89 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include <evmc/evmc.hpp>
+
+#include <silkworm/core/common/bytes.hpp>
+#include <silkworm/core/types/hash.hpp>
+#include <silkworm/core/types/transaction.hpp>
+
+namespace silkworm::snapshot {
+
+//! \brief TransactionView is a read-only view over one transaction word in a snapshot segment, whose fields are
+//! decoded on demand without copying the word content.
+//! \details The word format is: tx_hash_1byte + sender_address_20byte + tx_rlp_bytes, empty for system transactions.
+//! \warning The view points into the decompressed word buffer, so it must not be used after the word is gone. Fields
+//! decoded lazily are cached within the view, hence the same view must not be shared by many threads.
+class TransactionView {
+  public:
+    TransactionView(uint64_t txn_id, ByteView word) : txn_id_{txn_id}, word_{word} {}
+
+    //! The transaction identifier, unique across all transaction snapshots
+    [[nodiscard]] uint64_t id() const { return txn_id_; }
+
+    //! The raw snapshot word
+    [[nodiscard]] ByteView word() const { return word_; }
+
+    //! Flag indicating if this is a system transaction, which has no content
+    [[nodiscard]] bool is_system() const { return word_.empty(); }
+
+    //! Check the first byte of the specified hash against the one stored in the word, without any hashing
+    //! @return false if the transaction surely has another hash, true if it may have the specified hash
+    [[nodiscard]] bool may_have_hash(const Hash& txn_hash) const;
+
+    //! The transaction hash, computed just once
+    //! @details system transactions have the transaction identifier (big-endian) as hash
+    [[nodiscard]] const Hash& hash() const;
+
+    //! The 20-byte sender address data
+    [[nodiscard]] ByteView senders_data() const;
+
+    //! The sender address
+    [[nodiscard]] evmc::address sender() const;
+
+    //! The transaction RLP as stored in the word, i.e. typed transactions wrapped into an RLP string
+    [[nodiscard]] ByteView rlp() const;
+
+    //! The transaction canonical encoding, i.e. the RLP list for legacy transactions or type + RLP list otherwise
+    [[nodiscard]] ByteView payload() const;
+
+    //! The transaction type
+    [[nodiscard]] TransactionType type() const;
+
+    //! The recipient address, std::nullopt for contract creation, decoded skipping all the preceding fields
+    [[nodiscard]] std::optional<evmc::address> to() const;
+
+    //! Decode the whole transaction
+    [[nodiscard]] Transaction to_transaction(bool read_sender = true) const;
+
+  private:
+    void decode_envelope() const;
+
+    uint64_t txn_id_;
+    ByteView word_;
+
+    //! The fields decoded lazily
+    mutable std::optional<ByteView> payload_;
+    mutable TransactionType type_{TransactionType::kLegacy};
+    mutable std::optional<Hash> hash_;
+};
+
+}  // namespace silkworm::snapshot
@@ -0,0 +1,161 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "transaction_view.hpp"
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/infra/common/directories.hpp>
+#include <silkworm/infra/test_util/log.hpp>
+#include <silkworm/node/snapshot/index.hpp>
+#include <silkworm/node/snapshot/snapshot.hpp>
+#include <silkworm/node/test/snapshots.hpp>
+
+namespace silkworm::snapshot {
+
+using namespace evmc::literals;
+
+//! Build a transaction snapshot word for the specified transaction: tx_hash_1byte + sender_address_20byte + tx_rlp_bytes
+static Bytes make_word(const Transaction& txn, const evmc::address& sender) {
+    Bytes word;
+    word.push_back(txn.hash().bytes[0]);
+    word.append(sender.bytes, kAddressLength);
+    rlp::encode(word, txn, /*wrap_eip2718_into_string=*/true);
+    return word;
+}
+
+TEST_CASE("TransactionView", "[silkworm][node][snapshot]") {
+    const auto sender{0x68d7b0a3a4ec1bb0d7a6b0f3c2a8e4ad6e9a1c52_address};
+    Transaction txn{};
+    txn.nonce = 7;
+    txn.max_priority_fee_per_gas = 10000000000;
+    txn.max_fee_per_gas = 30000000000;
+    txn.gas_limit = 5748100;
+    txn.to = 0x811a752c8cd697e3cb27279c330ed1ada745a8d7_address;
+    txn.value = 2 * kEther;
+    txn.data = *from_hex("6ebaf477f83e051589c1188bcc6ddccd");
+    txn.odd_y_parity = false;
+    txn.r = intx::from_string<intx::uint256>("0x36b241b061a36a32ab7fe86c7aa9eb592dd59018cd0443adc0903590c16b02b0");
+    txn.s = intx::from_string<intx::uint256>("0x5edcc541b4741c5cc6dd347c5ed9577ef293a62787b4510465fadbfe39ee4094");
+
+    SECTION("legacy") {
+        txn.type = TransactionType::kLegacy;
+        txn.max_fee_per_gas = txn.max_priority_fee_per_gas;
+        txn.chain_id = 1;
+        const Bytes word{make_word(txn, sender)};
+        const TransactionView view{42, word};
+        CHECK(view.id() == 42);
+        CHECK(!view.is_system());
+        CHECK(view.type() == TransactionType::kLegacy);
+        CHECK(view.sender() == sender);
+        CHECK(view.to() == txn.to);
+        CHECK(view.hash() == Hash{txn.hash()});
+        CHECK(view.may_have_hash(Hash{txn.hash()}));
+        CHECK(view.to_transaction() == txn);
+        CHECK(view.to_transaction().from == sender);
+        CHECK(!view.to_transaction(/*read_sender=*/false).from);
+    }
+
+    SECTION("typed") {
+        for (const auto type : {TransactionType::kAccessList, TransactionType::kDynamicFee}) {
+            txn.type = type;
+            txn.chain_id = 5;
+            if (type == TransactionType::kAccessList) {
+                txn.max_fee_per_gas = txn.max_priority_fee_per_gas;
+            }
+            txn.reset();  // discard the hash cached for the previous type
+            const Bytes word{make_word(txn, sender)};
+            const TransactionView view{42, word};
+            CHECK(view.type() == type);
+            CHECK(view.payload()[0] == static_cast<uint8_t>(type));
+            CHECK(view.to() == txn.to);
+            CHECK(view.hash() == Hash{txn.hash()});
+            CHECK(view.to_transaction() == txn);
+        }
+    }
+
+    SECTION("contract creation") {
+        txn.type = TransactionType::kDynamicFee;
+        txn.chain_id = 5;
+        txn.to.reset();
+        const Bytes word{make_word(txn, sender)};
+        const TransactionView view{42, word};
+        CHECK(!view.to());
+    }
+
+    SECTION("system") {
+        const TransactionView view{0x0102, ByteView{}};
+        CHECK(view.is_system());
+        CHECK(view.hash() == 0x0000000000000102000000000000000000000000000000000000000000000000_bytes32);
+        CHECK(view.may_have_hash(view.hash()));
+        CHECK_THROWS(view.sender());
+        CHECK_THROWS(view.to());
+    }
+}
+
+TEST_CASE("TransactionSnapshot::for_each_txn_view", "[silkworm][node][snapshot][index]") {
+    test_util::SetLogVerbosityGuard guard{log::Level::kNone};
+    TemporaryDirectory tmp_dir;
+    test::SampleTransactionSnapshotFile tx_snapshot_file{tmp_dir.path()};           // contains txs for [1'500'012, 1'500'013]
+    test::SampleTransactionSnapshotPath tx_snapshot_path{tx_snapshot_file.path()};  // necessary to tweak the block numbers
+    TransactionIndex tx_index{tx_snapshot_path};
+    REQUIRE_NOTHROW(tx_index.build());
+    TransactionSnapshot tx_snapshot{tx_snapshot_path};
+    tx_snapshot.reopen_segment();
+    tx_snapshot.reopen_index();
+
+    SECTION("range") {
+        // block 1'500'012: base_txn_id is 7'341'263, txn_count is 7
+        const auto transactions{tx_snapshot.txn_range(7'341'263, 7, /*read_senders=*/true)};
+        REQUIRE(transactions.size() == 7);
+        std::size_t i{0};
+        tx_snapshot.for_each_txn_view(7'341'263, 7, [&](const TransactionView& txn) -> bool {
+            CHECK(txn.id() == 7'341'263 + i);
+            CHECK(txn.sender() == transactions[i].from);
+            CHECK(txn.to() == transactions[i].to);
+            CHECK(txn.hash() == Hash{transactions[i].hash()});
+            CHECK(txn.may_have_hash(Hash{transactions[i].hash()}));
+            CHECK(txn.to_transaction() == transactions[i]);
+            ++i;
+            return true;
+        });
+        CHECK(i == 7);
+    }
+
+    SECTION("range stopped by walker") {
+        std::size_t visited{0};
+        tx_snapshot.for_each_txn_view(7'341'263, 7, [&](const TransactionView&) -> bool {
+            return ++visited < 3;
+        });
+        CHECK(visited == 3);
+    }
+
+    SECTION("all") {
+        std::vector<uint64_t> txn_ids;
+        CHECK(tx_snapshot.for_each_txn_view([&](const TransactionView& txn) -> bool {
+            txn_ids.push_back(txn.id());
+            return true;
+        }));
+        REQUIRE(txn_ids.size() == tx_snapshot.item_count());
+        CHECK(txn_ids.front() == tx_snapshot.idx_txn_hash()->base_data_id());
+        CHECK(txn_ids.back() == txn_ids.front() + txn_ids.size() - 1);
+    }
+}
+
+}  // namespace silkworm::snapshot
@@ -16,9 +16,13 @@
 
 #include "stage_execution.hpp"
 
+#include <atomic>
+#include <future>
+#include <optional>
 #include <span>
 #include <stdexcept>
 
+#include <gsl/util>
 #include <magic_enum.hpp>
 
 #include <silkworm/core/common/endian.hpp>
@@ -66,6 +70,7 @@ Stage::Result Execution::forward(db::RWTxn& txn) {
         processed_blocks_ = 0;
         processed_transactions_ = 0;
         processed_gas_ = 0;
+        reader_stall_ = executor_stall_ = writer_stall_ = std::chrono::nanoseconds::zero();
         lap_time_ = std::chrono::steady_clock::now();
         progress_lock.unlock();
 
@@ -89,12 +94,28 @@ Stage::Result Execution::forward(db::RWTxn& txn) {
             prune_receipts = std::min(prune_receipts, hashstate_stage_progress - 1);
         }
 
-        static constexpr size_t kCacheSize{5'000};
-        AnalysisCache analysis_cache{kCacheSize};
+        AnalysisCache& analysis_cache{analysis_cache_};
         ObjectPool<evmone::ExecutionState> state_pool;
 
+        // One pool serves both parallel execution and state prefetching, so that together they do not oversubscribe cores
+        const bool workers_needed{node_settings_->parallel_execution_enabled || node_settings_->execution_prefetch_blocks > 0};
+        if (workers_needed && !worker_pool_) {
+            worker_pool_ = std::make_unique<ThreadPool>();
+        }
+
         prefetched_blocks_.clear();
 
+        // Pipelining relies on commits to let read-only txns see the state persisted so far
+        if (node_settings_->execution_pipeline_enabled && !txn.commit_disabled()) {
+            forward_pipelined(txn, max_block_num, analysis_cache, state_pool, prune_history, prune_receipts);
+        } else if (!txn.commit_disabled() && workers_needed) {
+            // So do parallel execution and state prefetching: make visible to read-only txns what has been written so far
+            txn.commit_and_renew();
+            if (node_settings_->execution_prefetch_blocks > 0) {
+                state_prefetcher_ = std::make_unique<db::StatePrefetcher>(txn.db(), *worker_pool_);
+            }
+        }
+
         while (block_num_ <= max_block_num) {
             throw_if_stopping();
             const auto execution_result{execute_batch(txn,
@@ -141,6 +162,7 @@ Stage::Result Execution::forward(db::RWTxn& txn) {
         ret = Stage::Result::kUnexpectedError;
     }
 
+    state_prefetcher_.reset();
     operation_ = OperationType::None;
     return ret;
 }
@@ -192,6 +214,19 @@ void Execution::prefetch_blocks(db::RWTxn& txn, const BlockNum from, const Block
         auto [_, duration]{sw->lap()};
         log::Trace("Fetched blocks", {"size", std::to_string(num_read), "in", StopWatch::format(duration)});
     }
+
+    if (state_prefetcher_) {
+        prefetch_state(0, node_settings_->execution_prefetch_blocks);
+    }
+}
+
+void Execution::prefetch_state(size_t first, size_t count) {
+    if (!state_prefetcher_) {
+        return;
+    }
+    for (size_t i{first}; i < first + count && i < prefetched_blocks_.size(); ++i) {
+        state_prefetcher_->prefetch(prefetched_blocks_[i]);
+    }
 }
 
 Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, AnalysisCache& analysis_cache,
@@ -202,7 +237,19 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, A
     auto log_time{std::chrono::steady_clock::now()};
 
     try {
-        db::Buffer buffer(txn, prune_history_threshold);
+        // The RW txn is bound to this thread, so speculative workers must read through read-only txns instead: they
+        // see the state committed at the end of previous batch and can be used from any thread thanks to MDBX_NOTLS
+        const bool parallel{node_settings_->parallel_execution_enabled && !txn.commit_disabled()};
+        std::optional<db::ROTxnManaged> read_txn;
+        std::vector<db::ROTxnManaged> worker_txns;  // Each worker reads through its own txn, so they never wait
+        if (parallel) {
+            read_txn.emplace(txn.db());
+            worker_txns.reserve(worker_pool_->get_thread_count());
+            for (size_t w{0}; w < worker_pool_->get_thread_count(); ++w) {
+                worker_txns.emplace_back(txn.db());
+            }
+        }
+        db::Buffer buffer{txn, read_txn ? static_cast<db::ROTxn&>(*read_txn) : txn, /*previous=*/nullptr, prune_history_threshold};
         std::vector<Receipt> receipts;
 
         // Transform batch_size limit into Ggas
@@ -216,6 +263,12 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, A
             lap_time_ = std::chrono::steady_clock::now();
         }
 
+        // State prefetched so far may be older than what previous batch has just committed
+        if (state_prefetcher_) {
+            state_prefetcher_->cancel();
+            prefetch_state(0, node_settings_->execution_prefetch_blocks);
+        }
+
         while (true) {
             if (prefetched_blocks_.empty()) {
                 throw_if_stopping();
@@ -231,9 +284,20 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, A
                 log_time = now + 5s;
             }
 
+            size_t warmed_state_entries{0};
+            if (state_prefetcher_) {
+                warmed_state_entries = state_prefetcher_->warm(buffer);
+            }
+
             ExecutionProcessor processor(block, *rule_set_, buffer, node_settings_->chain_config.value());
             processor.evm().analysis_cache = &analysis_cache;
             processor.evm().state_pool = &state_pool;
+            std::vector<std::unique_ptr<db::Buffer>> worker_readers;  // Fresh for each block, as the buffer changes
+            if (parallel) {
+                worker_readers = make_worker_readers(buffer, worker_txns);
+                processor.set_parallel_runner(make_parallel_runner(
+                    *worker_pool_, [&](size_t worker) -> State& { return *worker_readers[worker]; }));
+            }
 
             // TODO Add Tracer and collect call traces
 
@@ -266,12 +330,25 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, A
             ++processed_blocks_;
             processed_transactions_ += block.transactions.size();
             processed_gas_ += block.header.gas_used;
+            reexecuted_transactions_ += processor.reexecuted_transactions();
+            warmed_state_entries_ += warmed_state_entries;
             gas_batch_size += block.header.gas_used;
             gas_history_size += block.header.gas_used;
             progress_lock.unlock();
 
+            // Storage changes are recorded just for blocks whose history is kept, so hot slots are not learnt below
+            // the history pruning threshold and only the accounts and access lists of upcoming blocks are prefetched
+            if (state_prefetcher_ && block_num_ >= prune_history_threshold) {
+                if (const auto it{buffer.storage_changes().find(block_num_)}; it != buffer.storage_changes().end()) {
+                    state_prefetcher_->learn(it->second);
+                }
+            }
+
             prefetched_blocks_.pop_front();
 
+            // Keep prefetching state the same number of blocks ahead
+            prefetch_state(node_settings_->execution_prefetch_blocks - 1, 1);
+
             // Flush whole buffer if time to
             if (gas_batch_size >= gas_max_batch_size || block_num_ >= max_block_num) {
                 log::Trace(log_prefix_, {"buffer", "state", "size", human_size(buffer.current_batch_state_size())});
@@ -312,6 +389,220 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, A
     return ret;
 }
 
+void Execution::forward_pipelined(db::RWTxn& txn, BlockNum max_block_num, AnalysisCache& analysis_cache,
+                                  ObjectPool<evmone::ExecutionState>& state_pool, BlockNum prune_history_threshold,
+                                  BlockNum prune_receipts_threshold) {
+    using std::chrono::steady_clock;
+
+    // Make visible to read-only txns what previous stages have written so far
+    txn.commit_and_renew();
+    mdbx::env env{txn.db()};
+
+    BoundedQueue<Block> blocks{kMaxQueuedBlocks};
+    std::unique_ptr<db::Buffer> flushed_buffer;  // State of the last executed batch, read by the running one
+    std::future<void> reader;
+    std::future<PipelinedBatch> executor;
+
+    // Closing the queue unblocks both reader and executor, then futures wait for them before releasing anything
+    [[maybe_unused]] auto _ = gsl::finally([&]() {
+        blocks.close();
+        std::unique_lock progress_lock(progress_mtx_);
+        block_queue_ = nullptr;
+    });
+    {
+        std::unique_lock progress_lock(progress_mtx_);
+        block_queue_ = &blocks;
+    }
+
+    reader = std::async(std::launch::async, [&, from = block_num_]() {
+        read_blocks(env, from, max_block_num, blocks);
+    });
+
+    const auto execute_batch_async{[&](const db::Buffer* previous, BlockNum from) {
+        return std::async(std::launch::async, [=, this, &txn, &blocks, &analysis_cache, &state_pool]() {
+            return execute_pipelined_batch(txn, env, previous, blocks, from, max_block_num, analysis_cache, state_pool,
+                                           prune_history_threshold, prune_receipts_threshold);
+        });
+    }};
+    executor = execute_batch_async(/*previous=*/nullptr, block_num_);
+
+    StopWatch commit_stopwatch;
+    while (true) {
+        const auto wait_start{steady_clock::now()};
+        PipelinedBatch batch{executor.get()};
+        const auto wait_end{steady_clock::now()};
+        {
+            std::unique_lock progress_lock(progress_mtx_);
+            writer_stall_ += wait_end - wait_start;
+            if (batch.finish_time < wait_start) {
+                executor_stall_ += wait_start - batch.finish_time;
+            }
+        }
+
+        // The batch just executed has done reading the state of the previous one, which can be released
+        flushed_buffer = std::move(batch.buffer);
+
+        if (batch.validation != ValidationResult::kOk) {
+            // Persist work done so far
+            flushed_buffer->write_to_db();
+
+            // Notify sync_loop we need to unwind
+            sync_context_->unwind_point.emplace(batch.last_block_num - 1u);
+            sync_context_->bad_block_hash.emplace(batch.bad_block_hash);
+
+            log::Warning(log_prefix_,
+                         {"block", std::to_string(batch.last_block_num),
+                          "hash", to_hex(batch.bad_block_hash.bytes, true),
+                          "error", std::string(magic_enum::enum_name<ValidationResult>(batch.validation))});
+            throw StageError(Stage::Result::kInvalidBlock);
+        }
+
+        // Start executing next batch on top of this one while it gets persisted
+        const bool last_batch{batch.last_block_num >= max_block_num};
+        if (!last_batch) {
+            flushed_buffer->retain_state_on_write();
+            executor = execute_batch_async(flushed_buffer.get(), batch.last_block_num + 1);
+        }
+
+        flushed_buffer->write_to_db();
+
+        // Persist forward and prune progresses
+        update_progress(txn, batch.last_block_num);
+        if (node_settings_->prune_mode->history().enabled() || node_settings_->prune_mode->receipts().enabled()) {
+            db::stages::write_stage_prune_progress(txn, db::stages::kExecutionKey, batch.last_block_num);
+        }
+
+        (void)commit_stopwatch.start(/*with_reset=*/true);
+        txn.commit_and_renew();
+        const auto commit_duration{commit_stopwatch.stop().second};
+        log::Info(log_prefix_ + " commit", {"batch time", StopWatch::format(commit_duration)});
+
+        block_num_ = batch.last_block_num + 1;
+        if (last_batch) {
+            break;
+        }
+    }
+
+    reader.get();
+}
+
+void Execution::read_blocks(mdbx::env env, BlockNum from, BlockNum to, BoundedQueue<Block>& blocks) {
+    try {
+        db::ROTxnManaged txn{env};
+        db::DataModel data_model{txn};
+        for (BlockNum block_num{from}; block_num <= to; ++block_num) {
+            // A long-lived reader would pin its snapshot and prevent page reuse across all the batch commits
+            if (block_num > from && (block_num - from) % kReadTxnRenewBlocks == 0) {
+                txn.abort();
+                txn = db::ROTxnManaged{env};
+            }
+
+            Block block;
+            if (!data_model.read_block(block_num, /*read_senders=*/true, block)) {
+                throw std::runtime_error("Unable to read block " + std::to_string(block_num));
+            }
+
+            const auto wait_start{std::chrono::steady_clock::now()};
+            const bool pushed{blocks.push(std::move(block))};
+            const auto wait_time{std::chrono::steady_clock::now() - wait_start};
+            {
+                std::unique_lock progress_lock(progress_mtx_);
+                reader_stall_ += wait_time;
+            }
+            if (!pushed) {
+                break;  // Pipeline has stopped
+            }
+        }
+    } catch (const std::exception& ex) {
+        log::Error(log_prefix_, {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        blocks.close();
+        throw;
+    }
+}
+
+Execution::PipelinedBatch Execution::execute_pipelined_batch(db::RWTxn& txn, mdbx::env env, const db::Buffer* previous,
+                                                             BoundedQueue<Block>& blocks, BlockNum from,
+                                                             BlockNum max_block_num, AnalysisCache& analysis_cache,
+                                                             ObjectPool<evmone::ExecutionState>& state_pool,
+                                                             BlockNum prune_history_threshold,
+                                                             BlockNum prune_receipts_threshold) {
+    using namespace std::chrono_literals;
+    auto log_time{std::chrono::steady_clock::now()};
+
+    PipelinedBatch batch;
+    batch.read_txn = std::make_unique<db::ROTxnManaged>(env);
+    batch.buffer = std::make_unique<db::Buffer>(txn, *batch.read_txn, previous, prune_history_threshold);
+    std::vector<db::ROTxnManaged> worker_txns;  // Opened along with the batch one, so that they see the same snapshot
+    if (node_settings_->parallel_execution_enabled) {
+        worker_txns.reserve(worker_pool_->get_thread_count());
+        for (size_t w{0}; w < worker_pool_->get_thread_count(); ++w) {
+            worker_txns.emplace_back(env);
+        }
+    }
+    std::vector<Receipt> receipts;
+
+    // History cannot be flushed while executing, so the batch is bounded by the history size limit
+    const size_t gas_max_batch_size{node_settings_->batch_size * 1_Kibi / 2};  // 512MB -> 256Ggas roughly
+    size_t gas_batch_size{0};
+
+    for (BlockNum block_num{from};; ++block_num) {
+        const auto wait_start{std::chrono::steady_clock::now()};
+        std::optional<Block> block{blocks.pop()};
+        const auto wait_time{std::chrono::steady_clock::now() - wait_start};
+        if (!block) {
+            throw_if_stopping();
+            throw std::runtime_error("Missing block " + std::to_string(block_num));
+        }
+        check_block_sequence(block->header.number, block_num);
+
+        // Log and abort check
+        if (const auto now{std::chrono::steady_clock::now()}; log_time <= now) {
+            throw_if_stopping();
+            log_time = now + 5s;
+        }
+
+        ExecutionProcessor processor(*block, *rule_set_, *batch.buffer, node_settings_->chain_config.value());
+        processor.evm().analysis_cache = &analysis_cache;
+        processor.evm().state_pool = &state_pool;
+        std::vector<std::unique_ptr<db::Buffer>> worker_readers;  // Fresh for each block, as the buffer changes
+        if (node_settings_->parallel_execution_enabled) {
+            worker_readers = make_worker_readers(*batch.buffer, worker_txns);
+            processor.set_parallel_runner(make_parallel_runner(
+                *worker_pool_, [&](size_t worker) -> State& { return *worker_readers[worker]; }));
+        }
+
+        batch.last_block_num = block_num;
+        const auto res{processor.execute_and_write_block(receipts)};
+        if (block_num >= prune_receipts_threshold) {
+            batch.buffer->insert_receipts(block_num, receipts);
+        }
+        if (res != ValidationResult::kOk) {
+            batch.validation = res;
+            batch.bad_block_hash = block->header.hash();
+            break;
+        }
+
+        // Stats
+        std::unique_lock progress_lock(progress_mtx_);
+        executor_stall_ += wait_time;
+        ++processed_blocks_;
+        processed_transactions_ += block->transactions.size();
+        processed_gas_ += block->header.gas_used;
+        reexecuted_transactions_ += processor.reexecuted_transactions();
+        progress_lock.unlock();
+
+        gas_batch_size += block->header.gas_used;
+        if (gas_batch_size >= gas_max_batch_size || block_num >= max_block_num) {
+            break;
+        }
+    }
+
+    // Release the db snapshot as soon as possible, following batches read the state persisted meanwhile
+    batch.read_txn->abort();
+    batch.finish_time = std::chrono::steady_clock::now();
+    return batch;
+}
+
 Stage::Result Execution::unwind(db::RWTxn& txn) {
     static const db::MapConfig unwind_tables[5] = {
         db::table::kAccountChangeSet,  //
@@ -551,13 +842,71 @@ std::vector<std::string> Execution::get_log_progress() {
     auto speed_blocks = processed_blocks_ / elapsed_seconds;
     auto speed_transactions = processed_transactions_ / elapsed_seconds;
     auto speed_mgas = processed_gas_ / elapsed_seconds / 1'000'000;
+    const auto reexecuted_transactions{reexecuted_transactions_};
+    const auto processed_transactions{processed_transactions_};
     processed_blocks_ = 0;
     processed_transactions_ = 0;
     processed_gas_ = 0;
+    reexecuted_transactions_ = 0;
+    const auto warmed_state_entries{warmed_state_entries_};
+    warmed_state_entries_ = 0;
+    const bool block_queue{block_queue_ != nullptr};
+    const size_t queued_blocks{block_queue ? block_queue_->size() : 0};
+    const auto reader_stall{reader_stall_}, executor_stall{executor_stall_}, writer_stall{writer_stall_};
+    reader_stall_ = executor_stall_ = writer_stall_ = std::chrono::nanoseconds::zero();
     progress_lock.unlock();
 
-    return {"block", std::to_string(block_num_), "blocks/s", std::to_string(speed_blocks),
-            "txns/s", std::to_string(speed_transactions), "Mgas/s", std::to_string(speed_mgas)};
+    std::vector<std::string> progress{"block", std::to_string(block_num_), "blocks/s", std::to_string(speed_blocks),
+                                      "txns/s", std::to_string(speed_transactions), "Mgas/s", std::to_string(speed_mgas)};
+    if (node_settings_->parallel_execution_enabled && processed_transactions) {
+        progress.insert(progress.end(), {"reexec %", std::to_string(reexecuted_transactions * 100 / processed_transactions)});
+    }
+    if (const auto lookups{analysis_cache_.hits() + analysis_cache_.misses()}; lookups) {
+        progress.insert(progress.end(), {"code cache hit %", std::to_string(analysis_cache_.hits() * 100 / lookups)});
+    }
+    if (node_settings_->execution_prefetch_blocks > 0 && !block_queue) {
+        progress.insert(progress.end(), {"warmed/s", std::to_string(warmed_state_entries / elapsed_seconds)});
+    }
+    if (block_queue) {
+        progress.insert(progress.end(), {"queue", std::to_string(queued_blocks) + "/" + std::to_string(kMaxQueuedBlocks),
+                                         "reader stall", StopWatch::format(reader_stall),
+                                         "exec stall", StopWatch::format(executor_stall),
+                                         "write stall", StopWatch::format(writer_stall)});
+    }
+    return progress;
+}
+
+ExecutionProcessor::TaskRunner Execution::make_parallel_runner(ThreadPool& thread_pool,
+                                                               std::function<State&(size_t worker)> reader) {
+    return [&thread_pool, reader = std::move(reader)](size_t count, const std::function<void(size_t, State&)>& task) {
+        // Each worker keeps picking the next task until there are no more left, reading through its own reader
+        std::atomic_size_t next_task{0};
+        const auto work{[&](size_t worker) {
+            State& worker_reader{reader(worker)};
+            for (size_t i{next_task++}; i < count; i = next_task++) {
+                task(i, worker_reader);
+            }
+        }};
+        const size_t num_workers{std::min(static_cast<size_t>(thread_pool.get_thread_count()), count)};
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_workers);
+        for (size_t w{0}; w < num_workers; ++w) {
+            futures.emplace_back(thread_pool.submit(work, w));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+    };
+}
+
+std::vector<std::unique_ptr<db::Buffer>> Execution::make_worker_readers(const db::Buffer& buffer,
+                                                                       std::vector<db::ROTxnManaged>& read_txns) {
+    std::vector<std::unique_ptr<db::Buffer>> readers;
+    readers.reserve(read_txns.size());
+    for (auto& read_txn : read_txns) {
+        readers.emplace_back(std::make_unique<db::Buffer>(buffer, read_txn));
+    }
+    return readers;
 }
 
 void Execution::revert_state(ByteView key, ByteView value, db::RWCursorDupSort& plain_state_table,
@@ -16,10 +16,21 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
 #include <boost/circular_buffer.hpp>
 
 #include <silkworm/core/execution/evm.hpp>
+#include <silkworm/core/execution/processor.hpp>
 #include <silkworm/core/protocol/rule_set.hpp>
+#include <silkworm/infra/concurrency/bounded_queue.hpp>
+#include <silkworm/infra/concurrency/thread_pool.hpp>
+#include <silkworm/node/db/buffer.hpp>
+#include <silkworm/node/db/state_prefetcher.hpp>
 #include <silkworm/node/stagedsync/stages/stage.hpp>
 
 namespace silkworm::stagedsync {
@@ -37,12 +48,37 @@ class Execution final : public Stage {
     Stage::Result prune(db::RWTxn& txn) final;
     std::vector<std::string> get_log_progress() final;
 
+    //! \brief Builds a runner for parallel transaction execution spreading the tasks over the given thread pool
+    //! \param reader gives the State read by the given worker, in [0, thread count): distinct workers read concurrently
+    static ExecutionProcessor::TaskRunner make_parallel_runner(ThreadPool& thread_pool,
+                                                               std::function<State&(size_t worker)> reader);
+
+    //! \brief Builds the readers of buffer for the parallel execution workers, one per read-only txn
+    static std::vector<std::unique_ptr<db::Buffer>> make_worker_readers(const db::Buffer& buffer,
+                                                                        std::vector<db::ROTxnManaged>& read_txns);
+
   private:
     static constexpr size_t kMaxPrefetchedBlocks{10240};
+    static constexpr size_t kMaxQueuedBlocks{1024};    // Blocks read ahead by the pipeline reader
+    static constexpr size_t kReadTxnRenewBlocks{256};  // Blocks read by the pipeline reader before renewing its txn
+    static constexpr size_t kAnalysisCacheSize{5'000};
+
+    //! \brief Outcome of a batch executed by the pipeline
+    struct PipelinedBatch {
+        std::unique_ptr<db::ROTxnManaged> read_txn;  // Aborted as soon as execution is done
+        std::unique_ptr<db::Buffer> buffer;
+        BlockNum last_block_num{0};  // The last block executed (i.e. the bad one if validation failed)
+        ValidationResult validation{ValidationResult::kOk};
+        evmc::bytes32 bad_block_hash{};
+        std::chrono::steady_clock::time_point finish_time{};
+    };
 
     protocol::RuleSetPtr rule_set_;
     BlockNum block_num_{0};
     boost::circular_buffer<Block> prefetched_blocks_{/*buffer_capacity=*/kMaxPrefetchedBlocks};
+    std::unique_ptr<ThreadPool> worker_pool_;  // Workers for parallel transaction execution and state prefetching (if enabled)
+    std::unique_ptr<db::StatePrefetcher> state_prefetcher_;
+    AnalysisCache analysis_cache_{kAnalysisCacheSize};  // Shared by all the execution threads
 
     //! \brief Prefetches blocks for processing
     //! \param [in] from: the first block to prefetch (inclusive)
@@ -51,12 +87,32 @@ class Execution final : public Stage {
     //! or kMaxPrefetchedBlocks collected, whichever comes first
     void prefetch_blocks(db::RWTxn& txn, BlockNum from, BlockNum to);
 
+    //! \brief Starts prefetching the state touched by count prefetched blocks starting at given index (if enabled)
+    void prefetch_state(size_t first, size_t count);
+
     //! \brief Executes a batch of blocks
     //! \remarks A batch completes when either max block is reached or buffer dimensions overflow
     Stage::Result execute_batch(db::RWTxn& txn, BlockNum max_block_num, AnalysisCache& analysis_cache,
                                 ObjectPool<evmone::ExecutionState>& state_pool, BlockNum prune_history_threshold,
                                 BlockNum prune_receipts_threshold);
 
+    //! \brief Executes blocks up to max_block_num overlapping block reads, execution and state flushes
+    //! \remarks A reader thread decodes blocks on its own read-only txn into a bounded queue, each batch is executed
+    //! on a separate thread on top of the previous batch state while the latter is persisted and committed here
+    void forward_pipelined(db::RWTxn& txn, BlockNum max_block_num, AnalysisCache& analysis_cache,
+                           ObjectPool<evmone::ExecutionState>& state_pool, BlockNum prune_history_threshold,
+                           BlockNum prune_receipts_threshold);
+
+    //! \brief Reads canonical blocks with senders in [from, to] into the queue until done or the queue is closed
+    void read_blocks(mdbx::env env, BlockNum from, BlockNum to, BoundedQueue<Block>& blocks);
+
+    //! \brief Executes a pipelined batch starting at from, reading state through previous and then the db
+    //! \remarks A batch completes when either max block is reached or the history size limit is hit
+    PipelinedBatch execute_pipelined_batch(db::RWTxn& txn, mdbx::env env, const db::Buffer* previous,
+                                           BoundedQueue<Block>& blocks, BlockNum from, BlockNum max_block_num,
+                                           AnalysisCache& analysis_cache, ObjectPool<evmone::ExecutionState>& state_pool,
+                                           BlockNum prune_history_threshold, BlockNum prune_receipts_threshold);
+
     //! \brief For given changeset cursor/bucket it reverts the changes on states buckets
     static void unwind_state_from_changeset(db::ROCursor& source_changeset, db::RWCursorDupSort& plain_state_table,
                                             db::RWCursor& plain_code_table, BlockNum unwind_to);
@@ -71,6 +127,12 @@ class Execution final : public Stage {
     size_t processed_blocks_{0};
     size_t processed_transactions_{0};
     size_t processed_gas_{0};
+    size_t reexecuted_transactions_{0};
+    size_t warmed_state_entries_{0};
+    const BoundedQueue<Block>* block_queue_{nullptr};  // Pipeline block queue (if running)
+    std::chrono::nanoseconds reader_stall_{0};         // Pipeline reader waiting for room in block queue
+    std::chrono::nanoseconds executor_stall_{0};       // Pipeline executor waiting for blocks or for the writer
+    std::chrono::nanoseconds writer_stall_{0};         // Pipeline writer waiting for the executor
 };
 
 }  // namespace silkworm::stagedsync
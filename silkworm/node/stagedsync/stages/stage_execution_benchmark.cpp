@@ -0,0 +1,130 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/core/common/assert.hpp>
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/test_util.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/execution/processor.hpp>
+#include <silkworm/core/state/in_memory_state.hpp>
+#include <silkworm/infra/concurrency/thread_pool.hpp>
+#include <silkworm/node/stagedsync/stages/stage_execution.hpp>
+
+namespace silkworm {
+
+static constexpr size_t kNumBlocks{64};
+static constexpr size_t kTransactionsPerBlock{256};
+static constexpr size_t kNumAccounts{kNumBlocks * kTransactionsPerBlock};
+static constexpr size_t kHotContractEvery{8};  // one transaction out of 8 writes into the same contract slot
+
+static const evmc::address kHotContract{0x6d20c1c07e56b7098eb8c50ee03ba0f6f498a91d_address};
+
+// Stores the first word of the call data into the 0th storage slot
+static const Bytes kHotContractCode{*from_hex("600035600055")};
+
+static constexpr uint8_t kAccountPrefix{0xaa};
+
+static std::unique_ptr<InMemoryState> make_genesis_state() {
+    return test::synthetic_state(kNumAccounts, kAccountPrefix, kHotContract, kHotContractCode);
+}
+
+//! Fixed range of pre-Byzantium blocks made of plain transfers among distinct accounts plus calls to a hot contract
+static const std::vector<Block>& block_range() {
+    static const std::vector<Block> blocks{[]() {
+        std::vector<Block> range(kNumBlocks);
+        auto rule_set{protocol::rule_set_factory(kMainnetConfig)};
+        auto state{make_genesis_state()};
+        size_t sender_index{0};
+        for (size_t n{0}; n < kNumBlocks; ++n) {
+            Block& block{range[n]};
+            block.header.number = n + 1;
+            block.header.gas_limit = 100'000'000;
+            block.header.beneficiary = 0x61c808d82a3ac53231750dadc13c777b59310bd9_address;
+            for (size_t i{0}; i < kTransactionsPerBlock; ++i, ++sender_index) {
+                const evmc::address sender{test::synthetic_address(sender_index, kAccountPrefix)};
+                if (i % kHotContractEvery == 0) {
+                    Transaction txn{test::synthetic_transaction(sender, kHotContract)};
+                    txn.data = Bytes(32, '\0');
+                    endian::store_big_u64(&txn.data[24], sender_index);
+                    block.transactions.push_back(std::move(txn));
+                } else {
+                    const evmc::address recipient{test::synthetic_address((sender_index + 1) % kNumAccounts, kAccountPrefix)};
+                    Transaction txn{test::synthetic_transaction(sender, recipient)};
+                    txn.value = 1'000;
+                    block.transactions.push_back(std::move(txn));
+                }
+            }
+
+            // Dry run to find out the block gas used, then execute for real to move on the state
+            test::set_gas_used_by_dry_run(block, *state, kMainnetConfig);
+            std::vector<Receipt> receipts;
+            ExecutionProcessor processor{block, *rule_set, *state, kMainnetConfig};
+            SILKWORM_ASSERT(processor.execute_and_write_block(receipts) == ValidationResult::kOk);
+        }
+        return range;
+    }()};
+    return blocks;
+}
+
+static void execute_block_range(benchmark::State& state, bool parallel) {
+    const auto& blocks{block_range()};
+    auto rule_set{protocol::rule_set_factory(kMainnetConfig)};
+    std::unique_ptr<ThreadPool> thread_pool;
+    if (parallel) {
+        thread_pool = std::make_unique<ThreadPool>(static_cast<unsigned>(state.range(0)));
+    }
+
+    size_t reexecuted_transactions{0};
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        auto block_state{make_genesis_state()};
+        state.ResumeTiming();
+
+        std::vector<Receipt> receipts;
+        for (const auto& block : blocks) {
+            ExecutionProcessor processor{block, *rule_set, *block_state, kMainnetConfig};
+            if (thread_pool) {
+                // Concurrent reads of an InMemoryState are safe, so all the workers share it
+                processor.set_parallel_runner(stagedsync::Execution::make_parallel_runner(
+                    *thread_pool, [&](size_t) -> State& { return *block_state; }));
+            }
+            const auto result{processor.execute_and_write_block(receipts)};
+            benchmark::DoNotOptimize(result);
+            reexecuted_transactions += processor.reexecuted_transactions();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(kNumBlocks) * static_cast<int64_t>(kTransactionsPerBlock));
+    state.counters["reexecuted"] = benchmark::Counter(static_cast<double>(reexecuted_transactions),
+                                                      benchmark::Counter::kAvgIterations);
+}
+
+static void execute_block_range_serial(benchmark::State& state) {
+    execute_block_range(state, /*parallel=*/false);
+}
+BENCHMARK(execute_block_range_serial);
+
+static void execute_block_range_parallel(benchmark::State& state) {
+    execute_block_range(state, /*parallel=*/true);
+}
+BENCHMARK(execute_block_range_parallel)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+
+}  // namespace silkworm
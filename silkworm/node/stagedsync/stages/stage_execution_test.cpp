@@ -0,0 +1,136 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <bit>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/chain/config.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/execution/processor.hpp>
+#include <silkworm/core/types/address.hpp>
+#include <silkworm/infra/concurrency/thread_pool.hpp>
+#include <silkworm/infra/test_util/log.hpp>
+#include <silkworm/node/db/buffer.hpp>
+#include <silkworm/node/stagedsync/stages/stage_execution.hpp>
+#include <silkworm/node/test/context.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Parallel execution reading state from MDBX") {
+    test_util::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+    db::RWTxn& txn{context.rw_txn()};
+
+    const std::vector<evmc::address> senders{
+        0x4bf2054ffae7a454a35fd8cf4be21b23b1f25a6f_address,
+        0x5a0b54d5dc17e0aadc383d2db43b0a0d3e029c4c_address,
+        0x834e9b529ac9fa63b39a06f8d8c9b0d6791fa5df_address,
+        0xb685342b8c54347aad148e1f22eff3eb3eb29391_address,
+    };
+    const std::vector<evmc::address> recipients{
+        0xee098e6c2a43d9e2c04f08f0c3a87b0ba59079d5_address,
+        0x2a65aca4d5fc5b5c859090a6c34d164135398226_address,
+        0x61c808d82a3ac53231750dadc13c777b59310bd9_address,
+    };
+    const evmc::address contract{0x6d20c1c07e56b7098eb8c50ee03ba0f6f498a91d_address};
+
+    // Stores the first word of the call data into the 0th storage slot
+    const Bytes code{*from_hex("600035600055")};
+    const evmc::bytes32 code_hash{std::bit_cast<evmc_bytes32>(keccak256(code))};
+
+    // Persist the initial state, so that speculative executions must read it from the db
+    db::Buffer initial_buffer{txn, 0};
+    initial_buffer.begin_block(0);
+    for (const auto& sender : senders) {
+        initial_buffer.update_account(sender, std::nullopt, Account{.balance = kEther});
+    }
+    initial_buffer.update_account(contract, std::nullopt, Account{.code_hash = code_hash, .incarnation = kDefaultIncarnation});
+    initial_buffer.update_account_code(contract, kDefaultIncarnation, code_hash, code);
+    initial_buffer.write_to_db();
+    context.commit_and_renew_txn();
+
+    Block block{};
+    block.header.number = 1;
+    block.header.gas_limit = 5'000'000;
+    block.header.beneficiary = 0x5a0b54d5dc17e0aadc383d2db43b0a0d3e029c4d_address;
+    for (size_t i{0}; i < senders.size(); ++i) {
+        Transaction txn{};
+        txn.max_priority_fee_per_gas = 10 * kGiga;
+        txn.max_fee_per_gas = 10 * kGiga;
+        txn.gas_limit = 100'000;
+        txn.r = 1;
+        txn.s = 1;
+        txn.from = senders[i];
+        if (i < recipients.size()) {
+            txn.to = recipients[i];
+            txn.value = 1'000 * (i + 1);
+        } else {
+            txn.to = contract;
+            txn.data = Bytes(32, '\x2a');
+        }
+        block.transactions.push_back(txn);
+    }
+
+    auto rule_set{protocol::rule_set_factory(kMainnetConfig)};
+
+    // Dry run to find out the block gas used, then serial execution as reference (nothing is persisted)
+    std::vector<Receipt> receipts;
+    db::Buffer dry_run_buffer{txn, 0};
+    ExecutionProcessor dry_run_processor{block, *rule_set, dry_run_buffer, kMainnetConfig};
+    CHECK(dry_run_processor.execute_and_write_block(receipts) == ValidationResult::kWrongBlockGas);
+    block.header.gas_used = receipts.back().cumulative_gas_used;
+
+    std::vector<Receipt> serial_receipts;
+    db::Buffer serial_buffer{txn, 0};
+    ExecutionProcessor serial_processor{block, *rule_set, serial_buffer, kMainnetConfig};
+    REQUIRE(serial_processor.execute_and_write_block(serial_receipts) == ValidationResult::kOk);
+
+    // Workers read through their own read-only txn each, the RW one being bound to this thread
+    db::ROTxnManaged read_txn{context.env()};
+    db::Buffer parallel_buffer{txn, read_txn, /*previous=*/nullptr, 0};
+    ThreadPool thread_pool{4};
+    std::vector<db::ROTxnManaged> worker_txns;
+    for (size_t w{0}; w < thread_pool.get_thread_count(); ++w) {
+        worker_txns.emplace_back(context.env());
+    }
+    const auto worker_readers{stagedsync::Execution::make_worker_readers(parallel_buffer, worker_txns)};
+    std::vector<Receipt> parallel_receipts;
+    ExecutionProcessor parallel_processor{block, *rule_set, parallel_buffer, kMainnetConfig};
+    parallel_processor.set_parallel_runner(stagedsync::Execution::make_parallel_runner(
+        thread_pool, [&](size_t worker) -> State& { return *worker_readers[worker]; }));
+    REQUIRE(parallel_processor.execute_and_write_block(parallel_receipts) == ValidationResult::kOk);
+    CHECK(parallel_processor.reexecuted_transactions() == 0);
+
+    REQUIRE(parallel_receipts.size() == serial_receipts.size());
+    for (size_t i{0}; i < serial_receipts.size(); ++i) {
+        CHECK(parallel_receipts[i].success == serial_receipts[i].success);
+        CHECK(parallel_receipts[i].cumulative_gas_used == serial_receipts[i].cumulative_gas_used);
+    }
+    for (const auto& address : senders) {
+        CHECK(parallel_buffer.read_account(address) == serial_buffer.read_account(address));
+    }
+    for (const auto& address : recipients) {
+        CHECK(parallel_buffer.read_account(address) == serial_buffer.read_account(address));
+    }
+    const evmc::bytes32 location{};
+    CHECK(parallel_buffer.read_storage(contract, kDefaultIncarnation, location) ==
+          serial_buffer.read_storage(contract, kDefaultIncarnation, location));
+    CHECK(parallel_buffer.account_changes() == serial_buffer.account_changes());
+    CHECK(parallel_buffer.storage_changes() == serial_buffer.storage_changes());
+}
+
+}  // namespace silkworm
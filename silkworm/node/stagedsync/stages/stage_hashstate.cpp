@@ -22,6 +22,7 @@
 
 #include <silkworm/core/common/bytes_to_string.hpp>
 #include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/crypto/keccak256_batch.hpp>
 #include <silkworm/core/types/address.hpp>
 #include <silkworm/core/types/evmc_bytes32.hpp>
 #include <silkworm/infra/common/decoding_exception.hpp>
@@ -187,7 +188,6 @@ Stage::Result HashState::hash_from_plainstate(db::RWTxn& txn) {
          */
 
         evmc::address last_address{};
-        ethash_hash256 address_hash{keccak256(last_address.bytes)};  // We might have all zeroed addresses ?
 
         std::unique_lock log_lck(log_mtx_);
         current_source_ = std::string(db::table::kPlainState.name);
@@ -200,16 +200,73 @@ Stage::Result HashState::hash_from_plainstate(db::RWTxn& txn) {
         // + Location hash (32 bytes)
         Bytes etl_storage_entry_key(72, '\0');
 
+        // Addresses and storage locations are hashed in batches, entries are collected only when the batch is full
+        // because the collector sorts them anyway
+        static constexpr size_t kBatchSize{128};
+        struct PendingStorage {
+            size_t address_index{0};
+            uint64_t incarnation{0};
+            Bytes value;  // Location + zeroless Value
+        };
+        std::vector<evmc::address> pending_addresses;
+        std::vector<std::pair<size_t, Bytes>> pending_accounts;  // Address index + Account encoded for storage
+        std::vector<PendingStorage> pending_storage;
+        std::vector<ByteView> inputs;
+        std::vector<evmc::bytes32> address_hashes(kBatchSize);
+        std::vector<evmc::bytes32> location_hashes(kBatchSize);
+        pending_addresses.reserve(kBatchSize);
+        pending_storage.reserve(kBatchSize);
+        inputs.reserve(kBatchSize);
+
+        auto flush_batch = [&]() {
+            inputs.clear();
+            for (const auto& address : pending_addresses) {
+                inputs.emplace_back(address.bytes, kAddressLength);
+            }
+            keccak256_batch(inputs, address_hashes);
+            inputs.clear();
+            for (const auto& storage : pending_storage) {
+                inputs.emplace_back(ByteView{storage.value}.substr(0, kHashLength));
+            }
+            keccak256_batch(inputs, location_hashes);
+
+            for (auto& [address_index, value] : pending_accounts) {
+                etl::Entry entry{Bytes(address_hashes[address_index].bytes, kHashLength), std::move(value)};
+                collector_->collect(std::move(entry));
+            }
+            for (size_t i{0}; i < pending_storage.size(); ++i) {
+                const auto& storage{pending_storage[i]};
+                std::memcpy(&etl_storage_entry_key[0], address_hashes[storage.address_index].bytes, kHashLength);
+                endian::store_big_u64(&etl_storage_entry_key[kHashLength], storage.incarnation);
+                std::memcpy(&etl_storage_entry_key[kHashLength + db::kIncarnationLength], location_hashes[i].bytes,
+                            kHashLength);
+                etl::Entry entry{etl_storage_entry_key, storage.value.substr(kHashLength)};
+                collector_->collect(std::move(entry));
+            }
+            pending_addresses.clear();
+            pending_accounts.clear();
+            pending_storage.clear();
+        };
+
+        // Index in the current batch of the address being hashed, added to the batch if not there yet
+        auto last_address_index = [&]() -> size_t {
+            if (pending_addresses.empty() || pending_addresses.back() != last_address) {
+                if (pending_addresses.size() == kBatchSize) {
+                    flush_batch();
+                }
+                pending_addresses.push_back(last_address);
+            }
+            return pending_addresses.size() - 1;
+        };
+
         // Hash accounts
         while (data) {
             auto data_key_view{db::from_slice(data.key)};
 
             // We're reading PlainState which keys are ordered by address (always initial 20 bytes of key)
-            // Rehash the address only when changes
             if (std::memcmp(data_key_view.data(), last_address.bytes, kAddressLength) != 0) {
                 throw_if_stopping();
                 last_address = bytes_to_address(data_key_view);
-                address_hash = keccak256(last_address.bytes);
                 log_lck.lock();
                 current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
                 log_lck.unlock();
@@ -224,23 +281,18 @@ Stage::Result HashState::hash_from_plainstate(db::RWTxn& txn) {
                     throw StageError(Stage::Result::kUnexpectedError, what);
                 }
 
-                etl::Entry entry{Bytes(address_hash.bytes, kHashLength), Bytes{db::from_slice(data.value)}};
-                collector_->collect(std::move(entry));
+                const size_t address_index{last_address_index()};
+                pending_accounts.emplace_back(address_index, Bytes{db::from_slice(data.value)});
 
             } else if (data.key.length() == db::kPlainStoragePrefixLength) {
                 // Hash storage
                 // data.key           == Address + Incarnation
                 // data.value (multi) == Location + zeroless Value
-
-                // See above for allocation
-                std::memcpy(&etl_storage_entry_key[0], address_hash.bytes, kHashLength);
-                std::memcpy(&etl_storage_entry_key[kHashLength], &data_key_view[kAddressLength],
-                            db::kIncarnationLength);
+                const auto incarnation{endian::load_big_u64(&data_key_view[kAddressLength])};
 
                 // Iterate dupkeys only to avoid re-hashing of same address
                 while (data) {
                     if (!(data.value.length() > kHashLength)) {
-                        const auto incarnation{endian::load_big_u64(&data_key_view[kAddressLength])};
                         const std::string what("Unexpected empty value in PlainState for Account " + current_key_ +
                                                " incarnation " + std::to_string(incarnation));
                         throw StageError(Stage::Result::kUnexpectedError, what);
@@ -255,12 +307,11 @@ Stage::Result HashState::hash_from_plainstate(db::RWTxn& txn) {
                      * part of the db record. This way we can reliably insert records using MDBX_APPENDDUP
                      */
 
-                    auto data_value_view{db::from_slice(data.value)};
-                    std::memcpy(&etl_storage_entry_key[kHashLength + db::kIncarnationLength],
-                                keccak256(data_value_view.substr(0, kHashLength)).bytes, kHashLength);
-                    data_value_view.remove_prefix(kHashLength);
-                    etl::Entry entry{etl_storage_entry_key, Bytes{data_value_view}};
-                    collector_->collect(std::move(entry));
+                    if (pending_storage.size() == kBatchSize) {
+                        flush_batch();
+                    }
+                    const size_t address_index{last_address_index()};
+                    pending_storage.push_back({address_index, incarnation, Bytes{db::from_slice(data.value)}});
                     data = source->to_current_next_multi(false);
                 }
 
@@ -271,6 +322,7 @@ Stage::Result HashState::hash_from_plainstate(db::RWTxn& txn) {
 
             data = source->to_next(/*throw_notfound=*/false);
         }
+        flush_batch();
 
         throw_if_stopping();
 
@@ -452,7 +452,9 @@ Stage::Result InterHashes::regenerate_intermediate_hashes(db::RWTxn& txn, const
                                                           storage_collector_.get());
         log_lck.unlock();
 
-        const evmc::bytes32 computed_root{trie_loader_->calculate_root()};
+        // Subtrie workers use their own read transactions so they can only see committed data
+        const size_t num_threads{txn.commit_disabled() ? 1 : node_settings_->trie_regeneration_threads};
+        const evmc::bytes32 computed_root{trie_loader_->calculate_root_parallel(num_threads)};
 
         // Fail if not what expected
         if (expected_root != nullptr && computed_root != *expected_root) {
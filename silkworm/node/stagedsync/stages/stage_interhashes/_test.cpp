@@ -875,4 +875,61 @@ TEST_CASE("Trie Storage : incremental vs regeneration") {
     REQUIRE(fused_nodes == incremental_nodes);
 }
 
+TEST_CASE("Trie : parallel vs sequential regeneration") {
+    test::Context context;
+    auto& txn{context.rw_txn()};
+
+    static constexpr size_t n{5'000};
+    static constexpr auto code_hash{0x5be74cad16203c4905c068b012a2e9fb6d19d036c410f16fd177f337541440dd_bytes32};
+
+    {
+        db::PooledCursor hashed_accounts{txn, db::table::kHashedAccounts};
+        db::PooledCursor hashed_storage{txn, db::table::kHashedStorage};
+
+        // Every tenth account is a contract holding some storage
+        for (size_t i{0}; i < n; ++i) {
+            const evmc::address address{int_to_address(i)};
+            const auto hash{keccak256(address)};
+            if (i % 10 == 0) {
+                const Account contract{0, 1 * kEther, code_hash, kDefaultIncarnation};
+                hashed_accounts.upsert(db::to_slice(hash.bytes), db::to_slice(contract.encode_for_storage()));
+                const Bytes storage_key{db::storage_prefix(hash.bytes, kDefaultIncarnation)};
+                for (size_t j{0}; j <= i % 70; ++j) {
+                    const auto location{keccak256(int_to_address(j))};
+                    db::upsert_storage_value(hashed_storage, storage_key, location.bytes, *from_hex("0x42"));
+                }
+            } else {
+                const Account eoa{i, 1 * kEther};
+                hashed_accounts.upsert(db::to_slice(hash.bytes), db::to_slice(eoa.encode_for_storage()));
+            }
+        }
+    }
+    // Subtrie workers only see committed data
+    context.commit_and_renew_txn();
+
+    const auto regenerate = [&](size_t num_threads) {
+        txn->clear_map(db::open_map(txn, db::table::kTrieOfAccounts));
+        txn->clear_map(db::open_map(txn, db::table::kTrieOfStorage));
+        context.commit_and_renew_txn();
+
+        etl::Collector account_trie_node_collector{context.dir().etl().path()};
+        etl::Collector storage_trie_node_collector{context.dir().etl().path()};
+        TrieLoader trie_loader(txn, nullptr, nullptr, &account_trie_node_collector, &storage_trie_node_collector);
+        const auto root{trie_loader.calculate_root_parallel(num_threads)};
+
+        db::PooledCursor account_trie(txn, db::table::kTrieOfAccounts);
+        account_trie_node_collector.load(account_trie, nullptr, MDBX_put_flags_t::MDBX_APPEND);
+        db::PooledCursor storage_trie(txn, db::table::kTrieOfStorage);
+        storage_trie_node_collector.load(storage_trie, nullptr, MDBX_put_flags_t::MDBX_APPEND);
+        return std::make_tuple(root, read_all_nodes(account_trie), read_all_nodes(storage_trie));
+    };
+
+    const auto [sequential_root, sequential_account_nodes, sequential_storage_nodes]{regenerate(1)};
+    const auto [parallel_root, parallel_account_nodes, parallel_storage_nodes]{regenerate(4)};
+
+    REQUIRE(to_hex(parallel_root.bytes, true) == to_hex(sequential_root.bytes, true));
+    CHECK(parallel_account_nodes == sequential_account_nodes);
+    CHECK(parallel_storage_nodes == sequential_storage_nodes);
+}
+
 }  // namespace silkworm::trie
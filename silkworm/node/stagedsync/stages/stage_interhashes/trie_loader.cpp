@@ -16,12 +16,16 @@
 
 #include "trie_loader.hpp"
 
+#include <algorithm>
+#include <future>
 #include <stdexcept>
+#include <vector>
 
 #include <silkworm/core/trie/nibbles.hpp>
 #include <silkworm/core/types/account.hpp>
 #include <silkworm/infra/common/decoding_exception.hpp>
 #include <silkworm/infra/concurrency/signal_handler.hpp>
+#include <silkworm/infra/concurrency/thread_pool.hpp>
 #include <silkworm/node/db/tables.hpp>
 
 namespace silkworm::trie {
@@ -143,12 +147,155 @@ evmc::bytes32 TrieLoader::calculate_root() {
     return root_hash;
 }
 
+evmc::bytes32 TrieLoader::calculate_root_parallel(size_t num_threads) {
+    if (account_changes_) {
+        throw std::logic_error("TrieLoader parallel root calculation requires full regeneration");
+    }
+    if (!txn_.ro_cursor(db::table::kTrieOfAccounts)->empty() || !txn_.ro_cursor(db::table::kTrieOfStorage)->empty()) {
+        throw std::domain_error(" full regeneration detected but either " +
+                                std::string(db::table::kTrieOfAccounts.name) + " or " +
+                                std::string(db::table::kTrieOfStorage.name) + " aren't empty");
+    }
+
+    // Find the subtries actually holding accounts
+    std::vector<uint8_t> nibbles;
+    auto hashed_accounts = txn_.ro_cursor(db::table::kHashedAccounts);
+    for (uint8_t nibble{0}; nibble < 0x10; ++nibble) {
+        const Bytes seek_key(1, static_cast<uint8_t>(nibble << 4));
+        const auto data{hashed_accounts->lower_bound(db::to_slice(seek_key), false)};
+        if (data && (db::from_slice(data.key)[0] >> 4) == nibble) {
+            nibbles.push_back(nibble);
+        }
+    }
+
+    // Unless the root is a branch node there's nothing to split
+    if (num_threads < 2 || nibbles.size() < 2) {
+        return calculate_root();
+    }
+
+    std::atomic_bool cancelled{false};
+    std::vector<std::future<Subtrie>> subtries;
+    subtries.reserve(nibbles.size());
+    ThreadPool workers{static_cast<unsigned>(std::min(num_threads, nibbles.size()))};
+    for (const uint8_t nibble : nibbles) {
+        subtries.push_back(workers.submit([this, env = txn_.db(), nibble, &cancelled]() {
+            return calculate_subtrie(env, nibble, cancelled);
+        }));
+    }
+
+    HashBuilder account_hash_builder;
+    account_hash_builder.node_collector = [&](ByteView nibbled_key, const trie::Node& node) {
+        Bytes value{node.state_mask() ? node.encode_for_storage() : Bytes{}};  // Node with no state should be deleted
+        std::scoped_lock lock{collectors_mtx_};
+        account_trie_node_collector_->collect({Bytes{nibbled_key}, value});
+    };
+
+    // Subtries are combined in nibble order as soon as they're available
+    try {
+        for (auto& subtrie : subtries) {
+            account_hash_builder.add_subtrie(subtrie.get());
+        }
+    } catch (...) {
+        cancelled = true;  // Pending workers bail out and get joined by pool destructor
+        throw;
+    }
+
+    auto root_hash{account_hash_builder.root_hash()};
+    account_hash_builder.reset();
+    return root_hash;
+}
+
+Subtrie TrieLoader::calculate_subtrie(mdbx::env env, uint8_t nibble, const std::atomic_bool& cancelled) {
+    using namespace std::chrono_literals;
+    auto log_time{std::chrono::steady_clock::now()};
+
+    db::ROTxnManaged txn{env};
+    auto hashed_accounts = txn.ro_cursor(db::table::kHashedAccounts);
+    auto hashed_storage = txn.ro_cursor_dup_sort(db::table::kHashedStorage);
+    auto trie_storage = txn.ro_cursor(db::table::kTrieOfStorage);
+
+    // Nodes are handed over to the shared collectors in batches to keep contention low
+    static constexpr size_t kNodesBatchSize{4096};
+    std::vector<etl::Entry> account_nodes;
+    std::vector<etl::Entry> storage_nodes;
+    auto flush_nodes = [this](std::vector<etl::Entry>& nodes, etl::Collector& collector) {
+        std::scoped_lock lock{collectors_mtx_};
+        for (auto& entry : nodes) {
+            collector.collect(std::move(entry));
+        }
+        nodes.clear();
+    };
+
+    Bytes storage_prefix_buffer{};
+    storage_prefix_buffer.reserve(db::kHashedStoragePrefixLength);
+
+    HashBuilder account_hash_builder;
+    account_hash_builder.node_collector = [&](ByteView nibbled_key, const trie::Node& node) {
+        Bytes value{node.state_mask() ? node.encode_for_storage() : Bytes{}};  // Node with no state should be deleted
+        account_nodes.push_back({Bytes{nibbled_key}, std::move(value)});
+        if (account_nodes.size() == kNodesBatchSize) {
+            flush_nodes(account_nodes, *account_trie_node_collector_);
+        }
+    };
+
+    HashBuilder storage_hash_builder;
+    storage_hash_builder.node_collector = [&](ByteView nibbled_key, const trie::Node& node) {
+        Bytes key{storage_prefix_buffer};
+        key.append(nibbled_key);
+        Bytes value{node.state_mask() ? node.encode_for_storage() : Bytes{}};  // Node with no state should be deleted
+        storage_nodes.push_back({std::move(key), std::move(value)});
+        if (storage_nodes.size() == kNodesBatchSize) {
+            flush_nodes(storage_nodes, *storage_trie_node_collector_);
+        }
+    };
+
+    // Storage trie is empty on full regeneration, the cursor only drives the scan of hashed storage
+    TrieCursor trie_storage_cursor(*trie_storage, nullptr);
+
+    const Bytes seek_key(1, static_cast<uint8_t>(nibble << 4));
+    auto hashed_account_data{hashed_accounts->lower_bound(db::to_slice(seek_key), false)};
+    while (hashed_account_data) {
+        auto hashed_account_data_key_view{db::from_slice(hashed_account_data.key)};
+        if ((hashed_account_data_key_view[0] >> 4) != nibble) {
+            break;
+        }
+
+        if (const auto now{std::chrono::steady_clock::now()}; log_time <= now) {
+            SignalHandler::throw_if_signalled();
+            if (cancelled) {
+                throw std::runtime_error("subtrie calculation cancelled");
+            }
+            std::unique_lock log_lck(log_mtx_);
+            log_key_ = to_hex(hashed_account_data_key_view, true);
+            log_time = now + 2s;
+        }
+
+        const auto account{Account::from_encoded_storage(db::from_slice(hashed_account_data.value))};
+        success_or_throw(account);
+
+        evmc::bytes32 storage_root{kEmptyRoot};
+        if (account->incarnation) {
+            storage_prefix_buffer.assign(db::storage_prefix(hashed_account_data_key_view, account->incarnation));
+            storage_root = calculate_storage_root(trie_storage_cursor, storage_hash_builder, *hashed_storage,
+                                                  storage_prefix_buffer);
+        }
+
+        account_hash_builder.add_leaf(unpack_nibbles(hashed_account_data_key_view), account->rlp(storage_root));
+        hashed_account_data = hashed_accounts->to_next(false);
+    }
+
+    Subtrie subtrie{account_hash_builder.finalize_subtrie()};
+    flush_nodes(account_nodes, *account_trie_node_collector_);
+    flush_nodes(storage_nodes, *storage_trie_node_collector_);
+    return subtrie;
+}
+
 evmc::bytes32 TrieLoader::calculate_storage_root(TrieCursor& trie_storage_cursor, HashBuilder& storage_hash_builder,
                                                  db::ROCursorDupSort& hashed_storage, const Bytes& db_storage_prefix) {
     using namespace std::chrono_literals;
     auto log_time{std::chrono::steady_clock::now()};
 
-    static Bytes rlp_buffer{};
+    thread_local Bytes rlp_buffer{};
 
     const auto db_storage_prefix_slice{db::to_slice(db_storage_prefix)};
     auto trie_storage_data{trie_storage_cursor.to_prefix(db_storage_prefix)};
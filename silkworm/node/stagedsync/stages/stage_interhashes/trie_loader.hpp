@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include <silkworm/core/trie/hash_builder.hpp>
 #include <silkworm/core/trie/prefix_set.hpp>
 #include <silkworm/node/db/mdbx.hpp>
@@ -35,6 +38,13 @@ class TrieLoader {
     //! \remark May throw
     [[nodiscard]] evmc::bytes32 calculate_root();
 
+    //! \brief Same as calculate_root() for full regeneration only, splitting the accounts trie by the first nibble of
+    //! hashed keys into up to 16 subtries which are built concurrently, storage tries included
+    //! \details Each worker reads through its own read-only transaction, hence all data in txn must be committed.
+    //! Computed hash and collected nodes are identical to the ones of calculate_root()
+    //! \remark May throw
+    [[nodiscard]] evmc::bytes32 calculate_root_parallel(size_t num_threads);
+
     //! \brief Returns the hex representation of current load key (for progress tracking)
     [[nodiscard]] std::string get_log_key() const {
         std::unique_lock l{log_mtx_};
@@ -50,6 +60,10 @@ class TrieLoader {
 
     std::string log_key_{};         // To export logging key
     mutable std::mutex log_mtx_{};  // Guards async logging
+    std::mutex collectors_mtx_{};   // Guards node collectors against concurrent subtrie workers
+
+    //! \brief Builds the subtrie of accounts whose hashed key starts with the given nibble
+    [[nodiscard]] Subtrie calculate_subtrie(mdbx::env env, uint8_t nibble, const std::atomic_bool& cancelled);
 
     //! \brief (re)calculates storage root hash on behalf of collected hashed changes and existing data in
     //! TrieOfStorage bucket
@@ -16,11 +16,13 @@
 
 #include "stage_tx_lookup.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <magic_enum.hpp>
 
 #include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/crypto/keccak256_batch.hpp>
 #include <silkworm/node/db/access_layer.hpp>
 
 namespace silkworm::stagedsync {
@@ -202,9 +204,12 @@ Stage::Result TxLookup::prune(db::RWTxn& txn) {
         }
 
         if (!prune_progress || prune_progress < forward_progress) {
+            // Frozen txs have no TxLookup entries (see Freezer::prune), so we must start after max frozen block here
             const auto previous_prune_threshold{
-                node_settings_->prune_mode->tx_index().value_from_head(prune_progress)};
-            prune_impl(txn, previous_prune_threshold, prune_threshold);
+                std::max(node_settings_->prune_mode->tx_index().value_from_head(prune_progress),
+                         db::DataModel::highest_frozen_block_number())};
+            if (previous_prune_threshold < prune_threshold)
+                prune_impl(txn, previous_prune_threshold, prune_threshold);
         }
 
         reset_log_progress();
@@ -341,6 +346,8 @@ void TxLookup::collect_transaction_hashes_from_canonical_bodies(db::RWTxn& txn,
     BlockNum start_block_num{std::min(from, to) + 1};
 
     Bytes etl_value{};
+    std::vector<ByteView> rlp_views;
+    std::vector<evmc::bytes32> transaction_hashes;
 
     for (BlockNum current_block_num = start_block_num; current_block_num <= target_block_num; ++current_block_num) {
         auto current_hash = db::read_canonical_hash(txn, current_block_num);
@@ -369,9 +376,11 @@ void TxLookup::collect_transaction_hashes_from_canonical_bodies(db::RWTxn& txn,
             etl_value.assign(zeroless_view(block_num_as_bytes));
         }
 
-        for (auto& rlp_encoded_tx : rlp_encoded_txs) {
-            // Hash transaction rlp
-            auto transaction_hash = keccak256(rlp_encoded_tx);  // see Transaction::hash()
+        // Hash all transaction rlps of the block at once (see Transaction::hash())
+        rlp_views.assign(rlp_encoded_txs.begin(), rlp_encoded_txs.end());
+        transaction_hashes.resize(rlp_views.size());
+        keccak256_batch(rlp_views, transaction_hashes);
+        for (const auto& transaction_hash : transaction_hashes) {
             collector_->collect({Bytes(transaction_hash.bytes, kHashLength), etl_value});
         }
     }
@@ -848,12 +848,12 @@ Task<void> EthereumRpcApi::handle_eth_get_raw_transaction_by_block_number_and_in
 }
 
 // https://eth.wiki/json-rpc/API#eth_gettransactionreceipt
-Task<void> EthereumRpcApi::handle_eth_get_transaction_receipt(const nlohmann::json& request, nlohmann::json& reply) {
+Task<void> EthereumRpcApi::handle_eth_get_transaction_receipt(const nlohmann::json& request, std::string& reply) {
     auto params = request["params"];
     if (params.size() != 1) {
         auto error_msg = "invalid eth_getTransactionReceipt params: " + params.dump();
         SILK_ERROR << error_msg;
-        reply = make_json_error(request, 100, error_msg);
+        make_glaze_json_error(request, 100, error_msg, reply);
         co_return;
     }
     auto transaction_hash = params[0].get<evmc::bytes32>();
@@ -866,7 +866,7 @@ Task<void> EthereumRpcApi::handle_eth_get_transaction_receipt(const nlohmann::js
 
         const auto block_with_hash = co_await core::read_block_by_transaction_hash(*block_cache_, *chain_storage, transaction_hash);
         if (!block_with_hash) {
-            reply = make_json_content(request, {});
+            make_glaze_json_null_content(request, reply);
             co_await tx->close();  // RAII not (yet) available with coroutines
             co_return;
         }
@@ -893,15 +893,15 @@ Task<void> EthereumRpcApi::handle_eth_get_transaction_receipt(const nlohmann::js
         if (!tx_index) {
             throw std::invalid_argument{"Unexpected transaction index in handle_eth_get_transaction_receipt"};
         }
-        reply = make_json_content(request, receipts[*tx_index]);
+        make_glaze_json_content(request, receipts[*tx_index], reply);
     } catch (const std::invalid_argument& iv) {
-        reply = make_json_content(request, {});
+        make_glaze_json_null_content(request, reply);
     } catch (const std::exception& e) {
         SILK_ERROR << "exception: " << e.what() << " processing request: " << request.dump();
-        reply = make_json_content(request, {});
+        make_glaze_json_null_content(request, reply);
     } catch (...) {
         SILK_ERROR << "unexpected exception processing request: " << request.dump();
-        reply = make_json_error(request, 100, "unexpected exception");
+        make_glaze_json_error(request, 100, "unexpected exception", reply);
     }
 
     co_await tx->close();  // RAII not (yet) available with coroutines
@@ -1455,9 +1455,10 @@ Task<void> EthereumRpcApi::handle_eth_call_bundle(const nlohmann::json& request,
 
         silkworm::Bytes hash_data{};
 
+        const auto txs_with_block = co_await core::read_transactions_by_hash(*block_cache_, *chain_storage, tx_hash_list);
         for (std::size_t i{0}; i < tx_hash_list.size(); i++) {
             struct CallBundleTxInfo tx_info {};
-            const auto tx_with_block = co_await core::read_transaction_by_hash(*block_cache_, *chain_storage, tx_hash_list[i]);
+            const auto& tx_with_block = txs_with_block[i];
             if (!tx_with_block) {
                 const auto error_msg = "invalid transaction hash";
                 SILK_ERROR << error_msg;
@@ -2065,41 +2066,15 @@ Task<void> EthereumRpcApi::handle_eth_submit_work(const nlohmann::json& request,
 
 // https://eth.wiki/json-rpc/API#eth_subscribe
 Task<void> EthereumRpcApi::handle_eth_subscribe(const nlohmann::json& request, nlohmann::json& reply) {
-    auto tx = co_await database_->begin();
-
-    try {
-        ethdb::TransactionDatabase tx_database{*tx};
-
-        reply = make_json_content(request, to_quantity(0));
-    } catch (const std::exception& e) {
-        SILK_ERROR << "exception: " << e.what() << " processing request: " << request.dump();
-        reply = make_json_error(request, 100, e.what());
-    } catch (...) {
-        SILK_ERROR << "unexpected exception processing request: " << request.dump();
-        reply = make_json_error(request, 100, "unexpected exception");
-    }
-
-    co_await tx->close();  // RAII not (yet) available with coroutines
+    // Subscriptions are served by WebSocket connections, which handle this method on their own
+    reply = make_json_error(request, -32601, "notifications not supported, use WebSocket");
     co_return;
 }
 
 // https://eth.wiki/json-rpc/API#eth_unsubscribe
 Task<void> EthereumRpcApi::handle_eth_unsubscribe(const nlohmann::json& request, nlohmann::json& reply) {
-    auto tx = co_await database_->begin();
-
-    try {
-        ethdb::TransactionDatabase tx_database{*tx};
-
-        reply = make_json_content(request, to_quantity(0));
-    } catch (const std::exception& e) {
-        SILK_ERROR << "exception: " << e.what() << " processing request: " << request.dump();
-        reply = make_json_error(request, 100, e.what());
-    } catch (...) {
-        SILK_ERROR << "unexpected exception processing request: " << request.dump();
-        reply = make_json_error(request, 100, "unexpected exception");
-    }
-
-    co_await tx->close();  // RAII not (yet) available with coroutines
+    // Subscriptions are served by WebSocket connections, which handle this method on their own
+    reply = make_json_error(request, -32601, "notifications not supported, use WebSocket");
     co_return;
 }
 
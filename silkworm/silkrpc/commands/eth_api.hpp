@@ -83,7 +83,6 @@ class EthereumRpcApi {
     Task<void> handle_eth_get_raw_transaction_by_hash(const nlohmann::json& request, nlohmann::json& reply);
     Task<void> handle_eth_get_raw_transaction_by_block_hash_and_index(const nlohmann::json& request, nlohmann::json& reply);
     Task<void> handle_eth_get_raw_transaction_by_block_number_and_index(const nlohmann::json& request, nlohmann::json& reply);
-    Task<void> handle_eth_get_transaction_receipt(const nlohmann::json& request, nlohmann::json& reply);
     Task<void> handle_eth_estimate_gas(const nlohmann::json& request, nlohmann::json& reply);
     Task<void> handle_eth_get_balance(const nlohmann::json& request, nlohmann::json& reply);
     Task<void> handle_eth_get_code(const nlohmann::json& request, nlohmann::json& reply);
@@ -115,6 +114,7 @@ class EthereumRpcApi {
 
     // GLAZE format routine
     Task<void> handle_eth_get_logs(const nlohmann::json& request, std::string& reply);
+    Task<void> handle_eth_get_transaction_receipt(const nlohmann::json& request, std::string& reply);
     Task<void> handle_eth_call(const nlohmann::json& request, std::string& reply);
     Task<void> handle_eth_get_block_by_number(const nlohmann::json& request, std::string& reply);
     Task<void> handle_eth_get_block_by_hash(const nlohmann::json& request, std::string& reply);
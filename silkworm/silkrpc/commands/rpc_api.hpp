@@ -68,6 +68,9 @@ class RpcApi : protected EthereumRpcApi,
 
     ~RpcApi() override = default;
 
+    //! The pool of worker threads shared by all the APIs
+    boost::asio::thread_pool& workers() { return EthereumRpcApi::workers_; }
+
     RpcApi(const RpcApi&) = delete;
     RpcApi& operator=(const RpcApi&) = delete;
 
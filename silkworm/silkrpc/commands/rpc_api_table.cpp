@@ -132,7 +132,6 @@ void RpcApiTable::add_eth_handlers() {
     method_handlers_[http::method::k_eth_getRawTransactionByHash] = &commands::RpcApi::handle_eth_get_raw_transaction_by_hash;
     method_handlers_[http::method::k_eth_getRawTransactionByBlockHashAndIndex] = &commands::RpcApi::handle_eth_get_raw_transaction_by_block_hash_and_index;
     method_handlers_[http::method::k_eth_getRawTransactionByBlockNumberAndIndex] = &commands::RpcApi::handle_eth_get_raw_transaction_by_block_number_and_index;
-    method_handlers_[http::method::k_eth_getTransactionReceipt] = &commands::RpcApi::handle_eth_get_transaction_receipt;
     method_handlers_[http::method::k_eth_estimateGas] = &commands::RpcApi::handle_eth_estimate_gas;
     method_handlers_[http::method::k_eth_getBalance] = &commands::RpcApi::handle_eth_get_balance;
     method_handlers_[http::method::k_eth_getCode] = &commands::RpcApi::handle_eth_get_code;
@@ -166,6 +165,7 @@ void RpcApiTable::add_eth_handlers() {
 
     // GLAZE methods
     method_handlers_glaze_[http::method::k_eth_getLogs] = &commands::RpcApi::handle_eth_get_logs;
+    method_handlers_glaze_[http::method::k_eth_getTransactionReceipt] = &commands::RpcApi::handle_eth_get_transaction_receipt;
     method_handlers_glaze_[http::method::k_eth_call] = &commands::RpcApi::handle_eth_call;
     method_handlers_glaze_[http::method::k_eth_getBlockByNumber] = &commands::RpcApi::handle_eth_get_block_by_number;
     method_handlers_glaze_[http::method::k_eth_getBlockByHash] = &commands::RpcApi::handle_eth_get_block_by_hash;
@@ -157,6 +157,69 @@ TEST_CASE("rpc_api io (individual)", "[silkrpc][rpc_api][ignore]") {
         CHECK(nlohmann::json::parse(reply.content) == R"({"jsonrpc":"2.0","id":1,"result":"0xf8678084342770c182520894658bdf435d810c91414ec09147daa6db624063798203e880820a95a0af5fc351b9e457a31f37c84e5cd99dd3c5de60af3de33c6f4160177a2c786a60a0201da7a21046af55837330a2c52fc1543cd4d9ead00ddf178dd96935b607ff9b"})"_json);
     }
 }
+
+TEST_CASE("rpc_api glaze request envelope", "[silkrpc][rpc_api]") {
+    test_util::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    auto context = test::TestDatabaseContext();
+    test::RpcApiTestBase<test::RequestHandler_ForTest> test_base{context.db};
+
+    // Requests for glaze handlers parsed from their envelope get the same reply as those parsed into a DOM
+    for (const auto* request : {R"({"jsonrpc":"2.0","id":1,"method":"eth_getBlockByNumber","params":["0x1",true]})",
+                                R"({"jsonrpc":"2.0","id":"a","method":"eth_getBlockByNumber","params":["0x2",false]})",
+                                R"({"jsonrpc":"2.0","id":null,"method":"eth_getBlockByNumber","params":["0x1"]})"}) {
+        http::Reply envelope_reply;
+        test_base.run<&test::RequestHandler_ForTest::handle_request>(std::string{request}, envelope_reply);
+        http::Reply dom_reply;
+        test_base.run<&test::RequestHandler_ForTest::request_and_create_reply>(nlohmann::json::parse(request), dom_reply);
+        CHECK(envelope_reply.status == dom_reply.status);
+        CHECK(nlohmann::json::parse(envelope_reply.content) == nlohmann::json::parse(dom_reply.content));
+    }
+
+    SECTION("invalid request left to the full parser") {
+        http::Reply reply;
+        test_base.run<&test::RequestHandler_ForTest::handle_request>(std::string{R"({"jsonrpc":"1.0","id":1,"method":"eth_getBlockByNumber","params":["0x1",true]})"}, reply);
+        CHECK(reply.status == http::StatusType::bad_request);
+    }
+}
+
+TEST_CASE("rpc_api batch", "[silkrpc][rpc_api]") {
+    test_util::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    auto context = test::TestDatabaseContext();
+    test::RpcApiTestBase<test::RequestHandler_ForTest> test_base{context.db, /*num_workers=*/4};
+
+    std::string batch_request{"["};
+    for (int id{0}; id < 20; ++id) {
+        if (id > 0) batch_request += ",";
+        const auto* method{id % 2 == 0 ? "eth_blockNumber" : "eth_chainId"};
+        batch_request += R"({"jsonrpc":"2.0","id":)" + std::to_string(id) + R"(,"method":")" + method + R"(","params":[]})";
+    }
+    batch_request += R"(,{"jsonrpc":"2.0","id":20,"foo":"bar"}])";
+
+    SECTION("replies in request order") {
+        for (const std::size_t concurrency : {1u, 4u, 32u}) {
+            test_base.batch_settings.max_concurrency = concurrency;
+            http::Reply reply;
+            test_base.run<&test::RequestHandler_ForTest::handle_request>(batch_request, reply);
+            CHECK(reply.status == http::StatusType::ok);
+            const auto reply_json = nlohmann::json::parse(reply.content);
+            REQUIRE(reply_json.is_array());
+            REQUIRE(reply_json.size() == 21);
+            for (int id{0}; id < 20; ++id) {
+                CHECK(reply_json[static_cast<std::size_t>(id)]["id"] == id);
+                CHECK(reply_json[static_cast<std::size_t>(id)].contains("result"));
+            }
+            CHECK(reply_json[20].contains("error"));
+        }
+    }
+
+    SECTION("batch size exceeding limit") {
+        test_base.batch_settings.max_size = 20;
+        http::Reply reply;
+        test_base.run<&test::RequestHandler_ForTest::handle_request>(batch_request, reply);
+        CHECK(reply.status == http::StatusType::bad_request);
+        CHECK(nlohmann::json::parse(reply.content).contains("error"));
+    }
+}
 #endif  // SILKWORM_SANITIZE
 
 }  // namespace silkworm::rpc::commands
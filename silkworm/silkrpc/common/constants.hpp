@@ -46,6 +46,16 @@ constexpr const std::chrono::milliseconds kDefaultTimeout{10000};
 
 constexpr const std::size_t kHttpIncomingBufferSize{8192};
 
+constexpr const std::size_t kDefaultMaxBatchSize{1000};
+constexpr const std::size_t kDefaultBatchConcurrency{16};
+
+constexpr const std::size_t kDefaultCompressionThreshold{1024};
+
+constexpr const std::chrono::milliseconds kDefaultIdleTimeout{120'000};
+constexpr const std::size_t kDefaultMaxRequestsPerConnection{0};
+constexpr const std::size_t kDefaultMaxPipelinedRequests{16};
+constexpr const std::size_t kDefaultMaxRequestContentLength{32 * 1024 * 1024};
+
 constexpr const std::size_t kRequestContentInitialCapacity{1024};
 constexpr const std::size_t kRequestHeadersInitialCapacity{8};
 constexpr const std::size_t kRequestMethodInitialCapacity{64};
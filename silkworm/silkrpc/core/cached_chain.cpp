@@ -91,12 +91,8 @@ Task<std::shared_ptr<BlockWithHash>> read_block_by_transaction_hash(BlockCache&
     co_return block_by_hash;
 }
 
-Task<std::optional<TransactionWithBlock>> read_transaction_by_hash(BlockCache& cache, const ChainStorage& storage, const evmc::bytes32& transaction_hash) {
-    const auto block_number = co_await storage.read_block_number_by_transaction_hash(transaction_hash);
-    if (!block_number) {
-        co_return std::nullopt;
-    }
-    const auto block_with_hash = co_await read_block_by_number(cache, storage, *block_number);
+static Task<std::optional<TransactionWithBlock>> read_transaction_in_block(BlockCache& cache, const ChainStorage& storage, const evmc::bytes32& transaction_hash, BlockNum block_number) {
+    const auto block_with_hash = co_await read_block_by_number(cache, storage, block_number);
     if (!block_with_hash) {
         co_return std::nullopt;
     }
@@ -112,4 +108,27 @@ Task<std::optional<TransactionWithBlock>> read_transaction_by_hash(BlockCache& c
     co_return std::nullopt;
 }
 
+Task<std::optional<TransactionWithBlock>> read_transaction_by_hash(BlockCache& cache, const ChainStorage& storage, const evmc::bytes32& transaction_hash) {
+    const auto block_number = co_await storage.read_block_number_by_transaction_hash(transaction_hash);
+    if (!block_number) {
+        co_return std::nullopt;
+    }
+    co_return co_await read_transaction_in_block(cache, storage, transaction_hash, *block_number);
+}
+
+Task<std::vector<std::optional<TransactionWithBlock>>> read_transactions_by_hash(BlockCache& cache, const ChainStorage& storage, std::span<const evmc::bytes32> transaction_hashes) {
+    // Block numbers are looked up all together, so that missing ones are searched in snapshots just once
+    const auto block_numbers = co_await storage.read_block_numbers_by_transaction_hashes(transaction_hashes);
+    std::vector<std::optional<TransactionWithBlock>> transactions;
+    transactions.reserve(transaction_hashes.size());
+    for (std::size_t i{0}; i < transaction_hashes.size(); ++i) {
+        if (block_numbers[i]) {
+            transactions.push_back(co_await read_transaction_in_block(cache, storage, transaction_hashes[i], *block_numbers[i]));
+        } else {
+            transactions.emplace_back(std::nullopt);
+        }
+    }
+    co_return transactions;
+}
+
 }  // namespace silkworm::rpc::core
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <optional>
+#include <span>
+#include <vector>
+
 #include <silkworm/infra/concurrency/task.hpp>
 
 #include <evmc/evmc.hpp>
@@ -33,5 +37,6 @@ Task<std::shared_ptr<BlockWithHash>> read_block_by_hash(BlockCache& cache, const
 Task<std::shared_ptr<BlockWithHash>> read_block_by_number_or_hash(BlockCache& cache, const ChainStorage& storage, const rawdb::DatabaseReader& reader, const BlockNumberOrHash& bnoh);
 Task<std::shared_ptr<BlockWithHash>> read_block_by_transaction_hash(BlockCache& cache, const ChainStorage& storage, const evmc::bytes32& transaction_hash);
 Task<std::optional<TransactionWithBlock>> read_transaction_by_hash(BlockCache& cache, const ChainStorage& storage, const evmc::bytes32& transaction_hash);
+Task<std::vector<std::optional<TransactionWithBlock>>> read_transactions_by_hash(BlockCache& cache, const ChainStorage& storage, std::span<const evmc::bytes32> transaction_hashes);
 
 }  // namespace silkworm::rpc::core
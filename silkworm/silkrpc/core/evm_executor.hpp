@@ -69,7 +69,7 @@ class AnalysisCacheService : public ServiceBase<AnalysisCacheService> {
 
   private:
     ObjectPool<evmone::ExecutionState> state_pool_{true};
-    AnalysisCache analysis_cache_{kCacheSize, true};
+    AnalysisCache analysis_cache_{kCacheSize};
 };
 
 using Tracers = std::vector<std::shared_ptr<EvmTracer>>;
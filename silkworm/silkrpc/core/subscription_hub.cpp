@@ -0,0 +1,187 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "subscription_hub.hpp"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include <silkworm/core/types/evmc_bytes32.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/silkrpc/json/types.hpp>
+
+namespace silkworm::rpc {
+
+std::optional<SubscriptionKind> parse_subscription_kind(std::string_view name) {
+    if (name == "newHeads") {
+        return SubscriptionKind::kNewHeads;
+    }
+    if (name == "logs") {
+        return SubscriptionKind::kLogs;
+    }
+    if (name == "newPendingTransactions" || name == "pendingTransactions") {
+        return SubscriptionKind::kNewPendingTransactions;
+    }
+    return std::nullopt;
+}
+
+//! Check if the log matches the addresses and topics in the filter, following the same rules as eth_getLogs
+static bool filter_matches(const Filter& filter, const Log& log) {
+    if (!filter.addresses.empty() && std::find(filter.addresses.cbegin(), filter.addresses.cend(), log.address) == filter.addresses.cend()) {
+        return false;
+    }
+    if (filter.topics.size() > log.topics.size()) {
+        return false;
+    }
+    for (std::size_t i{0}; i < filter.topics.size(); ++i) {
+        const auto& subtopics{filter.topics[i]};
+        if (!subtopics.empty() && std::find(subtopics.cbegin(), subtopics.cend(), log.topics[i]) == subtopics.cend()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static SubscriptionHub::Generator make_default_generator() {
+    return [random_engine = std::mt19937_64{std::random_device{}()}]() mutable { return random_engine(); };
+}
+
+SubscriptionHub::SubscriptionHub(std::size_t max_subscriptions)
+    : SubscriptionHub{make_default_generator(), max_subscriptions} {}
+
+SubscriptionHub::SubscriptionHub(Generator generator, std::size_t max_subscriptions)
+    : generator_{std::move(generator)}, max_subscriptions_{max_subscriptions} {}
+
+std::optional<std::string> SubscriptionHub::subscribe(SubscriptionKind kind, const Filter& filter, const std::shared_ptr<SubscriptionSink>& sink) {
+    std::lock_guard lock{mutex_};
+
+    if (subscriptions_.size() >= max_subscriptions_) {
+        SILK_WARN << "No room available for subscriptions, max size " << max_subscriptions_ << " reached";
+        return std::nullopt;
+    }
+
+    std::string subscription_id;
+    do {
+        subscription_id = to_quantity(generator_());
+    } while (subscriptions_.contains(subscription_id));
+
+    subscriptions_.emplace(subscription_id, Subscription{kind, filter, sink, sink.get()});
+    ++subscription_counts_[static_cast<std::size_t>(kind)];
+    return subscription_id;
+}
+
+bool SubscriptionHub::unsubscribe(const std::string& subscription_id, const SubscriptionSink& sink) {
+    std::lock_guard lock{mutex_};
+
+    const auto it = subscriptions_.find(subscription_id);
+    if (it == subscriptions_.end() || it->second.owner != &sink) {
+        return false;
+    }
+    erase(it);
+    return true;
+}
+
+void SubscriptionHub::unsubscribe_all(const SubscriptionSink& sink) {
+    std::lock_guard lock{mutex_};
+
+    for (auto it = subscriptions_.begin(); it != subscriptions_.end();) {
+        if (it->second.owner == &sink) {
+            erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool SubscriptionHub::has_subscribers(SubscriptionKind kind) const {
+    std::lock_guard lock{mutex_};
+    return subscription_counts_[static_cast<std::size_t>(kind)] > 0;
+}
+
+std::size_t SubscriptionHub::size() const {
+    std::lock_guard lock{mutex_};
+    return subscriptions_.size();
+}
+
+void SubscriptionHub::publish_new_head(const BlockHeader& header) {
+    if (!has_subscribers(SubscriptionKind::kNewHeads)) return;
+
+    const nlohmann::json header_json = header;
+    const auto payload{std::make_shared<const std::string>(header_json.dump())};
+    publish(SubscriptionKind::kNewHeads, payload, [](const Subscription&) { return true; });
+}
+
+void SubscriptionHub::publish_logs(const Logs& logs) {
+    if (!has_subscribers(SubscriptionKind::kLogs)) return;
+
+    for (const auto& log : logs) {
+        SharedPayload payload;  // encoded lazily, just if at least one filter matches
+        publish(SubscriptionKind::kLogs, payload, [&](const Subscription& subscription) {
+            if (!filter_matches(subscription.filter, log)) {
+                return false;
+            }
+            if (!payload) {
+                GlazeJsonLogItem log_json;
+                make_glaze_json_log(log, log_json);
+                std::string log_content;
+                glz::write_json(log_json, log_content);
+                payload = std::make_shared<const std::string>(std::move(log_content));
+            }
+            return true;
+        });
+    }
+}
+
+void SubscriptionHub::publish_pending_transactions(const std::vector<evmc::bytes32>& tx_hashes) {
+    if (!has_subscribers(SubscriptionKind::kNewPendingTransactions)) return;
+
+    for (const auto& tx_hash : tx_hashes) {
+        const auto payload{std::make_shared<const std::string>("\"" + silkworm::to_hex(tx_hash, /*with_prefix=*/true) + "\"")};
+        publish(SubscriptionKind::kNewPendingTransactions, payload, [](const Subscription&) { return true; });
+    }
+}
+
+void SubscriptionHub::publish(SubscriptionKind kind, const SharedPayload& payload, const std::function<bool(const Subscription&)>& accept) {
+    std::lock_guard lock{mutex_};
+
+    for (auto it = subscriptions_.begin(); it != subscriptions_.end();) {
+        auto& [subscription_id, subscription] = *it;
+        if (subscription.kind != kind || !accept(subscription)) {
+            ++it;
+            continue;
+        }
+        const auto sink{subscription.sink.lock()};
+        if (!sink) {
+            SILK_DEBUG << "SubscriptionHub::publish removing subscription " << subscription_id << " of gone sink";
+            erase(it++);
+            continue;
+        }
+        if (!sink->notify(subscription_id, payload)) {
+            SILK_WARN << "SubscriptionHub::publish notification dropped for slow subscription " << subscription_id;
+        }
+        ++it;
+    }
+}
+
+void SubscriptionHub::erase(std::map<std::string, Subscription>::iterator it) {
+    --subscription_counts_[static_cast<std::size_t>(it->second.kind)];
+    subscriptions_.erase(it);
+}
+
+}  // namespace silkworm::rpc
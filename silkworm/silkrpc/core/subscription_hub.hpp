@@ -0,0 +1,120 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+
+#include <silkworm/core/types/block.hpp>
+#include <silkworm/silkrpc/types/filter.hpp>
+#include <silkworm/silkrpc/types/log.hpp>
+
+namespace silkworm::rpc {
+
+static const std::size_t kDefaultMaxSubscriptions = 16 * 1024;  // default max num of active subscriptions
+
+//! The kinds of subscription available through eth_subscribe
+enum class SubscriptionKind : std::size_t {
+    kNewHeads = 0,
+    kLogs = 1,
+    kNewPendingTransactions = 2,
+};
+
+//! Parse the subscription kind from its eth_subscribe name, std::nullopt if unknown
+std::optional<SubscriptionKind> parse_subscription_kind(std::string_view name);
+
+//! The notification result encoded just once as JSON and shared by all the subscribers
+using SharedPayload = std::shared_ptr<const std::string>;
+
+//! The destination of subscription notifications, typically one client connection
+class SubscriptionSink {
+  public:
+    virtual ~SubscriptionSink() = default;
+
+    //! Deliver the notification for the given subscription without blocking
+    //! @return false if the notification cannot be accepted now and must be dropped
+    virtual bool notify(const std::string& subscription_id, const SharedPayload& payload) = 0;
+};
+
+//! The registry of active subscriptions: every event published here is encoded once and fanned out to all the
+//! matching subscribers. Events are published from the stream consumers while the subscribers come and go
+//! on the connection threads, hence all the operations are thread-safe.
+class SubscriptionHub {
+  public:
+    using Generator = std::function<std::uint64_t()>;
+
+    explicit SubscriptionHub(std::size_t max_subscriptions = kDefaultMaxSubscriptions);
+    explicit SubscriptionHub(Generator generator, std::size_t max_subscriptions = kDefaultMaxSubscriptions);
+
+    SubscriptionHub(const SubscriptionHub&) = delete;
+    SubscriptionHub& operator=(const SubscriptionHub&) = delete;
+
+    //! Register a new subscription for the given sink, the filter is meaningful just for logs
+    //! @return the subscription identifier or std::nullopt if the max number of subscriptions is reached
+    std::optional<std::string> subscribe(SubscriptionKind kind, const Filter& filter, const std::shared_ptr<SubscriptionSink>& sink);
+
+    //! Remove the subscription, provided that it belongs to the given sink
+    bool unsubscribe(const std::string& subscription_id, const SubscriptionSink& sink);
+
+    //! Remove all the subscriptions belonging to the given sink
+    void unsubscribe_all(const SubscriptionSink& sink);
+
+    //! Check if there is any subscription of the given kind, so that producers can skip building useless events
+    [[nodiscard]] bool has_subscribers(SubscriptionKind kind) const;
+
+    [[nodiscard]] std::size_t size() const;
+
+    //! Notify the new canonical header to newHeads subscribers
+    void publish_new_head(const BlockHeader& header);
+
+    //! Notify each log to the logs subscribers whose filter matches it
+    void publish_logs(const Logs& logs);
+
+    //! Notify the hash of each transaction entering the pool to newPendingTransactions subscribers
+    void publish_pending_transactions(const std::vector<evmc::bytes32>& tx_hashes);
+
+  private:
+    struct Subscription {
+        SubscriptionKind kind;
+        Filter filter;
+        std::weak_ptr<SubscriptionSink> sink;
+        const SubscriptionSink* owner;
+    };
+
+    //! Deliver the payload to the subscriptions of the given kind accepted by the predicate, pruning dead sinks
+    void publish(SubscriptionKind kind, const SharedPayload& payload, const std::function<bool(const Subscription&)>& accept);
+
+    void erase(std::map<std::string, Subscription>::iterator it);
+
+    Generator generator_;
+    std::size_t max_subscriptions_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Subscription> subscriptions_;
+    std::array<std::size_t, 3> subscription_counts_{};
+};
+
+}  // namespace silkworm::rpc
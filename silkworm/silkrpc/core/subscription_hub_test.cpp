@@ -0,0 +1,125 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "subscription_hub.hpp"
+
+#include <utility>
+
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+#include <silkworm/infra/test_util/log.hpp>
+
+namespace silkworm::rpc {
+
+using namespace evmc::literals;
+
+struct CollectingSink : public SubscriptionSink {
+    bool notify(const std::string& subscription_id, const SharedPayload& payload) override {
+        notifications.emplace_back(subscription_id, payload);
+        return accept;
+    }
+
+    std::vector<std::pair<std::string, SharedPayload>> notifications;
+    bool accept{true};
+};
+
+TEST_CASE("parse_subscription_kind", "[silkrpc][core][subscription_hub]") {
+    CHECK(parse_subscription_kind("newHeads") == SubscriptionKind::kNewHeads);
+    CHECK(parse_subscription_kind("logs") == SubscriptionKind::kLogs);
+    CHECK(parse_subscription_kind("newPendingTransactions") == SubscriptionKind::kNewPendingTransactions);
+    CHECK(parse_subscription_kind("pendingTransactions") == SubscriptionKind::kNewPendingTransactions);
+    CHECK(!parse_subscription_kind("syncing"));
+}
+
+TEST_CASE("SubscriptionHub", "[silkrpc][core][subscription_hub]") {
+    test_util::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    SubscriptionHub hub;
+    auto sink1{std::make_shared<CollectingSink>()};
+    auto sink2{std::make_shared<CollectingSink>()};
+
+    SECTION("subscribe and unsubscribe") {
+        const auto id1{hub.subscribe(SubscriptionKind::kNewHeads, {}, sink1)};
+        const auto id2{hub.subscribe(SubscriptionKind::kNewHeads, {}, sink2)};
+        REQUIRE(id1);
+        REQUIRE(id2);
+        CHECK(*id1 != *id2);
+        CHECK(hub.size() == 2);
+        CHECK(hub.has_subscribers(SubscriptionKind::kNewHeads));
+        CHECK(!hub.has_subscribers(SubscriptionKind::kLogs));
+        CHECK(!hub.unsubscribe(*id1, *sink2));  // only the owner can unsubscribe
+        CHECK(hub.unsubscribe(*id1, *sink1));
+        CHECK(!hub.unsubscribe(*id1, *sink1));
+        hub.unsubscribe_all(*sink2);
+        CHECK(hub.size() == 0);
+        CHECK(!hub.has_subscribers(SubscriptionKind::kNewHeads));
+    }
+
+    SECTION("max subscriptions") {
+        SubscriptionHub small_hub{1};
+        CHECK(small_hub.subscribe(SubscriptionKind::kNewHeads, {}, sink1));
+        CHECK(!small_hub.subscribe(SubscriptionKind::kNewHeads, {}, sink1));
+    }
+
+    SECTION("new heads encoded once for all subscribers") {
+        const auto id1{hub.subscribe(SubscriptionKind::kNewHeads, {}, sink1)};
+        const auto id2{hub.subscribe(SubscriptionKind::kNewHeads, {}, sink2)};
+        hub.subscribe(SubscriptionKind::kNewPendingTransactions, {}, sink2);
+        BlockHeader header;
+        header.number = 5'000'000;
+        hub.publish_new_head(header);
+        REQUIRE(sink1->notifications.size() == 1);
+        REQUIRE(sink2->notifications.size() == 1);
+        CHECK(sink1->notifications[0].first == *id1);
+        CHECK(sink2->notifications[0].first == *id2);
+        CHECK(sink1->notifications[0].second == sink2->notifications[0].second);  // same shared bytes
+        CHECK(nlohmann::json::parse(*sink1->notifications[0].second)["number"] == "0x4c4b40");
+    }
+
+    SECTION("logs filtered by address and topics") {
+        const auto address{0x6090a6e47849629b7245dfa1ca21d94cd15878ef_address};
+        const auto topic{0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef_bytes32};
+        hub.subscribe(SubscriptionKind::kLogs, Filter{.addresses = {address}}, sink1);
+        hub.subscribe(SubscriptionKind::kLogs, Filter{.topics = {{}, {topic}}}, sink2);
+        const Logs logs{
+            Log{.address = address, .topics = {topic}},
+            Log{.address = 0x0715a7794a1dc8e42615f059dd6e406a6594651a_address, .topics = {topic, topic}},
+        };
+        hub.publish_logs(logs);
+        REQUIRE(sink1->notifications.size() == 1);
+        CHECK(nlohmann::json::parse(*sink1->notifications[0].second)["address"] == "0x6090a6e47849629b7245dfa1ca21d94cd15878ef");
+        REQUIRE(sink2->notifications.size() == 1);
+        CHECK(nlohmann::json::parse(*sink2->notifications[0].second)["address"] == "0x0715a7794a1dc8e42615f059dd6e406a6594651a");
+    }
+
+    SECTION("pending transactions") {
+        hub.subscribe(SubscriptionKind::kNewPendingTransactions, {}, sink1);
+        sink1->accept = false;  // dropped notifications don't affect the subscription
+        hub.publish_pending_transactions({0xb8a92e8b0a2ee8f8d4e2f2ffdc4a0d1ac1cf1ba8d9ff2bd53a8deb4cd7b5c7a1_bytes32});
+        REQUIRE(sink1->notifications.size() == 1);
+        CHECK(*sink1->notifications[0].second == R"("0xb8a92e8b0a2ee8f8d4e2f2ffdc4a0d1ac1cf1ba8d9ff2bd53a8deb4cd7b5c7a1")");
+        CHECK(hub.size() == 1);
+    }
+
+    SECTION("gone sink is pruned") {
+        hub.subscribe(SubscriptionKind::kNewPendingTransactions, {}, sink1);
+        sink1.reset();
+        hub.publish_pending_transactions({0xb8a92e8b0a2ee8f8d4e2f2ffdc4a0d1ac1cf1ba8d9ff2bd53a8deb4cd7b5c7a1_bytes32});
+        CHECK(hub.size() == 0);
+    }
+}
+
+}  // namespace silkworm::rpc
@@ -202,7 +202,8 @@ Daemon::Daemon(DaemonSettings settings, std::optional<mdbx::env> chaindata_env)
       create_channel_{make_channel_factory(settings_)},
       context_pool_{settings_.context_pool_settings.num_contexts},
       worker_pool_{settings_.num_workers},
-      kv_stub_{::remote::KV::NewStub(create_channel_())} {
+      kv_stub_{::remote::KV::NewStub(create_channel_())},
+      txpool_stub_{::txpool::Txpool::NewStub(create_channel_())} {
     // Load the channel authentication token (if required)
     if (settings_.jwt_secret_file) {
         jwt_secret_ = load_jwt_token(*settings_.jwt_secret_file);
@@ -221,6 +222,9 @@ Daemon::Daemon(DaemonSettings settings, std::optional<mdbx::env> chaindata_env)
     auto& context = context_pool_.next_context();
     state_changes_stream_ = std::make_unique<ethdb::kv::StateChangesStream>(context, kv_stub_.get());
 
+    // Create the unique txpool stream feeding the pending transactions subscriptions
+    pending_transactions_stream_ = std::make_unique<txpool::PendingTransactionsStream>(context, txpool_stub_.get());
+
     // Set compatibility with Erigon RpcDaemon at JSON RPC level
     compatibility::set_erigon_json_api_compatibility_required(settings_.erigon_json_rpc_compatibility);
 }
@@ -258,6 +262,8 @@ void Daemon::add_shared_services() {
     auto state_cache = std::make_shared<ethdb::kv::CoherentStateCache>();
     // Create the unique filter storage to be shared among the execution contexts
     auto filter_storage = std::make_shared<FilterStorage>(context_pool_.num_contexts() * kDefaultFilterStorageSize);
+    // Create the unique subscription hub to be shared among the execution contexts
+    auto subscription_hub = std::make_shared<SubscriptionHub>();
 
     // Add the shared state to the execution contexts
     for (std::size_t i{0}; i < settings_.context_pool_settings.num_contexts; ++i) {
@@ -266,6 +272,7 @@ void Daemon::add_shared_services() {
         add_shared_service(io_context, block_cache);
         add_shared_service<ethdb::kv::StateCache>(io_context, state_cache);
         add_shared_service(io_context, filter_storage);
+        add_shared_service(io_context, subscription_hub);
     }
 }
 
@@ -292,18 +299,34 @@ DaemonChecklist Daemon::run_checklist() {
 }
 
 void Daemon::start() {
+    const http::BatchSettings batch_settings{
+        .max_size = settings_.max_batch_size,
+        .max_concurrency = settings_.batch_concurrency,
+    };
+    const http::CompressionSettings compression_settings{
+        .enabled = settings_.http_compression,
+        .threshold = settings_.http_compression_threshold,
+    };
+    // Engine API replies are consumed locally by the consensus client: compression is just CPU overhead there
+    const http::CompressionSettings engine_compression_settings{.enabled = false};
+    const http::ConnectionSettings connection_settings{
+        .idle_timeout = settings_.http_idle_timeout,
+        .max_requests = settings_.http_max_requests_per_connection,
+        .max_pipelined_requests = settings_.http_max_pipelined_requests,
+        .max_content_length = settings_.http_max_content_length,
+    };
     for (std::size_t i{0}; i < settings_.context_pool_settings.num_contexts; ++i) {
         auto& ioc = context_pool_.next_io_context();
 
         if (not settings_.eth_end_point.empty()) {
             rpc_services_.emplace_back(
                 std::make_unique<http::Server>(
-                    settings_.eth_end_point, settings_.eth_api_spec, ioc, worker_pool_, settings_.cors_domain, /*jwt_secret=*/std::nullopt));
+                    settings_.eth_end_point, settings_.eth_api_spec, ioc, worker_pool_, settings_.cors_domain, /*jwt_secret=*/std::nullopt, batch_settings, compression_settings, connection_settings));
         }
         if (not settings_.engine_end_point.empty()) {
             rpc_services_.emplace_back(
                 std::make_unique<http::Server>(
-                    settings_.engine_end_point, kDefaultEth2ApiSpec, ioc, worker_pool_, settings_.cors_domain, jwt_secret_));
+                    settings_.engine_end_point, kDefaultEth2ApiSpec, ioc, worker_pool_, settings_.cors_domain, jwt_secret_, batch_settings, engine_compression_settings, connection_settings));
         }
     }
 
@@ -311,9 +334,12 @@ void Daemon::start() {
         service->start();
     }
 
-    // Open the KV state-changes stream feeding the state cache
+    // Open the KV state-changes stream feeding the state cache and the subscriptions
     state_changes_stream_->open();
 
+    // Open the txpool stream feeding the pending transactions subscriptions
+    pending_transactions_stream_->open();
+
     context_pool_.start();
 }
 
@@ -321,6 +347,9 @@ void Daemon::stop() {
     // Cancel registration for incoming KV state changes
     state_changes_stream_->close();
 
+    // Cancel registration for incoming pending transactions
+    pending_transactions_stream_->close();
+
     context_pool_.stop();
 
     for (auto& service : rpc_services_) {
@@ -31,6 +31,7 @@
 #include <silkworm/silkrpc/common/constants.hpp>
 #include <silkworm/silkrpc/ethdb/kv/state_changes_stream.hpp>
 #include <silkworm/silkrpc/http/server.hpp>
+#include <silkworm/silkrpc/txpool/pending_transactions_stream.hpp>
 
 #include "settings.hpp"
 
@@ -98,6 +99,12 @@ class Daemon {
     //! The stream handling StateChanges server-streaming RPC.
     std::unique_ptr<ethdb::kv::StateChangesStream> state_changes_stream_;
 
+    //! The gRPC txpool interface client stub.
+    std::unique_ptr<::txpool::Txpool::StubInterface> txpool_stub_;
+
+    //! The stream handling OnAdd server-streaming RPC.
+    std::unique_ptr<txpool::PendingTransactionsStream> pending_transactions_stream_;
+
     //! The secret key for communication from CL & EL
     std::optional<std::string> jwt_secret_;
 };
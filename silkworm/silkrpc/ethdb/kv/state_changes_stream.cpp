@@ -24,7 +24,13 @@
 
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/concurrency/co_spawn_sw.hpp>
+#include <silkworm/infra/concurrency/private_service.hpp>
 #include <silkworm/infra/concurrency/shared_service.hpp>
+#include <silkworm/silkrpc/core/cached_chain.hpp>
+#include <silkworm/silkrpc/core/receipts.hpp>
+#include <silkworm/silkrpc/ethbackend/backend.hpp>
+#include <silkworm/silkrpc/ethdb/database.hpp>
+#include <silkworm/silkrpc/ethdb/transaction_database.hpp>
 #include <silkworm/silkrpc/grpc/util.hpp>
 
 namespace silkworm::rpc::ethdb::kv {
@@ -43,6 +49,7 @@ StateChangesStream::StateChangesStream(ClientContext& context, remote::KV::StubI
       grpc_context_(*context.grpc_context()),
       stub_(stub),
       cache_(must_use_shared_service<ethdb::kv::StateCache>(scheduler_)),
+      subscription_hub_(use_shared_service<SubscriptionHub>(scheduler_)),
       retry_timer_{scheduler_} {}
 
 std::future<void> StateChangesStream::open() {
@@ -102,6 +109,9 @@ Task<void> StateChangesStream::run() {
             if (!read_ec) {
                 SILK_TRACE << "State changes batch received: " << reply << "";
                 cache_->on_new_block(reply);
+                if (subscription_hub_) {
+                    co_await publish_new_blocks(reply);
+                }
             } else {
                 if (read_ec.value() == grpc::StatusCode::CANCELLED) {
                     cancelled = true;
@@ -122,4 +132,45 @@ Task<void> StateChangesStream::run() {
     SILK_TRACE << "StateChangesStream::run state stream END";
 }
 
+Task<void> StateChangesStream::publish_new_blocks(const remote::StateChangeBatch& batch) {
+    const bool publish_heads{subscription_hub_->has_subscribers(SubscriptionKind::kNewHeads)};
+    const bool publish_logs{subscription_hub_->has_subscribers(SubscriptionKind::kLogs)};
+    if (!publish_heads && !publish_logs) {
+        co_return;
+    }
+
+    auto* database = must_use_private_service<ethdb::Database>(scheduler_);
+    auto* backend = must_use_private_service<ethbackend::BackEnd>(scheduler_);
+    auto* block_cache = must_use_shared_service<BlockCache>(scheduler_);
+    auto tx = co_await database->begin();
+    try {
+        ethdb::TransactionDatabase tx_database{*tx};
+        const auto chain_storage{tx->create_storage(tx_database, backend)};
+        for (const auto& state_change : batch.change_batch()) {
+            if (state_change.direction() != remote::Direction::FORWARD) {
+                continue;
+            }
+            const auto block_with_hash = co_await core::read_block_by_number(*block_cache, *chain_storage, state_change.block_height());
+            if (!block_with_hash) {
+                SILK_WARN << "New block " << state_change.block_height() << " not found, skip publishing";
+                continue;
+            }
+            if (publish_heads) {
+                subscription_hub_->publish_new_head(block_with_hash->block.header);
+            }
+            if (publish_logs) {
+                const auto receipts{co_await core::get_receipts(tx_database, *block_with_hash)};
+                Logs logs;
+                for (const auto& receipt : receipts) {
+                    logs.insert(logs.end(), receipt.logs.cbegin(), receipt.logs.cend());
+                }
+                subscription_hub_->publish_logs(logs);
+            }
+        }
+    } catch (const std::exception& e) {
+        SILK_ERROR << "New blocks publishing failed: " << e.what();
+    }
+    co_await tx->close();  // RAII not (yet) available with coroutines
+}
+
 }  // namespace silkworm::rpc::ethdb::kv
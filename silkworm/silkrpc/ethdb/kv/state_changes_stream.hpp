@@ -32,6 +32,7 @@
 
 #include <silkworm/infra/grpc/client/client_context_pool.hpp>
 #include <silkworm/interfaces/remote/kv.grpc.pb.h>
+#include <silkworm/silkrpc/core/subscription_hub.hpp>
 #include <silkworm/silkrpc/ethdb/kv/rpc.hpp>
 #include <silkworm/silkrpc/ethdb/kv/state_cache.hpp>
 
@@ -51,7 +52,8 @@ namespace silkworm::rpc::ethdb::kv {
 //! The default registration interval
 constexpr std::chrono::milliseconds kDefaultRegistrationInterval{10'000};
 
-//! End-point of the stream of state changes coming from the node Core component
+//! End-point of the stream of state changes coming from the node Core component, feeding the state cache and
+//! the newHeads and logs subscriptions (if any)
 class StateChangesStream {
   public:
     //! Return the retry interval between successive registration attempts
@@ -72,6 +74,9 @@ class StateChangesStream {
     Task<void> run();
 
   private:
+    //! Publish the headers and logs of the new canonical blocks to the subscribers
+    Task<void> publish_new_blocks(const remote::StateChangeBatch& batch);
+
     //! The retry interval between successive registration attempts
     static std::chrono::milliseconds registration_interval_;
 
@@ -87,6 +92,9 @@ class StateChangesStream {
     //! The local state cache where the received state changes will be applied
     StateCache* cache_;
 
+    //! The registry of subscriptions where the new blocks will be published or nullptr if not available
+    SubscriptionHub* subscription_hub_;
+
     //! The signal used to cancel the register-and-receive stream loop
     boost::asio::cancellation_signal cancellation_signal_;
 
@@ -0,0 +1,170 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "compression.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+namespace silkworm::rpc::http {
+
+//! The compression level used for replies: JSON compresses well even at the fastest level, which keeps latency low
+static constexpr int kCompressionLevel{Z_BEST_SPEED};
+
+//! The zlib window bits selecting the gzip (RFC 1952) or zlib (RFC 1950, i.e. HTTP deflate) wrapper
+static constexpr int kMaxWindowBits{15};
+static constexpr int kGzipWindowBits{kMaxWindowBits + 16};
+
+//! The zlib memory level, default value
+static constexpr int kMemoryLevel{8};
+
+std::string_view to_string(ContentEncoding encoding) {
+    switch (encoding) {
+        case ContentEncoding::kGzip:
+            return "gzip";
+        case ContentEncoding::kDeflate:
+            return "deflate";
+        default:
+            return "";
+    }
+}
+
+//! Strip the optional whitespace around an element of a comma-separated header value
+static std::string_view trim(std::string_view value) {
+    const auto begin = value.find_first_not_of(" \t");
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    return value.substr(begin, value.find_last_not_of(" \t") - begin + 1);
+}
+
+//! Check if the quality value among the coding parameters is zero, i.e. "not acceptable"
+static bool is_zero_quality(std::string_view parameters) {
+    while (!parameters.empty()) {
+        const auto separator = parameters.find(';');
+        const auto param = trim(parameters.substr(0, separator));
+        if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+            const auto value = param.substr(2);
+            return std::all_of(value.begin(), value.end(), [](char c) { return c == '0' || c == '.'; });
+        }
+        parameters.remove_prefix(separator == std::string_view::npos ? parameters.size() : separator + 1);
+    }
+    return false;
+}
+
+ContentEncoding negotiate_content_encoding(std::string_view accept_encoding) {
+    std::optional<bool> gzip_accepted;
+    std::optional<bool> deflate_accepted;
+    bool any_accepted{false};
+    while (!accept_encoding.empty()) {
+        const auto element_end = accept_encoding.find(',');
+        const auto element = accept_encoding.substr(0, element_end);
+        accept_encoding.remove_prefix(element_end == std::string_view::npos ? accept_encoding.size() : element_end + 1);
+
+        const auto separator = element.find(';');
+        const auto coding = trim(element.substr(0, separator));
+        const bool accepted = separator == std::string_view::npos || !is_zero_quality(element.substr(separator + 1));
+        if (boost::algorithm::iequals(coding, "gzip") || boost::algorithm::iequals(coding, "x-gzip")) {
+            gzip_accepted = accepted;
+        } else if (boost::algorithm::iequals(coding, "deflate")) {
+            deflate_accepted = accepted;
+        } else if (coding == "*") {
+            any_accepted = accepted;
+        }
+    }
+    if (gzip_accepted.value_or(any_accepted)) {
+        return ContentEncoding::kGzip;
+    }
+    if (deflate_accepted.value_or(any_accepted)) {
+        return ContentEncoding::kDeflate;
+    }
+    return ContentEncoding::kIdentity;
+}
+
+ContentEncoding negotiate_content_encoding(const std::vector<Header>& request_headers) {
+    for (const auto& header : request_headers) {
+        if (boost::algorithm::iequals(header.name, "Accept-Encoding")) {
+            return negotiate_content_encoding(header.value);
+        }
+    }
+    return ContentEncoding::kIdentity;
+}
+
+std::string compress(std::string_view content, ContentEncoding encoding) {
+    // Textual JSON content shrinks at least by a factor of 4 in practice, so this is enough to avoid most reallocations
+    StringWriter string_writer{content.size() / 4};
+    CompressionWriter compression_writer{string_writer, encoding};
+    compression_writer.write(content);
+    compression_writer.close();
+    return string_writer.get_content();
+}
+
+CompressionWriter::CompressionWriter(Writer& writer, ContentEncoding encoding) : writer_(writer) {
+    if (encoding == ContentEncoding::kIdentity) {
+        throw std::invalid_argument{"CompressionWriter: identity is not a compression coding"};
+    }
+    const int window_bits = encoding == ContentEncoding::kGzip ? kGzipWindowBits : kMaxWindowBits;
+    if (deflateInit2(&stream_, kCompressionLevel, Z_DEFLATED, window_bits, kMemoryLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error{"CompressionWriter: deflate initialization failed"};
+    }
+}
+
+CompressionWriter::~CompressionWriter() {
+    if (!closed_) {
+        deflateEnd(&stream_);
+    }
+}
+
+void CompressionWriter::write(std::string_view content) {
+    // zlib counts input bytes as unsigned int, so huge contents must be split
+    while (!content.empty()) {
+        const auto size = std::min<std::size_t>(content.size(), std::numeric_limits<uInt>::max());
+        stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(content.data()));
+        stream_.avail_in = static_cast<uInt>(size);
+        deflate_pending(Z_NO_FLUSH);
+        content.remove_prefix(size);
+    }
+}
+
+void CompressionWriter::close() {
+    if (closed_) {
+        return;
+    }
+    deflate_pending(Z_FINISH);
+    deflateEnd(&stream_);
+    closed_ = true;
+    writer_.close();
+}
+
+void CompressionWriter::deflate_pending(int flush) {
+    do {
+        stream_.next_out = reinterpret_cast<Bytef*>(output_.data());
+        stream_.avail_out = static_cast<uInt>(output_.size());
+        if (deflate(&stream_, flush) == Z_STREAM_ERROR) {
+            throw std::runtime_error{"CompressionWriter: deflate failed"};
+        }
+        const auto produced = output_.size() - stream_.avail_out;
+        if (produced > 0) {
+            writer_.write(std::string_view{output_.data(), produced});
+        }
+    } while (stream_.avail_out == 0);
+}
+
+}  // namespace silkworm::rpc::http
@@ -0,0 +1,74 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <zlib.h>
+
+#include <silkworm/silkrpc/http/header.hpp>
+#include <silkworm/silkrpc/types/writer.hpp>
+
+namespace silkworm::rpc::http {
+
+//! The HTTP content codings supported for replies
+enum class ContentEncoding {
+    kIdentity,
+    kGzip,
+    kDeflate,
+};
+
+//! The value of Content-Encoding header for the given coding, empty for identity
+std::string_view to_string(ContentEncoding encoding);
+
+//! Choose the content coding for the reply according to the Accept-Encoding request header value (RFC 9110 12.5.3)
+//! @return gzip or deflate if acceptable by the client (in this order of preference), identity otherwise
+ContentEncoding negotiate_content_encoding(std::string_view accept_encoding);
+
+//! Choose the content coding for the reply looking for Accept-Encoding in the request headers
+ContentEncoding negotiate_content_encoding(const std::vector<Header>& request_headers);
+
+//! Compress the whole content at once using the given coding, which must not be identity
+std::string compress(std::string_view content, ContentEncoding encoding);
+
+//! Writer compressing the content incrementally before forwarding it to the underlying writer, so that streamed
+//! replies can be compressed without being buffered as a whole
+class CompressionWriter : public Writer {
+  public:
+    CompressionWriter(Writer& writer, ContentEncoding encoding);
+    ~CompressionWriter() override;
+
+    CompressionWriter(const CompressionWriter&) = delete;
+    CompressionWriter& operator=(const CompressionWriter&) = delete;
+
+    void write(std::string_view content) override;
+    void close() override;
+
+  private:
+    //! Feed the deflate stream with the pending input, forwarding any compressed output produced
+    void deflate_pending(int flush);
+
+    Writer& writer_;
+    z_stream stream_{};
+    bool closed_{false};
+    std::array<char, 0x4000> output_{};
+};
+
+}  // namespace silkworm::rpc::http
@@ -0,0 +1,133 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "compression.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::rpc::http {
+
+//! Decompress gzip or zlib content, detecting the format automatically
+static std::string decompress(const std::string& content) {
+    z_stream stream{};
+    REQUIRE(inflateInit2(&stream, 15 + 32) == Z_OK);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(content.data()));
+    stream.avail_in = static_cast<uInt>(content.size());
+    std::string result;
+    std::array<char, 1024> buffer{};
+    int ret{Z_OK};
+    while (ret == Z_OK) {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+        stream.avail_out = static_cast<uInt>(buffer.size());
+        ret = inflate(&stream, Z_NO_FLUSH);
+        result.append(buffer.data(), buffer.size() - stream.avail_out);
+    }
+    inflateEnd(&stream);
+    CHECK(ret == Z_STREAM_END);
+    return result;
+}
+
+TEST_CASE("negotiate_content_encoding", "[silkrpc][http][compression]") {
+    CHECK(negotiate_content_encoding("") == ContentEncoding::kIdentity);
+    CHECK(negotiate_content_encoding("identity") == ContentEncoding::kIdentity);
+    CHECK(negotiate_content_encoding("br") == ContentEncoding::kIdentity);
+    CHECK(negotiate_content_encoding("gzip") == ContentEncoding::kGzip);
+    CHECK(negotiate_content_encoding("x-gzip") == ContentEncoding::kGzip);
+    CHECK(negotiate_content_encoding("deflate") == ContentEncoding::kDeflate);
+    CHECK(negotiate_content_encoding("deflate, gzip, br") == ContentEncoding::kGzip);
+    CHECK(negotiate_content_encoding("GZIP;q=0.5 , Deflate") == ContentEncoding::kGzip);
+    CHECK(negotiate_content_encoding("gzip;q=0, deflate") == ContentEncoding::kDeflate);
+    CHECK(negotiate_content_encoding("gzip; q=0.000, deflate;q=0") == ContentEncoding::kIdentity);
+    CHECK(negotiate_content_encoding("*") == ContentEncoding::kGzip);
+    CHECK(negotiate_content_encoding("*, gzip;q=0") == ContentEncoding::kDeflate);
+    CHECK(negotiate_content_encoding("*;q=0") == ContentEncoding::kIdentity);
+}
+
+TEST_CASE("negotiate_content_encoding from headers", "[silkrpc][http][compression]") {
+    CHECK(negotiate_content_encoding(std::vector<Header>{}) == ContentEncoding::kIdentity);
+    CHECK(negotiate_content_encoding(std::vector<Header>{{"Authorization", "Bearer x"}}) == ContentEncoding::kIdentity);
+    CHECK(negotiate_content_encoding(std::vector<Header>{{"accept-encoding", "deflate"}}) == ContentEncoding::kDeflate);
+}
+
+TEST_CASE("compress", "[silkrpc][http][compression]") {
+    std::string content{R"({"jsonrpc":"2.0","id":1,"result":[)"};
+    for (int i{0}; i < 1000; ++i) {
+        content.append(R"({"pc":)" + std::to_string(i) + R"(,"op":"PUSH1","gas":1000,"depth":1},)");
+    }
+    content.append("{}]}");
+
+    for (const auto encoding : {ContentEncoding::kGzip, ContentEncoding::kDeflate}) {
+        const auto compressed{compress(content, encoding)};
+        CHECK(compressed.size() < content.size() / 4);
+        CHECK(decompress(compressed) == content);
+    }
+    CHECK(decompress(compress("", ContentEncoding::kGzip)).empty());
+}
+
+TEST_CASE("CompressionWriter", "[silkrpc][http][compression]") {
+    SECTION("identity is rejected") {
+        StringWriter s_writer;
+        CHECK_THROWS_AS(CompressionWriter(s_writer, ContentEncoding::kIdentity), std::invalid_argument);
+    }
+
+    SECTION("chunked compressed stream") {
+        StringWriter s_writer;
+        ChunksWriter chunks_writer(s_writer, 0x100);
+        CompressionWriter writer(chunks_writer, ContentEncoding::kGzip);
+
+        std::string content;
+        for (int i{0}; i < 10'000; ++i) {
+            const auto entry{R"({"stack":[")" + std::to_string(i * 7919) + R"("]},)"};
+            writer.write(entry);
+            content.append(entry);
+        }
+        writer.close();
+
+        // Strip the chunk framing and check the compressed payload
+        const auto& chunked{s_writer.get_content()};
+        REQUIRE(chunked.ends_with("0\r\n\r\n"));
+        std::string compressed;
+        std::size_t position{0};
+        while (true) {
+            const auto size_end{chunked.find("\r\n", position)};
+            const auto size{std::stoul(chunked.substr(position, size_end - position), nullptr, 16)};
+            if (size == 0) {
+                break;
+            }
+            compressed.append(chunked, size_end + 2, size);
+            position = size_end + 2 + size + 2;
+        }
+        CHECK(decompress(compressed) == content);
+    }
+
+    SECTION("close is idempotent") {
+        StringWriter s_writer;
+        CompressionWriter writer(s_writer, ContentEncoding::kDeflate);
+        writer.write("[]");
+        writer.close();
+        const auto compressed{s_writer.get_content()};
+        writer.close();
+        CHECK(s_writer.get_content() == compressed);
+        CHECK(decompress(compressed) == "[]");
+    }
+}
+
+}  // namespace silkworm::rpc::http
@@ -22,31 +22,55 @@
 
 #include "connection.hpp"
 
+#include <algorithm>
 #include <exception>
-#include <fstream>
 #include <string_view>
+#include <utility>
 
+#include <boost/asio/experimental/awaitable_operators.hpp>
 #include <boost/asio/use_awaitable.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/system/error_code.hpp>
+#include <boost/system/system_error.hpp>
 
 #include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/concurrency/shared_service.hpp>
 #include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/http/websocket_session.hpp>
 
 namespace silkworm::rpc::http {
 
+//! Create an empty request ready to be filled by the parser
+static Request make_request() {
+    Request request;
+    request.headers.reserve(kRequestHeadersInitialCapacity);
+    request.method.reserve(kRequestMethodInitialCapacity);
+    request.uri.reserve(kRequestUriInitialCapacity);
+    return request;
+}
+
+//! Create a stock reply closing the connection, used when the connection cannot receive any further request
+static Reply make_closing_reply(StatusType status) {
+    auto reply{Reply::stock_reply(status)};
+    reply.headers.emplace_back(Header{"Connection", "close"});
+    return reply;
+}
+
 Connection::Connection(boost::asio::io_context& io_context,
                        commands::RpcApi& api,
                        commands::RpcApiTable& handler_table,
                        const std::vector<std::string>& allowed_origins,
-                       std::optional<std::string> jwt_secret)
+                       std::optional<std::string> jwt_secret,
+                       BatchSettings batch_settings,
+                       CompressionSettings compression_settings,
+                       ConnectionSettings connection_settings)
     : socket_{io_context},
-      request_handler_{socket_, api, handler_table, allowed_origins, std::move(jwt_secret)},
-      buffer_{} {
-    request_.content.reserve(kRequestContentInitialCapacity);
-    request_.headers.reserve(kRequestHeadersInitialCapacity);
-    request_.method.reserve(kRequestMethodInitialCapacity);
-    request_.uri.reserve(kRequestUriInitialCapacity);
+      request_handler_{socket_, api, handler_table, allowed_origins, std::move(jwt_secret), batch_settings,
+                       use_shared_service<SubscriptionHub>(io_context), compression_settings},
+      settings_{connection_settings},
+      request_parser_{connection_settings.max_content_length},
+      pipeline_{io_context.get_executor(), connection_settings.max_pipelined_requests},
+      idle_timer_{io_context} {
     SILK_DEBUG << "Connection::Connection socket " << &socket_ << " created";
 }
 
@@ -57,9 +81,14 @@ Connection::~Connection() {
 
 Task<void> Connection::read_loop() {
     try {
-        // Read next request or next chunk (result == RequestParser::indeterminate) until closed or error
-        while (true) {
-            co_await do_read();
+        // Receive the next requests while the previous ones are handled, until closed or error
+        using namespace boost::asio::experimental::awaitable_operators;
+        if (settings_.idle_timeout == std::chrono::milliseconds::zero()) {
+            co_await (receive_requests() && handle_requests());
+        } else {
+            // The idle watchdog never completes by itself, it is cancelled as soon as the connection is done
+            idle_deadline_ = std::chrono::steady_clock::now() + settings_.idle_timeout;
+            co_await ((receive_requests() && handle_requests()) || close_when_idle());
         }
     } catch (const boost::system::system_error& se) {
         if (se.code() == boost::asio::error::eof || se.code() == boost::asio::error::connection_reset || se.code() == boost::asio::error::broken_pipe) {
@@ -76,38 +105,127 @@ Task<void> Connection::read_loop() {
     }
 }
 
-Task<void> Connection::do_read() {
-    SILK_DEBUG << "Connection::do_read going to read...";
-    std::size_t bytes_read = co_await socket_.async_read_some(boost::asio::buffer(buffer_), boost::asio::use_awaitable);
-    SILK_DEBUG << "Connection::do_read bytes_read: " << bytes_read;
-    SILK_TRACE << "Connection::do_read buffer: " << std::string_view{static_cast<const char*>(buffer_.data()), bytes_read};
-
-    RequestParser::ResultType result = request_parser_.parse(request_, buffer_.data(), buffer_.data() + bytes_read);
-
-    if (result == RequestParser::ResultType::good) {
-        co_await request_handler_.handle(request_);
-        clean();
-    } else if (result == RequestParser::ResultType::bad) {
-        reply_ = Reply::stock_reply(StatusType::bad_request);
-        co_await do_write();
-        clean();
-    } else if (result == RequestParser::ResultType::processing_continue) {
-        reply_ = Reply::stock_reply(StatusType::processing_continue);
-        co_await do_write();
-        reply_.reset();
+Task<void> Connection::receive_requests() {
+    std::size_t num_requests{0};
+    auto request{make_request()};
+    bool receiving{true};
+    while (receiving) {
+        std::size_t bytes_read{0};
+        try {
+            bytes_read = co_await do_read();
+        } catch (const boost::system::system_error& se) {
+            // The client may close its sending side just after the last request, whose reply must be sent anyway
+            if (se.code() != boost::asio::error::eof) {
+                throw;
+            }
+            SILK_DEBUG << "Connection::receive_requests end of stream";
+        }
+        if (bytes_read == 0) {
+            break;
+        }
+
+        // Parse in place all the requests received so far, the last one may be incomplete
+        auto result{RequestParser::ResultType::good};
+        while (receiving && result != RequestParser::ResultType::indeterminate) {
+            const auto data{buffer_.data()};
+            result = request_parser_.parse_received(request, {static_cast<const char*>(data.data()), data.size()});
+            switch (result) {
+                case RequestParser::ResultType::good: {
+                    buffer_.consume(request_parser_.consumed());
+                    ++num_requests;
+                    if (settings_.max_requests > 0 && num_requests == settings_.max_requests) {
+                        request.keep_alive = false;
+                    }
+                    // After an upgrade to WebSocket the connection does not speak HTTP anymore
+                    receiving = request.keep_alive && !is_websocket_upgrade(request);
+                    ++requests_in_progress_;
+                    co_await pipeline_.send(std::move(request));
+                    request = make_request();
+                    break;
+                }
+                case RequestParser::ResultType::processing_continue:
+                    co_await pipeline_.send(Reply::stock_reply(StatusType::processing_continue));
+                    break;
+                case RequestParser::ResultType::content_too_large:
+                    co_await pipeline_.send(make_closing_reply(StatusType::payload_too_large));
+                    receiving = false;
+                    break;
+                case RequestParser::ResultType::bad:
+                    // The start of the next request cannot be found after a malformed one
+                    co_await pipeline_.send(make_closing_reply(StatusType::bad_request));
+                    receiving = false;
+                    break;
+                case RequestParser::ResultType::indeterminate:
+                    break;
+            }
+        }
     }
+    co_await pipeline_.send(std::monostate{});
 }
 
-Task<void> Connection::do_write() {
-    SILK_DEBUG << "Connection::do_write reply: " << reply_.content;
-    const auto bytes_transferred = co_await boost::asio::async_write(socket_, reply_.to_buffers(), boost::asio::use_awaitable);
-    SILK_TRACE << "Connection::do_write bytes_transferred: " << bytes_transferred;
+Task<void> Connection::handle_requests() {
+    while (true) {
+        auto item{co_await pipeline_.receive()};
+        if (auto* request = std::get_if<Request>(&item)) {
+            co_await request_handler_.handle(*request);
+            --requests_in_progress_;
+            // The socket is closed by the request handler after serving a connection upgraded to WebSocket
+            if (!socket_.is_open()) {
+                co_return;
+            }
+        } else if (const auto* reply = std::get_if<Reply>(&item)) {
+            co_await do_write(*reply);
+        } else {
+            co_return;
+        }
+    }
 }
 
-void Connection::clean() {
-    request_.reset();
-    request_parser_.reset();
-    reply_.reset();
+Task<void> Connection::close_when_idle() {
+    while (true) {
+        idle_timer_.expires_at(idle_deadline_);
+        co_await idle_timer_.async_wait(boost::asio::use_awaitable);
+        const auto now{std::chrono::steady_clock::now()};
+        if (now < idle_deadline_) {
+            continue;  // the deadline has been moved forward by a read started in the meantime
+        }
+        if (reading_ && requests_in_progress_ == 0) {
+            SILK_DEBUG << "Connection::close_when_idle idle timeout expired";
+            idle_timeout_expired_ = true;
+            socket_.cancel();
+        }
+        idle_deadline_ = now + settings_.idle_timeout;
+    }
+}
+
+Task<std::size_t> Connection::do_read() {
+    // Read as much as the buffer can hold without growing, but not less than the incoming buffer size
+    const auto buffer{buffer_.prepare(std::max(kHttpIncomingBufferSize, buffer_.capacity() - buffer_.size()))};
+
+    SILK_DEBUG << "Connection::do_read going to read...";
+    // A single read is pending at any time, so that received data is never dropped: the idle watchdog just cancels it
+    idle_deadline_ = std::chrono::steady_clock::now() + settings_.idle_timeout;
+    reading_ = true;
+    std::size_t bytes_read{0};
+    try {
+        bytes_read = co_await socket_.async_read_some(buffer, boost::asio::use_awaitable);
+    } catch (const boost::system::system_error& se) {
+        reading_ = false;
+        if (se.code() == boost::asio::error::operation_aborted && idle_timeout_expired_) {
+            co_return 0;
+        }
+        throw;
+    }
+    reading_ = false;
+    buffer_.commit(bytes_read);
+    SILK_DEBUG << "Connection::do_read bytes_read: " << bytes_read;
+    co_return bytes_read;
+}
+
+Task<void> Connection::do_write(const Reply& reply) {
+    SILK_DEBUG << "Connection::do_write reply: " << reply.content;
+    const auto bytes_transferred = co_await boost::asio::async_write(socket_, reply.to_buffers(), boost::asio::use_awaitable);
+    SILK_TRACE << "Connection::do_write bytes_transferred: " << bytes_transferred;
 }
 
 }  // namespace silkworm::rpc::http
@@ -22,15 +22,22 @@
 
 #pragma once
 
-#include <array>
+#include <chrono>
+#include <cstddef>
+#include <optional>
 #include <string>
+#include <variant>
+#include <vector>
 
 #include <silkworm/infra/concurrency/task.hpp>
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/thread_pool.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
 
+#include <silkworm/infra/concurrency/channel.hpp>
 #include <silkworm/silkrpc/commands/rpc_api_table.hpp>
 #include <silkworm/silkrpc/common/constants.hpp>
 #include <silkworm/silkrpc/http/reply.hpp>
@@ -40,6 +47,21 @@
 
 namespace silkworm::rpc::http {
 
+//! The settings for HTTP/1.1 persistent connections
+struct ConnectionSettings {
+    //! The max time a connection with no request in progress waits for the next one before closing, zero means unlimited
+    std::chrono::milliseconds idle_timeout{kDefaultIdleTimeout};
+
+    //! The max number of requests served on one connection before closing it, zero means unlimited
+    std::size_t max_requests{kDefaultMaxRequestsPerConnection};
+
+    //! The max number of requests received on one connection and still waiting to be handled
+    std::size_t max_pipelined_requests{kDefaultMaxPipelinedRequests};
+
+    //! The max size in bytes of the request content
+    std::size_t max_content_length{kDefaultMaxRequestContentLength};
+};
+
 //! Represents a single connection from a client.
 class Connection {
   public:
@@ -51,7 +73,10 @@ class Connection {
                commands::RpcApi& api,
                commands::RpcApiTable& handler_table,
                const std::vector<std::string>& allowed_origins,
-               std::optional<std::string> jwt_secret);
+               std::optional<std::string> jwt_secret,
+               BatchSettings batch_settings = {},
+               CompressionSettings compression_settings = {},
+               ConnectionSettings connection_settings = {});
 
     ~Connection();
 
@@ -61,14 +86,24 @@ class Connection {
     Task<void> read_loop();
 
   private:
-    //! Reset connection data
-    void clean();
+    //! The item passed from receiving to handling: request to handle, reply to send as is or end of requests
+    using PipelinedItem = std::variant<std::monostate, Request, Reply>;
+
+    //! Receive and parse the incoming requests, queueing them in arrival order until the connection stops receiving
+    Task<void> receive_requests();
+
+    //! Handle the queued requests one at a time in arrival order, so that replies are sent back in the same order
+    Task<void> handle_requests();
 
-    //! Perform an asynchronous read operation.
-    Task<void> do_read();
+    //! Cancel the pending read when no request is in progress and nothing has been received for the idle timeout
+    Task<void> close_when_idle();
+
+    //! Perform an asynchronous read operation into the receive buffer
+    //! @return the number of bytes read, zero if the read has been cancelled because the connection is idle
+    Task<std::size_t> do_read();
 
     //! Perform an asynchronous write operation.
-    Task<void> do_write();
+    Task<void> do_write(const Reply& reply);
 
     //! Socket for the connection.
     boost::asio::ip::tcp::socket socket_;
@@ -76,17 +111,32 @@ class Connection {
     //! The handler used to process the incoming request.
     RequestHandler request_handler_;
 
-    //! Buffer for incoming data.
-    std::array<char, kHttpIncomingBufferSize> buffer_;
+    //! The settings for this connection.
+    const ConnectionSettings settings_;
 
-    //! The incoming request.
-    Request request_;
+    //! Buffer for incoming data, growing as needed and parsed in place.
+    boost::beast::flat_buffer buffer_;
 
-    //! The parser for the incoming request.
+    //! The parser for the incoming requests.
     RequestParser request_parser_;
 
-    //! The reply to be sent back to the client.
-    Reply reply_;
+    //! The queue of received items waiting to be handled, bounded to apply backpressure on the client.
+    concurrency::Channel<PipelinedItem> pipeline_;
+
+    //! The timer closing the connection when idle.
+    boost::asio::steady_timer idle_timer_;
+
+    //! The time after which the pending read is cancelled if the connection is still idle.
+    std::chrono::steady_clock::time_point idle_deadline_;
+
+    //! Flag indicating if a read is pending.
+    bool reading_{false};
+
+    //! Flag indicating if the pending read has been cancelled because the connection is idle.
+    bool idle_timeout_expired_{false};
+
+    //! The number of requests received but not handled yet.
+    std::size_t requests_in_progress_{0};
 };
 
 }  // namespace silkworm::rpc::http
@@ -49,6 +49,7 @@ namespace status_strings {
     const std::string unauthorized = "HTTP/1.1 401 Unauthorized\r\n";                    // NOLINT(runtime/string)
     const std::string forbidden = "HTTP/1.1 403 Forbidden\r\n";                          // NOLINT(runtime/string)
     const std::string not_found = "HTTP/1.1 404 Not Found\r\n";                          // NOLINT(runtime/string)
+    const std::string payload_too_large = "HTTP/1.1 413 Payload Too Large\r\n";          // NOLINT(runtime/string)
     const std::string internal_server_error = "HTTP/1.1 500 Internal Server Error\r\n";  // NOLINT(runtime/string)
     const std::string not_implemented = "HTTP/1.1 501 Not Implemented\r\n";              // NOLINT(runtime/string)
     const std::string bad_gateway = "HTTP/1.1 502 Bad Gateway\r\n";                      // NOLINT(runtime/string)
@@ -90,6 +91,8 @@ boost::asio::const_buffer to_buffer(StatusType status) {
             return boost::asio::buffer(status_strings::forbidden);
         case StatusType::not_found:
             return boost::asio::buffer(status_strings::not_found);
+        case StatusType::payload_too_large:
+            return boost::asio::buffer(status_strings::payload_too_large);
         case StatusType::internal_server_error:
             return boost::asio::buffer(status_strings::internal_server_error);
         case StatusType::not_implemented:
@@ -206,6 +209,11 @@ namespace stock_replies {
         "<head><title>Not Found</title></head>"
         "<body><h1>404 Not Found</h1></body>"
         "</html>";
+    const char payload_too_large[] =
+        "<html>"
+        "<head><title>Payload Too Large</title></head>"
+        "<body><h1>413 Payload Too Large</h1></body>"
+        "</html>";
     const char internal_server_error[] =
         "<html>"
         "<head><title>Internal Server Error</title></head>"
@@ -255,6 +263,8 @@ namespace stock_replies {
                 return forbidden;
             case StatusType::not_found:
                 return not_found;
+            case StatusType::payload_too_large:
+                return payload_too_large;
             case StatusType::internal_server_error:
                 return internal_server_error;
             case StatusType::not_implemented:
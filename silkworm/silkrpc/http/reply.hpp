@@ -49,6 +49,7 @@ enum class StatusType {
     unauthorized = 401,
     forbidden = 403,
     not_found = 404,
+    payload_too_large = 413,
     internal_server_error = 500,
     not_implemented = 501,
     bad_gateway = 502,
@@ -120,6 +120,11 @@ TEST_CASE("StatusType to_buffer", "[silkrpc][http][reply]") {
         std::string result(static_cast<const char*>(buffer.data()), buffer.size());
         CHECK(result == "HTTP/1.1 404 Not Found\r\n");
     }
+    SECTION("payload_too_large") {
+        auto buffer = to_buffer(StatusType::payload_too_large);
+        std::string result(static_cast<const char*>(buffer.data()), buffer.size());
+        CHECK(result == "HTTP/1.1 413 Payload Too Large\r\n");
+    }
     SECTION("internal_server_error") {
         auto buffer = to_buffer(StatusType::internal_server_error);
         std::string result(static_cast<const char*>(buffer.data()), buffer.size());
@@ -240,6 +245,11 @@ TEST_CASE("Reply stock_reply", "[silkrpc][http][reply]") {
         CHECK(result.status == StatusType::not_found);
         CHECK(result.content == "<html><head><title>Not Found</title></head><body><h1>404 Not Found</h1></body></html>");
     }
+    SECTION("payload_too_large") {
+        auto result = Reply::stock_reply(StatusType::payload_too_large);
+        CHECK(result.status == StatusType::payload_too_large);
+        CHECK(result.content == "<html><head><title>Payload Too Large</title></head><body><h1>413 Payload Too Large</h1></body></html>");
+    }
     SECTION("internal_server_error") {
         auto result = Reply::stock_reply(StatusType::internal_server_error);
         CHECK(result.status == StatusType::internal_server_error);
@@ -39,6 +39,7 @@ struct Request {
     std::vector<Header> headers;
     uint32_t content_length{0};
     std::string content;
+    bool keep_alive{true};
 
     void reset() {
         method.resize(0);
@@ -48,6 +49,7 @@ struct Request {
         headers.resize(0);
         content_length = 0;
         content.resize(0);
+        keep_alive = true;
     }
 };
 
@@ -22,25 +22,44 @@
 
 #include "request_handler.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
-#include <sstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <absl/strings/str_join.h>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <boost/asio/write.hpp>
 #include <jwt-cpp/jwt.h>
 #include <jwt-cpp/traits/nlohmann-json/defaults.h>
 #include <nlohmann/json.hpp>
 
 #include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/concurrency/parallel_group_utils.hpp>
 #include <silkworm/silkrpc/commands/eth_api.hpp>
 #include <silkworm/silkrpc/common/clock_time.hpp>
 #include <silkworm/silkrpc/http/header.hpp>
+#include <silkworm/silkrpc/http/websocket_session.hpp>
+#include <silkworm/silkrpc/json/request_envelope.hpp>
 #include <silkworm/silkrpc/types/writer.hpp>
 
 namespace silkworm::rpc::http {
 
 Task<void> RequestHandler::handle(const http::Request& request) {
+    reply_encoding_ = compression_settings_.enabled ? negotiate_content_encoding(request.headers) : ContentEncoding::kIdentity;
+    keep_alive_ = request.keep_alive;
+
+    if (is_websocket_upgrade(request)) {
+        co_await handle_websocket(request);
+        co_return;
+    }
+
     auto start = clock_time::now();
 
     bool send_reply{true};
@@ -55,6 +74,13 @@ Task<void> RequestHandler::handle(const http::Request& request) {
         if (!auth_result) {
             reply.content = make_json_error(0, 403, auth_result.error()).dump() + "\n";
             reply.status = http::StatusType::unauthorized;
+        } else if (const auto glaze_request{make_glaze_request(request.content)}) {
+            // Requests served by glaze handlers skip the DOM of the whole request, just their id and params are parsed
+            const auto& [glaze_handler, request_json] = *glaze_request;
+            SILK_TRACE << "--> handle RPC request: " << request_json["method"];
+            co_await handle_request(glaze_handler, request_json, reply);
+            SILK_TRACE << "<-- handle RPC request: " << request_json["method"];
+            reply.content += "\n";
         } else {
             const auto request_json = nlohmann::json::parse(request.content);
             if (request_json.is_object()) {
@@ -66,26 +92,7 @@ Task<void> RequestHandler::handle(const http::Request& request) {
                     reply.content += "\n";
                 }
             } else {
-                std::stringstream batch_reply_content;
-                batch_reply_content << "[";
-                int index = 0;
-                for (auto& item : request_json.items()) {
-                    if (index++ > 0) {
-                        batch_reply_content << ",";
-                    }
-
-                    if (!is_valid_jsonrpc(item.value())) {
-                        batch_reply_content << make_json_error(0, -32600, "invalid request").dump();
-                    } else {
-                        http::Reply single_reply;
-                        send_reply = co_await handle_request_and_create_reply(item.value(), single_reply);
-                        batch_reply_content << single_reply.content;
-                    }
-                }
-                batch_reply_content << "]\n";
-
-                reply.status = http::StatusType::ok;
-                reply.content = batch_reply_content.str();
+                send_reply = co_await handle_batch_request_and_create_reply(request_json, reply);
             }
         }
     }
@@ -97,6 +104,39 @@ Task<void> RequestHandler::handle(const http::Request& request) {
     SILK_TRACE << "handle HTTP request t=" << clock_time::since(start) << "ns";
 }
 
+std::optional<std::pair<commands::RpcApiTable::HandleMethodGlaze, nlohmann::json>> RequestHandler::make_glaze_request(std::string_view content) const {
+    const auto envelope{parse_request_envelope(content)};
+    if (!envelope) {
+        return std::nullopt;
+    }
+    // Anything not valid or not served by glaze goes through the full parser, which also builds the error replies
+    const bool valid_jsonrpc{envelope->jsonrpc.empty() || envelope->jsonrpc == "2.0"};
+    const bool valid_id{envelope->id.empty() || envelope->id == "null" || envelope->id.front() == '"' ||
+                        envelope->id.front() == '-' || (envelope->id.front() >= '0' && envelope->id.front() <= '9')};
+    const bool valid_params{envelope->params.empty() || envelope->params.front() == '['};
+    if (!valid_jsonrpc || !valid_id || !valid_params || envelope->method.empty()) {
+        return std::nullopt;
+    }
+    const std::string method{envelope->method};
+    const auto handler{rpc_api_table_.find_json_glaze_handler(method)};
+    if (!handler) {
+        return std::nullopt;
+    }
+
+    nlohmann::json request_json = nlohmann::json::object();
+    if (!envelope->jsonrpc.empty()) {
+        request_json["jsonrpc"] = envelope->jsonrpc;
+    }
+    if (!envelope->id.empty()) {
+        request_json["id"] = nlohmann::json::parse(envelope->id);
+    }
+    request_json["method"] = method;
+    if (!envelope->params.empty()) {
+        request_json["params"] = nlohmann::json::parse(envelope->params);
+    }
+    return std::make_pair(*handler, std::move(request_json));
+}
+
 bool RequestHandler::is_valid_jsonrpc(const nlohmann::json& request_json) {
     const std::string valid_jsonrpc_version = "2.0";
 
@@ -130,6 +170,120 @@ bool RequestHandler::is_valid_jsonrpc(const nlohmann::json& request_json) {
     return true;
 }
 
+bool RequestHandler::is_stream_request(const nlohmann::json& request_json) const {
+    return request_json.is_object() && request_json.contains("method") && request_json["method"].is_string() &&
+           rpc_api_table_.find_stream_handler(request_json["method"].get<std::string>());
+}
+
+Task<void> RequestHandler::handle_websocket(const http::Request& request) {
+    const auto auth_result = is_request_authorized(request);
+    if (!auth_result) {
+        http::Reply reply;
+        reply.content = make_json_error(0, 403, auth_result.error()).dump() + "\n";
+        reply.status = http::StatusType::unauthorized;
+        co_await do_write(reply);
+        co_return;
+    }
+
+    auto session = std::make_shared<WebSocketSession>(socket_, subscription_hub_, [&](const nlohmann::json& request_json) {
+        return handle_message(request_json);
+    });
+    co_await session->run(request);
+
+    boost::system::error_code ec;
+    socket_.close(ec);
+}
+
+Task<std::string> RequestHandler::handle_message(const nlohmann::json& request_json) {
+    // Streaming handlers write HTTP chunks directly to the socket, so they cannot be used over WebSocket
+    const auto is_stream_item = [&](const auto& item) { return is_stream_request(item); };
+    http::Reply reply;
+    if (request_json.is_object()) {
+        if (!is_valid_jsonrpc(request_json)) {
+            reply.content = make_json_error(0, -32600, "invalid request").dump();
+        } else if (is_stream_request(request_json)) {
+            reply.content = make_json_error(request_json, -32601, "the method " + request_json["method"].get<std::string>() + " is not available over websocket").dump();
+        } else {
+            co_await handle_request_and_create_reply(request_json, reply);
+        }
+    } else if (request_json.is_array() && std::any_of(request_json.begin(), request_json.end(), is_stream_item)) {
+        reply.content = make_json_error(0, -32601, "batch including streaming methods is not available over websocket").dump();
+    } else {
+        co_await handle_batch_request_and_create_reply(request_json, reply);
+        if (!reply.content.empty() && reply.content.back() == '\n') {
+            reply.content.pop_back();
+        }
+    }
+    co_return std::move(reply.content);
+}
+
+Task<bool> RequestHandler::handle_batch_request_and_create_reply(const nlohmann::json& request_json, http::Reply& reply) {
+    if (!request_json.is_array()) {
+        reply.status = http::StatusType::bad_request;
+        reply.content = make_json_error(0, -32600, "invalid request").dump() + "\n";
+        co_return true;
+    }
+    const std::size_t batch_size{request_json.size()};
+    if (batch_settings_.max_size > 0 && batch_size > batch_settings_.max_size) {
+        reply.status = http::StatusType::bad_request;
+        reply.content = make_json_error(0, -32600, "batch size " + std::to_string(batch_size) + " exceeds limit " +
+                                                       std::to_string(batch_settings_.max_size))
+                            .dump() +
+                        "\n";
+        co_return true;
+    }
+
+    // Streaming handlers write directly to the socket, so batches including any of them must be handled sequentially
+    std::size_t num_workers{std::clamp<std::size_t>(batch_settings_.max_concurrency, 1, std::max<std::size_t>(batch_size, 1))};
+    if (std::any_of(request_json.begin(), request_json.end(), [&](const auto& item) { return is_stream_request(item); })) {
+        num_workers = 1;
+    }
+
+    // Each worker picks the next pending item, so at most num_workers items are in progress at any time. Concurrent
+    // workers run on the worker pool rather than on the connection executor, so that also items never suspending
+    // (e.g. those just reading from the local database) are handled in parallel
+    std::vector<http::Reply> item_replies(batch_size);
+    std::atomic_size_t next_item{0};
+    std::atomic_bool send_reply{true};
+    auto handle_items = [&]() -> Task<void> {
+        for (std::size_t index{next_item++}; index < batch_size; index = next_item++) {
+            const auto& item{request_json[index]};
+            if (!is_valid_jsonrpc(item)) {
+                item_replies[index].content = make_json_error(0, -32600, "invalid request").dump();
+            } else if (!co_await handle_request_and_create_reply(item, item_replies[index])) {
+                send_reply = false;
+            }
+        }
+    };
+    auto batch_worker = [&](std::size_t /*worker_index*/) -> Task<void> {
+        if (num_workers == 1) {
+            co_await handle_items();
+        } else {
+            co_await boost::asio::co_spawn(rpc_api_.workers(), handle_items(), boost::asio::use_awaitable);
+        }
+    };
+    co_await concurrency::generate_parallel_group_task(num_workers, batch_worker);
+
+    // Assemble the item replies in request order into one buffer sized upfront
+    std::size_t content_size{3};  // brackets plus trailing newline
+    for (const auto& item_reply : item_replies) {
+        content_size += item_reply.content.size() + 1;
+    }
+    reply.content.clear();
+    reply.content.reserve(content_size);
+    reply.content.push_back('[');
+    for (std::size_t i{0}; i < item_replies.size(); ++i) {
+        if (i > 0) {
+            reply.content.push_back(',');
+        }
+        reply.content.append(item_replies[i].content);
+    }
+    reply.content.append("]\n");
+    reply.status = http::StatusType::ok;
+
+    co_return send_reply;
+}
+
 Task<bool> RequestHandler::handle_request_and_create_reply(const nlohmann::json& request_json, http::Reply& reply) {
     if (!request_json.contains("method")) {
         reply.content = make_json_error(request_json, -32600, "invalid request").dump();
@@ -218,9 +372,15 @@ Task<void> RequestHandler::handle_request(commands::RpcApiTable::HandleStream ha
     try {
         SocketWriter socket_writer(socket_);
         ChunksWriter chunks_writer(socket_writer, 0x1FFF);
-        json::Stream stream(chunks_writer);
 
-        co_await write_headers();
+        // The streamed reply size is unknown upfront but typically huge, so compress it whenever the client accepts
+        std::optional<CompressionWriter> compression_writer;
+        if (reply_encoding_ != ContentEncoding::kIdentity) {
+            compression_writer.emplace(chunks_writer, reply_encoding_);
+        }
+        json::Stream stream(compression_writer ? static_cast<Writer&>(*compression_writer) : chunks_writer);
+
+        co_await write_headers(reply_encoding_);
         co_await (rpc_api_.*handler)(request_json, stream);
 
         stream.close();
@@ -280,13 +440,28 @@ RequestHandler::AuthorizationResult RequestHandler::is_request_authorized(const
 //! The number of HTTP headers added when Cross-Origin Resource Sharing (CORS) is enabled.
 static constexpr size_t kCorsNumHeaders{4};
 
+void RequestHandler::set_vary(std::vector<Header>& headers) const {
+    // The reply content coding depends on Accept-Encoding whenever it is negotiated, even if no compression is applied
+    if (compression_settings_.enabled) {
+        headers.emplace_back(http::Header{"Vary", "Accept-Encoding"});
+    }
+}
+
 Task<void> RequestHandler::do_write(Reply& reply) {
     try {
         SILK_DEBUG << "RequestHandler::do_write reply: " << reply.content;
 
-        reply.headers.reserve(allowed_origins_.empty() ? 2 : 2 + kCorsNumHeaders);
+        reply.headers.reserve(allowed_origins_.empty() ? 5 : 5 + kCorsNumHeaders);
+        if (reply_encoding_ != ContentEncoding::kIdentity && reply.content.size() >= compression_settings_.threshold) {
+            reply.content = compress(reply.content, reply_encoding_);
+            reply.headers.emplace_back(http::Header{"Content-Encoding", std::string{to_string(reply_encoding_)}});
+        }
+        set_vary(reply.headers);
         reply.headers.emplace_back(http::Header{"Content-Length", std::to_string(reply.content.size())});
         reply.headers.emplace_back(http::Header{"Content-Type", "application/json"});
+        if (!keep_alive_) {
+            reply.headers.emplace_back(http::Header{"Connection", "close"});
+        }
 
         set_cors(reply.headers);
 
@@ -299,12 +474,19 @@ Task<void> RequestHandler::do_write(Reply& reply) {
     }
 }
 
-Task<void> RequestHandler::write_headers() {
+Task<void> RequestHandler::write_headers(ContentEncoding encoding) {
     try {
         std::vector<http::Header> headers;
-        headers.reserve(allowed_origins_.empty() ? 2 : 2 + kCorsNumHeaders);
+        headers.reserve(allowed_origins_.empty() ? 5 : 5 + kCorsNumHeaders);
         headers.emplace_back(http::Header{"Content-Type", "application/json"});
         headers.emplace_back(http::Header{"Transfer-Encoding", "chunked"});
+        if (encoding != ContentEncoding::kIdentity) {
+            headers.emplace_back(http::Header{"Content-Encoding", std::string{to_string(encoding)}});
+        }
+        set_vary(headers);
+        if (!keep_alive_) {
+            headers.emplace_back(http::Header{"Connection", "close"});
+        }
 
         set_cors(headers);
 
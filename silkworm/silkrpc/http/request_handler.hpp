@@ -18,7 +18,9 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include <silkworm/infra/concurrency/task.hpp>
@@ -30,23 +32,50 @@
 
 #include <silkworm/silkrpc/commands/rpc_api.hpp>
 #include <silkworm/silkrpc/commands/rpc_api_table.hpp>
+#include <silkworm/silkrpc/common/constants.hpp>
+#include <silkworm/silkrpc/core/subscription_hub.hpp>
+#include <silkworm/silkrpc/http/compression.hpp>
 #include <silkworm/silkrpc/http/reply.hpp>
 #include <silkworm/silkrpc/http/request.hpp>
 
 namespace silkworm::rpc::http {
 
+//! The settings for handling JSON-RPC batch requests
+struct BatchSettings {
+    //! The max number of requests in one batch, zero means unlimited
+    std::size_t max_size{kDefaultMaxBatchSize};
+
+    //! The max number of requests in one batch handled concurrently on the worker pool
+    std::size_t max_concurrency{kDefaultBatchConcurrency};
+};
+
+//! The settings for compressing HTTP replies
+struct CompressionSettings {
+    //! Flag indicating if replies are compressed when the client accepts gzip or deflate coding
+    bool enabled{false};
+
+    //! The min size in bytes of non-streamed replies to compress, smaller ones are not worth the effort
+    std::size_t threshold{kDefaultCompressionThreshold};
+};
+
 class RequestHandler {
   public:
     RequestHandler(boost::asio::ip::tcp::socket& socket,
                    commands::RpcApi& rpc_api,
                    const commands::RpcApiTable& rpc_api_table,
                    const std::vector<std::string>& allowed_origins,
-                   std::optional<std::string> jwt_secret)
+                   std::optional<std::string> jwt_secret,
+                   BatchSettings batch_settings = {},
+                   SubscriptionHub* subscription_hub = nullptr,
+                   CompressionSettings compression_settings = {})
         : rpc_api_{rpc_api},
           socket_{socket},
           rpc_api_table_(rpc_api_table),
           jwt_secret_(std::move(jwt_secret)),
-          allowed_origins_(allowed_origins) {}
+          allowed_origins_(allowed_origins),
+          batch_settings_{batch_settings},
+          subscription_hub_{subscription_hub},
+          compression_settings_{compression_settings} {}
 
     RequestHandler(const RequestHandler&) = delete;
     virtual ~RequestHandler() = default;
@@ -56,6 +85,7 @@ class RequestHandler {
 
   protected:
     Task<bool> handle_request_and_create_reply(const nlohmann::json& request_json, http::Reply& reply);
+    Task<bool> handle_batch_request_and_create_reply(const nlohmann::json& request_json, http::Reply& reply);
     virtual Task<void> do_write(http::Reply& reply);
 
   private:
@@ -63,9 +93,23 @@ class RequestHandler {
     using AuthorizationResult = tl::expected<void, AuthorizationError>;
     AuthorizationResult is_request_authorized(const http::Request& request);
     bool is_valid_jsonrpc(const nlohmann::json& request_json);
+    bool is_stream_request(const nlohmann::json& request_json) const;
+
+    //! Build the request for a glaze handler from the request envelope, without parsing the whole request into a DOM
+    //! \return the handler and request or std::nullopt if the request is not valid or not served by a glaze handler
+    std::optional<std::pair<commands::RpcApiTable::HandleMethodGlaze, nlohmann::json>> make_glaze_request(std::string_view content) const;
+
+    //! Upgrade the connection to WebSocket and serve it until closed, the connection cannot go back to HTTP afterwards
+    Task<void> handle_websocket(const http::Request& request);
+
+    //! Handle one JSON-RPC message received over WebSocket, i.e. single or batch request, returning the reply content
+    Task<std::string> handle_message(const nlohmann::json& request_json);
 
     void set_cors(std::vector<Header>& headers);
 
+    //! Add the Vary header for caches whenever the reply content coding is negotiated
+    void set_vary(std::vector<Header>& headers) const;
+
     Task<void> handle_request(
         commands::RpcApiTable::HandleMethod handler,
         const nlohmann::json& request_json,
@@ -75,7 +119,7 @@ class RequestHandler {
         const nlohmann::json& request_json,
         http::Reply& reply);
     Task<void> handle_request(commands::RpcApiTable::HandleStream handler, const nlohmann::json& request_json);
-    Task<void> write_headers();
+    Task<void> write_headers(ContentEncoding encoding);
 
     commands::RpcApi& rpc_api_;
 
@@ -86,6 +130,18 @@ class RequestHandler {
     const std::optional<std::string> jwt_secret_;
 
     const std::vector<std::string>& allowed_origins_;
+
+    const BatchSettings batch_settings_;
+
+    SubscriptionHub* subscription_hub_;
+
+    const CompressionSettings compression_settings_;
+
+    //! The content coding negotiated for the reply to the request being handled
+    ContentEncoding reply_encoding_{ContentEncoding::kIdentity};
+
+    //! Flag indicating if the connection is kept open after the reply to the request being handled
+    bool keep_alive_{true};
 };
 
 }  // namespace silkworm::rpc::http
@@ -0,0 +1,68 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/silkrpc/test/api_test_database.hpp>
+
+namespace {
+
+using namespace silkworm;
+using namespace silkworm::rpc;
+
+constexpr std::size_t kBatchSize{500};
+constexpr std::size_t kNumBlocks{4};  // Look up just the blocks surely present in the test database
+
+//! Build a batch mixing block and receipt queries like the ones sent by indexers
+std::string make_batch_request() {
+    std::string batch_request{"["};
+    for (std::size_t id{0}; id < kBatchSize; ++id) {
+        if (id > 0) batch_request += ",";
+        const auto id_str{std::to_string(id)};
+        const auto block_number{to_hex(id % kNumBlocks + 1, /*with_prefix=*/true)};
+        if (id % 2 == 0) {
+            batch_request += R"({"jsonrpc":"2.0","id":)" + id_str + R"(,"method":"eth_getBlockByNumber","params":[")" + block_number + R"(",true]})";
+        } else {
+            batch_request += R"({"jsonrpc":"2.0","id":)" + id_str + R"(,"method":"eth_getBlockReceipts","params":[")" + block_number + R"("]})";
+        }
+    }
+    batch_request += "]";
+    return batch_request;
+}
+
+//! Batch items run on a worker pool as large as the machine, hence the concurrency level is the only varying factor
+void bench_batch_request(benchmark::State& state) {
+    auto context = test::TestDatabaseContext();
+    test::RpcApiTestBase<test::RequestHandler_ForTest> test_base{context.db, std::max(std::thread::hardware_concurrency(), 1u)};
+    test_base.batch_settings.max_concurrency = static_cast<std::size_t>(state.range(0));
+
+    const auto batch_request{make_batch_request()};
+    for ([[maybe_unused]] auto _ : state) {
+        http::Reply reply;
+        test_base.run<&test::RequestHandler_ForTest::handle_request>(batch_request, reply);
+        benchmark::DoNotOptimize(reply.content.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(kBatchSize));
+}
+
+}  // namespace
+
+BENCHMARK(bench_batch_request)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
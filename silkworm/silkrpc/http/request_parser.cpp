@@ -24,8 +24,12 @@
 
 #include <picohttpparser.h>
 
+#include <array>
 #include <cstdlib>
 #include <cstring>
+#include <string_view>
+
+#include <boost/algorithm/string/predicate.hpp>
 
 namespace silkworm::rpc::http {
 
@@ -35,93 +39,128 @@ constexpr std::size_t kDefaultHttpBufferSize{65536};
 //! The maximum number of HTTP headers supported by the parser
 constexpr std::size_t kMaxHttpHeaders{100};
 
+//! The HTTP headers kept in the request: authorization, content negotiation and the ones needed by WebSocket opening handshake
+constexpr std::array<std::string_view, 6> kKeptHttpHeaders{
+    "Authorization",
+    "Accept-Encoding",
+    "Connection",
+    "Upgrade",
+    "Sec-WebSocket-Key",
+    "Sec-WebSocket-Version",
+};
+
+static bool is_kept_header(std::string_view header_name) {
+    for (const auto kept_header : kKeptHttpHeaders) {
+        if (boost::algorithm::iequals(header_name, kept_header)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//! Check if the connection must be closed after the reply according to the request version and Connection header
+static bool is_keep_alive(const Request& req) {
+    for (const auto& header : req.headers) {
+        if (boost::algorithm::iequals(header.name, "Connection")) {
+            if (boost::algorithm::icontains(header.value, "close")) {
+                return false;
+            }
+            if (boost::algorithm::icontains(header.value, "keep-alive")) {
+                return true;
+            }
+        }
+    }
+    // HTTP/1.1 connections are persistent by default, HTTP/1.0 ones are not
+    return req.http_version_major > 1 || (req.http_version_major == 1 && req.http_version_minor >= 1);
+}
+
+RequestParser::RequestParser(std::size_t max_content_length) : max_content_length_{max_content_length} {
+    buffer_.reserve(kDefaultHttpBufferSize);
+}
+
 void RequestParser::reset() {
     prev_len_ = 0;
+    header_length_ = 0;
+    consumed_ = 0;
     buffer_.clear();
 }
 
-RequestParser::RequestParser() {
-    buffer_.resize(kDefaultHttpBufferSize);
-}
-
 RequestParser::ResultType RequestParser::parse(Request& req, const char* begin, const char* end) {
-    auto current_len = static_cast<size_t>(end - begin);
+    buffer_.insert(buffer_.end(), begin, end);
 
-    if (req.content_length != 0 && req.content.length() < req.content_length) {
-        for (size_t i{0}; i < current_len; i++) {
-            req.content.push_back(begin[i]);
-        }
-        if (req.content.length() < req.content_length)
-            return ResultType::indeterminate;
-        else
-            return ResultType::good;
+    const auto result = parse_received(req, {buffer_.data(), buffer_.size()});
+    if (result == ResultType::good) {
+        buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(consumed_));
     }
+    return result;
+}
 
-    if (prev_len_) {
-        for (size_t i = 0; i < current_len; i++) {
-            buffer_.push_back(*begin++);
+RequestParser::ResultType RequestParser::parse_received(Request& req, std::string_view received) {
+    if (header_length_ == 0) {
+        if (received.empty()) {
+            return ResultType::indeterminate;
         }
-        begin = buffer_.data();
-        current_len = buffer_.size();
-    }
 
-    const char* method_name;  // uninitialised here because phr_parse_request initialises it
-    size_t method_len;        // uninitialised here because phr_parse_request initialises it
-    const char* path;         // uninitialised here because phr_parse_request initialises it
-    size_t path_len;          // uninitialised here because phr_parse_request initialises it
-    int minor_version;        // uninitialised here because phr_parse_request initialises it
-    struct phr_header headers[kMaxHttpHeaders];
-    size_t num_headers = sizeof(headers) / sizeof(headers[0]);
-
-    const auto res = phr_parse_request(begin, current_len, &method_name, &method_len, &path, &path_len, &minor_version, headers, &num_headers, prev_len_);
-    if (res == -1) {
-        return ResultType::bad;
-    } else if (res == -2) {
-        buffer_.clear();
-        for (size_t i = 0; i < current_len; i++) {
-            buffer_.push_back(*begin++);
+        const char* method_name;  // uninitialised here because phr_parse_request initialises it
+        size_t method_len;        // uninitialised here because phr_parse_request initialises it
+        const char* path;         // uninitialised here because phr_parse_request initialises it
+        size_t path_len;          // uninitialised here because phr_parse_request initialises it
+        int minor_version;        // uninitialised here because phr_parse_request initialises it
+        struct phr_header headers[kMaxHttpHeaders];
+        size_t num_headers = sizeof(headers) / sizeof(headers[0]);
+
+        const auto res = phr_parse_request(received.data(), received.size(), &method_name, &method_len, &path, &path_len, &minor_version, headers, &num_headers, prev_len_);
+        if (res == -1) {
+            return ResultType::bad;
+        } else if (res == -2) {
+            // Request line plus headers cannot grow indefinitely
+            if (received.size() > kDefaultHttpBufferSize) {
+                return ResultType::bad;
+            }
+            prev_len_ = received.size();
+            return ResultType::indeterminate;
         }
-        prev_len_ = buffer_.size();
-        return ResultType::indeterminate;
-    }
 
-    req.http_version_minor = minor_version;
-
-    bool expect_request{false};
-    bool content_length_present{false};
-    for (size_t i{0}; i < num_headers; ++i) {
-        const auto& header{headers[i]};
-        if (header.name_len == 0) continue;
-        if (std::memcmp(header.name, "Content-Length", std::min(header.name_len, sizeof("Content-Length"))) == 0) {
-            req.content_length = static_cast<uint32_t>(atoi(header.value));
-            content_length_present = true;
-        } else if (std::memcmp(header.name, "Expect", std::min(header.name_len, sizeof("Expect"))) == 0) {
-            expect_request = true;
-        } else if (std::memcmp(header.name, "Authorization", std::min(header.name_len, sizeof("Authorization"))) == 0) {
-            req.headers.emplace_back();
-            for (size_t index = 0; index < static_cast<size_t>(header.name_len); index++) {
-                req.headers.back().name.push_back(header.name[index]);
-            }
-            for (size_t index = 0; index < static_cast<size_t>(header.value_len); index++) {
-                req.headers.back().value.push_back(header.value[index]);
+        req.method.assign(method_name, method_len);
+        req.uri.assign(path, path_len);
+        req.http_version_minor = minor_version;
+
+        bool expect_request{false};
+        for (size_t i{0}; i < num_headers; ++i) {
+            const auto& header{headers[i]};
+            if (header.name_len == 0) continue;
+            const std::string_view header_name{header.name, header.name_len};
+            if (boost::algorithm::iequals(header_name, "Content-Length")) {
+                req.content_length = static_cast<uint32_t>(atoi(header.value));
+            } else if (boost::algorithm::iequals(header_name, "Expect")) {
+                expect_request = true;
+            } else if (is_kept_header(header_name)) {
+                req.headers.emplace_back();
+                req.headers.back().name.assign(header.name, header.name_len);
+                req.headers.back().value.assign(header.value, header.value_len);
             }
         }
-    }
+        req.keep_alive = is_keep_alive(req);
 
-    if (!content_length_present || req.content_length == 0) {
-        return ResultType::good;
-    }
+        prev_len_ = 0;
+        header_length_ = static_cast<std::size_t>(res);
 
-    req.content.resize(current_len - static_cast<size_t>(res));
-    std::memcpy(req.content.data(), begin + res, current_len - static_cast<size_t>(res));
+        if (req.content_length > max_content_length_) {
+            return ResultType::content_too_large;
+        }
+        if (expect_request && req.content_length > 0) {
+            return ResultType::processing_continue;
+        }
+    }
 
-    if (expect_request) {
-        return ResultType::processing_continue;
-    } else if (req.content.length() < req.content_length) {
+    if (received.size() < header_length_ + req.content_length) {
         return ResultType::indeterminate;
-    } else {
-        return ResultType::good;
     }
+
+    req.content.assign(received.data() + header_length_, req.content_length);
+    consumed_ = header_length_ + req.content_length;
+    header_length_ = 0;
+    return ResultType::good;
 }
 
 }  // namespace silkworm::rpc::http
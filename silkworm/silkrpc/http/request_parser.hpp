@@ -16,6 +16,13 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <silkworm/silkrpc/common/constants.hpp>
+
 #include "request.hpp"
 
 namespace silkworm::rpc::http {
@@ -23,27 +30,51 @@ namespace silkworm::rpc::http {
 //! Parser for incoming requests.
 class RequestParser {
   public:
-    RequestParser();
+    explicit RequestParser(std::size_t max_content_length = kDefaultMaxRequestContentLength);
+
     //! Result of parse.
     enum class ResultType {
         good,
         bad,
         indeterminate,
-        processing_continue
+        processing_continue,
+        content_too_large
     };
 
     /**
      * Parse some data. The enum return value is good when a complete request has
      * been parsed, bad if the data is invalid, indeterminate when more data is
-     * required. The InputIterator return value indicates how much of the input
-     * has been consumed.
+     * required. The data is copied into the parser until the request is complete.
      */
     ResultType parse(Request& req, const char* begin, const char* end);
 
+    /**
+     * Parse the request at the head of the received data, i.e. all the bytes received and not consumed yet, without
+     * copying them until the request is complete. When the result is indeterminate, the whole received data must be
+     * provided again after more bytes have arrived. When the result is good, the request is made up of the first
+     * consumed() bytes, which can be discarded and any following byte belongs to the next pipelined request.
+     */
+    ResultType parse_received(Request& req, std::string_view received);
+
+    //! The number of bytes making up the last request parsed as good
+    [[nodiscard]] std::size_t consumed() const { return consumed_; }
+
     void reset();
 
   private:
-    uint64_t prev_len_{0};
+    //! The max accepted request content length in bytes
+    std::size_t max_content_length_;
+
+    //! The length of received data already inspected by a previous incomplete header parsing
+    std::size_t prev_len_{0};
+
+    //! The length of request line plus headers, zero until they are completely parsed
+    std::size_t header_length_{0};
+
+    //! The number of bytes of the last good request
+    std::size_t consumed_{0};
+
+    //! The data accumulated by incremental parse calls
     std::vector<char> buffer_;
 };
 
@@ -19,6 +19,8 @@
 #include <array>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <catch2/catch.hpp>
@@ -159,6 +161,37 @@ TEST_CASE("parse", "[silkrpc][http][request_parser]") {
         }
     }
 
+    SECTION("websocket upgrade request") {
+        const std::string s{
+            "GET /ws HTTP/1.1\r\nHost: localhost:8545\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+            "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nsec-websocket-version: 13\r\nUser-Agent: wscat\r\n\r\n"};
+        RequestParser parser;
+        Request req;
+        const auto result{parser.parse(req, s.data(), s.data() + s.size())};
+        CHECK(result == RequestParser::ResultType::good);
+        CHECK(req.method == "GET");
+        CHECK(req.uri == "/ws");
+        REQUIRE(req.headers.size() == 4);
+        CHECK(req.headers[0].name == "Upgrade");
+        CHECK(req.headers[0].value == "websocket");
+        CHECK(req.headers[2].value == "dGhlIHNhbXBsZSBub25jZQ==");
+        CHECK(req.headers[3].name == "sec-websocket-version");
+        CHECK(req.headers[3].value == "13");
+    }
+
+    SECTION("accept encoding header") {
+        const std::string s{
+            "POST / HTTP/1.1\r\nHost: localhost:8545\r\nAccept: */*\r\naccept-encoding: gzip, deflate\r\n"
+            "Content-Type: application/json\r\nContent-Length: 0\r\n\r\n"};
+        RequestParser parser;
+        Request req;
+        const auto result{parser.parse(req, s.data(), s.data() + s.size())};
+        CHECK(result == RequestParser::ResultType::good);
+        REQUIRE(req.headers.size() == 1);
+        CHECK(req.headers[0].name == "accept-encoding");
+        CHECK(req.headers[0].value == "gzip, deflate");
+    }
+
     SECTION("segemented http request 2 segs") {
         std::string seg1{"POST / HTTP/1.9\r\nHost: localhost:8545\r\n User-Agent: curl/7.68.0\r\n Accept: */*\r\n"};
         std::string seg2{"Content-Type: application/json\r\nContent-Length: 0\r\n\r\n}"};
@@ -217,6 +250,85 @@ TEST_CASE("parse", "[silkrpc][http][request_parser]") {
     }
 }
 
+TEST_CASE("parse_received", "[silkrpc][http][request_parser]") {
+    SECTION("pipelined requests") {
+        const std::string s{
+            "POST / HTTP/1.1\r\nContent-Length: 15\r\n\r\n{\"json\": \"2.0\"}"
+            "POST / HTTP/1.1\r\ncontent-length: 2\r\n\r\n[]"
+            "POST / HTTP/1.1\r\nContent-Length: 4\r\n\r\n{"};
+        RequestParser parser;
+        std::string_view received{s};
+
+        Request req1;
+        CHECK(parser.parse_received(req1, received) == RequestParser::ResultType::good);
+        CHECK(req1.content == "{\"json\": \"2.0\"}");
+        received.remove_prefix(parser.consumed());
+
+        Request req2;
+        CHECK(parser.parse_received(req2, received) == RequestParser::ResultType::good);
+        CHECK(req2.content == "[]");
+        received.remove_prefix(parser.consumed());
+
+        Request req3;
+        CHECK(parser.parse_received(req3, received) == RequestParser::ResultType::indeterminate);
+        const std::string more_received{std::string{received} + "\"a\"}"};
+        CHECK(parser.parse_received(req3, more_received) == RequestParser::ResultType::good);
+        CHECK(req3.content == "{\"a\"}");
+        CHECK(parser.consumed() == more_received.size());
+    }
+
+    SECTION("incomplete headers") {
+        const std::string s{"POST / HTTP/1.1\r\nContent-Length: 2\r\n\r\n[]"};
+        RequestParser parser;
+        Request req;
+        CHECK(parser.parse_received(req, std::string_view{s}.substr(0, 20)) == RequestParser::ResultType::indeterminate);
+        CHECK(parser.parse_received(req, std::string_view{s}.substr(0, 38)) == RequestParser::ResultType::indeterminate);
+        CHECK(parser.parse_received(req, s) == RequestParser::ResultType::good);
+        CHECK(req.content == "[]");
+        CHECK(parser.consumed() == s.size());
+    }
+
+    SECTION("continue request") {
+        const std::string s{"POST / HTTP/1.1\r\nExpect: 100-continue\r\nContent-Length: 2\r\n\r\n"};
+        RequestParser parser;
+        Request req;
+        CHECK(parser.parse_received(req, s) == RequestParser::ResultType::processing_continue);
+        CHECK(parser.parse_received(req, s) == RequestParser::ResultType::indeterminate);
+        CHECK(parser.parse_received(req, s + "[]") == RequestParser::ResultType::good);
+        CHECK(req.content == "[]");
+    }
+
+    SECTION("content too large") {
+        const std::string s{"POST / HTTP/1.1\r\nContent-Length: 1025\r\n\r\n"};
+        RequestParser parser{1024};
+        Request req;
+        CHECK(parser.parse_received(req, s) == RequestParser::ResultType::content_too_large);
+    }
+
+    SECTION("headers too large") {
+        const std::string s{"POST / HTTP/1.1\r\nX-Padding: " + std::string(70'000, 'a')};
+        RequestParser parser;
+        Request req;
+        CHECK(parser.parse_received(req, s) == RequestParser::ResultType::bad);
+    }
+
+    SECTION("keep alive") {
+        const std::vector<std::pair<std::string, bool>> requests{
+            {"POST / HTTP/1.1\r\n\r\n", true},
+            {"POST / HTTP/1.1\r\nConnection: close\r\n\r\n", false},
+            {"POST / HTTP/1.1\r\nconnection: Close\r\n\r\n", false},
+            {"POST / HTTP/1.0\r\n\r\n", false},
+            {"POST / HTTP/1.0\r\nConnection: keep-alive\r\n\r\n", true},
+        };
+        for (const auto& [s, keep_alive] : requests) {
+            RequestParser parser;
+            Request req;
+            CHECK(parser.parse_received(req, s) == RequestParser::ResultType::good);
+            CHECK(req.keep_alive == keep_alive);
+        }
+    }
+}
+
 TEST_CASE("reset", "[silkrpc][http][request_parser]") {
     RequestParser parser;
 
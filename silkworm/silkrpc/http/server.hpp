@@ -34,6 +34,7 @@
 
 #include <silkworm/infra/grpc/client/client_context_pool.hpp>
 #include <silkworm/silkrpc/commands/rpc_api_table.hpp>
+#include <silkworm/silkrpc/http/connection.hpp>
 #include <silkworm/silkrpc/http/request_handler.hpp>
 
 namespace silkworm::rpc::http {
@@ -50,7 +51,10 @@ class Server {
                     boost::asio::io_context& io_context,
                     boost::asio::thread_pool& workers,
                     std::vector<std::string> allowed_origins,
-                    std::optional<std::string> jwt_secret);
+                    std::optional<std::string> jwt_secret,
+                    BatchSettings batch_settings = {},
+                    CompressionSettings compression_settings = {},
+                    ConnectionSettings connection_settings = {});
 
     void start();
 
@@ -78,6 +82,15 @@ class Server {
 
     //! The JSON Web Token (JWT) secret for secure channel communication
     std::optional<std::string> jwt_secret_;
+
+    //! The settings for handling JSON-RPC batch requests
+    BatchSettings batch_settings_;
+
+    //! The settings for compressing HTTP replies
+    CompressionSettings compression_settings_;
+
+    //! The settings for HTTP/1.1 persistent connections
+    ConnectionSettings connection_settings_;
 };
 
 }  // namespace silkworm::rpc::http
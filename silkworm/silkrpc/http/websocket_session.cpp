@@ -0,0 +1,188 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "websocket_session.hpp"
+
+#include <array>
+#include <string_view>
+#include <utility>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/silkrpc/json/types.hpp>
+
+namespace silkworm::rpc::http {
+
+//! The closing part of every subscription notification, after the shared payload
+static constexpr std::string_view kNotificationTrailer{"}}"};
+
+bool is_websocket_upgrade(const Request& request) {
+    if (request.method != "GET") {
+        return false;
+    }
+    for (const auto& header : request.headers) {
+        if (boost::algorithm::iequals(header.name, "Upgrade") && boost::algorithm::iequals(header.value, "websocket")) {
+            return true;
+        }
+    }
+    return false;
+}
+
+WebSocketSession::WebSocketSession(boost::asio::ip::tcp::socket& socket, SubscriptionHub* subscription_hub, MessageHandler message_handler)
+    : stream_{socket},
+      subscription_hub_{subscription_hub},
+      message_handler_{std::move(message_handler)},
+      outgoing_messages_{socket.get_executor(), kWebSocketOutgoingQueueSize} {}
+
+WebSocketSession::~WebSocketSession() {
+    if (subscription_hub_) {
+        subscription_hub_->unsubscribe_all(*this);
+    }
+}
+
+Task<void> WebSocketSession::run(const Request& upgrade_request) {
+    boost::beast::http::request<boost::beast::http::empty_body> handshake_request;
+    handshake_request.method_string(upgrade_request.method);
+    handshake_request.target(upgrade_request.uri);
+    handshake_request.version(upgrade_request.http_version_major * 10 + upgrade_request.http_version_minor);
+    for (const auto& header : upgrade_request.headers) {
+        handshake_request.set(header.name, header.value);
+    }
+
+    auto timeout{boost::beast::websocket::stream_base::timeout::suggested(boost::beast::role_type::server)};
+    timeout.keep_alive_pings = true;  // subscribers may stay silent for long, so ping them instead of closing when idle
+    stream_.set_option(timeout);
+    stream_.text(true);
+
+    try {
+        co_await stream_.async_accept(handshake_request, boost::asio::use_awaitable);
+        SILK_DEBUG << "WebSocketSession::run handshake completed";
+
+        // The reader stops on close or error and the writer is cancelled then
+        using namespace boost::asio::experimental::awaitable_operators;
+        co_await (read_loop() || write_loop());
+    } catch (const boost::system::system_error& se) {
+        SILK_DEBUG << "WebSocketSession::run closed: " << se.what();
+    }
+    outgoing_messages_.close();
+}
+
+bool WebSocketSession::notify(const std::string& subscription_id, const SharedPayload& payload) {
+    std::string content{R"({"jsonrpc":"2.0","method":"eth_subscription","params":{"subscription":")"};
+    content.append(subscription_id);
+    content.append(R"(","result":)");
+    return outgoing_messages_.try_send(OutgoingMessage{std::move(content), payload});
+}
+
+Task<void> WebSocketSession::read_loop() {
+    boost::beast::flat_buffer buffer;
+    while (true) {
+        co_await stream_.async_read(buffer, boost::asio::use_awaitable);
+        const auto message{boost::beast::buffers_to_string(buffer.data())};
+        buffer.consume(buffer.size());
+        SILK_TRACE << "WebSocketSession::read_loop message: " << message;
+
+        auto reply_content{co_await handle_message(message)};
+        co_await outgoing_messages_.send(OutgoingMessage{std::move(reply_content), nullptr});
+    }
+}
+
+Task<void> WebSocketSession::write_loop() {
+    while (true) {
+        const auto message{co_await outgoing_messages_.receive()};
+        if (message.payload) {
+            // Just the subscription-specific content is copied, the payload is shared among all the subscribers
+            const std::array<boost::asio::const_buffer, 3> buffers{
+                boost::asio::buffer(message.content),
+                boost::asio::buffer(*message.payload),
+                boost::asio::buffer(kNotificationTrailer)};
+            co_await stream_.async_write(buffers, boost::asio::use_awaitable);
+        } else {
+            co_await stream_.async_write(boost::asio::buffer(message.content), boost::asio::use_awaitable);
+        }
+    }
+}
+
+Task<std::string> WebSocketSession::handle_message(const std::string& message) {
+    nlohmann::json request_json;
+    try {
+        request_json = nlohmann::json::parse(message);
+    } catch (const nlohmann::json::parse_error& pe) {
+        SILK_DEBUG << "WebSocketSession::handle_message invalid JSON: " << pe.what();
+        co_return make_json_error(0, -32700, "parse error").dump();
+    }
+
+    if (request_json.is_object() && request_json.contains("method") && request_json["method"].is_string()) {
+        const auto method{request_json["method"].get<std::string>()};
+        if (method == "eth_subscribe") {
+            co_return handle_subscribe(request_json);
+        }
+        if (method == "eth_unsubscribe") {
+            co_return handle_unsubscribe(request_json);
+        }
+    }
+    co_return co_await message_handler_(request_json);
+}
+
+std::string WebSocketSession::handle_subscribe(const nlohmann::json& request_json) {
+    if (!subscription_hub_) {
+        return make_json_error(request_json, -32601, "subscriptions not available").dump();
+    }
+    const auto params = request_json.contains("params") ? request_json["params"] : nlohmann::json::array();
+    if (!params.is_array() || params.empty() || !params[0].is_string()) {
+        return make_json_error(request_json, -32602, "invalid eth_subscribe params: " + params.dump()).dump();
+    }
+    const auto kind_name{params[0].get<std::string>()};
+    const auto kind{parse_subscription_kind(kind_name)};
+    if (!kind) {
+        return make_json_error(request_json, -32602, "unsupported subscription: " + kind_name).dump();
+    }
+    Filter filter;
+    if (*kind == SubscriptionKind::kLogs && params.size() > 1) {
+        try {
+            filter = params[1].get<Filter>();
+        } catch (const std::exception& e) {
+            return make_json_error(request_json, -32602, "invalid logs filter: " + std::string{e.what()}).dump();
+        }
+    }
+
+    const auto subscription_id{subscription_hub_->subscribe(*kind, filter, shared_from_this())};
+    if (!subscription_id) {
+        return make_json_error(request_json, -32000, "too many subscriptions").dump();
+    }
+    SILK_DEBUG << "WebSocketSession::handle_subscribe " << kind_name << " subscription: " << *subscription_id;
+    return make_json_content(request_json, *subscription_id).dump();
+}
+
+std::string WebSocketSession::handle_unsubscribe(const nlohmann::json& request_json) {
+    const auto params = request_json.contains("params") ? request_json["params"] : nlohmann::json::array();
+    if (!params.is_array() || params.size() != 1 || !params[0].is_string()) {
+        return make_json_error(request_json, -32602, "invalid eth_unsubscribe params: " + params.dump()).dump();
+    }
+    const bool removed{subscription_hub_ && subscription_hub_->unsubscribe(params[0].get<std::string>(), *this)};
+    return make_json_content(request_json, removed).dump();
+}
+
+}  // namespace silkworm::rpc::http
@@ -0,0 +1,88 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <silkworm/infra/concurrency/task.hpp>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/websocket/stream.hpp>
+#include <nlohmann/json.hpp>
+
+#include <silkworm/infra/concurrency/channel.hpp>
+#include <silkworm/silkrpc/core/subscription_hub.hpp>
+#include <silkworm/silkrpc/http/request.hpp>
+
+namespace silkworm::rpc::http {
+
+//! The max number of outgoing messages waiting to be sent on one WebSocket connection
+constexpr std::size_t kWebSocketOutgoingQueueSize{1024};
+
+//! Check if the request asks to upgrade the connection to the WebSocket protocol
+bool is_websocket_upgrade(const Request& request);
+
+//! Represents a WebSocket connection from a client, upgraded from HTTP. It serves JSON-RPC requests like the
+//! HTTP connection does plus eth_subscribe/eth_unsubscribe, whose notifications are pushed by the subscription hub.
+class WebSocketSession : public SubscriptionSink, public std::enable_shared_from_this<WebSocketSession> {
+  public:
+    //! The handler of JSON-RPC requests other than subscription ones, returning the reply content
+    using MessageHandler = std::function<Task<std::string>(const nlohmann::json&)>;
+
+    WebSocketSession(boost::asio::ip::tcp::socket& socket, SubscriptionHub* subscription_hub, MessageHandler message_handler);
+    ~WebSocketSession() override;
+
+    WebSocketSession(const WebSocketSession&) = delete;
+    WebSocketSession& operator=(const WebSocketSession&) = delete;
+
+    //! Complete the opening handshake replying to the upgrade request, then serve messages until the connection is closed
+    Task<void> run(const Request& upgrade_request);
+
+    //! Queue the notification for sending, called by the subscription hub from any thread
+    bool notify(const std::string& subscription_id, const SharedPayload& payload) override;
+
+  private:
+    //! The message to be sent: a reply has just the content, whilst a notification has the content specific for
+    //! the subscription followed by the payload shared among all the subscribers
+    struct OutgoingMessage {
+        std::string content;
+        SharedPayload payload;
+    };
+
+    Task<void> read_loop();
+    Task<void> write_loop();
+
+    Task<std::string> handle_message(const std::string& message);
+    std::string handle_subscribe(const nlohmann::json& request_json);
+    std::string handle_unsubscribe(const nlohmann::json& request_json);
+
+    //! The WebSocket stream layered over the connection socket
+    boost::beast::websocket::stream<boost::asio::ip::tcp::socket&> stream_;
+
+    //! The registry of subscriptions or nullptr if subscriptions are not available
+    SubscriptionHub* subscription_hub_;
+
+    //! The handler used to process the incoming requests
+    MessageHandler message_handler_;
+
+    //! The queue of replies and notifications waiting to be sent, so that writes never overlap
+    concurrency::Channel<OutgoingMessage> outgoing_messages_;
+};
+
+}  // namespace silkworm::rpc::http
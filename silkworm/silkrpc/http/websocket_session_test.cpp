@@ -0,0 +1,52 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "websocket_session.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::rpc::http {
+
+TEST_CASE("is_websocket_upgrade", "[silkrpc][http][websocket_session]") {
+    Request request{.method = "GET", .uri = "/", .http_version_minor = 1};
+
+    SECTION("plain HTTP request") {
+        CHECK(!is_websocket_upgrade(request));
+    }
+
+    SECTION("upgrade request") {
+        request.headers = {{"Connection", "Upgrade"}, {"Upgrade", "websocket"}};
+        CHECK(is_websocket_upgrade(request));
+    }
+
+    SECTION("upgrade request case insensitive") {
+        request.headers = {{"connection", "upgrade"}, {"upgrade", "WebSocket"}};
+        CHECK(is_websocket_upgrade(request));
+    }
+
+    SECTION("upgrade to other protocol") {
+        request.headers = {{"Connection", "Upgrade"}, {"Upgrade", "h2c"}};
+        CHECK(!is_websocket_upgrade(request));
+    }
+
+    SECTION("upgrade request with POST") {
+        request.method = "POST";
+        request.headers = {{"Connection", "Upgrade"}, {"Upgrade", "websocket"}};
+        CHECK(!is_websocket_upgrade(request));
+    }
+}
+
+}  // namespace silkworm::rpc::http
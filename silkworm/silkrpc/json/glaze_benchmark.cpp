@@ -0,0 +1,213 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/silkrpc/json/types.hpp>
+
+namespace {
+
+using namespace silkworm;
+using namespace silkworm::rpc;
+using namespace evmc::literals;
+
+constexpr std::size_t kNumTransactions{180};  // Typical mainnet block after London fork
+constexpr std::size_t kNumLogsPerReceipt{2};
+
+const nlohmann::json kRequest = R"({"jsonrpc":"2.0","id":1,"method":"eth_getBlockByNumber","params":["0x1036640",true]})"_json;
+
+//! Build a block resembling mainnet ones: mostly EIP-1559 transactions with some legacy and access list ones,
+//! calldata ranging from token transfers to contract interactions
+rpc::Block make_block() {
+    rpc::Block block;
+    block.hash = 0x6de42f4c0d3b43d7b88a1bb4d7aa1c2b6a4d4bd9eb2b6c6ddb7e4e2a1e86f3c3_bytes32;
+    block.total_difficulty = intx::from_string<intx::uint256>("58750003716598352816469");
+    block.full_tx = true;
+    auto& header{block.block.header};
+    header.number = 17'000'000;
+    header.parent_hash = 0x2c5d9d4e8b1c8b0f1b8a3d6e0f7a9c4b5d6e7f8091a2b3c4d5e6f708192a3b4c_bytes32;
+    header.beneficiary = 0x388c818ca8b9251b393131c08a736a67ccb19297_address;
+    header.gas_limit = 30'000'000;
+    header.gas_used = 15'000'000;
+    header.timestamp = 1'681'338'455;
+    header.base_fee_per_gas = 20 * kGiga;
+    header.extra_data = *from_hex("6265617665726275696c642e6f7267");
+
+    auto& transactions{block.block.transactions};
+    transactions.reserve(kNumTransactions);
+    for (std::size_t i{0}; i < kNumTransactions; ++i) {
+        Transaction txn;
+        txn.type = i % 4 == 0 ? TransactionType::kLegacy : TransactionType::kDynamicFee;
+        txn.chain_id = 1;
+        txn.nonce = 100 + i;
+        txn.max_priority_fee_per_gas = 2 * kGiga;
+        txn.max_fee_per_gas = txn.type == TransactionType::kLegacy ? 25 * kGiga : 40 * kGiga;
+        txn.gas_limit = 21'000 + 10'000 * (i % 20);
+        txn.to = 0xdac17f958d2ee523a2206206994597c13d831ec7_address;
+        txn.value = i % 5 == 0 ? kEther / 10 : 0;
+        txn.data = Bytes(i % 3 == 0 ? 68 : (i % 3 == 1 ? 132 : 1'028), static_cast<uint8_t>(i));
+        if (i % 10 == 1) {
+            txn.type = TransactionType::kAccessList;
+            txn.access_list = {{0xdac17f958d2ee523a2206206994597c13d831ec7_address,
+                                {0x0000000000000000000000000000000000000000000000000000000000000003_bytes32,
+                                 0x0000000000000000000000000000000000000000000000000000000000000007_bytes32}}};
+        }
+        txn.odd_y_parity = i % 2 == 1;
+        txn.r = intx::from_string<intx::uint256>("0x36b241b061a36a32ab7fe86c7aa9eb592dd59018cd0443adc0903590c16b02b0");
+        txn.s = intx::from_string<intx::uint256>("0x5edcc541b4741c5cc6dd347c5ed9577ef293a62787b4510465fadbfe39ee4094");
+        txn.from = 0x68d7b0a3a4ec1bb0d7a6b0f3c2a8e4ad6e9a1c52_address;
+        (void)txn.hash();  // cache the hash, it's not part of the serialisation cost
+        transactions.push_back(std::move(txn));
+    }
+    return block;
+}
+
+//! Build the receipts for the specified block, each one with some ERC20 Transfer-like logs
+Receipts make_receipts(const rpc::Block& block) {
+    Receipts receipts;
+    receipts.reserve(block.block.transactions.size());
+    uint64_t cumulative_gas_used{0};
+    for (std::size_t i{0}; i < block.block.transactions.size(); ++i) {
+        const auto& txn{block.block.transactions[i]};
+        Receipt receipt;
+        receipt.success = true;
+        receipt.gas_used = txn.gas_limit / 2;
+        cumulative_gas_used += receipt.gas_used;
+        receipt.cumulative_gas_used = cumulative_gas_used;
+        receipt.tx_hash = txn.hash();
+        receipt.block_hash = block.hash;
+        receipt.block_number = block.block.header.number;
+        receipt.tx_index = static_cast<uint32_t>(i);
+        receipt.from = txn.from;
+        receipt.to = txn.to;
+        receipt.type = static_cast<uint8_t>(txn.type);
+        receipt.effective_gas_price = txn.effective_gas_price(*block.block.header.base_fee_per_gas);
+        for (std::size_t j{0}; j < kNumLogsPerReceipt; ++j) {
+            receipt.logs.push_back(Log{
+                .address = *txn.to,
+                .topics = {0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef_bytes32,
+                           0x00000000000000000000000068d7b0a3a4ec1bb0d7a6b0f3c2a8e4ad6e9a1c52_bytes32,
+                           0x000000000000000000000000388c818ca8b9251b393131c08a736a67ccb19297_bytes32},
+                .data = Bytes(32, static_cast<uint8_t>(j)),
+                .block_number = receipt.block_number,
+                .tx_hash = receipt.tx_hash,
+                .tx_index = receipt.tx_index,
+                .block_hash = receipt.block_hash,
+                .index = static_cast<uint32_t>(i * kNumLogsPerReceipt + j),
+            });
+        }
+        receipt.bloom = bloom_from_logs(receipt.logs);
+        receipts.push_back(std::move(receipt));
+    }
+    return receipts;
+}
+
+void bench_block_nlohmann(benchmark::State& state) {
+    const auto block{make_block()};
+    std::size_t reply_size{0};
+    for ([[maybe_unused]] auto _ : state) {
+        const std::string reply{make_json_content(kRequest, block).dump()};
+        benchmark::DoNotOptimize(reply.data());
+        reply_size = reply.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(reply_size));
+}
+
+void bench_block_glaze(benchmark::State& state) {
+    const auto block{make_block()};
+    std::size_t reply_size{0};
+    for ([[maybe_unused]] auto _ : state) {
+        std::string reply;
+        make_glaze_json_content(kRequest, block, reply);
+        benchmark::DoNotOptimize(reply.data());
+        reply_size = reply.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(reply_size));
+}
+
+void bench_receipts_nlohmann(benchmark::State& state) {
+    const auto receipts{make_receipts(make_block())};
+    std::size_t replies_size{0};
+    for ([[maybe_unused]] auto _ : state) {
+        replies_size = 0;
+        for (const auto& receipt : receipts) {
+            const std::string reply{make_json_content(kRequest, receipt).dump()};
+            benchmark::DoNotOptimize(reply.data());
+            replies_size += reply.size();
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(replies_size));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(receipts.size()));
+}
+
+void bench_receipts_glaze(benchmark::State& state) {
+    const auto receipts{make_receipts(make_block())};
+    std::size_t replies_size{0};
+    for ([[maybe_unused]] auto _ : state) {
+        replies_size = 0;
+        for (const auto& receipt : receipts) {
+            std::string reply;
+            make_glaze_json_content(kRequest, receipt, reply);
+            benchmark::DoNotOptimize(reply.data());
+            replies_size += reply.size();
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(replies_size));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(receipts.size()));
+}
+
+void bench_logs_nlohmann(benchmark::State& state) {
+    Logs logs;
+    for (const auto& receipt : make_receipts(make_block())) {
+        logs.insert(logs.end(), receipt.logs.cbegin(), receipt.logs.cend());
+    }
+    std::size_t reply_size{0};
+    for ([[maybe_unused]] auto _ : state) {
+        const std::string reply{make_json_content(kRequest, logs).dump()};
+        benchmark::DoNotOptimize(reply.data());
+        reply_size = reply.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(reply_size));
+}
+
+void bench_logs_glaze(benchmark::State& state) {
+    Logs logs;
+    for (const auto& receipt : make_receipts(make_block())) {
+        logs.insert(logs.end(), receipt.logs.cbegin(), receipt.logs.cend());
+    }
+    std::size_t reply_size{0};
+    for ([[maybe_unused]] auto _ : state) {
+        std::string reply;
+        make_glaze_json_content(kRequest, logs, reply);
+        benchmark::DoNotOptimize(reply.data());
+        reply_size = reply.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(reply_size));
+}
+
+}  // namespace
+
+BENCHMARK(bench_block_nlohmann);
+BENCHMARK(bench_block_glaze);
+BENCHMARK(bench_receipts_nlohmann);
+BENCHMARK(bench_receipts_glaze);
+BENCHMARK(bench_logs_nlohmann);
+BENCHMARK(bench_logs_glaze);
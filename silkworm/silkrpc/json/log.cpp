@@ -78,33 +78,23 @@ void from_json(const nlohmann::json& json, Log& log) {
     }
 }
 
-struct GlazeJsonLogItem {
-    char address[kAddressHexSize];
-    char tx_hash[kHashHexSize];
-    char block_hash[kHashHexSize];
-    char block_number[kInt64HexSize];
-    char tx_index[kInt64HexSize];
-    char index[kInt64HexSize];
-    char data[kDataSize];
-    bool removed;
-    std::vector<std::string> topics;
-    std::optional<std::string> timestamp;
-
-    struct glaze {
-        using T = GlazeJsonLogItem;
-        static constexpr auto value = glz::object(
-            "address", &T::address,
-            "transactionHash", &T::tx_hash,
-            "blockHash", &T::block_hash,
-            "blockNumber", &T::block_number,
-            "transactionIndex", &T::tx_index,
-            "logIndex", &T::index,
-            "data", &T::data,
-            "removed", &T::removed,
-            "topics", &T::topics,
-            "timestamp", &T::timestamp);
-    };
-};
+void make_glaze_json_log(const Log& log, GlazeJsonLogItem& json_log) {
+    to_hex(std::span(json_log.address), log.address.bytes);
+    to_hex(std::span(json_log.tx_hash), log.tx_hash.bytes);
+    to_hex(std::span(json_log.block_hash), log.block_hash.bytes);
+    to_quantity(std::span(json_log.block_number), log.block_number);
+    to_quantity(std::span(json_log.tx_index), log.tx_index);
+    to_quantity(std::span(json_log.index), log.index);
+    json_log.removed = log.removed;
+    json_log.data = "0x" + silkworm::to_hex(log.data);
+    if (log.timestamp) {
+        json_log.timestamp = to_quantity(*(log.timestamp));
+    }
+    json_log.topics.reserve(log.topics.size());
+    for (const auto& t : log.topics) {
+        json_log.topics.push_back(silkworm::to_hex(t, true));
+    }
+}
 
 struct GlazeJsonLog {
     std::string_view jsonrpc = kJsonVersion;
@@ -127,20 +117,7 @@ void make_glaze_json_content(const nlohmann::json& request_json, const Logs& log
 
     for (const auto& l : logs) {
         GlazeJsonLogItem item{};
-        to_hex(std::span(item.address), l.address.bytes);
-        to_hex(std::span(item.tx_hash), l.tx_hash.bytes);
-        to_hex(std::span(item.block_hash), l.block_hash.bytes);
-        to_quantity(std::span(item.block_number), l.block_number);
-        to_quantity(std::span(item.tx_index), l.tx_index);
-        to_quantity(std::span(item.index), l.index);
-        item.removed = l.removed;
-        to_hex(item.data, l.data);
-        if (l.timestamp) {
-            item.timestamp = to_quantity(*(l.timestamp));
-        }
-        for (const auto& t : l.topics) {
-            item.topics.push_back(silkworm::to_hex(t, true));
-        }
+        make_glaze_json_log(l, item);
         log_json_data.log_json_list.push_back(std::move(item));
     }
 
@@ -16,8 +16,13 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
+#include <vector>
+
 #include <nlohmann/json.hpp>
 
+#include <silkworm/silkrpc/json/glaze.hpp>
 #include <silkworm/silkrpc/types/log.hpp>
 
 namespace silkworm::rpc {
@@ -25,6 +30,36 @@ namespace silkworm::rpc {
 void from_json(const nlohmann::json& json, Log& log);
 void to_json(nlohmann::json& json, const Log& log);
 
+struct GlazeJsonLogItem {
+    char address[kAddressHexSize];
+    char tx_hash[kHashHexSize];
+    char block_hash[kHashHexSize];
+    char block_number[kInt64HexSize];
+    char tx_index[kInt64HexSize];
+    char index[kInt64HexSize];
+    std::string data;
+    bool removed;
+    std::vector<std::string> topics;
+    std::optional<std::string> timestamp;
+
+    struct glaze {
+        using T = GlazeJsonLogItem;
+        static constexpr auto value = glz::object(
+            "address", &T::address,
+            "transactionHash", &T::tx_hash,
+            "blockHash", &T::block_hash,
+            "blockNumber", &T::block_number,
+            "transactionIndex", &T::tx_index,
+            "logIndex", &T::index,
+            "data", &T::data,
+            "removed", &T::removed,
+            "topics", &T::topics,
+            "timestamp", &T::timestamp);
+    };
+};
+
+void make_glaze_json_log(const Log& log, GlazeJsonLogItem& json_log);
+
 void make_glaze_json_content(const nlohmann::json& request_json, const Logs& logs, std::string& json_reply);
 
 }  // namespace silkworm::rpc
@@ -16,6 +16,9 @@
 
 #include "receipt.hpp"
 
+#include <span>
+#include <utility>
+
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/silkrpc/common/util.hpp>
@@ -79,4 +82,55 @@ void from_json(const nlohmann::json& json, Receipt& receipt) {
     }
 }
 
+void make_glaze_json_receipt(const Receipt& receipt, GlazeJsonReceipt& json_receipt) {
+    to_hex(std::span(json_receipt.block_hash), receipt.block_hash.bytes);
+    to_quantity(std::span(json_receipt.block_number), receipt.block_number);
+    to_hex(std::span(json_receipt.tx_hash), receipt.tx_hash.bytes);
+    to_quantity(std::span(json_receipt.tx_index), receipt.tx_index);
+    to_hex(std::span(json_receipt.from), receipt.from.value_or(evmc::address{}).bytes);
+    if (receipt.to) {
+        json_receipt.to = "0x" + silkworm::to_hex(receipt.to->bytes);
+    } else {
+        json_receipt.nullto = std::monostate{};
+    }
+    to_quantity(std::span(json_receipt.type), receipt.type ? receipt.type.value() : 0);
+    to_quantity(std::span(json_receipt.gas_used), receipt.gas_used);
+    to_quantity(std::span(json_receipt.cumulative_gas_used), receipt.cumulative_gas_used);
+    to_quantity(std::span(json_receipt.effective_gas_price), receipt.effective_gas_price);
+    if (receipt.contract_address) {
+        json_receipt.contract_address = "0x" + silkworm::to_hex(receipt.contract_address.bytes);
+    } else {
+        json_receipt.null_contract_address = std::monostate{};
+    }
+    json_receipt.logs.reserve(receipt.logs.size());
+    for (const auto& log : receipt.logs) {
+        GlazeJsonLogItem item{};
+        make_glaze_json_log(log, item);
+        json_receipt.logs.push_back(std::move(item));
+    }
+    to_hex(std::span(json_receipt.logs_bloom), full_view(receipt.bloom));
+    to_quantity(std::span(json_receipt.status), receipt.success ? 1 : 0);
+}
+
+struct GlazeJsonReceiptReply {
+    std::string_view jsonrpc = kJsonVersion;
+    JsonRpcId id;
+    GlazeJsonReceipt result;
+    struct glaze {
+        using T = GlazeJsonReceiptReply;
+        static constexpr auto value = glz::object(
+            "jsonrpc", &T::jsonrpc,
+            "id", &T::id,
+            "result", &T::result);
+    };
+};
+
+void make_glaze_json_content(const nlohmann::json& request_json, const Receipt& receipt, std::string& json_reply) {
+    GlazeJsonReceiptReply receipt_json_data{};
+    receipt_json_data.id = make_jsonrpc_id(request_json);
+    make_glaze_json_receipt(receipt, receipt_json_data.result);
+
+    glz::write_json(receipt_json_data, json_reply);
+}
+
 }  // namespace silkworm::rpc
@@ -16,8 +16,15 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
 #include <nlohmann/json.hpp>
 
+#include <silkworm/silkrpc/json/glaze.hpp>
+#include <silkworm/silkrpc/json/log.hpp>
 #include <silkworm/silkrpc/types/receipt.hpp>
 
 namespace silkworm::rpc {
@@ -25,4 +32,48 @@ namespace silkworm::rpc {
 void to_json(nlohmann::json& json, const Receipt& receipt);
 void from_json(const nlohmann::json& json, Receipt& receipt);
 
+struct GlazeJsonReceipt {
+    char block_hash[kHashHexSize];
+    char block_number[kInt64HexSize];
+    char tx_hash[kHashHexSize];
+    char tx_index[kInt64HexSize];
+    char from[kAddressHexSize];
+    char type[kInt64HexSize];
+    char gas_used[kInt64HexSize];
+    char cumulative_gas_used[kInt64HexSize];
+    char effective_gas_price[kInt256HexSize];
+    char logs_bloom[kBloomSize];
+    char status[kInt64HexSize];
+    std::vector<GlazeJsonLogItem> logs;
+    std::optional<std::string> to;
+    std::optional<std::monostate> nullto;
+    std::optional<std::string> contract_address;
+    std::optional<std::monostate> null_contract_address;
+
+    struct glaze {
+        using T = GlazeJsonReceipt;
+        static constexpr auto value = glz::object(
+            "blockHash", &T::block_hash,
+            "blockNumber", &T::block_number,
+            "transactionHash", &T::tx_hash,
+            "transactionIndex", &T::tx_index,
+            "from", &T::from,
+            "to", &T::to,
+            "to", &T::nullto,
+            "type", &T::type,
+            "gasUsed", &T::gas_used,
+            "cumulativeGasUsed", &T::cumulative_gas_used,
+            "effectiveGasPrice", &T::effective_gas_price,
+            "contractAddress", &T::contract_address,
+            "contractAddress", &T::null_contract_address,
+            "logs", &T::logs,
+            "logsBloom", &T::logs_bloom,
+            "status", &T::status);
+    };
+};
+
+void make_glaze_json_receipt(const Receipt& receipt, GlazeJsonReceipt& json_receipt);
+
+void make_glaze_json_content(const nlohmann::json& request_json, const Receipt& receipt, std::string& json_reply);
+
 }  // namespace silkworm::rpc
@@ -16,9 +16,13 @@
 
 #include "receipt.hpp"
 
+#include <string>
+
 #include <catch2/catch.hpp>
 #include <evmc/evmc.hpp>
 
+#include <silkworm/silkrpc/json/types.hpp>
+
 namespace silkworm::rpc {
 
 using Catch::Matchers::Message;
@@ -143,4 +147,46 @@ TEST_CASE("serialize receipt", "[silkworm::json][to_json]") {
     })"_json);
 }
 
+TEST_CASE("make glaze json receipt", "[silkworm::json][make_glaze_json_content]") {
+    Receipt r{
+        true,
+        454647,
+        silkworm::Bloom{},
+        Logs{},
+        0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32,
+        0x0715a7794a1dc8e42615f059dd6e406a6594651a_address,
+        10,
+        0xb02a3b0ee16c858afaa34bcd6770b3c20ee56aa2f75858733eb0e927b5b7126f_bytes32,
+        5000000,
+        3,
+        0x22ea9f6b28db76a7162054c05ed812deb2f519cd_address,
+        std::nullopt,
+        2,
+        2000000000};
+    r.bloom[10] = 0x80;
+    r.logs.push_back(Log{
+        .address = 0x22ea9f6b28db76a7162054c05ed812deb2f519cd_address,
+        .topics = {0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32},
+        .data = silkworm::Bytes(3'000, 0xab),  // bigger than any fixed-size buffer
+        .block_number = 5000000,
+        .tx_hash = r.tx_hash,
+        .tx_index = 3,
+        .block_hash = r.block_hash,
+        .index = 7,
+    });
+    const auto request = R"({"jsonrpc":"2.0","id":1,"method":"eth_getTransactionReceipt","params":[]})"_json;
+
+    std::string json;
+    make_glaze_json_content(request, r, json);
+    CHECK(nlohmann::json::parse(json) == make_json_content(request, r));
+
+    SECTION("contract call") {
+        r.contract_address = evmc::address{};
+        r.to = 0x0715a7794a1dc8e42615f059dd6e406a6594651a_address;
+        std::string call_json;
+        make_glaze_json_content(request, r, call_json);
+        CHECK(nlohmann::json::parse(call_json) == make_json_content(request, r));
+    }
+}
+
 }  // namespace silkworm::rpc
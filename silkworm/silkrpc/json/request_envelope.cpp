@@ -0,0 +1,159 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "request_envelope.hpp"
+
+#include <cstddef>
+
+namespace silkworm::rpc {
+
+namespace {
+
+class EnvelopeScanner {
+  public:
+    explicit EnvelopeScanner(std::string_view text) : text_{text} {}
+
+    bool at_end() {
+        skip_whitespace();
+        return position_ == text_.size();
+    }
+
+    bool consume(char c) {
+        skip_whitespace();
+        if (position_ < text_.size() && text_[position_] == c) {
+            ++position_;
+            return true;
+        }
+        return false;
+    }
+
+    //! Scan a string without escapes returning its content
+    std::optional<std::string_view> plain_string() {
+        skip_whitespace();
+        if (position_ >= text_.size() || text_[position_] != '"') {
+            return std::nullopt;
+        }
+        const std::size_t begin{position_ + 1};
+        for (std::size_t i{begin}; i < text_.size(); ++i) {
+            if (text_[i] == '\\') {
+                return std::nullopt;
+            }
+            if (text_[i] == '"') {
+                position_ = i + 1;
+                return text_.substr(begin, i - begin);
+            }
+        }
+        return std::nullopt;
+    }
+
+    //! Scan any value returning its raw text: nested objects and arrays are matched by bracket depth outside strings
+    std::optional<std::string_view> raw_value() {
+        skip_whitespace();
+        const std::size_t begin{position_};
+        std::size_t depth{0};
+        bool in_string{false};
+        for (; position_ < text_.size(); ++position_) {
+            const char c{text_[position_]};
+            if (in_string) {
+                if (c == '\\') {
+                    ++position_;
+                } else if (c == '"') {
+                    in_string = false;
+                    if (depth == 0) {
+                        ++position_;
+                        break;
+                    }
+                }
+            } else if (c == '"') {
+                in_string = true;
+            } else if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (depth == 0) {
+                    break;  // End of enclosing object
+                }
+                if (--depth == 0) {
+                    ++position_;
+                    break;
+                }
+            } else if (depth == 0 && (c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r')) {
+                break;
+            }
+        }
+        if (in_string || depth > 0 || position_ > text_.size() || position_ == begin) {
+            return std::nullopt;
+        }
+        return text_.substr(begin, position_ - begin);
+    }
+
+  private:
+    void skip_whitespace() {
+        while (position_ < text_.size() && (text_[position_] == ' ' || text_[position_] == '\t' ||
+                                            text_[position_] == '\n' || text_[position_] == '\r')) {
+            ++position_;
+        }
+    }
+
+    std::string_view text_;
+    std::size_t position_{0};
+};
+
+}  // namespace
+
+std::optional<RequestEnvelope> parse_request_envelope(std::string_view content) {
+    EnvelopeScanner scanner{content};
+    if (!scanner.consume('{')) {
+        return std::nullopt;
+    }
+    RequestEnvelope envelope;
+    bool first{true};
+    while (!scanner.consume('}')) {
+        if (!first && !scanner.consume(',')) {
+            return std::nullopt;
+        }
+        first = false;
+        const auto key{scanner.plain_string()};
+        if (!key || !scanner.consume(':')) {
+            return std::nullopt;
+        }
+        std::optional<std::string_view> value;
+        std::string_view* member{nullptr};
+        if (*key == "jsonrpc") {
+            value = scanner.plain_string();
+            member = &envelope.jsonrpc;
+        } else if (*key == "method") {
+            value = scanner.plain_string();
+            member = &envelope.method;
+        } else if (*key == "id") {
+            value = scanner.raw_value();
+            member = &envelope.id;
+        } else if (*key == "params") {
+            value = scanner.raw_value();
+            member = &envelope.params;
+        }
+        // Unknown or duplicate members are left to the full parser
+        if (!value || !member->empty() || value->empty()) {
+            return std::nullopt;
+        }
+        *member = *value;
+    }
+    if (!scanner.at_end()) {
+        return std::nullopt;
+    }
+    return envelope;
+}
+
+}  // namespace silkworm::rpc
@@ -0,0 +1,39 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+namespace silkworm::rpc {
+
+//! The members of a JSON-RPC request object, each one being the raw JSON text of its value (or empty if missing)
+//! except method and jsonrpc which are the content of their string values
+struct RequestEnvelope {
+    std::string_view jsonrpc;
+    std::string_view id;
+    std::string_view method;
+    std::string_view params;
+};
+
+//! Extract the members of a JSON-RPC request object scanning its text once, without building any DOM
+//! \details Values are just delimited, not validated: id and params must be parsed by the caller
+//! \return the envelope or std::nullopt if content is not a single object having just JSON-RPC members, jsonrpc and
+//! method being strings without escapes
+std::optional<RequestEnvelope> parse_request_envelope(std::string_view content);
+
+}  // namespace silkworm::rpc
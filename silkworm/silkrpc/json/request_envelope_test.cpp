@@ -0,0 +1,64 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "request_envelope.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::rpc {
+
+TEST_CASE("parse_request_envelope", "[silkrpc][json][request_envelope]") {
+    SECTION("all members") {
+        const auto envelope{parse_request_envelope(
+            R"( {"jsonrpc":"2.0", "id" : 7,"method":"eth_getLogs","params":[{"address":["0x1"],"topics":[null,"a]}\"b"]}]} )")};
+        REQUIRE(envelope);
+        CHECK(envelope->jsonrpc == "2.0");
+        CHECK(envelope->id == "7");
+        CHECK(envelope->method == "eth_getLogs");
+        CHECK(envelope->params == R"([{"address":["0x1"],"topics":[null,"a]}\"b"]}])");
+    }
+
+    SECTION("id of any kind") {
+        CHECK(parse_request_envelope(R"({"method":"m","id":"x,}"})")->id == R"("x,}")");
+        CHECK(parse_request_envelope(R"({"method":"m","id":null})")->id == "null");
+        CHECK(parse_request_envelope(R"({"id":-1.5e3,"method":"m"})")->id == "-1.5e3");
+    }
+
+    SECTION("missing members") {
+        const auto envelope{parse_request_envelope(R"({"method":"eth_blockNumber"})")};
+        REQUIRE(envelope);
+        CHECK(envelope->jsonrpc.empty());
+        CHECK(envelope->id.empty());
+        CHECK(envelope->params.empty());
+        CHECK(parse_request_envelope("{}"));
+    }
+
+    SECTION("left to the full parser") {
+        CHECK_FALSE(parse_request_envelope(""));
+        CHECK_FALSE(parse_request_envelope(R"([{"method":"m"}])"));
+        CHECK_FALSE(parse_request_envelope(R"({"method":"m","foo":1})"));
+        CHECK_FALSE(parse_request_envelope(R"({"method":"m","method":"n"})"));
+        CHECK_FALSE(parse_request_envelope(R"({"method":"eth\u005fcall"})"));
+        CHECK_FALSE(parse_request_envelope(R"({"method":1})"));
+        CHECK_FALSE(parse_request_envelope(R"({"method":"m","params":[1,2})"));
+        CHECK_FALSE(parse_request_envelope(R"({"method":"m","params":["x]})"));
+        CHECK_FALSE(parse_request_envelope(R"({"method":"m" "id":1})"));
+        CHECK_FALSE(parse_request_envelope(R"({"method":"m"} x)"));
+        CHECK_FALSE(parse_request_envelope(R"({"method":"m",})"));
+    }
+}
+
+}  // namespace silkworm::rpc
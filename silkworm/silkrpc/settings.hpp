@@ -39,6 +39,14 @@ struct DaemonSettings {
     std::optional<std::string> jwt_secret_file;
     bool skip_protocol_check{false};
     bool erigon_json_rpc_compatibility{false};
+    std::size_t max_batch_size{kDefaultMaxBatchSize};
+    std::size_t batch_concurrency{kDefaultBatchConcurrency};
+    bool http_compression{false};
+    std::size_t http_compression_threshold{kDefaultCompressionThreshold};
+    std::chrono::milliseconds http_idle_timeout{kDefaultIdleTimeout};
+    std::size_t http_max_requests_per_connection{kDefaultMaxRequestsPerConnection};
+    std::size_t http_max_pipelined_requests{kDefaultMaxPipelinedRequests};
+    std::size_t http_max_content_length{kDefaultMaxRequestContentLength};
 };
 
 }  // namespace silkworm::rpc
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <optional>
+#include <span>
+#include <vector>
 
 #include <silkworm/infra/concurrency/task.hpp>
 
@@ -95,6 +97,9 @@ class ChainStorage {
 
     virtual Task<std::optional<BlockNum>> read_block_number_by_transaction_hash(const evmc::bytes32& transaction_hash) const = 0;
 
+    //! Read the numbers of the blocks containing the specified transactions, the same as read_block_number_by_transaction_hash for each hash
+    virtual Task<std::vector<std::optional<BlockNum>>> read_block_numbers_by_transaction_hashes(std::span<const evmc::bytes32> transaction_hashes) const = 0;
+
     // Task<silkworm::BlockHeader> read_current_header();
 
     // Task<evmc::bytes32> read_head_header_hash();
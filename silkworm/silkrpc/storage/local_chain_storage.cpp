@@ -147,4 +147,8 @@ Task<std::optional<BlockNum>> LocalChainStorage::read_block_number_by_transactio
     co_return data_model_.read_tx_lookup(txn_hash);
 }
 
+Task<std::vector<std::optional<BlockNum>>> LocalChainStorage::read_block_numbers_by_transaction_hashes(std::span<const evmc::bytes32> txn_hashes) const {
+    co_return data_model_.read_tx_lookups(txn_hashes);
+}
+
 }  // namespace silkworm::rpc
@@ -70,6 +70,7 @@ class LocalChainStorage : public ChainStorage {
     [[nodiscard]] Task<std::optional<intx::uint256>> read_total_difficulty(const Hash& block_hash, BlockNum block_number) const override;
 
     Task<std::optional<BlockNum>> read_block_number_by_transaction_hash(const evmc::bytes32& transaction_hash) const override;
+    Task<std::vector<std::optional<BlockNum>>> read_block_numbers_by_transaction_hashes(std::span<const evmc::bytes32> transaction_hashes) const override;
 
   private:
     db::DataModel data_model_;
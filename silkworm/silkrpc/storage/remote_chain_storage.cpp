@@ -172,4 +172,14 @@ Task<std::optional<BlockNum>> RemoteChainStorage::read_block_number_by_transacti
     co_return co_await backend_->get_block_number_from_txn_hash(transaction_hash.bytes);
 }
 
+Task<std::vector<std::optional<BlockNum>>> RemoteChainStorage::read_block_numbers_by_transaction_hashes(std::span<const evmc::bytes32> transaction_hashes) const {
+    // No batch lookup in remote backend interface
+    std::vector<std::optional<BlockNum>> block_numbers;
+    block_numbers.reserve(transaction_hashes.size());
+    for (const auto& transaction_hash : transaction_hashes) {
+        block_numbers.push_back(co_await read_block_number_by_transaction_hash(transaction_hash));
+    }
+    co_return block_numbers;
+}
+
 }  // namespace silkworm::rpc
@@ -184,8 +184,9 @@ class RequestHandler_ForTest : public silkworm::rpc::http::RequestHandler {
     RequestHandler_ForTest(boost::asio::ip::tcp::socket& socket,
                            commands::RpcApi& rpc_api,
                            const commands::RpcApiTable& rpc_api_table,
-                           std::optional<std::string> jwt_secret)
-        : silkworm::rpc::http::RequestHandler(socket, rpc_api, rpc_api_table, allowed_origins, std::move(jwt_secret)) {
+                           std::optional<std::string> jwt_secret,
+                           http::BatchSettings batch_settings = {})
+        : silkworm::rpc::http::RequestHandler(socket, rpc_api, rpc_api_table, allowed_origins, std::move(jwt_secret), batch_settings) {
     }
 
     Task<void> request_and_create_reply(const nlohmann::json& request_json, http::Reply& reply) {
@@ -229,12 +230,13 @@ class LocalContextTestBase : public silkworm::rpc::test::ContextTestBase {
 template <typename TestRequestHandler>
 class RpcApiTestBase : public LocalContextTestBase {
   public:
-    explicit RpcApiTestBase(mdbx::env& chaindata_env) : LocalContextTestBase(chaindata_env), workers_{1}, socket{io_context_}, rpc_api{io_context_, workers_}, rpc_api_table{kDefaultEth1ApiSpec} {
+    explicit RpcApiTestBase(mdbx::env& chaindata_env, std::size_t num_workers = 1)
+        : LocalContextTestBase(chaindata_env), workers_{num_workers}, socket{io_context_}, rpc_api{io_context_, workers_}, rpc_api_table{kDefaultEth1ApiSpec} {
     }
 
     template <auto method, typename... Args>
     auto run(Args&&... args) {
-        TestRequestHandler handler{socket, rpc_api, rpc_api_table, ""};
+        TestRequestHandler handler{socket, rpc_api, rpc_api_table, "", batch_settings};
         return spawn_and_wait((handler.*method)(std::forward<Args>(args)...));
     }
 
@@ -242,6 +244,7 @@ class RpcApiTestBase : public LocalContextTestBase {
     boost::asio::ip::tcp::socket socket;
     commands::RpcApi rpc_api;
     commands::RpcApiTable rpc_api_table;
+    http::BatchSettings batch_settings;
 };
 mdbx::env_managed InitializeTestDatabase() {
     const auto tests_dir = get_tests_dir();
@@ -74,6 +74,8 @@ class MockChainStorage : public silkworm::rpc::ChainStorage {
     MOCK_METHOD((Task<std::optional<intx::uint256>>), read_total_difficulty, (const Hash& block_hash, BlockNum block_number), (const override));
 
     MOCK_METHOD((Task<std::optional<BlockNum>>), read_block_number_by_transaction_hash, (const evmc::bytes32& transaction_hash), (const override));
+
+    MOCK_METHOD((Task<std::vector<std::optional<BlockNum>>>), read_block_numbers_by_transaction_hashes, (std::span<const evmc::bytes32> transaction_hashes), (const override));
 };
 
 }  // namespace silkworm::rpc::test
@@ -0,0 +1,125 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "pending_transactions_stream.hpp"
+
+#include <bit>
+#include <tuple>
+
+#include <boost/asio/experimental/as_tuple.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/use_future.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/concurrency/co_spawn_sw.hpp>
+#include <silkworm/infra/concurrency/shared_service.hpp>
+#include <silkworm/silkrpc/grpc/util.hpp>
+
+namespace silkworm::rpc::txpool {
+
+//! Define Asio coroutine-based completion token using error codes instead of exceptions for errors
+constexpr auto use_nothrow_awaitable = boost::asio::as_tuple(boost::asio::use_awaitable);
+
+std::vector<evmc::bytes32> make_transaction_hashes(const ::txpool::OnAddReply& reply) {
+    std::vector<evmc::bytes32> tx_hashes;
+    tx_hashes.reserve(static_cast<std::size_t>(reply.rpl_txs_size()));
+    for (const auto& rlp_tx : reply.rpl_txs()) {
+        const ByteView rlp_tx_view{reinterpret_cast<const uint8_t*>(rlp_tx.data()), rlp_tx.size()};
+        tx_hashes.push_back(std::bit_cast<evmc_bytes32>(keccak256(rlp_tx_view)));
+    }
+    return tx_hashes;
+}
+
+PendingTransactionsStream::PendingTransactionsStream(ClientContext& context, ::txpool::Txpool::StubInterface* stub)
+    : scheduler_(*context.io_context()),
+      grpc_context_(*context.grpc_context()),
+      stub_(stub),
+      subscription_hub_(must_use_shared_service<SubscriptionHub>(scheduler_)),
+      retry_timer_{scheduler_} {}
+
+std::future<void> PendingTransactionsStream::open() {
+    return concurrency::co_spawn_sw(scheduler_, run(), boost::asio::use_future);
+}
+
+void PendingTransactionsStream::close() {
+    std::lock_guard lock{cancellation_mutex_};
+    SILK_DEBUG << "Close pending transactions stream: emitting cancellation";
+    cancellation_signal_.emit(boost::asio::cancellation_type::all);
+    SILK_DEBUG << "Close pending transactions stream: cancellation emitted";
+}
+
+Task<void> PendingTransactionsStream::run() {
+    SILK_TRACE << "PendingTransactionsStream::run pending txs stream START";
+
+    auto cancellation_slot = cancellation_signal_.slot();
+
+    const ::txpool::OnAddRequest request;
+    bool cancelled{false};
+    while (!cancelled) {
+        auto on_add_rpc{std::make_shared<OnAddRpc>(*stub_, grpc_context_)};
+
+        {
+            std::lock_guard lock{cancellation_mutex_};
+            cancellation_slot.assign([&, on_add_rpc](boost::asio::cancellation_type /*type*/) {
+                retry_timer_.cancel();
+                on_add_rpc->cancel();
+                SILK_DEBUG << "Pending transactions stream cancelled";
+            });
+        }
+
+        SILK_DEBUG << "Registration for pending transactions started";
+        const auto [req_ec] = co_await on_add_rpc->request_on(scheduler_.get_executor(), request, use_nothrow_awaitable);
+        if (req_ec) {
+            if (std::error_code(req_ec).value() == grpc::StatusCode::CANCELLED) {
+                cancelled = true;
+            } else {
+                SILK_WARN << "Pending transactions stream request error [" << req_ec.message() << "], schedule reopen";
+                cancelled = !co_await wait_before_retry();
+            }
+            continue;
+        }
+        SILK_DEBUG << "Pending transactions stream opened";
+
+        std::error_code read_ec;
+        ::txpool::OnAddReply reply;
+        while (!read_ec) {
+            std::tie(read_ec, reply) = co_await on_add_rpc->read_on(scheduler_.get_executor(), use_nothrow_awaitable);
+            if (!read_ec) {
+                SILK_TRACE << "Pending transactions received: " << reply.rpl_txs_size();
+                if (subscription_hub_->has_subscribers(SubscriptionKind::kNewPendingTransactions)) {
+                    subscription_hub_->publish_pending_transactions(make_transaction_hashes(reply));
+                }
+            } else if (read_ec.value() == grpc::StatusCode::CANCELLED) {
+                cancelled = true;
+            } else {
+                SILK_WARN << "Pending transactions stream read error [" << read_ec.message() << "], schedule reopen";
+                cancelled = !co_await wait_before_retry();
+            }
+        }
+    }
+
+    SILK_TRACE << "PendingTransactionsStream::run pending txs stream END";
+}
+
+Task<bool> PendingTransactionsStream::wait_before_retry() {
+    retry_timer_.expires_after(kDefaultOnAddRegistrationInterval);
+    const auto [ec] = co_await retry_timer_.async_wait(use_nothrow_awaitable);
+    co_return ec != boost::asio::error::operation_aborted;
+}
+
+}  // namespace silkworm::rpc::txpool
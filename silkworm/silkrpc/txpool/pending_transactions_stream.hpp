@@ -0,0 +1,88 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include <silkworm/infra/concurrency/task.hpp>
+
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <evmc/evmc.hpp>
+
+#include <silkworm/infra/grpc/client/client_context_pool.hpp>
+#include <silkworm/interfaces/txpool/txpool.grpc.pb.h>
+#include <silkworm/silkrpc/core/subscription_hub.hpp>
+#include <silkworm/silkrpc/grpc/server_streaming_rpc.hpp>
+
+namespace silkworm::rpc::txpool {
+
+using OnAddRpc = ServerStreamingRpc<&::txpool::Txpool::StubInterface::PrepareAsyncOnAdd>;
+
+//! The default interval between successive registration attempts
+constexpr std::chrono::milliseconds kDefaultOnAddRegistrationInterval{10'000};
+
+//! Compute the hashes of the transactions received from the pool as their canonical encoding
+std::vector<evmc::bytes32> make_transaction_hashes(const ::txpool::OnAddReply& reply);
+
+//! End-point of the stream of transactions added to the pool of the node Core component, feeding the
+//! newPendingTransactions subscriptions
+class PendingTransactionsStream {
+  public:
+    explicit PendingTransactionsStream(ClientContext& context, ::txpool::Txpool::StubInterface* stub);
+
+    //! Open up the stream, starting the register-and-receive loop
+    std::future<void> open();
+
+    //! Close down the stream, stopping the register-and-receive loop
+    void close();
+
+    //! The register-and-receive asynchronous loop
+    Task<void> run();
+
+  private:
+    //! Wait for the registration interval before the next registration attempt
+    //! @return false if the wait has been cancelled, true otherwise
+    Task<bool> wait_before_retry();
+
+    //! Asio execution scheduler running the register-and-receive asynchronous loop
+    boost::asio::io_context& scheduler_;
+
+    //! gRPC execution scheduler running the register-and-receive asynchronous loop
+    agrpc::GrpcContext& grpc_context_;
+
+    //! The gRPC stub for remote txpool interface of the Core component
+    ::txpool::Txpool::StubInterface* stub_;
+
+    //! The registry of subscriptions where the pending transactions will be published
+    SubscriptionHub* subscription_hub_;
+
+    //! The signal used to cancel the register-and-receive stream loop
+    boost::asio::cancellation_signal cancellation_signal_;
+
+    //! The timer to schedule retries for stream opening
+    boost::asio::steady_timer retry_timer_;
+
+    //! The mutual exclusion access to the cancellation signal
+    std::mutex cancellation_mutex_;
+};
+
+}  // namespace silkworm::rpc::txpool
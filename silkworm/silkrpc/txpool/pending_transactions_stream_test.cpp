@@ -0,0 +1,62 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "pending_transactions_stream.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/rlp/encode.hpp>
+#include <silkworm/core/types/transaction.hpp>
+
+namespace silkworm::rpc::txpool {
+
+using namespace evmc::literals;
+
+TEST_CASE("make_transaction_hashes", "[silkrpc][txpool][pending_transactions_stream]") {
+    SECTION("empty reply") {
+        CHECK(make_transaction_hashes(::txpool::OnAddReply{}).empty());
+    }
+
+    SECTION("legacy and typed transactions") {
+        Transaction txn{};
+        txn.nonce = 7;
+        txn.max_priority_fee_per_gas = 10000000000;
+        txn.max_fee_per_gas = 30000000000;
+        txn.gas_limit = 5748100;
+        txn.to = 0x811a752c8cd697e3cb27279c330ed1ada745a8d7_address;
+        txn.value = 2 * kEther;
+        txn.data = *from_hex("6ebaf477f83e051589c1188bcc6ddccd");
+        txn.odd_y_parity = false;
+        txn.r = intx::from_string<intx::uint256>("0x36b241b061a36a32ab7fe86c7aa9eb592dd59018cd0443adc0903590c16b02b0");
+        txn.s = intx::from_string<intx::uint256>("0x5edcc541b4741c5cc6dd347c5ed9577ef293a62787b4510465fadbfe39ee4094");
+
+        ::txpool::OnAddReply reply;
+        std::vector<evmc::bytes32> expected_hashes;
+        for (const auto type : {TransactionType::kLegacy, TransactionType::kDynamicFee}) {
+            txn.type = type;
+            txn.chain_id = 1;
+            txn.reset();  // discard the hash cached for the previous type
+            Bytes rlp_tx;
+            rlp::encode(rlp_tx, txn, /*wrap_eip2718_into_string=*/false);
+            reply.add_rpl_txs(rlp_tx.data(), rlp_tx.size());
+            expected_hashes.push_back(txn.hash());
+        }
+        CHECK(make_transaction_hashes(reply) == expected_hashes);
+    }
+}
+
+}  // namespace silkworm::rpc::txpool
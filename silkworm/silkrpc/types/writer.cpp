@@ -17,7 +17,9 @@
 #include "writer.hpp"
 
 #include <algorithm>
+#include <array>
 #include <charconv>
+#include <cstring>
 #include <iostream>
 #include <utility>
 
@@ -31,9 +33,16 @@ namespace silkworm::rpc {
 const std::string kChunkSep{'\r', '\n'};                     // NOLINT(runtime/string)
 const std::string kFinalChunk{'0', '\r', '\n', '\r', '\n'};  // NOLINT(runtime/string)
 
+//! The room reserved in front of the chunk data for its header, i.e. the chunk size in hex digits plus separator
+constexpr std::size_t kChunkHeaderRoom{2 * sizeof(std::size_t) + 2};
+
 ChunksWriter::ChunksWriter(Writer& writer, std::size_t chunk_size)
-    : writer_(writer), chunk_size_(chunk_size), available_(chunk_size_), buffer_{new char[chunk_size_]} {
-    std::memset(buffer_.get(), 0, chunk_size_);
+    : writer_(writer),
+      chunk_size_(chunk_size),
+      available_(chunk_size_),
+      buffer_{new char[kChunkHeaderRoom + chunk_size_ + kChunkSep.size()]},
+      data_{buffer_.get() + kChunkHeaderRoom} {
+    std::memset(buffer_.get(), 0, kChunkHeaderRoom + chunk_size_ + kChunkSep.size());
 }
 
 void ChunksWriter::write(std::string_view content) {
@@ -42,7 +51,7 @@ void ChunksWriter::write(std::string_view content) {
 
     SILK_DEBUG << "ChunksWriter::write available_: " << available_ << " size: " << size;
 
-    char* buffer_start = buffer_.get() + (chunk_size_ - available_);
+    char* buffer_start = data_ + (chunk_size_ - available_);
     if (available_ > size) {
         std::memcpy(buffer_start, c_str, size);
         available_ -= size;
@@ -60,7 +69,7 @@ void ChunksWriter::write(std::string_view content) {
         }
         flush();
 
-        buffer_start = buffer_.get();
+        buffer_start = data_;
     }
 }
 
@@ -75,16 +84,16 @@ void ChunksWriter::flush() {
     SILK_DEBUG << "ChunksWriter::flush available_: " << available_ << " size: " << size;
 
     if (size > 0) {
-        std::array<char, 19> str;
-        if (auto [ptr, ec] = std::to_chars(str.data(), str.data() + str.size(), size, 16); ec == std::errc()) {
-            writer_.write(std::string_view(str.data(), ptr));
-            writer_.write(kChunkSep);
-        } else {
-            writer_.write("Invalid value");
-        }
-
-        writer_.write(std::string_view(buffer_.get(), size));
-        writer_.write(kChunkSep);
+        // Frame the chunk in place around its data, so that it is written at once: size line, data and separator
+        std::array<char, 2 * sizeof(std::size_t)> str;
+        const auto result = std::to_chars(str.data(), str.data() + str.size(), size, 16);
+        const auto size_length = static_cast<std::size_t>(result.ptr - str.data());
+        char* chunk_start = data_ - kChunkSep.size() - size_length;
+        std::memcpy(chunk_start, str.data(), size_length);
+        std::memcpy(data_ - kChunkSep.size(), kChunkSep.data(), kChunkSep.size());
+        std::memcpy(data_ + size, kChunkSep.data(), kChunkSep.size());
+
+        writer_.write(std::string_view(chunk_start, size_length + kChunkSep.size() + size + kChunkSep.size()));
     }
     available_ = chunk_size_;
 }
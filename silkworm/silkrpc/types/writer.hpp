@@ -89,6 +89,7 @@ class ChunksWriter : public Writer {
     const std::size_t chunk_size_;
     std::size_t available_;
     std::unique_ptr<char[]> buffer_;
+    char* data_;
 };
 
 class JsonChunksWriter : public Writer {
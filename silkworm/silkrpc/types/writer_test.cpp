@@ -102,6 +102,25 @@ TEST_CASE("ChunksWriter", "[silkrpc]") {
 
         CHECK(s_writer.get_content() == "0\r\n\r\n");
     }
+    SECTION("one write per chunk") {
+        class CountingWriter : public StringWriter {
+          public:
+            void write(std::string_view content) override {
+                StringWriter::write(content);
+                ++writes;
+            }
+            int writes{0};
+        };
+        CountingWriter c_writer;
+        ChunksWriter writer(c_writer, 0x20);
+
+        writer.write(std::string(0x30, 'a'));
+        CHECK(c_writer.writes == 1);
+        writer.close();
+        CHECK(c_writer.writes == 3);
+
+        CHECK(c_writer.get_content() == "20\r\n" + std::string(0x20, 'a') + "\r\n10\r\n" + std::string(0x10, 'a') + "\r\n0\r\n\r\n");
+    }
 }
 
 TEST_CASE("JsonChunksWriter", "[silkrpc]") {